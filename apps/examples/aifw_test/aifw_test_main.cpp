@@ -17,12 +17,15 @@
  ****************************************************************************/
 
 #include <stdio.h>
+#include <string.h>
+#include <unistd.h>
 #include <memory>
 #include "aifw/aifw.h"
 #include "aifw/aifw_log.h"
 #include "aifw/aifw_csv_reader.h"
 #include "aifw_test_main.h"
 #include "aifw/AIModelService.h"
+#include "aifw/AIModelScheduler.h"
 #include "aifw/AIInferenceHandler.h"
 #include "SineWaveInferenceHandler.h"
 
@@ -276,8 +279,184 @@ static void sine_inferenceResultListener(AIFW_RESULT res, void *values, uint16_t
 	AIFW_LOGI("Expected value: %f, AIFW prediction result : %f", gResultValues[1], predictedResult[0]);
 }
 
+#define SCHED_SERVICE_COUNT 2
+#define SCHED_WORKER_COUNT 2
+#define SCHED_INTERVAL_MSEC 200
+#define SCHED_RUN_SEC 10
+
+/**
+ * @brief SchedServiceInfo keeps a model service run by the scheduler and its own raw data source.
+ */
+struct SchedServiceInfo {
+	std::shared_ptr<AIInferenceHandler> aiInferenceHandler;
+	std::shared_ptr<AIModelService> aiModelService;
+	void *csvHandle;
+	float *values;
+	uint16_t valueCount;
+	uint32_t resultCount;
+};
+
+static struct SchedServiceInfo gSchedServices[SCHED_SERVICE_COUNT];
+
+/* A service never runs on two workers at once, so each one reads its own CSV without locking. */
+static void sched_collectRawData(int index)
+{
+	struct SchedServiceInfo *info = &gSchedServices[index];
+	memset(info->values, '\0', info->valueCount * sizeof(float));
+	AIFW_RESULT result = readCSVData(info->csvHandle, info->values);
+	if (result != AIFW_OK) {
+		/* Start the data set again from its first row */
+		csvDeinit(&info->csvHandle);
+		result = csvInit(&info->csvHandle, "/mnt/AI/SineWave_packet.csv", FLOAT32, false);
+		if (result == AIFW_OK) {
+			result = readCSVData(info->csvHandle, info->values);
+		}
+		if (result != AIFW_OK) {
+			AIFW_LOGE("reading input CSV data for service %d failed: %d", index, result);
+			return;
+		}
+	}
+	result = info->aiModelService->pushData((void *)info->values, info->valueCount);
+	if (result != AIFW_OK) {
+		AIFW_LOGE("push data operation for service %d failed. ret: %d", index, result);
+	}
+}
+
+static void sched_collectRawData0(void)
+{
+	sched_collectRawData(0);
+}
+
+static void sched_collectRawData1(void)
+{
+	sched_collectRawData(1);
+}
+
+static void sched_inferenceResult(int index, AIFW_RESULT res, void *values)
+{
+	if (res != AIFW_OK) {
+		AIFW_LOGE("Inference of service %d failed for this cycle, ret: %d", index, res);
+		return;
+	}
+	gSchedServices[index].resultCount++;
+	AIFW_LOGV("Service %d prediction result : %f", index, ((float *)values)[0]);
+}
+
+static void sched_inferenceResult0(AIFW_RESULT res, void *values, uint16_t count)
+{
+	sched_inferenceResult(0, res, values);
+}
+
+static void sched_inferenceResult1(AIFW_RESULT res, void *values, uint16_t count)
+{
+	sched_inferenceResult(1, res, values);
+}
+
+static void sched_printStats(void)
+{
+	AIModelScheduleStats stats;
+	for (int i = 0; i < SCHED_SERVICE_COUNT; i++) {
+		if (gSchedServices[i].aiModelService->getScheduleStats(&stats) != AIFW_OK) {
+			continue;
+		}
+		printf("service %d: results %u runs %u skipped %u deadline misses %u latency last %u max %u avg %u us\n", i,
+			   gSchedServices[i].resultCount, stats.runCount, stats.skipCount, stats.deadlineMissCount, stats.lastLatency, stats.maxLatency,
+			   stats.runCount ? (uint32_t)(stats.totalLatency / stats.runCount) : 0);
+	}
+}
+
+static void sched_deinit(std::shared_ptr<AIModelScheduler> scheduler)
+{
+	for (int i = 0; i < SCHED_SERVICE_COUNT; i++) {
+		struct SchedServiceInfo *info = &gSchedServices[i];
+		if (info->aiModelService) {
+			info->aiModelService->stop();
+		}
+		/* Service is removed from the scheduler when it is destroyed */
+		info->aiModelService = nullptr;
+		info->aiInferenceHandler = nullptr;
+		csvDeinit(&info->csvHandle);
+		if (info->values) {
+			free(info->values);
+			info->values = NULL;
+		}
+	}
+	scheduler->stop();
+}
+
+/**
+ * @brief: Runs two sine wave model services from one AIModelScheduler with two workers.
+ * Service 0 has the higher priority, its interval is halved in the middle of the run.
+ * Scheduling statistics of both services are printed before and after the change.
+ */
+static int aifw_test_scheduler(void)
+{
+	const CollectRawDataListener collect[SCHED_SERVICE_COUNT] = {sched_collectRawData0, sched_collectRawData1};
+	const InferenceResultListener result[SCHED_SERVICE_COUNT] = {sched_inferenceResult0, sched_inferenceResult1};
+	std::shared_ptr<AIModelScheduler> scheduler = std::make_shared<AIModelScheduler>(SCHED_WORKER_COUNT);
+	if (!scheduler || scheduler->start() != AIFW_OK) {
+		AIFW_LOGE("Scheduler start failed");
+		return -1;
+	}
+
+	for (int i = 0; i < SCHED_SERVICE_COUNT; i++) {
+		struct SchedServiceInfo *info = &gSchedServices[i];
+		info->resultCount = 0;
+		AIFW_RESULT res = csvInit(&info->csvHandle, "/mnt/AI/SineWave_packet.csv", FLOAT32, false);
+		if (res == AIFW_OK) {
+			res = getColumnCount(info->csvHandle, &info->valueCount);
+		}
+		if (res != AIFW_OK) {
+			AIFW_LOGE("Input CSV init for service %d failed. ret: %d", i, res);
+			goto cleanup;
+		}
+		info->values = (float *)malloc(info->valueCount * sizeof(float));
+		if (!info->values) {
+			AIFW_LOGE("Memory allocation failed for sensor values buffer");
+			goto cleanup;
+		}
+		info->aiInferenceHandler = std::make_shared<SineWaveInferenceHandler>(result[i]);
+		info->aiModelService = std::make_shared<AIModelService>(collect[i], info->aiInferenceHandler);
+		if (!info->aiInferenceHandler || !info->aiModelService) {
+			AIFW_LOGE("Memory allocation failed for service %d", i);
+			goto cleanup;
+		}
+		/* Higher value runs first, deadline is the interval */
+		if (info->aiModelService->setScheduler(scheduler, SCHED_SERVICE_COUNT - i, 0) != AIFW_OK ||
+			info->aiModelService->prepare() != AIFW_OK ||
+			info->aiModelService->setInterval(SCHED_INTERVAL_MSEC) != AIFW_OK ||
+			info->aiModelService->start() != AIFW_OK) {
+			AIFW_LOGE("Service %d start on scheduler failed", i);
+			goto cleanup;
+		}
+	}
+
+	printf("%d services every %d msec on %d workers\n", SCHED_SERVICE_COUNT, SCHED_INTERVAL_MSEC, SCHED_WORKER_COUNT);
+	sleep(SCHED_RUN_SEC / 2);
+	sched_printStats();
+
+	printf("service 0 interval changed to %d msec\n", SCHED_INTERVAL_MSEC / 2);
+	if (gSchedServices[0].aiModelService->setInterval(SCHED_INTERVAL_MSEC / 2) != AIFW_OK) {
+		AIFW_LOGE("Changing interval of service 0 failed");
+		goto cleanup;
+	}
+	sleep(SCHED_RUN_SEC / 2);
+	sched_printStats();
+
+	sched_deinit(scheduler);
+	return 0;
+
+cleanup:
+	sched_deinit(scheduler);
+	return -1;
+}
+
 int aifw_test_main(int argc, char *argv[])
 {
+	if (argc > 1 && strcmp(argv[1], "sched") == 0) {
+		return aifw_test_scheduler();
+	}
+
 	/* Initialize CSV data source for input raw data */
 	AIFW_RESULT res = csvInit(&gHandle, "/mnt/AI/SineWave_packet.csv", FLOAT32, false);
 	if (res != AIFW_OK) {
@@ -0,0 +1,170 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <time.h>
+#include <mutex>
+#include <condition_variable>
+
+#include <media/MediaPlayer.h>
+#include <media/FocusManager.h>
+#include <media/FileInputDataSource.h>
+
+using namespace std;
+using namespace media;
+using namespace media::stream;
+
+static const char *DEFAULT_FILES[] = {"/rom/sample.mp3", "/rom/sample.wav"};
+
+class CopyBenchPlayer : public MediaPlayerObserverInterface,
+						public FocusChangeListener,
+						public enable_shared_from_this<CopyBenchPlayer>
+{
+public:
+	CopyBenchPlayer() : mHasFocus(false), mDone(false), mError(false) {}
+	virtual ~CopyBenchPlayer() = default;
+	bool play(const char *path);
+	void onPlaybackFinished(MediaPlayer &mediaPlayer) override;
+	void onPlaybackError(MediaPlayer &mediaPlayer, player_error_t error) override;
+	void onFocusChange(int focusChange) override;
+
+private:
+	void done(bool error);
+
+	MediaPlayer mp;
+	mutex mMutex;
+	condition_variable mCondv;
+	shared_ptr<FocusRequest> mFocusRequest;
+	bool mHasFocus;
+	bool mDone;
+	bool mError;
+};
+
+bool CopyBenchPlayer::play(const char *path)
+{
+	struct timespec start;
+	struct timespec end;
+
+	if (mp.create() != PLAYER_OK) {
+		printf("MediaPlayer::create failed\n");
+		return false;
+	}
+	mp.setObserver(shared_from_this());
+
+	stream_info_t *info;
+	stream_info_create(STREAM_TYPE_MEDIA, &info);
+	auto stream_info = shared_ptr<stream_info_t>(info, [](stream_info_t *ptr) { stream_info_destroy(ptr); });
+	mFocusRequest = FocusRequest::Builder()
+						.setStreamInfo(stream_info)
+						.setFocusChangeListener(shared_from_this())
+						.build();
+	mp.setStreamInfo(stream_info);
+
+	// Player commands are accepted only while it has the focus
+	auto &focusManager = FocusManager::getFocusManager();
+	mHasFocus = false;
+	focusManager.requestFocus(mFocusRequest);
+	{
+		unique_lock<mutex> lock(mMutex);
+		mCondv.wait(lock, [this] { return mHasFocus; });
+	}
+
+	mp.setDataSource(unique_ptr<FileInputDataSource>(new FileInputDataSource(path)));
+	if (mp.prepare() != PLAYER_OK) {
+		printf("MediaPlayer::prepare failed : %s\n", path);
+		focusManager.abandonFocus(mFocusRequest);
+		mp.destroy();
+		return false;
+	}
+
+	mDone = false;
+	mError = false;
+	clock_gettime(CLOCK_REALTIME, &start);
+	if (mp.start() != PLAYER_OK) {
+		printf("MediaPlayer::start failed : %s\n", path);
+		mp.unprepare();
+		focusManager.abandonFocus(mFocusRequest);
+		mp.destroy();
+		return false;
+	}
+
+	// Copy statistics are printed by the framework when playback finishes
+	{
+		unique_lock<mutex> lock(mMutex);
+		mCondv.wait(lock, [this] { return mDone; });
+	}
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	unsigned int elapsed = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000;
+	printf("[MEDIA COPY] %s : %s, %u msec\n", path, mError ? "error" : "finished", elapsed);
+
+	mp.unprepare();
+	focusManager.abandonFocus(mFocusRequest);
+	mp.destroy();
+	return !mError;
+}
+
+void CopyBenchPlayer::done(bool error)
+{
+	lock_guard<mutex> lock(mMutex);
+	mDone = true;
+	mError = error;
+	mCondv.notify_one();
+}
+
+void CopyBenchPlayer::onPlaybackFinished(MediaPlayer &mediaPlayer)
+{
+	done(false);
+}
+
+void CopyBenchPlayer::onPlaybackError(MediaPlayer &mediaPlayer, player_error_t error)
+{
+	done(true);
+}
+
+void CopyBenchPlayer::onFocusChange(int focusChange)
+{
+	lock_guard<mutex> lock(mMutex);
+	mHasFocus = (focusChange == FOCUS_GAIN);
+	mCondv.notify_one();
+}
+
+extern "C" {
+int media_copy_main(int argc, char *argv[])
+{
+	int i;
+	int nfiles = argc > 1 ? argc - 1 : (int)(sizeof(DEFAULT_FILES) / sizeof(DEFAULT_FILES[0]));
+
+#ifdef CONFIG_MEDIA_STREAM_ZEROCOPY
+	printf("Media Stream Copy Performance (zero-copy)\n");
+#else
+	printf("Media Stream Copy Performance (copy)\n");
+#endif
+
+	auto player = make_shared<CopyBenchPlayer>();
+	for (i = 0; i < nfiles; i++) {
+		player->play(argc > 1 ? argv[i + 1] : DEFAULT_FILES[i]);
+	}
+
+	return 0;
+}
+}
@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+
+#define DEFAULT_COUNT 10000
+#define BUF_SIZE      256
+
+enum printf_case_e {
+	CASE_LITERAL,
+	CASE_LOG,
+	CASE_HTTP,
+	CASE_TABLE,
+	CASE_NUM
+};
+
+static const char *g_case_name[CASE_NUM] = { "literal", "log", "http", "table" };
+
+static char g_buf[BUF_SIZE];
+
+static unsigned long elapsed_usec(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000UL + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+static int format_case(int fd, int num, int i)
+{
+	switch (num) {
+	case CASE_LITERAL:
+		if (fd >= 0) {
+			return dprintf(fd, "The quick brown fox jumps over the lazy dog, nothing to convert here\n");
+		}
+		return snprintf(g_buf, BUF_SIZE, "The quick brown fox jumps over the lazy dog, nothing to convert here\n");
+	case CASE_LOG:
+		if (fd >= 0) {
+			return dprintf(fd, "[%s] %s: state changed to %d after %u ms\n", "INFO", "wifi_manager", i & 7, i);
+		}
+		return snprintf(g_buf, BUF_SIZE, "[%s] %s: state changed to %d after %u ms\n", "INFO", "wifi_manager", i & 7, i);
+	case CASE_HTTP:
+		if (fd >= 0) {
+			return dprintf(fd, "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Length: %d\r\nConnection: %s\r\n\r\n", "text/html", i, "keep-alive");
+		}
+		return snprintf(g_buf, BUF_SIZE, "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Length: %d\r\nConnection: %s\r\n\r\n", "text/html", i, "keep-alive");
+	case CASE_TABLE:
+		if (fd >= 0) {
+			return dprintf(fd, "%-16s %8d %08x %10lu\n", "task_name", i, i * 2654435761U, (unsigned long)i * 1000);
+		}
+		return snprintf(g_buf, BUF_SIZE, "%-16s %8d %08x %10lu\n", "task_name", i, i * 2654435761U, (unsigned long)i * 1000);
+	}
+
+	return 0;
+}
+
+static void run_case(int fd, int num, int count)
+{
+	struct timespec start;
+	struct timespec end;
+	unsigned long usec;
+	unsigned long bytes = 0;
+	int i;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < count; i++) {
+		bytes += format_case(fd, num, i);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	usec = elapsed_usec(&start, &end);
+	if (usec == 0) {
+		usec = 1;
+	}
+
+	printf("%-8s %-9s %10lu %10lu %12llu\n", fd >= 0 ? "dprintf" : "snprintf", g_case_name[num], bytes, usec, (unsigned long long)bytes * 1000000 / usec);
+}
+
+/****************************************************************************
+ * printf_perf_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int printf_perf_main(int argc, char *argv[])
+#endif
+{
+	int count = DEFAULT_COUNT;
+	int fd;
+	int num;
+
+	if (argc > 1) {
+		count = atoi(argv[1]);
+		if (count <= 0) {
+			printf("Usage: printf_perf [COUNT]\n");
+			return -1;
+		}
+	}
+
+	printf("Printf performance, %d calls per case\n", count);
+	printf("%-8s %-9s %10s %10s %12s\n", "func", "case", "bytes", "usec", "bytes/sec");
+
+	for (num = 0; num < CASE_NUM; num++) {
+		run_case(-1, num, count);
+	}
+
+	fd = open("/dev/null", O_WRONLY);
+	if (fd < 0) {
+		printf("Failed to open /dev/null, skip dprintf cases\n");
+		return 0;
+	}
+
+	for (num = 0; num < CASE_NUM; num++) {
+		run_case(fd, num, count);
+	}
+
+	close(fd);
+
+	return 0;
+}
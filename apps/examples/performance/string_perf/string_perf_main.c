@@ -0,0 +1,145 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_SIZE  4096
+#define BENCH_BYTES (1024 * 1024)
+
+enum string_func_e {
+	FUNC_MEMCPY,
+	FUNC_MEMSET,
+	FUNC_MEMCMP,
+	FUNC_STRLEN,
+	FUNC_NUM
+};
+
+static const char *g_func_name[FUNC_NUM] = { "memcpy", "memset", "memcmp", "strlen" };
+static const int g_sizes[] = { 16, 64, 256, 1024, 4096 };
+
+/* Offsets of (dest, src) from a word boundary */
+
+static const int g_offsets[][2] = { { 0, 0 }, { 1, 1 }, { 0, 3 } };
+
+static char g_src[MAX_SIZE + 4];
+static char g_dest[MAX_SIZE + 4];
+
+/* Keep the results, so that the calls are not optimized out */
+
+static volatile int g_result;
+
+static unsigned long elapsed_usec(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000UL + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+static unsigned long run_case(int func, int size, int dest_off, int src_off)
+{
+	struct timespec start;
+	struct timespec end;
+	char *dest = g_dest + dest_off;
+	char *src = g_src + src_off;
+	int count = BENCH_BYTES / size;
+	int i;
+
+	memset(g_src, 'a', sizeof(g_src));
+	memset(g_dest, 'a', sizeof(g_dest));
+	src[size - 1] = '\0';
+	dest[size - 1] = '\0';
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < count; i++) {
+		switch (func) {
+		case FUNC_MEMCPY:
+			memcpy(dest, src, size);
+			break;
+		case FUNC_MEMSET:
+			memset(dest, i, size);
+			break;
+		case FUNC_MEMCMP:
+			/* Equal buffers, so that all bytes are compared */
+			g_result += memcmp(dest, src, size);
+			break;
+		case FUNC_STRLEN:
+			g_result += strlen(src);
+			break;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return elapsed_usec(&start, &end);
+}
+
+/****************************************************************************
+ * string_perf_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int string_perf_main(int argc, char *argv[])
+#endif
+{
+	unsigned long usec;
+	unsigned long bytes;
+	int cpu_mhz = 0;
+	int func;
+	int size;
+	int off;
+
+	if (argc > 1) {
+		cpu_mhz = atoi(argv[1]);
+	}
+
+	printf("String functions performance, %d bytes per case\n", BENCH_BYTES);
+	printf("%-7s %5s %4s %4s %10s %10s\n", "func", "size", "dst", "src", "bytes/us", cpu_mhz > 0 ? "bytes/100cyc" : "");
+
+	for (func = 0; func < FUNC_NUM; func++) {
+		for (size = 0; size < sizeof(g_sizes) / sizeof(g_sizes[0]); size++) {
+			for (off = 0; off < sizeof(g_offsets) / sizeof(g_offsets[0]); off++) {
+				/* memset and strlen have one buffer only */
+				if ((func == FUNC_MEMSET && g_offsets[off][1] != g_offsets[off][0]) ||
+					(func == FUNC_STRLEN && g_offsets[off][0] != g_offsets[off][1])) {
+					continue;
+				}
+
+				usec = run_case(func, g_sizes[size], g_offsets[off][0], g_offsets[off][1]);
+				if (usec == 0) {
+					usec = 1;
+				}
+				bytes = (BENCH_BYTES / g_sizes[size]) * g_sizes[size];
+
+				printf("%-7s %5d %4d %4d %10lu", g_func_name[func], g_sizes[size], g_offsets[off][0], g_offsets[off][1], bytes / usec);
+				if (cpu_mhz > 0) {
+					printf(" %10lu", bytes * 100 / (usec * cpu_mhz));
+				}
+				printf("\n");
+			}
+		}
+	}
+
+	return 0;
+}
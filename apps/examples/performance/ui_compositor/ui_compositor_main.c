@@ -0,0 +1,267 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <araui/ui_commons.h>
+#include <araui/ui_core.h>
+#include <araui/ui_asset.h>
+#include <araui/ui_window.h>
+#include <araui/ui_widget.h>
+
+#define DEFAULT_SECONDS 10
+#define SPRITE_COUNT    8
+#define SPRITE_SIZE     32
+
+/* Same layout as the bitmap header which ui_image_asset_create_from_buffer reads */
+
+struct bitmap_header_s {
+	uint32_t id;
+	int32_t width;
+	int32_t height;
+	ui_pixel_format_t pf;
+	uint32_t header_size;
+	uint32_t data_size;
+	int32_t reserved[8];
+};
+
+struct sprite_s {
+	ui_widget_t widget;
+	int32_t x;
+	int32_t y;
+	int32_t dx;
+	int32_t dy;
+};
+
+static uint8_t *g_bg_buf;
+static uint8_t *g_sprite_buf;
+static ui_asset_t g_bg_image;
+static ui_asset_t g_sprite_image;
+static ui_asset_t g_font;
+static struct sprite_s g_sprites[SPRITE_COUNT];
+
+static uint8_t *make_bitmap(int32_t width, int32_t height, ui_pixel_format_t pf)
+{
+	struct bitmap_header_s *header;
+	uint8_t *buf;
+	uint8_t *pixel;
+	int32_t bpp = (pf == UI_PIXEL_FORMAT_RGBA8888) ? 4 : 3;
+	int32_t x;
+	int32_t y;
+
+	buf = (uint8_t *)malloc(sizeof(struct bitmap_header_s) + width * height * bpp);
+	if (!buf) {
+		return NULL;
+	}
+
+	header = (struct bitmap_header_s *)buf;
+	memset(header, 0, sizeof(struct bitmap_header_s));
+	header->width = width;
+	header->height = height;
+	header->pf = pf;
+	header->header_size = sizeof(struct bitmap_header_s);
+	header->data_size = width * height * bpp;
+
+	pixel = buf + sizeof(struct bitmap_header_s);
+	for (y = 0; y < height; y++) {
+		for (x = 0; x < width; x++) {
+			pixel[0] = (uint8_t)(x * 255 / width);
+			pixel[1] = (uint8_t)(y * 255 / height);
+			pixel[2] = 0x80;
+			if (bpp == 4) {
+				/* Round sprite, transparent outside of the circle */
+				int32_t cx = x - width / 2;
+				int32_t cy = y - height / 2;
+				pixel[3] = (cx * cx + cy * cy <= (width / 2) * (width / 2)) ? 0xff : 0;
+			}
+			pixel += bpp;
+		}
+	}
+
+	return buf;
+}
+
+static void sprite_tick_cb(ui_widget_t widget, uint32_t dt)
+{
+	struct sprite_s *sprite = (struct sprite_s *)ui_widget_get_userdata(widget);
+
+	sprite->x += sprite->dx;
+	sprite->y += sprite->dy;
+	if (sprite->x < 0 || sprite->x > CONFIG_UI_DISPLAY_WIDTH - SPRITE_SIZE) {
+		sprite->dx = -sprite->dx;
+		sprite->x += 2 * sprite->dx;
+	}
+	if (sprite->y < 0 || sprite->y > CONFIG_UI_DISPLAY_HEIGHT - SPRITE_SIZE) {
+		sprite->dy = -sprite->dy;
+		sprite->y += 2 * sprite->dy;
+	}
+
+	ui_widget_set_position(widget, sprite->x, sprite->y);
+}
+
+static void window_created_cb(ui_window_t window)
+{
+	ui_widget_t bg;
+	ui_widget_t text;
+	int i;
+
+	bg = ui_image_widget_create(g_bg_image);
+	if (bg == UI_NULL) {
+		printf("Failed to create background widget\n");
+		return;
+	}
+	ui_window_add_widget(window, bg, 0, 0);
+
+	for (i = 0; i < SPRITE_COUNT; i++) {
+		g_sprites[i].widget = ui_image_widget_create(g_sprite_image);
+		if (g_sprites[i].widget == UI_NULL) {
+			printf("Failed to create sprite widget %d\n", i);
+			return;
+		}
+		g_sprites[i].x = (i * 37) % (CONFIG_UI_DISPLAY_WIDTH - SPRITE_SIZE);
+		g_sprites[i].y = (i * 53) % (CONFIG_UI_DISPLAY_HEIGHT - SPRITE_SIZE);
+		g_sprites[i].dx = 1 + i % 3;
+		g_sprites[i].dy = 1 + (i + 1) % 3;
+		ui_widget_set_userdata(g_sprites[i].widget, &g_sprites[i]);
+		ui_widget_set_tick_callback(g_sprites[i].widget, sprite_tick_cb);
+		ui_window_add_widget(window, g_sprites[i].widget, g_sprites[i].x, g_sprites[i].y);
+	}
+
+	if (g_font != UI_NULL) {
+		text = ui_text_widget_create(CONFIG_UI_DISPLAY_WIDTH, 32, g_font, "AraUI Compositor", 24);
+		if (text != UI_NULL) {
+			ui_window_add_widget(window, text, 0, 0);
+		}
+	}
+}
+
+static void print_stats(int seconds)
+{
+	ui_frame_stats_t stats;
+
+	if (ui_get_frame_stats(&stats) != UI_OK) {
+		printf("Failed to get frame stats\n");
+		return;
+	}
+
+	if (stats.frame_count == 0) {
+		printf("No frame was redrawn\n");
+		return;
+	}
+
+	printf("\n[UI STATS] frames : %u (%u fps)\n", stats.frame_count, stats.frame_count / seconds);
+	printf("[UI STATS] frame time : avg %u us, max %u us\n",
+		   (uint32_t)(stats.total_frame_time / stats.frame_count), stats.max_frame_time);
+	printf("[UI STATS] redrawn area : avg %u of %u pixels\n",
+		   (uint32_t)(stats.total_redraw_area / stats.frame_count), CONFIG_UI_DISPLAY_WIDTH * CONFIG_UI_DISPLAY_HEIGHT);
+	printf("[UI STATS] drawn pixels : avg %u\n", (uint32_t)(stats.total_pixel_count / stats.frame_count));
+}
+
+/****************************************************************************
+ * ui_compositor_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int ui_compositor_main(int argc, char *argv[])
+#endif
+{
+	ui_window_t window = UI_NULL;
+	int seconds = DEFAULT_SECONDS;
+
+	if (argc > 1) {
+		seconds = atoi(argv[1]);
+		if (seconds <= 0) {
+			printf("Usage: ui_compositor [SECONDS] [FONT_FILE]\n");
+			return -1;
+		}
+	}
+
+	if (ui_start() != UI_OK) {
+		printf("Failed to start UI\n");
+		return -1;
+	}
+
+	g_bg_buf = make_bitmap(CONFIG_UI_DISPLAY_WIDTH, CONFIG_UI_DISPLAY_HEIGHT, UI_PIXEL_FORMAT_RGB888);
+	g_sprite_buf = make_bitmap(SPRITE_SIZE, SPRITE_SIZE, UI_PIXEL_FORMAT_RGBA8888);
+	if (!g_bg_buf || !g_sprite_buf) {
+		printf("Out of memory for bitmaps\n");
+		goto done;
+	}
+
+	g_bg_image = ui_image_asset_create_from_buffer(g_bg_buf);
+	g_sprite_image = ui_image_asset_create_from_buffer(g_sprite_buf);
+	if (g_bg_image == UI_NULL || g_sprite_image == UI_NULL) {
+		printf("Failed to create image assets\n");
+		goto done;
+	}
+
+	g_font = UI_NULL;
+	if (argc > 2) {
+		g_font = ui_font_asset_create_from_file(argv[2]);
+		if (g_font == UI_NULL) {
+			printf("Failed to load %s, run without text\n", argv[2]);
+		}
+	}
+
+	window = ui_window_create(window_created_cb, NULL, NULL, NULL);
+	if (window == UI_NULL) {
+		printf("Failed to create window\n");
+		goto done;
+	}
+
+	/* Let the first full screen frame pass before measuring */
+
+	sleep(1);
+	ui_reset_frame_stats();
+	sleep(seconds);
+	print_stats(seconds);
+
+done:
+	if (window != UI_NULL) {
+		ui_window_destroy(window);
+	}
+	if (g_font != UI_NULL) {
+		ui_font_asset_destroy(g_font);
+		g_font = UI_NULL;
+	}
+	if (g_sprite_image != UI_NULL) {
+		ui_image_asset_destroy(g_sprite_image);
+		g_sprite_image = UI_NULL;
+	}
+	if (g_bg_image != UI_NULL) {
+		ui_image_asset_destroy(g_bg_image);
+		g_bg_image = UI_NULL;
+	}
+	ui_stop();
+
+	free(g_sprite_buf);
+	free(g_bg_buf);
+	g_sprite_buf = NULL;
+	g_bg_buf = NULL;
+
+	return 0;
+}
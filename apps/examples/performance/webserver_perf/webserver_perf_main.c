@@ -0,0 +1,272 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <malloc.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <protocols/webserver/http_err.h>
+#include <protocols/webserver/http_server.h>
+
+#define PERF_PORT         8090
+#define DEFAULT_CONNS     8
+#define DEFAULT_REQUESTS  1000
+#define MAX_CONNS         32
+#define MAX_PIPELINE      8
+#define RECV_TIMEOUT_SEC  5
+#define RESPONSE_BODY     "OK"
+#define RESPONSE_MAX      512
+
+static const char g_request[] = "GET /perf HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: keep-alive\r\n\r\n";
+
+static char g_sendbuf[sizeof(g_request) * MAX_PIPELINE];
+static char g_recvbuf[RESPONSE_MAX * MAX_PIPELINE];
+static int g_fds[MAX_CONNS];
+
+static void perf_get_cb(struct http_client_t *client, struct http_req_message *req)
+{
+	http_send_response(client, 200, RESPONSE_BODY, NULL);
+}
+
+static unsigned long elapsed_usec(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000UL + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+static int used_heap(void)
+{
+	struct mallinfo info = mallinfo();
+
+	return info.uordblks;
+}
+
+static int perf_connect(int port)
+{
+	struct sockaddr_in addr;
+	struct timeval tv;
+	int fd;
+
+	fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd < 0) {
+		return -1;
+	}
+
+	tv.tv_sec = RECV_TIMEOUT_SEC;
+	tv.tv_usec = 0;
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+	if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+/* All responses have the same length, which the first one tells */
+
+static int perf_first_response(int fd)
+{
+	int len = 0;
+	int ret;
+
+	if (send(fd, g_request, sizeof(g_request) - 1, 0) < 0) {
+		return -1;
+	}
+
+	while (len < RESPONSE_MAX - 1) {
+		ret = recv(fd, g_recvbuf + len, RESPONSE_MAX - 1 - len, 0);
+		if (ret <= 0) {
+			return -1;
+		}
+		len += ret;
+		g_recvbuf[len] = '\0';
+		if (strstr(g_recvbuf, "\r\n\r\n" RESPONSE_BODY) != NULL) {
+			return len;
+		}
+	}
+
+	return -1;
+}
+
+static int perf_recv(int fd, int len)
+{
+	int ret;
+
+	while (len > 0) {
+		ret = recv(fd, g_recvbuf, len < sizeof(g_recvbuf) ? len : sizeof(g_recvbuf), 0);
+		if (ret <= 0) {
+			return -1;
+		}
+		len -= ret;
+	}
+
+	return 0;
+}
+
+static void perf_run(const char *name, http_server_mode_t mode, int conns, int requests, int depth)
+{
+	struct http_server_t *server;
+	struct timespec start;
+	struct timespec end;
+	unsigned long usec;
+	int port = PERF_PORT + mode;
+	int heap_start;
+	int heap_server;
+	int heap_conns;
+	int resp_len = 0;
+	int served = 0;
+	int rounds;
+	int opened;
+	int i;
+	int j;
+
+	heap_start = used_heap();
+
+	server = http_server_init(port);
+	if (server == NULL) {
+		printf("Failed to init the %s server\n", name);
+		return;
+	}
+	server->mode = mode;
+	http_server_register_cb(server, HTTP_METHOD_GET, NULL, perf_get_cb);
+
+	if (http_server_start(server) != HTTP_OK) {
+		printf("Failed to start the %s server\n", name);
+		http_server_release(&server);
+		return;
+	}
+
+	for (i = 0; i < 100 && server->state != HTTP_SERVER_RUN; i++) {
+		usleep(10000);
+	}
+	heap_server = used_heap();
+
+	/* Open the connections and let the server set them up */
+
+	for (opened = 0; opened < conns; opened++) {
+		g_fds[opened] = perf_connect(port);
+		if (g_fds[opened] < 0) {
+			printf("Failed to connect %d\n", opened);
+			break;
+		}
+		resp_len = perf_first_response(g_fds[opened]);
+		if (resp_len < 0) {
+			printf("No response on connection %d\n", opened);
+			close(g_fds[opened]);
+			break;
+		}
+	}
+	heap_conns = used_heap();
+
+	for (i = 0; i < depth; i++) {
+		memcpy(g_sendbuf + i * (sizeof(g_request) - 1), g_request, sizeof(g_request) - 1);
+	}
+
+	rounds = (opened > 0) ? requests / (opened * depth) : 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < rounds; i++) {
+		for (j = 0; j < opened; j++) {
+			if (send(g_fds[j], g_sendbuf, depth * (sizeof(g_request) - 1), 0) < 0) {
+				goto done;
+			}
+		}
+		for (j = 0; j < opened; j++) {
+			if (perf_recv(g_fds[j], depth * resp_len) < 0) {
+				printf("Response timeout on connection %d\n", j);
+				goto done;
+			}
+			served += depth;
+		}
+	}
+
+done:
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	usec = elapsed_usec(&start, &end);
+	if (usec == 0) {
+		usec = 1;
+	}
+
+	printf("%-7s %5d %8d %8d %10lu %10llu %8d %8d\n", name, opened, depth, served, usec,
+		   (unsigned long long)served * 1000000 / usec, heap_server - heap_start,
+		   opened > 0 ? (heap_conns - heap_server) / opened : 0);
+
+	for (j = 0; j < opened; j++) {
+		close(g_fds[j]);
+	}
+
+	http_server_stop(server);
+	http_server_release(&server);
+}
+
+/****************************************************************************
+ * webserver_perf_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int webserver_perf_main(int argc, char *argv[])
+#endif
+{
+	int conns = DEFAULT_CONNS;
+	int requests = DEFAULT_REQUESTS;
+	int depth = 1;
+
+	if (argc > 1) {
+		conns = atoi(argv[1]);
+	}
+	if (argc > 2) {
+		requests = atoi(argv[2]);
+	}
+	if (argc > 3) {
+		depth = atoi(argv[3]);
+	}
+
+	if (conns <= 0 || conns > MAX_CONNS || requests <= 0 || depth <= 0 || depth > MAX_PIPELINE) {
+		printf("Usage: webserver_perf [CONNS(1-%d)] [REQUESTS] [PIPELINE(1-%d)]\n", MAX_CONNS, MAX_PIPELINE);
+		return -1;
+	}
+
+	printf("Webserver performance over loopback, %d requests per mode\n", requests);
+	printf("%-7s %5s %8s %8s %10s %10s %8s %8s\n", "mode", "conns", "pipeline", "requests", "usec", "req/sec", "server", "per conn");
+
+	/* A handler thread serves one connection until it closes */
+
+	perf_run("thread", HTTP_SERVER_MODE_THREAD, conns < HTTP_CONF_MAX_CLIENT_HANDLE ? conns : HTTP_CONF_MAX_CLIENT_HANDLE, requests, 1);
+#ifdef CONFIG_NETUTILS_WEBSERVER_EVENT_LOOP
+	perf_run("event", HTTP_SERVER_MODE_EVENT, conns, requests, depth);
+#endif
+
+	return 0;
+}
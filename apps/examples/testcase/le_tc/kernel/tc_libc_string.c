@@ -42,6 +42,25 @@
 
 #define EBUSY_STR_SIZE (sizeof(EBUSY_STR))
 
+/* Alignments and lengths to go through the word, block and tail paths of
+ * the architecture optimized functions.
+ */
+#define ALIGN_CNT 4
+#define SWEEP_LEN 80
+#define SWEEP_BUFF_SIZE (SWEEP_LEN + 2 * ALIGN_CNT)
+
+static unsigned char g_sweep_src[SWEEP_BUFF_SIZE];
+static unsigned char g_sweep_dest[SWEEP_BUFF_SIZE];
+
+static void tc_sweep_fill(unsigned char *buf, unsigned char seed)
+{
+	int i;
+
+	for (i = 0; i < SWEEP_BUFF_SIZE; i++) {
+		buf[i] = (unsigned char)(seed + i * 7);
+	}
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -61,12 +80,36 @@ static void tc_libc_string_memcpy(void)
 	char sz_src[BUFF_SIZE] = "test";
 	char sz_dest[BUFF_SIZE] = "aaaa";
 	char *res_ptr = NULL;
+	int src_off;
+	int dest_off;
+	int len;
+	int i;
 
 	res_ptr = (char *)memcpy(sz_dest, sz_src, BUFF_SIZE);
 	TC_ASSERT_NEQ("memcpy", res_ptr, NULL);
 	TC_ASSERT_EQ("memcpy", strncmp(sz_dest, res_ptr, BUFF_SIZE), 0);
 	TC_ASSERT_EQ("memcpy", strncmp(sz_dest, sz_src, BUFF_SIZE), 0);
 
+	/* Bytes around the copied area must not be touched */
+
+	for (src_off = 0; src_off < ALIGN_CNT; src_off++) {
+		for (dest_off = 0; dest_off < ALIGN_CNT; dest_off++) {
+			for (len = 0; len <= SWEEP_LEN; len++) {
+				tc_sweep_fill(g_sweep_src, 1);
+				tc_sweep_fill(g_sweep_dest, 2);
+				res_ptr = (char *)memcpy(g_sweep_dest + dest_off, g_sweep_src + src_off, len);
+				TC_ASSERT_EQ("memcpy", res_ptr, (char *)g_sweep_dest + dest_off);
+				for (i = 0; i < SWEEP_BUFF_SIZE; i++) {
+					if (i >= dest_off && i < dest_off + len) {
+						TC_ASSERT_EQ("memcpy", g_sweep_dest[i], g_sweep_src[i - dest_off + src_off]);
+					} else {
+						TC_ASSERT_EQ("memcpy", g_sweep_dest[i], (unsigned char)(2 + i * 7));
+					}
+				}
+			}
+		}
+	}
+
 	TC_SUCCESS_RESULT();
 }
 
@@ -84,12 +127,32 @@ static void tc_libc_string_memset(void)
 	char buffer[BUFF_SIZE] = "test";
 	char ctarget[BUFF_SIZE] = "aaaa";
 	char *res_ptr = NULL;
+	int dest_off;
+	int len;
+	int i;
 
 	res_ptr = (char *)memset(buffer, 'a', BUFF_SIZE - 1);
 	TC_ASSERT_NEQ("memset", res_ptr, NULL);
 	TC_ASSERT_EQ("memset", strncmp(res_ptr, ctarget, BUFF_SIZE), 0);
 	TC_ASSERT_EQ("memset", strncmp(ctarget, buffer, BUFF_SIZE), 0);
 
+	/* Only the low byte of the value is used */
+
+	for (dest_off = 0; dest_off < ALIGN_CNT; dest_off++) {
+		for (len = 0; len <= SWEEP_LEN; len++) {
+			tc_sweep_fill(g_sweep_dest, 2);
+			res_ptr = (char *)memset(g_sweep_dest + dest_off, 0x1a5, len);
+			TC_ASSERT_EQ("memset", res_ptr, (char *)g_sweep_dest + dest_off);
+			for (i = 0; i < SWEEP_BUFF_SIZE; i++) {
+				if (i >= dest_off && i < dest_off + len) {
+					TC_ASSERT_EQ("memset", g_sweep_dest[i], 0xa5);
+				} else {
+					TC_ASSERT_EQ("memset", g_sweep_dest[i], (unsigned char)(2 + i * 7));
+				}
+			}
+		}
+	}
+
 	TC_SUCCESS_RESULT();
 }
 
@@ -133,6 +196,9 @@ static void tc_libc_string_memcmp(void)
 	char buffer2[BUFF_SIZE] = "test";
 	char buffer3[BUFF_SIZE] = "tesz";
 	char buffer4[BUFF_SIZE] = "tesa";
+	int off;
+	int len;
+	int pos;
 
 	ret_chk = memcmp(buffer1, buffer2, BUFF_SIZE);
 	TC_ASSERT_EQ("memcmp", ret_chk, 0);
@@ -143,6 +209,27 @@ static void tc_libc_string_memcmp(void)
 	ret_chk = memcmp(buffer1, buffer4, BUFF_SIZE);
 	TC_ASSERT_EQ("memcmp", ret_chk, 1);
 
+	/* The first differing byte decides, whichever word it is in */
+
+	for (off = 0; off < ALIGN_CNT; off++) {
+		for (len = 1; len <= SWEEP_LEN; len++) {
+			tc_sweep_fill(g_sweep_src, 1);
+			tc_sweep_fill(g_sweep_dest, 1);
+			TC_ASSERT_EQ("memcmp", memcmp(g_sweep_src + off, g_sweep_dest + off, len), 0);
+			for (pos = 0; pos < len; pos++) {
+				g_sweep_dest[off + pos] = g_sweep_src[off + pos] + 1;
+				if (pos + 1 < len) {
+					g_sweep_src[off + pos + 1] = 0xff;
+					g_sweep_dest[off + pos + 1] = 0;
+				}
+				TC_ASSERT_EQ("memcmp", memcmp(g_sweep_src + off, g_sweep_dest + off, len), (g_sweep_src[off + pos] == 0xff) ? 1 : -1);
+				TC_ASSERT_EQ("memcmp", memcmp(g_sweep_dest + off, g_sweep_src + off, len), (g_sweep_src[off + pos] == 0xff) ? -1 : 1);
+				tc_sweep_fill(g_sweep_src, 1);
+				tc_sweep_fill(g_sweep_dest, 1);
+			}
+		}
+	}
+
 	TC_SUCCESS_RESULT();
 }
 
@@ -421,10 +508,21 @@ static void tc_libc_string_strlen(void)
 {
 	char src[BUFF_SIZE] = "test";
 	int ret_chk = ERROR;
+	int off;
+	int len;
 
 	ret_chk = strlen(src);
 	TC_ASSERT_EQ("strlen", ret_chk, BUFF_SIZE - 1);
 
+	for (off = 0; off < ALIGN_CNT; off++) {
+		for (len = 0; len < SWEEP_LEN; len++) {
+			memset(g_sweep_src, 0x80, SWEEP_BUFF_SIZE);
+			g_sweep_src[off + len] = '\0';
+			ret_chk = strlen((char *)g_sweep_src + off);
+			TC_ASSERT_EQ("strlen", ret_chk, len);
+		}
+	}
+
 	TC_SUCCESS_RESULT();
 }
 
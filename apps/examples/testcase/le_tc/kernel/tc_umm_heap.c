@@ -31,6 +31,7 @@
 #include <errno.h>
 #include <sched.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <tinyara/mm/mm.h>
 #include <tinyara/sched.h>
 #include "tc_internal.h"
@@ -45,6 +46,15 @@
 #define ALL_FREE 0
 #define MEM_REQ_SIZE(unit, iter) (MM_ALIGN_UP((unit) + SIZEOF_MM_ALLOCNODE) * (iter))
 
+#define BENCH_HOLES 64
+#define BENCH_SLOTS 32
+#define BENCH_ROUNDS 500
+#ifdef CONFIG_MM_SIZECLASS
+#define BENCH_MODE "size-class"
+#else
+#define BENCH_MODE "heap"
+#endif
+
 /****************************************************************************
  * Private functions
  ****************************************************************************/
@@ -471,6 +481,83 @@ static void tc_umm_heap_zalloc(void)
 	}
 	TC_SUCCESS_RESULT();
 }
+
+static unsigned long umm_elapsed_usec(struct timespec *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_REALTIME, &end);
+	return (end.tv_sec - start->tv_sec) * 1000000UL + (end.tv_nsec - start->tv_nsec) / 1000;
+}
+
+static void umm_free_holes(void *holes[])
+{
+	int i;
+
+	for (i = 1; i < BENCH_HOLES; i += 2) {
+		free(holes[i]);
+		holes[i] = NULL;
+	}
+}
+
+/**
+* @fn                   :tc_umm_heap_benchmark
+* @brief                :Measure malloc/free latency of small blocks and fragmentation.
+* @scenario             :Leave free holes of mixed sizes in the heap\n
+*                        allocate and free small blocks of 16 ~ 256 bytes repeatedly\n
+*                        report time per malloc/free pair and free space not in the largest node
+* @API's covered        :malloc, free, mallinfo
+* @passcase             :When all allocations succeed.
+* @failcase             :When malloc function returns null memory.
+* @Preconditions        :NA
+*/
+
+static void tc_umm_heap_benchmark(void)
+{
+	void *holes[BENCH_HOLES] = { NULL };
+	void *slots[BENCH_SLOTS] = { NULL };
+	struct timespec start;
+	struct mallinfo info;
+	unsigned long usec;
+	int round;
+	int i;
+
+	/* Free every other block so that the free lists are not empty */
+
+	for (i = 0; i < BENCH_HOLES; i++) {
+		holes[i] = malloc(24 + (i % 8) * 40);
+		TC_ASSERT_NEQ_CLEANUP("malloc", holes[i], NULL, mem_deallocate_func((int **)holes, i));
+	}
+	for (i = 0; i < BENCH_HOLES; i += 2) {
+		free(holes[i]);
+		holes[i] = NULL;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (round = 0; round < BENCH_ROUNDS; round++) {
+		for (i = 0; i < BENCH_SLOTS; i++) {
+			slots[i] = malloc(16 + (i % 16) * 16);
+			TC_ASSERT_NEQ_CLEANUP("malloc", slots[i], NULL, mem_deallocate_func((int **)slots, i); umm_free_holes(holes));
+		}
+		mem_deallocate_func((int **)slots, BENCH_SLOTS);
+	}
+	usec = umm_elapsed_usec(&start);
+
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	info = mallinfo();
+#else
+	(void)mallinfo(&info);
+#endif
+	umm_free_holes(holes);
+
+	printf("[UMM BENCH] %s : %lu nsec per malloc/free, free %d bytes in %d nodes, largest %d (%d%% fragmented)\n",
+		   BENCH_MODE, (unsigned long)((unsigned long long)usec * 1000 / (BENCH_ROUNDS * BENCH_SLOTS)),
+		   info.fordblks, info.ordblks, info.mxordblk,
+		   info.fordblks ? 100 - (int)((long long)info.mxordblk * 100 / info.fordblks) : 0);
+
+	TC_SUCCESS_RESULT();
+}
+
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 static void tc_umm_heap_get_heap_free_size(void)
 {
@@ -512,6 +599,7 @@ static int umm_test(int argc, char *argv[])
 	tc_umm_heap_memalign();
 	tc_umm_heap_mallinfo();
 	tc_umm_heap_zalloc();
+	tc_umm_heap_benchmark();
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 	tc_umm_heap_get_heap_free_size();
 	tc_umm_heap_get_largest_freenode_size();
@@ -23,6 +23,8 @@
 #include <tinyara/config.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
+#include <time.h>
 #include <semaphore.h>
 #include <arastorage/arastorage.h>
 #include <tinyara/fs/fs_utils.h>
@@ -37,6 +39,7 @@
 
 #define RELATION_NAME1  "rel1"
 #define RELATION_NAME2  "rel2"
+#define RELATION_BULK   "bulk"
 #define INDEX_BPLUS     "bplustree"
 #define INDEX_INLINE    "inline"
 #define QUERY_LENGTH    128
@@ -44,6 +47,9 @@
 #define DATA_SET_NUM    10
 #define DATA_SET_MULTIPLIER 80
 
+#define BULK_ROWS       200
+#define BULK_ATTRS      3
+
 /****************************************************************************
  *  Global Variables
  ****************************************************************************/
@@ -103,6 +109,59 @@ static void cleanup(void)
 	memset(query, 0, QUERY_LENGTH);
 	snprintf(query, QUERY_LENGTH, "REMOVE RELATION %s;", RELATION_NAME2);
 	db_exec(query);
+
+	memset(query, 0, QUERY_LENGTH);
+	snprintf(query, QUERY_LENGTH, "REMOVE RELATION %s;", RELATION_BULK);
+	db_exec(query);
+}
+
+/* Create an empty relation (id int, date long, value int) with a bplustree index on value */
+static db_result_t bulk_create_relation(void)
+{
+	db_result_t res;
+	char query[QUERY_LENGTH];
+
+	snprintf(query, QUERY_LENGTH, "REMOVE RELATION %s;", RELATION_BULK);
+	db_exec(query);
+
+	snprintf(query, QUERY_LENGTH, "CREATE RELATION %s;", RELATION_BULK);
+	res = db_exec(query);
+	if (DB_SUCCESS(res)) {
+		snprintf(query, QUERY_LENGTH, "CREATE ATTRIBUTE %s DOMAIN int IN %s;", g_attribute_set[0], RELATION_BULK);
+		res = db_exec(query);
+	}
+	if (DB_SUCCESS(res)) {
+		snprintf(query, QUERY_LENGTH, "CREATE ATTRIBUTE %s DOMAIN long IN %s;", g_attribute_set[1], RELATION_BULK);
+		res = db_exec(query);
+	}
+	if (DB_SUCCESS(res)) {
+		snprintf(query, QUERY_LENGTH, "CREATE ATTRIBUTE %s DOMAIN int IN %s;", g_attribute_set[3], RELATION_BULK);
+		res = db_exec(query);
+	}
+	if (DB_SUCCESS(res)) {
+		snprintf(query, QUERY_LENGTH, "CREATE INDEX %s.%s TYPE %s;", RELATION_BULK, g_attribute_set[3], INDEX_BPLUS);
+		res = db_exec(query);
+	}
+	return res;
+}
+
+/* Values of row i, the value attribute is a permutation of 0 ~ BULK_ROWS - 1 */
+static void bulk_fill_row(db_value_t *row, int i)
+{
+	row[0].domain = DOMAIN_INT;
+	row[0].u.int_value = i;
+	row[1].domain = DOMAIN_LONG;
+	row[1].u.long_value = g_arastorage_data_set[i % DATA_SET_NUM].long_value;
+	row[2].domain = DOMAIN_INT;
+	row[2].u.int_value = (i * 37) % BULK_ROWS;
+}
+
+static unsigned long bulk_elapsed_usec(struct timespec *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_REALTIME, &end);
+	return (end.tv_sec - start->tv_sec) * 1000000 + (end.tv_nsec - start->tv_nsec) / 1000;
 }
 
 /**
@@ -1435,6 +1494,323 @@ static void utc_arastorage_cursor_get_string_value_n(void)
 	TC_SUCCESS_RESULT();
 }
 
+/**
+* @testcase         utc_arastorage_db_bulk_insert_p
+* @brief            Insert many tuples at once
+* @scenario         Insert tuples into a relation with a bplustree index by db_bulk_insert
+*                   and check that index queries find all of them
+* @apicovered       db_bulk_insert
+* @precondition     utc_arastorage_db_init_p should be passed
+* @postcondition    none
+*/
+static void utc_arastorage_db_bulk_insert_p(void)
+{
+	db_result_t res;
+	db_value_t *values;
+	char query[QUERY_LENGTH];
+	int i;
+
+	res = bulk_create_relation();
+	TC_ASSERT_EQ("db_exec", DB_SUCCESS(res), true);
+
+	values = (db_value_t *)malloc(sizeof(db_value_t) * BULK_ATTRS * BULK_ROWS);
+	TC_ASSERT_NEQ("malloc", values, NULL);
+	for (i = 0; i < BULK_ROWS; i++) {
+		bulk_fill_row(&values[i * BULK_ATTRS], i);
+	}
+
+	res = db_bulk_insert(RELATION_BULK, values, BULK_ROWS);
+	free(values);
+	TC_ASSERT_EQ("db_bulk_insert", DB_SUCCESS(res), true);
+
+	snprintf(query, QUERY_LENGTH, "SELECT ALL FROM %s WHERE %s < 100 AND %s >= 10;", RELATION_BULK, g_attribute_set[3], g_attribute_set[3]);
+	g_cursor = db_query(query);
+	TC_ASSERT_NEQ("db_query", g_cursor, NULL);
+	TC_ASSERT_EQ_CLEANUP("db_bulk_insert", cursor_get_count(g_cursor), 90, db_cursor_free(g_cursor));
+	db_cursor_free(g_cursor);
+	g_cursor = NULL;
+
+	/* Rows inserted one by one after a bulk insertion are found as well */
+	snprintf(query, QUERY_LENGTH, "INSERT (%d, %ld, %d) INTO %s;", BULK_ROWS, g_arastorage_data_set[0].long_value, 50, RELATION_BULK);
+	res = db_exec(query);
+	TC_ASSERT_EQ("db_exec", DB_SUCCESS(res), true);
+
+	snprintf(query, QUERY_LENGTH, "SELECT ALL FROM %s WHERE %s = 50;", RELATION_BULK, g_attribute_set[3]);
+	g_cursor = db_query(query);
+	TC_ASSERT_NEQ("db_query", g_cursor, NULL);
+	TC_ASSERT_EQ_CLEANUP("db_bulk_insert", cursor_get_count(g_cursor), 2, db_cursor_free(g_cursor));
+	db_cursor_free(g_cursor);
+	g_cursor = NULL;
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+* @testcase         utc_arastorage_db_bulk_insert_n
+* @brief            Insert many tuples at once with invalid argument
+* @scenario         Insert with NULL relation name, NULL values, unknown relation
+*                   and a value of a wrong domain
+* @apicovered       db_bulk_insert
+* @precondition     utc_arastorage_db_bulk_insert_p should be passed
+* @postcondition    none
+*/
+static void utc_arastorage_db_bulk_insert_n(void)
+{
+	db_result_t res;
+	db_value_t row[BULK_ATTRS];
+
+	bulk_fill_row(row, 0);
+
+	res = db_bulk_insert(NULL, row, 1);
+	TC_ASSERT_EQ("db_bulk_insert", DB_ERROR(res), true);
+
+	res = db_bulk_insert(RELATION_BULK, NULL, 1);
+	TC_ASSERT_EQ("db_bulk_insert", DB_ERROR(res), true);
+
+	res = db_bulk_insert("nonexist", row, 1);
+	TC_ASSERT_EQ("db_bulk_insert", DB_ERROR(res), true);
+
+	row[2].domain = DOMAIN_STRING;
+	row[2].u.string_value = (unsigned char *)"apple";
+	res = db_bulk_insert(RELATION_BULK, row, 1);
+	TC_ASSERT_EQ("db_bulk_insert", DB_ERROR(res), true);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+* @brief            Compare insertion speed of db_exec and db_bulk_insert
+* @scenario         Insert BULK_ROWS tuples into an indexed relation with one
+*                   INSERT statement per tuple, then with one db_bulk_insert call,
+*                   and print rows per second of both
+* @precondition     utc_arastorage_db_init_p should be passed
+* @postcondition    none
+*/
+static void utc_arastorage_bulk_insert_benchmark(void)
+{
+	db_result_t res;
+	db_value_t *values;
+	char query[QUERY_LENGTH];
+	struct timespec start;
+	unsigned long exec_usec;
+	unsigned long bulk_usec;
+	int i;
+
+	values = (db_value_t *)malloc(sizeof(db_value_t) * BULK_ATTRS * BULK_ROWS);
+	TC_ASSERT_NEQ("malloc", values, NULL);
+	for (i = 0; i < BULK_ROWS; i++) {
+		bulk_fill_row(&values[i * BULK_ATTRS], i);
+	}
+
+	res = bulk_create_relation();
+	TC_ASSERT_EQ_CLEANUP("db_exec", DB_SUCCESS(res), true, free(values));
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < BULK_ROWS; i++) {
+		snprintf(query, QUERY_LENGTH, "INSERT (%d, %ld, %d) INTO %s;", values[i * BULK_ATTRS].u.int_value,
+				 values[i * BULK_ATTRS + 1].u.long_value, values[i * BULK_ATTRS + 2].u.int_value, RELATION_BULK);
+		res = db_exec(query);
+		TC_ASSERT_EQ_CLEANUP("db_exec", DB_SUCCESS(res), true, free(values));
+	}
+	exec_usec = bulk_elapsed_usec(&start);
+
+	res = bulk_create_relation();
+	TC_ASSERT_EQ_CLEANUP("db_exec", DB_SUCCESS(res), true, free(values));
+	clock_gettime(CLOCK_REALTIME, &start);
+	res = db_bulk_insert(RELATION_BULK, values, BULK_ROWS);
+	bulk_usec = bulk_elapsed_usec(&start);
+	free(values);
+	TC_ASSERT_EQ("db_bulk_insert", DB_SUCCESS(res), true);
+
+	printf("[BULK INSERT] %d rows, db_exec : %lu usec (%lu rows/sec), db_bulk_insert : %lu usec (%lu rows/sec)\n",
+		   BULK_ROWS, exec_usec, exec_usec ? BULK_ROWS * 1000000UL / exec_usec : 0,
+		   bulk_usec, bulk_usec ? BULK_ROWS * 1000000UL / bulk_usec : 0);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+* @testcase         utc_arastorage_db_prepare_p
+* @brief            Run prepared statements with bound parameters
+* @scenario         Insert tuples with a prepared INSERT statement, then run a prepared
+*                   SELECT with different bound values and check the number of results
+* @apicovered       db_prepare, db_bind_int, db_step, db_step_query, db_finalize
+* @precondition     utc_arastorage_db_init_p should be passed
+* @postcondition    none
+*/
+static void utc_arastorage_db_prepare_p(void)
+{
+	db_result_t res;
+	db_stmt_t *stmt;
+	char query[QUERY_LENGTH];
+	int i;
+
+	res = bulk_create_relation();
+	TC_ASSERT_EQ("db_exec", DB_SUCCESS(res), true);
+
+	snprintf(query, QUERY_LENGTH, "INSERT (?, ?, ?) INTO %s;", RELATION_BULK);
+	stmt = db_prepare(query);
+	TC_ASSERT_NEQ("db_prepare", stmt, NULL);
+
+	for (i = 0; i < BULK_ROWS; i++) {
+		db_bind_int(stmt, 0, i);
+		db_bind_int(stmt, 1, g_arastorage_data_set[i % DATA_SET_NUM].long_value);
+		db_bind_int(stmt, 2, (i * 37) % BULK_ROWS);
+		res = db_step(stmt);
+		TC_ASSERT_EQ_CLEANUP("db_step", DB_SUCCESS(res), true, db_finalize(stmt));
+	}
+	res = db_finalize(stmt);
+	TC_ASSERT_EQ("db_finalize", DB_SUCCESS(res), true);
+
+	snprintf(query, QUERY_LENGTH, "SELECT ALL FROM %s WHERE %s < ? AND %s >= ?;", RELATION_BULK, g_attribute_set[3], g_attribute_set[3]);
+	stmt = db_prepare(query);
+	TC_ASSERT_NEQ("db_prepare", stmt, NULL);
+
+	db_bind_int(stmt, 0, 100);
+	db_bind_int(stmt, 1, 10);
+	g_cursor = db_step_query(stmt);
+	TC_ASSERT_NEQ_CLEANUP("db_step_query", g_cursor, NULL, db_finalize(stmt));
+	TC_ASSERT_EQ_CLEANUP("db_step_query", cursor_get_count(g_cursor), 90, db_cursor_free(g_cursor); db_finalize(stmt));
+	db_cursor_free(g_cursor);
+
+	/* Only the changed parameter is bound again */
+	db_bind_int(stmt, 1, 50);
+	g_cursor = db_step_query(stmt);
+	TC_ASSERT_NEQ_CLEANUP("db_step_query", g_cursor, NULL, db_finalize(stmt));
+	TC_ASSERT_EQ_CLEANUP("db_step_query", cursor_get_count(g_cursor), 50, db_cursor_free(g_cursor); db_finalize(stmt));
+	db_cursor_free(g_cursor);
+	g_cursor = NULL;
+
+	res = db_finalize(stmt);
+	TC_ASSERT_EQ("db_finalize", DB_SUCCESS(res), true);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+* @testcase         utc_arastorage_db_prepare_n
+* @brief            Run prepared statements with invalid argument
+* @scenario         Prepare an invalid sentence, bind out of range parameters,
+*                   run with an unbound parameter or a value of a wrong domain,
+*                   bind a string in a WHERE clause and use a parameter in db_exec
+* @apicovered       db_prepare, db_bind_int, db_bind_string, db_step, db_step_query, db_finalize
+* @precondition     utc_arastorage_db_prepare_p should be passed
+* @postcondition    none
+*/
+static void utc_arastorage_db_prepare_n(void)
+{
+	db_result_t res;
+	db_stmt_t *stmt;
+	char query[QUERY_LENGTH];
+
+	stmt = db_prepare(NULL);
+	TC_ASSERT_EQ("db_prepare", stmt, NULL);
+
+	stmt = db_prepare("INSERT (?, ?, ?) INTO");
+	TC_ASSERT_EQ("db_prepare", stmt, NULL);
+
+	res = db_step(NULL);
+	TC_ASSERT_EQ("db_step", DB_ERROR(res), true);
+
+	TC_ASSERT_EQ("db_step_query", db_step_query(NULL), NULL);
+
+	res = db_finalize(NULL);
+	TC_ASSERT_EQ("db_finalize", DB_ERROR(res), true);
+
+	snprintf(query, QUERY_LENGTH, "INSERT (?, ?, ?) INTO %s;", RELATION_BULK);
+	res = db_exec(query);
+	TC_ASSERT_EQ("db_exec", DB_ERROR(res), true);
+
+	stmt = db_prepare(query);
+	TC_ASSERT_NEQ("db_prepare", stmt, NULL);
+
+	res = db_bind_int(stmt, 3, 0);
+	TC_ASSERT_EQ_CLEANUP("db_bind_int", DB_ERROR(res), true, db_finalize(stmt));
+
+	res = db_bind_int(stmt, -1, 0);
+	TC_ASSERT_EQ_CLEANUP("db_bind_int", DB_ERROR(res), true, db_finalize(stmt));
+
+	res = db_bind_int(stmt, 0, 0);
+	TC_ASSERT_EQ_CLEANUP("db_bind_int", DB_SUCCESS(res), true, db_finalize(stmt));
+
+	/* The other parameters are not bound yet */
+	res = db_step(stmt);
+	TC_ASSERT_EQ_CLEANUP("db_step", DB_ERROR(res), true, db_finalize(stmt));
+
+	db_bind_int(stmt, 1, 0);
+	res = db_bind_string(stmt, 2, "apple");
+	TC_ASSERT_EQ_CLEANUP("db_bind_string", DB_SUCCESS(res), true, db_finalize(stmt));
+
+	res = db_step(stmt);
+	TC_ASSERT_EQ_CLEANUP("db_step", DB_ERROR(res), true, db_finalize(stmt));
+
+	/* An INSERT statement has no result */
+	TC_ASSERT_EQ_CLEANUP("db_step_query", db_step_query(stmt), NULL, db_finalize(stmt));
+
+	res = db_finalize(stmt);
+	TC_ASSERT_EQ("db_finalize", DB_SUCCESS(res), true);
+
+	/* A WHERE clause compares numbers only */
+	snprintf(query, QUERY_LENGTH, "SELECT ALL FROM %s WHERE %s = ?;", RELATION_BULK, g_attribute_set[3]);
+	stmt = db_prepare(query);
+	TC_ASSERT_NEQ("db_prepare", stmt, NULL);
+
+	res = db_bind_string(stmt, 0, "apple");
+	TC_ASSERT_EQ_CLEANUP("db_bind_string", DB_ERROR(res), true, db_finalize(stmt));
+
+	TC_ASSERT_EQ_CLEANUP("db_step_query", db_step_query(stmt), NULL, db_finalize(stmt));
+
+	res = db_finalize(stmt);
+	TC_ASSERT_EQ("db_finalize", DB_SUCCESS(res), true);
+
+	TC_SUCCESS_RESULT();
+}
+
+/**
+* @brief            Compare query speed of db_query and a prepared statement
+* @scenario         Run the same SELECT statement BULK_ROWS times with db_query and
+*                   with db_step_query, and print the average time of both
+* @precondition     utc_arastorage_db_prepare_p should be passed
+* @postcondition    none
+*/
+static void utc_arastorage_prepare_benchmark(void)
+{
+	db_stmt_t *stmt;
+	char query[QUERY_LENGTH];
+	struct timespec start;
+	unsigned long query_usec;
+	unsigned long step_usec;
+	int i;
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < BULK_ROWS; i++) {
+		snprintf(query, QUERY_LENGTH, "SELECT %s, %s FROM %s WHERE %s = %d;", g_attribute_set[0], g_attribute_set[3], RELATION_BULK, g_attribute_set[3], i);
+		g_cursor = db_query(query);
+		TC_ASSERT_NEQ("db_query", g_cursor, NULL);
+		db_cursor_free(g_cursor);
+	}
+	query_usec = bulk_elapsed_usec(&start);
+
+	snprintf(query, QUERY_LENGTH, "SELECT %s, %s FROM %s WHERE %s = ?;", g_attribute_set[0], g_attribute_set[3], RELATION_BULK, g_attribute_set[3]);
+	stmt = db_prepare(query);
+	TC_ASSERT_NEQ("db_prepare", stmt, NULL);
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < BULK_ROWS; i++) {
+		db_bind_int(stmt, 0, i);
+		g_cursor = db_step_query(stmt);
+		TC_ASSERT_NEQ_CLEANUP("db_step_query", g_cursor, NULL, db_finalize(stmt));
+		db_cursor_free(g_cursor);
+	}
+	step_usec = bulk_elapsed_usec(&start);
+	g_cursor = NULL;
+	db_finalize(stmt);
+
+	printf("[PREPARE] %d queries, db_query : %lu usec/query, db_step_query : %lu usec/query\n",
+		   BULK_ROWS, query_usec / BULK_ROWS, step_usec / BULK_ROWS);
+
+	TC_SUCCESS_RESULT();
+}
+
 /**
 * @brief  test example for bplustree indexing
 * @scenario :
@@ -1550,6 +1926,10 @@ int utc_arastorage_main(int argc, char *argv[])
 #endif
 	utc_arastorage_cursor_get_string_value_p();
 	utc_arastorage_db_cursor_free_p();
+	utc_arastorage_db_bulk_insert_p();
+	utc_arastorage_bulk_insert_benchmark();
+	utc_arastorage_db_prepare_p();
+	utc_arastorage_prepare_benchmark();
 	utc_arastorage_db_deinit_p();
 
 	db_init();
@@ -1580,6 +1960,8 @@ int utc_arastorage_main(int argc, char *argv[])
 #endif
 	utc_arastorage_cursor_get_string_value_n();
 	utc_arastorage_db_cursor_free_n();
+	utc_arastorage_db_bulk_insert_n();
+	utc_arastorage_db_prepare_n();
 	cleanup();
 	db_deinit();
 
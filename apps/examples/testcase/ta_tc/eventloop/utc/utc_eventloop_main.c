@@ -38,6 +38,7 @@
 
 #define EL_SEND_COUNT 5
 #define EL_WIFI_ON_COUNT 3
+#define EL_BURST_COUNT 8
 
 static int el_timer_flag;
 static int el_thread_safe_flag;
@@ -47,6 +48,9 @@ static bool el_event_wifi_off_flag;
 static int el_event_wifi_on_cnt;
 static int send_cnt;
 
+static int el_burst_cnt;
+static int el_burst_data[EL_BURST_COUNT];
+
 static el_timer_t *g_repeat_timer;
 
 static void timer_cb(void *data)
@@ -421,6 +425,108 @@ static void utc_eventloop_send_event_p(void)
 	TC_SUCCESS_RESULT();
 }
 
+static int burst_callback(void *cb_data, void *event_data)
+{
+	if (event_data != NULL && el_burst_cnt < EL_BURST_COUNT) {
+		el_burst_data[el_burst_cnt] = *(int *)event_data;
+	}
+	el_burst_cnt++;
+
+	return EVENTLOOP_CALLBACK_CONTINUE;
+}
+
+static int burst_stop_callback(void *cb_data, void *event_data)
+{
+	if (eventloop_loop_stop() == OK) {
+		loop_stop_flag = true;
+	}
+
+	return EVENTLOOP_CALLBACK_CONTINUE;
+}
+
+/* Send a burst of WIFI_ON events before the loop runs, and then WIFI_OFF which
+ * stops the loop. All of them are delivered in one wake-up of the loop, and
+ * WIFI_ON events queued after WIFI_OFF would be dropped with the loop stopped.
+ */
+static int send_event_burst(void)
+{
+	int i;
+	int ret;
+
+	for (i = 0; i < EL_BURST_COUNT; i++) {
+		ret = eventloop_send_event(EL_EVENT_WIFI_ON, &i, sizeof(i));
+		if (ret != OK) {
+			return ret;
+		}
+	}
+
+	return eventloop_send_event(EL_EVENT_WIFI_OFF, EL_WIFI_OFF_DATA, sizeof(EL_WIFI_OFF_DATA));
+}
+
+#ifndef CONFIG_EVENTLOOP_EVENT_COALESCE
+static void utc_eventloop_send_event_burst_p(void)
+{
+	int i;
+	int ret;
+	el_event_t *event_handle;
+	el_event_t *stop_handle;
+
+	el_burst_cnt = 0;
+	loop_stop_flag = false;
+
+	event_handle = eventloop_add_event_handler(EL_EVENT_WIFI_ON, (event_callback)burst_callback, NULL);
+	TC_ASSERT_NEQ("eventloop_add_event_handler", event_handle, NULL);
+	stop_handle = eventloop_add_event_handler(EL_EVENT_WIFI_OFF, (event_callback)burst_stop_callback, NULL);
+	TC_ASSERT_NEQ_CLEANUP("eventloop_add_event_handler", stop_handle, NULL, eventloop_del_event_handler(event_handle));
+	ret = send_event_burst();
+	if (ret == OK) {
+		ret = eventloop_loop_run();
+	}
+	eventloop_del_event_handler(event_handle);
+	eventloop_del_event_handler(stop_handle);
+	TC_ASSERT_EQ("eventloop_send_event", ret, OK);
+	TC_ASSERT_EQ("eventloop_loop_run", loop_stop_flag, true);
+
+	TC_ASSERT_EQ("eventloop_send_event", el_burst_cnt, EL_BURST_COUNT);
+	for (i = 0; i < EL_BURST_COUNT; i++) {
+		TC_ASSERT_EQ("eventloop_send_event", el_burst_data[i], i);
+	}
+
+	TC_SUCCESS_RESULT();
+}
+#else
+static void utc_eventloop_send_event_coalesce_p(void)
+{
+	int ret;
+	el_event_t *event_handle;
+	el_event_t *stop_handle;
+
+	el_burst_cnt = 0;
+	loop_stop_flag = false;
+
+	event_handle = eventloop_add_event_handler(EL_EVENT_WIFI_ON, (event_callback)burst_callback, NULL);
+	TC_ASSERT_NEQ("eventloop_add_event_handler", event_handle, NULL);
+	stop_handle = eventloop_add_event_handler(EL_EVENT_WIFI_OFF, (event_callback)burst_stop_callback, NULL);
+	TC_ASSERT_NEQ_CLEANUP("eventloop_add_event_handler", stop_handle, NULL, eventloop_del_event_handler(event_handle));
+	ret = send_event_burst();
+	if (ret == OK) {
+		ret = eventloop_loop_run();
+	}
+	eventloop_del_event_handler(event_handle);
+	eventloop_del_event_handler(stop_handle);
+	TC_ASSERT_EQ("eventloop_send_event", ret, OK);
+	TC_ASSERT_EQ("eventloop_loop_run", loop_stop_flag, true);
+
+	/* Pending WIFI_ON events are collapsed into one which keeps its place
+	 * before WIFI_OFF and carries the data of the latest one
+	 */
+	TC_ASSERT_EQ("eventloop_send_event", el_burst_cnt, 1);
+	TC_ASSERT_EQ("eventloop_send_event", el_burst_data[0], EL_BURST_COUNT - 1);
+
+	TC_SUCCESS_RESULT();
+}
+#endif
+
 static void el_thread_safe_cb(void *data)
 {
 	if (strncmp((char *)data, EL_THREAD_SAFE_DATA, sizeof(EL_THREAD_SAFE_DATA)) == 0) {
@@ -481,6 +587,11 @@ int utc_eventloop_main(int argc, char *argv[])
 
 	utc_eventloop_send_event_n();
 	utc_eventloop_send_event_p();
+#ifndef CONFIG_EVENTLOOP_EVENT_COALESCE
+	utc_eventloop_send_event_burst_p();
+#else
+	utc_eventloop_send_event_coalesce_p();
+#endif
 
 	utc_eventloop_thread_safe_function_call_n();
 	utc_eventloop_thread_safe_function_call_p();
@@ -43,6 +43,7 @@ int gtest_run(int *argc, char **argv)
 #else
 int utc_media_FocusRequest_main(void);
 int utc_media_FocusManager_main(void);
+int utc_media_MediaQueue_main(void);
 #ifdef CONFIG_MEDIA_PLAYER
 int utc_media_MediaPlayer_main(void);
 int utc_media_FileInputDataSource_main(void);
@@ -74,6 +75,7 @@ int utc_media_main(int argc, char *argv[])
 #else
 	utc_media_FocusRequest_main();
 	utc_media_FocusManager_main();
+	utc_media_MediaQueue_main();
 #ifdef CONFIG_MEDIA_PLAYER
 	utc_media_MediaPlayer_main();
 	utc_media_FileInputDataSource_main();
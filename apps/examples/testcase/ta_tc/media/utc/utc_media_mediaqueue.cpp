@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdlib.h>
+#include <memory>
+#include "MediaQueue.h"
+#include "tc_common.h"
+
+#define TEST_QUEUE_SIZE 8
+
+class QueueTestObserver
+{
+public:
+	QueueTestObserver() : mSum(0) {}
+	void onEvent(std::shared_ptr<int> data, int value, size_t size)
+	{
+		mSum += *data + value + (int)size;
+	}
+	int mSum;
+};
+
+static size_t get_used_heap(void)
+{
+	struct mallinfo minfo;
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	minfo = mallinfo();
+#else
+	(void)mallinfo(&minfo);
+#endif
+	return minfo.uordblks;
+}
+
+static void drain_queue(media::MediaQueue &queue)
+{
+	media::MediaCommand command;
+	while (!queue.isEmpty()) {
+		queue.deQueue(command);
+		command();
+		command.reset();
+	}
+}
+
+static void utc_media_MediaQueue_enQueue_p(void)
+{
+	media::MediaQueue queue(TEST_QUEUE_SIZE);
+	auto observer = std::make_shared<QueueTestObserver>();
+	auto data = std::make_shared<int>(1);
+	int count = 0;
+	int i;
+
+	size_t before = get_used_heap();
+	for (i = 0; i < TEST_QUEUE_SIZE / 2; i++) {
+		TC_ASSERT_EQ("enQueue", queue.enQueue(&QueueTestObserver::onEvent, observer, data, i, (size_t)1), true);
+	}
+	for (; i < TEST_QUEUE_SIZE; i++) {
+		TC_ASSERT_EQ("enQueue", queue.enQueue([&count]() { count++; }), true);
+	}
+	size_t after = get_used_heap();
+
+	/* Commands are stored in preallocated slots, nothing is taken from heap */
+	TC_ASSERT_EQ("enQueue", after, before);
+
+	drain_queue(queue);
+	TC_ASSERT_EQ("deQueue", count, TEST_QUEUE_SIZE / 2);
+	TC_ASSERT_EQ("deQueue", observer->mSum, 14);
+	TC_ASSERT_EQ("deQueue", data.use_count(), 1);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_MediaQueue_enQueue_n(void)
+{
+	media::MediaQueue queue(TEST_QUEUE_SIZE);
+	int count = 0;
+
+	for (int i = 0; i < TEST_QUEUE_SIZE; i++) {
+		queue.enQueue([&count]() { count++; });
+	}
+	TC_ASSERT_EQ("enQueue", queue.enQueue([&count]() { count++; }), false);
+
+	drain_queue(queue);
+	TC_ASSERT_EQ("enQueue", count, TEST_QUEUE_SIZE);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_MediaQueue_clearQueue_p(void)
+{
+	media::MediaQueue queue(TEST_QUEUE_SIZE);
+	auto observer = std::make_shared<QueueTestObserver>();
+	auto data = std::make_shared<int>(1);
+
+	for (int i = 0; i < TEST_QUEUE_SIZE; i++) {
+		queue.enQueue(&QueueTestObserver::onEvent, observer, data, i, (size_t)1);
+	}
+	queue.clearQueue();
+
+	TC_ASSERT_EQ("clearQueue", queue.isEmpty(), true);
+	TC_ASSERT_EQ("clearQueue", data.use_count(), 1);
+	TC_ASSERT_EQ("clearQueue", observer->mSum, 0);
+	TC_SUCCESS_RESULT();
+}
+
+int utc_media_MediaQueue_main(void)
+{
+	utc_media_MediaQueue_enQueue_p();
+	utc_media_MediaQueue_enQueue_n();
+	utc_media_MediaQueue_clearQueue_p();
+	return 0;
+}
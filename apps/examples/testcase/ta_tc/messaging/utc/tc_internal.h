@@ -21,4 +21,5 @@
 void utc_messaging_recv_reply_and_cleanup_main(void);
 void utc_messaging_send_main(void);
 void utc_messaging_multicast_main(void);
+void utc_messaging_port_main(void);
 #endif
@@ -42,6 +42,8 @@ int utc_messaging_main(int argc, char *argv[])
 
 	utc_messaging_multicast_main();
 
+	utc_messaging_port_main();
+
 	(void)testcase_state_handler(TC_END, "Messaging UTC");
 
 	return 0;
@@ -0,0 +1,345 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/types.h>
+#include <messaging/messaging.h>
+#include "tc_common.h"
+
+#define TASK_PRIO 101
+#define STACKSIZE 2048
+#define MSG_PRIO 100
+
+#define TC_PORT_NAME   "port_bench"
+#define TC_SHARED_NAME "port_shared"
+#define TC_BLOCK_NAME  "port_block"
+#define TC_PORT_MSG    "port_msg"
+#define TC_SHARED_SIZE 4096
+#define TC_BLOCK_COUNT 3
+
+#define TC_BENCH_COUNT 500
+#define TC_WAIT_COUNT  500
+#define TC_WAIT_USEC   10000
+
+#define TC_OK   0
+#define TC_FAIL 1
+
+static volatile int tc_port_count;
+static volatile int tc_shared_count;
+static volatile int tc_block_count;
+static volatile bool tc_port_done;
+static int tc_port_chk = TC_OK;
+
+static void port_recv_callback(msg_reply_type_t msg_type, msg_recv_buf_t *recv_data, void *cb_data)
+{
+	if (recv_data == NULL || strncmp(recv_data->buf, TC_PORT_MSG, strlen(TC_PORT_MSG) + 1) != 0) {
+		tc_port_chk = TC_FAIL;
+		return;
+	}
+	tc_port_count++;
+}
+
+static void shared_recv_callback(msg_reply_type_t msg_type, msg_recv_buf_t *recv_data, void *cb_data)
+{
+	msg_shared_ref_t *ref;
+	int i;
+
+	if (recv_data == NULL) {
+		tc_port_chk = TC_FAIL;
+		return;
+	}
+
+	/* The message is the reference of the shared buffer, not the data itself. */
+	ref = (msg_shared_ref_t *)recv_data->buf;
+	for (i = 0; i < ref->datalen; i++) {
+		if (((unsigned char *)ref->data)[i] != (unsigned char)i) {
+			tc_port_chk = TC_FAIL;
+			break;
+		}
+	}
+	messaging_shared_release(ref->data);
+	tc_shared_count++;
+}
+
+static int port_receiver(int argc, FAR char *argv[])
+{
+	int ret;
+	msg_callback_info_t port_cb;
+	msg_callback_info_t shared_cb;
+	msg_recv_buf_t port_buf;
+	msg_recv_buf_t shared_buf;
+	char port_msg[sizeof(TC_PORT_MSG)];
+	msg_shared_ref_t shared_ref;
+
+	port_cb.cb_func = port_recv_callback;
+	port_cb.cb_data = NULL;
+	port_buf.buf = port_msg;
+	port_buf.buflen = sizeof(port_msg);
+
+	shared_cb.cb_func = shared_recv_callback;
+	shared_cb.cb_data = NULL;
+	shared_buf.buf = (char *)&shared_ref;
+	shared_buf.buflen = sizeof(shared_ref);
+
+	ret = messaging_recv_nonblock(TC_PORT_NAME, &port_buf, &port_cb);
+	if (ret != OK) {
+		tc_port_chk = TC_FAIL;
+		return ERROR;
+	}
+
+	ret = messaging_recv_nonblock(TC_SHARED_NAME, &shared_buf, &shared_cb);
+	if (ret != OK) {
+		tc_port_chk = TC_FAIL;
+		(void)messaging_cleanup(TC_PORT_NAME);
+		return ERROR;
+	}
+
+	/* Wait not to finish this task, because of receiving data through the callback. */
+	while (!tc_port_done) {
+		usleep(TC_WAIT_USEC);
+	}
+
+	(void)messaging_cleanup(TC_PORT_NAME);
+	(void)messaging_cleanup(TC_SHARED_NAME);
+	return OK;
+}
+
+static int port_block_receiver(int argc, FAR char *argv[])
+{
+	int i;
+	msg_recv_buf_t recv_buf;
+	char recv_msg[sizeof(TC_PORT_MSG)];
+
+	recv_buf.buf = recv_msg;
+	recv_buf.buflen = sizeof(recv_msg);
+
+	/* Every messaging_recv_block waits with a new message queue. */
+	for (i = 0; i < TC_BLOCK_COUNT; i++) {
+		if (messaging_recv_block(TC_BLOCK_NAME, &recv_buf) == ERROR || strncmp(recv_msg, TC_PORT_MSG, strlen(TC_PORT_MSG) + 1) != 0) {
+			tc_port_chk = TC_FAIL;
+			return ERROR;
+		}
+		tc_block_count++;
+	}
+	return OK;
+}
+
+static unsigned long port_elapsed_usec(struct timespec *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_REALTIME, &end);
+	return (end.tv_sec - start->tv_sec) * 1000000UL + (end.tv_nsec - start->tv_nsec) / 1000;
+}
+
+static bool port_wait_count(volatile int *count, int expected)
+{
+	int wait;
+
+	for (wait = 0; wait < TC_WAIT_COUNT && *count < expected; wait++) {
+		usleep(TC_WAIT_USEC);
+	}
+	return *count == expected;
+}
+
+static void utc_messaging_port_n(void)
+{
+	int ret;
+	msg_port_t *port;
+	msg_send_data_t send_data;
+
+	port = messaging_port_open(NULL);
+	TC_ASSERT_EQ("messaging_port_open", port, NULL);
+
+	send_data.msg = TC_PORT_MSG;
+	send_data.msglen = strlen(TC_PORT_MSG) + 1;
+	send_data.priority = MSG_PRIO;
+	ret = messaging_port_send(NULL, &send_data);
+	TC_ASSERT_EQ("messaging_port_send", ret, ERROR);
+
+	port = messaging_port_open(TC_PORT_NAME);
+	TC_ASSERT_NEQ("messaging_port_open", port, NULL);
+
+	ret = messaging_port_send(port, NULL);
+	TC_ASSERT_EQ_CLEANUP("messaging_port_send", ret, ERROR, messaging_port_close(port));
+
+	/* No receiver waits the port. */
+	ret = messaging_port_send(port, &send_data);
+	TC_ASSERT_EQ_CLEANUP("messaging_port_send", ret, ERROR, messaging_port_close(port));
+
+	ret = messaging_port_send_shared(port, NULL, 1, MSG_PRIO);
+	TC_ASSERT_EQ_CLEANUP("messaging_port_send_shared", ret, ERROR, messaging_port_close(port));
+
+	ret = messaging_port_close(port);
+	TC_ASSERT_EQ("messaging_port_close", ret, OK);
+
+	ret = messaging_port_close(NULL);
+	TC_ASSERT_EQ("messaging_port_close", ret, ERROR);
+
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_messaging_port_p(void)
+{
+	int ret;
+	int i;
+	int recv_pid;
+	msg_port_t *port;
+	msg_send_data_t send_data;
+	struct timespec start;
+	unsigned long send_usec;
+	unsigned long port_usec;
+	unsigned char *shared;
+
+	tc_port_count = 0;
+	tc_shared_count = 0;
+	tc_port_done = false;
+	tc_port_chk = TC_OK;
+
+	recv_pid = task_create("port_recv", TASK_PRIO, STACKSIZE, port_receiver, NULL);
+	TC_ASSERT_GEQ("messaging_port_send", recv_pid, 0);
+
+	port = messaging_port_open(TC_PORT_NAME);
+	TC_ASSERT_NEQ_CLEANUP("messaging_port_open", port, NULL, tc_port_done = true);
+
+	send_data.msg = TC_PORT_MSG;
+	send_data.msglen = strlen(TC_PORT_MSG) + 1;
+	send_data.priority = MSG_PRIO;
+
+	/* Wait until the receiver waits the port. */
+	for (i = 0; i < TC_WAIT_COUNT; i++) {
+		ret = messaging_port_send(port, &send_data);
+		if (ret == 1) {
+			break;
+		}
+		usleep(TC_WAIT_USEC);
+	}
+	TC_ASSERT_EQ_CLEANUP("messaging_port_send", ret, 1, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("messaging_port_send", port_wait_count(&tc_port_count, 1), true, goto cleanup);
+
+	/* Messages per second with messaging_send, which opens the port for every message. */
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < TC_BENCH_COUNT; i++) {
+		ret = messaging_send(TC_PORT_NAME, &send_data);
+		if (ret != OK) {
+			break;
+		}
+	}
+	send_usec = port_elapsed_usec(&start);
+	TC_ASSERT_EQ_CLEANUP("messaging_send", ret, OK, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("messaging_send", port_wait_count(&tc_port_count, 1 + TC_BENCH_COUNT), true, goto cleanup);
+
+	/* Messages per second with the opened port. */
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < TC_BENCH_COUNT; i++) {
+		ret = messaging_port_send(port, &send_data);
+		if (ret != 1) {
+			break;
+		}
+	}
+	port_usec = port_elapsed_usec(&start);
+	TC_ASSERT_EQ_CLEANUP("messaging_port_send", ret, 1, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("messaging_port_send", port_wait_count(&tc_port_count, 1 + 2 * TC_BENCH_COUNT), true, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("messaging_port_send", tc_port_chk, TC_OK, goto cleanup);
+
+	printf("[Messaging] messaging_send : %lu msgs/sec, messaging_port_send : %lu msgs/sec\n",
+		   send_usec ? TC_BENCH_COUNT * 1000000UL / send_usec : 0, port_usec ? TC_BENCH_COUNT * 1000000UL / port_usec : 0);
+
+	(void)messaging_port_close(port);
+
+	/* Send a shared buffer without copying its data. */
+	port = messaging_port_open(TC_SHARED_NAME);
+	TC_ASSERT_NEQ_CLEANUP("messaging_port_open", port, NULL, tc_port_done = true);
+
+	shared = (unsigned char *)messaging_shared_alloc(TC_SHARED_SIZE);
+	TC_ASSERT_NEQ_CLEANUP("messaging_shared_alloc", shared, NULL, goto cleanup);
+	for (i = 0; i < TC_SHARED_SIZE; i++) {
+		shared[i] = (unsigned char)i;
+	}
+
+	ret = messaging_port_send_shared(port, shared, TC_SHARED_SIZE, MSG_PRIO);
+	messaging_shared_release(shared);
+	TC_ASSERT_EQ_CLEANUP("messaging_port_send_shared", ret, 1, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("messaging_port_send_shared", port_wait_count(&tc_shared_count, 1), true, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("messaging_port_send_shared", tc_port_chk, TC_OK, goto cleanup);
+
+	(void)messaging_port_close(port);
+	tc_port_done = true;
+
+	TC_SUCCESS_RESULT();
+	return;
+
+cleanup:
+	(void)messaging_port_close(port);
+	tc_port_done = true;
+}
+
+static void utc_messaging_port_block_p(void)
+{
+	int ret;
+	int i;
+	int wait;
+	int recv_pid;
+	msg_port_t *port;
+	msg_send_data_t send_data;
+
+	tc_block_count = 0;
+	tc_port_chk = TC_OK;
+
+	recv_pid = task_create("port_block", TASK_PRIO, STACKSIZE, port_block_receiver, NULL);
+	TC_ASSERT_GEQ("messaging_port_send", recv_pid, 0);
+
+	port = messaging_port_open(TC_BLOCK_NAME);
+	TC_ASSERT_NEQ("messaging_port_open", port, NULL);
+
+	send_data.msg = TC_PORT_MSG;
+	send_data.msglen = strlen(TC_PORT_MSG) + 1;
+	send_data.priority = MSG_PRIO;
+
+	/* The port has to follow the receiver to its new queue for each message. */
+	for (i = 0; i < TC_BLOCK_COUNT; i++) {
+		for (wait = 0; wait < TC_WAIT_COUNT; wait++) {
+			ret = messaging_port_send(port, &send_data);
+			if (ret == 1) {
+				break;
+			}
+			usleep(TC_WAIT_USEC);
+		}
+		TC_ASSERT_EQ_CLEANUP("messaging_port_send", ret, 1, messaging_port_close(port));
+		TC_ASSERT_EQ_CLEANUP("messaging_recv_block", port_wait_count(&tc_block_count, i + 1), true, messaging_port_close(port));
+	}
+	TC_ASSERT_EQ_CLEANUP("messaging_recv_block", tc_port_chk, TC_OK, messaging_port_close(port));
+
+	ret = messaging_port_close(port);
+	TC_ASSERT_EQ("messaging_port_close", ret, OK);
+
+	TC_SUCCESS_RESULT();
+}
+
+void utc_messaging_port_main(void)
+{
+	utc_messaging_port_n();
+	utc_messaging_port_p();
+	utc_messaging_port_block_p();
+}
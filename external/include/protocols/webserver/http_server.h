@@ -128,6 +128,7 @@ extern "C" {
 
 struct http_client_t;
 struct http_keyvalue_list_t;
+struct http_cache_t;
 
 /**
  * @brief http server ssl config structure.
@@ -150,6 +151,15 @@ typedef enum {
 	HTTP_SERVER_STOP,
 } http_server_state_t;
 
+/**
+ * @brief how the webserver serves the accepted connections.
+ */
+
+typedef enum {
+	HTTP_SERVER_MODE_THREAD,	/* One client handler thread per connection being served */
+	HTTP_SERVER_MODE_EVENT,		/* Event loops serve all connections, see NETUTILS_WEBSERVER_EVENT_LOOP */
+} http_server_mode_t;
+
 /**
  * @brief http request message.
  */
@@ -180,6 +190,7 @@ struct http_server_t {
 	int  port;
 	int  listen_fd;
 	http_server_state_t state;
+	http_server_mode_t mode;
 	sem_t sem_thread_sync;
 	pthread_t tid;
 	pthread_t c_tid[HTTP_CONF_MAX_CLIENT_HANDLE];
@@ -203,6 +214,9 @@ struct http_server_t {
 #ifdef CONFIG_NETUTILS_WEBSOCKET
 	websocket_cb_t ws_cb;
 #endif
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE
+	struct http_cache_t *cache;
+#endif
 };
 
 typedef enum {
@@ -227,6 +241,8 @@ struct http_server_t *http_server_init(int port);
 
 /**
  * @brief http_server_start() starts the webserver.
+ *        server->mode can be set before the start to select how connections
+ *        are served. HTTPS servers are always served by client handler threads.
  *
  * @param[in] server http_server_t structure pointer returned by http_server_init().
  * @return On success, HTTP_OK(0) is returned.
@@ -330,6 +346,23 @@ int http_send_response_with_status_msg(struct http_client_t *client, int status,
  */
 int http_send_response_with_status(struct http_client_t *client, int status, const char* status_message, const char* body, int body_len, struct http_keyvalue_list_t *headers);
 
+/**
+ * @brief http_send_file_response() sends a file as the body of a 200 response.
+ *
+ * Small files are served from the response cache if NETUTILS_WEBSERVER_CACHE
+ * is enabled. If the file does not exist, a 404 response is sent instead.
+ *
+ * @param[in] client a pointer of HTTP client.
+ * @param[in] req the request, whose Accept-Encoding header tells if a gzip
+ *                body can be sent. It can be NULL.
+ * @param[in] path path of the file.
+ * @param[in] content_type value of the Content-Type header, or NULL to choose
+ *                         it by the file extension.
+ * @return On success, HTTP_OK(0) is returned.
+ *         On failure, HTTP_ERROR(-1) is returned.
+ */
+int http_send_file_response(struct http_client_t *client, struct http_req_message *req, const char *path, const char *content_type);
+
 /**
  * @brief http_send_response_chunk() sends the response in chunk form.
  *
@@ -0,0 +1,240 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * In-RAM cache of small file responses.
+ *
+ * Dashboards poll the same few files all the time, so the built responses
+ * are kept in RAM up to CONFIG_NETUTILS_WEBSERVER_CACHE_SIZE bytes and the
+ * least recently used ones are dropped when more room is needed. An entry
+ * is only used while the modification time and the size of its file are
+ * unchanged.
+ *
+ * Entries are reference counted, the cache holds one reference while the
+ * entry is linked. A handler which still sends an entry dropped from the
+ * cache keeps it alive until it puts its reference.
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <protocols/webserver/http_err.h>
+
+#include "http_cache.h"
+#include "http_arch.h"
+#include "http_log.h"
+
+static void http_cache_lock(struct http_cache_t *cache)
+{
+	while (sem_wait(&cache->sem) != 0) {
+		if (errno != EINTR) {
+			break;
+		}
+	}
+}
+
+static void http_cache_unlock(struct http_cache_t *cache)
+{
+	sem_post(&cache->sem);
+}
+
+static void http_cache_unref(struct http_cache_entry_t *entry)
+{
+	if (--entry->refs == 0) {
+		HTTP_FREE(entry);
+	}
+}
+
+/* Called with the cache locked */
+
+static void http_cache_unlink(struct http_cache_t *cache, struct http_cache_entry_t *entry)
+{
+	dq_rem(&entry->link, &cache->lru);
+	cache->size -= entry->len;
+	http_cache_unref(entry);
+}
+
+static struct http_cache_entry_t *http_cache_find(struct http_cache_t *cache, const char *path, int gzip)
+{
+	dq_entry_t *node;
+	struct http_cache_entry_t *entry;
+
+	for (node = dq_peek(&cache->lru); node != NULL; node = dq_next(node)) {
+		entry = (struct http_cache_entry_t *)node;
+		if (entry->gzip == gzip && strcmp(entry->path, path) == 0) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+int http_cache_init(struct http_server_t *server)
+{
+	struct http_cache_t *cache;
+
+	cache = (struct http_cache_t *)HTTP_MALLOC(sizeof(struct http_cache_t));
+	if (cache == NULL) {
+		HTTP_LOGE("Error: Failed to malloc cache\n");
+		return HTTP_ERROR;
+	}
+
+	dq_init(&cache->lru);
+	sem_init(&cache->sem, 0, 1);
+	cache->size = 0;
+	server->cache = cache;
+
+	return HTTP_OK;
+}
+
+void http_cache_release(struct http_server_t *server)
+{
+	struct http_cache_t *cache = server->cache;
+
+	if (cache == NULL) {
+		return;
+	}
+
+	while (!dq_empty(&cache->lru)) {
+		http_cache_unlink(cache, (struct http_cache_entry_t *)dq_peek(&cache->lru));
+	}
+
+	sem_destroy(&cache->sem);
+	HTTP_FREE(cache);
+	server->cache = NULL;
+}
+
+struct http_cache_entry_t *http_cache_get(struct http_server_t *server, const char *path, const struct stat *st, int gzip)
+{
+	struct http_cache_t *cache = server->cache;
+	struct http_cache_entry_t *entry;
+
+	if (cache == NULL) {
+		return NULL;
+	}
+
+	http_cache_lock(cache);
+
+	entry = http_cache_find(cache, path, gzip);
+	if (entry != NULL) {
+		if (entry->mtime != st->st_mtime || entry->file_size != st->st_size) {
+			HTTP_LOGD("Cached %s is out of date\n", path);
+			http_cache_unlink(cache, entry);
+			entry = NULL;
+		} else {
+			dq_rem(&entry->link, &cache->lru);
+			dq_addfirst(&entry->link, &cache->lru);
+			entry->refs++;
+		}
+	}
+
+	http_cache_unlock(cache);
+
+	return entry;
+}
+
+struct http_cache_entry_t *http_cache_alloc(const char *path, const struct stat *st, int gzip, int len)
+{
+	struct http_cache_entry_t *entry;
+	int path_len = strlen(path) + 1;
+
+	/* The path and the data follow the entry in the same allocation */
+
+	entry = (struct http_cache_entry_t *)HTTP_MALLOC(sizeof(struct http_cache_entry_t) + path_len + len);
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	HTTP_MEMSET(entry, 0, sizeof(struct http_cache_entry_t));
+	entry->refs = 1;
+	entry->mtime = st->st_mtime;
+	entry->file_size = st->st_size;
+	entry->gzip = gzip;
+	entry->path = (char *)(entry + 1);
+	entry->data = entry->path + path_len;
+	entry->len = len;
+	HTTP_MEMCPY(entry->path, path, path_len);
+
+	return entry;
+}
+
+void http_cache_insert(struct http_server_t *server, struct http_cache_entry_t *entry)
+{
+	struct http_cache_t *cache = server->cache;
+	struct http_cache_entry_t *old;
+
+	if (cache == NULL || entry->len > CONFIG_NETUTILS_WEBSERVER_CACHE_SIZE) {
+		return;
+	}
+
+	http_cache_lock(cache);
+
+	/* Another handler may have built the same response meanwhile */
+
+	old = http_cache_find(cache, entry->path, entry->gzip);
+	if (old != NULL) {
+		http_cache_unlink(cache, old);
+	}
+
+	while (cache->size + entry->len > CONFIG_NETUTILS_WEBSERVER_CACHE_SIZE) {
+		old = (struct http_cache_entry_t *)dq_tail(&cache->lru);
+		HTTP_LOGD("Drop cached %s\n", old->path);
+		http_cache_unlink(cache, old);
+	}
+
+	entry->refs++;
+	dq_addfirst(&entry->link, &cache->lru);
+	cache->size += entry->len;
+
+	http_cache_unlock(cache);
+}
+
+void http_cache_put(struct http_server_t *server, struct http_cache_entry_t *entry)
+{
+	struct http_cache_t *cache = server->cache;
+
+	if (cache == NULL) {
+		http_cache_unref(entry);
+		return;
+	}
+
+	http_cache_lock(cache);
+	http_cache_unref(entry);
+	http_cache_unlock(cache);
+}
+
+void http_cache_invalidate(struct http_server_t *server, const char *path)
+{
+	struct http_cache_t *cache = server->cache;
+	struct http_cache_entry_t *entry;
+	int gzip;
+
+	if (cache == NULL) {
+		return;
+	}
+
+	http_cache_lock(cache);
+
+	for (gzip = 0; gzip < 2; gzip++) {
+		entry = http_cache_find(cache, path, gzip);
+		if (entry != NULL) {
+			http_cache_unlink(cache, entry);
+		}
+	}
+
+	http_cache_unlock(cache);
+}
@@ -0,0 +1,63 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __http_cache_h__
+#define __http_cache_h__
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <semaphore.h>
+#include <time.h>
+#include <queue.h>
+#include <protocols/webserver/http_server.h>
+
+/*
+ * A cached file response: the content headers, the empty line which ends
+ * the headers and the body. The status line and the connection headers
+ * depend on the client, so they are not cached.
+ */
+struct http_cache_entry_t {
+	dq_entry_t link;			/* Must be first, entries are kept in LRU order */
+	int refs;					/* Users sending the entry, and the cache itself */
+	time_t mtime;				/* The file the entry was built from */
+	off_t file_size;
+	int gzip;					/* Built for clients which accept gzip */
+	char *path;
+	char *data;
+	int len;
+};
+
+struct http_cache_t {
+	dq_queue_t lru;				/* Most recently used first */
+	sem_t sem;
+	int size;					/* Sum of the lengths of the entries */
+};
+
+int   http_cache_init(struct http_server_t *server);
+void  http_cache_release(struct http_server_t *server);
+
+/* Returns a referenced entry of an unchanged file, or NULL */
+struct http_cache_entry_t *http_cache_get(struct http_server_t *server, const char *path, const struct stat *st, int gzip);
+
+/* Allocates a referenced entry of len bytes to be filled and inserted */
+struct http_cache_entry_t *http_cache_alloc(const char *path, const struct stat *st, int gzip, int len);
+void  http_cache_insert(struct http_server_t *server, struct http_cache_entry_t *entry);
+void  http_cache_put(struct http_server_t *server, struct http_cache_entry_t *entry);
+void  http_cache_invalidate(struct http_server_t *server, const char *path);
+
+#endif
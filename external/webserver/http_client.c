@@ -30,8 +30,10 @@
 #include "http_query.h"
 #include "http_arch.h"
 #include "http_log.h"
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE
+#include "http_cache.h"
+#endif
 
-#define MIN_WS_HEADER_FIELD 2
 #define MAX_CLIENT_REQUEST 999999 /* it Will be updated if max client request exceeds 999999 */
 #define MIN_CLIENT_REQUEST 100
 
@@ -595,6 +597,46 @@ int http_parse_message(char *buf, int buf_len, int *method, char *url,
 	return read_finish;
 }
 
+#ifdef CONFIG_NETUTILS_WEBSOCKET
+int http_client_upgrade_websocket(struct http_client_t *client)
+{
+	websocket_t *ws = NULL;
+
+	ws = websocket_find_table();
+	if (ws == NULL) {
+		return HTTP_ERROR;
+	}
+	ws->fd = client->client_fd;
+	ws->cb = &client->server->ws_cb;
+#ifdef CONFIG_NET_SECURITY_TLS
+	if (client->server->tls_init) {
+		ws->tls_enabled = 1;
+		ws->tls_net.fd = client->tls_client_fd.fd;
+		ws->tls_ssl = (mbedtls_ssl_context *)malloc(sizeof(mbedtls_ssl_context));
+		memcpy(ws->tls_ssl, &client->tls_ssl, sizeof(mbedtls_ssl_context));
+		ws->tls_conf = &client->server->tls_conf;
+		mbedtls_ssl_set_bio(ws->tls_ssl, &ws->tls_net, mbedtls_net_send, mbedtls_net_recv, NULL);
+	}
+#endif
+	if (pthread_attr_init(&ws->thread_attr) != 0) {
+		HTTP_LOGE("Error: Cannot initialize thread attribute\n");
+		return HTTP_ERROR;
+	}
+	pthread_attr_setstacksize(&ws->thread_attr, WEBSOCKET_STACKSIZE);
+	pthread_attr_setschedpolicy(&ws->thread_attr, SCHED_RR);
+	if (pthread_create(&ws->thread_id, &ws->thread_attr,
+					   (pthread_startroutine_t)websocket_server_init,
+					   (pthread_addr_t)ws) != 0) {
+		HTTP_LOGE("Error: Cannot create websocket thread!!\n");
+		return HTTP_ERROR;
+	}
+	pthread_setname_np(ws->thread_id, "websocket handle server");
+	pthread_detach(ws->thread_id);
+
+	return HTTP_OK;
+}
+#endif
+
 int http_recv_and_handle_request(struct http_client_t *client, struct http_keyvalue_list_t *request_params)
 {
 	char *buf;
@@ -723,37 +765,9 @@ int http_recv_and_handle_request(struct http_client_t *client, struct http_keyva
 #ifdef CONFIG_NETUTILS_WEBSOCKET
 	/* open websocket */
 	if (client->ws_state >= MIN_WS_HEADER_FIELD) {
-		websocket_t *ws = NULL;
-		ws = websocket_find_table();
-		if (ws == NULL) {
+		if (http_client_upgrade_websocket(client) != HTTP_OK) {
 			goto errout;
 		}
-		ws->fd = client->client_fd;
-		ws->cb = &client->server->ws_cb;
-#ifdef CONFIG_NET_SECURITY_TLS
-		if (client->server->tls_init) {
-			ws->tls_enabled = 1;
-			ws->tls_net.fd = client->tls_client_fd.fd;
-			ws->tls_ssl = (mbedtls_ssl_context *)malloc(sizeof(mbedtls_ssl_context));
-			memcpy(ws->tls_ssl, &client->tls_ssl, sizeof(mbedtls_ssl_context));
-			ws->tls_conf = &client->server->tls_conf;
-			mbedtls_ssl_set_bio(ws->tls_ssl, &ws->tls_net, mbedtls_net_send, mbedtls_net_recv, NULL);
-		}
-#endif
-		if (pthread_attr_init(&ws->thread_attr) != 0) {
-			HTTP_LOGE("Error: Cannot initialize thread attribute\n");
-			goto errout;
-		}
-		pthread_attr_setstacksize(&ws->thread_attr, WEBSOCKET_STACKSIZE);
-		pthread_attr_setschedpolicy(&ws->thread_attr, SCHED_RR);
-		if (pthread_create(&ws->thread_id, &ws->thread_attr,
-						   (pthread_startroutine_t)websocket_server_init,
-						   (pthread_addr_t)ws) != 0) {
-			HTTP_LOGE("Error: Cannot create websocket thread!!\n");
-			goto errout;
-		}
-		pthread_setname_np(ws->thread_id, "websocket handle server");
-		pthread_detach(ws->thread_id);
 	} else {
 		close(client->client_fd);
 	}
@@ -777,6 +791,19 @@ errout:
 	return HTTP_ERROR;
 }
 
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE
+/* The file may change within the same second, keeping its size, so its
+ * cached response is dropped. GET caches it under the url, which is the
+ * path without the leading ".".
+ */
+static void http_handle_file_changed(struct http_client_t *client, const char *path)
+{
+	http_cache_invalidate(client->server, path + 1);
+}
+#else
+#define http_handle_file_changed(client, path)
+#endif
+
 void http_handle_file(struct http_client_t *client, int method, const char *url, char *entity)
 {
 	FILE *f;
@@ -786,16 +813,8 @@ void http_handle_file(struct http_client_t *client, int method, const char *url,
 
 	switch (method) {
 	case HTTP_METHOD_GET:
-		if ((f = fopen(url, "r")) != NULL) {
-			fgets(entity, HTTP_CONF_MAX_ENTITY_LENGTH, f);
-			if (http_send_response(client, 200, entity, NULL) == HTTP_ERROR) {
-				HTTP_LOGE("Error: Fail to send response\n");
-			}
-			fclose(f);
-		} else {
-			if (http_send_response(client, 404, HTTP_ERROR_404, NULL) == HTTP_ERROR) {
-				HTTP_LOGE("Error: Fail to send response\n");
-			}
+		if (http_send_file_response(client, NULL, url, NULL) == HTTP_ERROR) {
+			HTTP_LOGE("Error: Fail to send response\n");
 		}
 		break;
 	case HTTP_METHOD_POST:
@@ -809,6 +828,7 @@ void http_handle_file(struct http_client_t *client, int method, const char *url,
 		strncat(path, url, HTTP_CONF_MAX_REQUEST_HEADER_URL_LENGTH - strlen(path));
 		strncat(path, "index.shtml", HTTP_CONF_MAX_REQUEST_HEADER_URL_LENGTH - strlen(path));
 		if (valid && (f = fopen(path, "w"))) {
+			http_handle_file_changed(client, path);
 			if (fputs(entity, f) < 0) {
 				HTTP_LOGE("Error: Fail to execute fputs\n");
 				fclose(f);
@@ -833,6 +853,7 @@ void http_handle_file(struct http_client_t *client, int method, const char *url,
 		} else
 			valid = 1;
 		if (valid && (f = fopen(strncat(path, url, HTTP_CONF_MAX_REQUEST_HEADER_URL_LENGTH - strlen(path)), "w"))) {
+			http_handle_file_changed(client, path);
 			if (fputs(entity, f) < 0) {
 				HTTP_LOGE("Error: Fail to execute fputs\n");
 				fclose(f);
@@ -863,6 +884,7 @@ void http_handle_file(struct http_client_t *client, int method, const char *url,
 			}
 		} else {
 			HTTP_LOGD("success to delete %s\n", url);
+			http_handle_file_changed(client, path);
 			if (http_send_response(client, 200, url, NULL) == HTTP_ERROR) {
 				HTTP_LOGE("Error: Fail to send response\n");
 			}
@@ -932,6 +954,12 @@ static int http_send_chunk_buffer(struct http_client_t *client, char *buf, int l
 		return -1;
 	}
 
+#ifdef CONFIG_NETUTILS_WEBSERVER_EVENT_LOOP
+	if (client->nonblock) {
+		return (http_client_write(client, buf, len) == HTTP_OK) ? 0 : -1;
+	}
+#endif
+
 	sndlen = len;
 
 	while (sndlen > 0) {
@@ -1073,7 +1101,7 @@ int http_send_response_chunk(struct http_client_t *client, int status, const cha
 	return HTTP_OK;
 }
 
-static int http_send_buffer(struct http_client_t *client, const char *buf, int len)
+int http_send_buffer(struct http_client_t *client, const char *buf, int len)
 {
 	int send_byte = 0;
 	int sndlen = 0;
@@ -1084,6 +1112,12 @@ static int http_send_buffer(struct http_client_t *client, const char *buf, int l
 		return -1;
 	}
 
+#ifdef CONFIG_NETUTILS_WEBSERVER_EVENT_LOOP
+	if (client->nonblock) {
+		return (http_client_write(client, buf, len) == HTTP_OK) ? 0 : -1;
+	}
+#endif
+
 	sndlen = len;
 	while (sndlen > 0) {
 #ifdef CONFIG_NET_SECURITY_TLS
@@ -1219,13 +1253,13 @@ int http_send_response_helper(struct http_client_t *client, int status, const ch
 					HTTP_CONF_MAX_REQUEST_LENGTH - buflen, "\r\n");
 		// Include response body
 		if (body) {
-			memcpy(buf + buflen, body, HTTP_CONF_MAX_REQUEST_LENGTH - buflen);
 			if (body_len <= HTTP_CONF_MAX_REQUEST_LENGTH - buflen) {
 				len = body_len;
 			} else {
 				len = HTTP_CONF_MAX_REQUEST_LENGTH - buflen;
 				rem_body_len = body_len - len;
 			}
+			memcpy(buf + buflen, body, len);
 			buflen += len;
 		}
 	}
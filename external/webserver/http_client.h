@@ -36,6 +36,10 @@
 #include "mbedtls/ssl_cache.h"
 #endif
 
+/* Number of websocket upgrade headers which turn a request into a websocket */
+
+#define MIN_WS_HEADER_FIELD 2
+
 enum {
 	HTTP_REQUEST_HEADER, HTTP_REQUEST_PARAMETERS, HTTP_REQUEST_BODY
 };
@@ -56,6 +60,18 @@ struct http_client_t {
 	uint32_t max_request;
 	uint32_t remaining_request;
 	int keep_alive_header_flag;
+
+#ifdef CONFIG_NETUTILS_WEBSERVER_EVENT_LOOP
+	/* Output of an event loop connection which the socket did not take yet */
+
+	int nonblock;				/* The socket is non-blocking */
+	char *wbuf;					/* Queued response data */
+	int wbuf_len;
+	int wbuf_sent;
+	int wfile;					/* File whose rest follows wbuf */
+	off_t wfile_offset;
+	off_t wfile_size;			/* 0 if no file is queued */
+#endif
 };
 
 struct http_message_len_t {
@@ -73,6 +89,15 @@ void *http_handle_client(void *arg /* struct http_client_t *client */);
 struct http_client_t *http_client_init(struct http_server_t *server, int sock_fd);
 int   http_client_release(struct http_client_t *client);
 
+#ifdef CONFIG_NETUTILS_WEBSERVER_EVENT_LOOP
+#define http_client_pending(client) ((client)->wbuf_len > 0 || (client)->wfile_size > 0)
+
+int   http_client_write(struct http_client_t *client, const char *buf, int len);
+int   http_client_queue_file(struct http_client_t *client, int fd, off_t offset, off_t size);
+int   http_client_flush(struct http_client_t *client);
+void  http_client_discard(struct http_client_t *client);
+#endif
+
 /**
  * @brief http_parse_message parse the http request and resonse message
  * @param[in] buf of http request and response message
@@ -101,6 +126,10 @@ int http_parse_message(char *buf, int buf_len, int *method, char *url,
 					   struct http_req_message *req,
 					   int *chunk_processed);
 int   http_recv_and_handle_request(struct http_client_t *client, struct http_keyvalue_list_t *request_params);
+int   http_send_buffer(struct http_client_t *client, const char *buf, int len);
+#ifdef CONFIG_NETUTILS_WEBSOCKET
+int   http_client_upgrade_websocket(struct http_client_t *client);
+#endif
 
 #ifdef CONFIG_NET_SECURITY_TLS
 int   http_client_tls_init(struct http_client_t *client);
@@ -0,0 +1,362 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * File responses of the webserver.
+ *
+ * Small files are answered from the response cache when it is enabled,
+ * bigger ones are sent with sendfile(), which sends files in an XIP ROMFS
+ * without copying them (see NET_SENDFILE).
+ */
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <protocols/webserver/http_err.h>
+#include <protocols/webserver/http_keyvalue_list.h>
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE_GZIP
+#include <miniz/miniz.h>
+#endif
+
+#include "http_client.h"
+#include "http_arch.h"
+#include "http_log.h"
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE
+#include "http_cache.h"
+#endif
+
+#define HTTP_FILE_HEADER_LENGTH 256
+
+#define GZIP_HEADER_LEN  10
+#define GZIP_TRAILER_LEN 8
+
+struct http_file_type_t {
+	const char *ext;
+	const char *type;
+	int compress;
+};
+
+static const struct http_file_type_t g_file_types[] = {
+	{ ".html", "text/html", 1 },
+	{ ".htm", "text/html", 1 },
+	{ ".shtml", "text/html", 1 },
+	{ ".css", "text/css", 1 },
+	{ ".js", "application/javascript", 1 },
+	{ ".json", "application/json", 1 },
+	{ ".txt", "text/plain", 1 },
+	{ ".svg", "image/svg+xml", 1 },
+	{ ".png", "image/png", 0 },
+	{ ".jpg", "image/jpeg", 0 },
+	{ ".gif", "image/gif", 0 },
+	{ ".ico", "image/x-icon", 0 },
+};
+
+static const struct http_file_type_t *http_file_type(const char *path)
+{
+	const char *ext = strrchr(path, '.');
+	int i;
+
+	if (ext != NULL) {
+		for (i = 0; i < sizeof(g_file_types) / sizeof(g_file_types[0]); i++) {
+			if (strcasecmp(ext, g_file_types[i].ext) == 0) {
+				return &g_file_types[i];
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/* The status line and the headers which depend on the client */
+
+static int http_file_status_header(struct http_client_t *client, char *buf, int size)
+{
+	return snprintf(buf, size, "HTTP/1.1 200 OK\r\n"
+					"Connection: %s\r\n"
+					"Keep-Alive: timeout=%d, max=%d\r\n",
+					client->keep_alive ? "Keep-Alive" : "close",
+					client->keep_alive_timeout, client->max_request);
+}
+
+static int http_file_content_header(char *buf, int size, const char *type, int len, int gzip, int vary)
+{
+	return snprintf(buf, size, "Content-Type: %s\r\n"
+					"Content-Length: %d\r\n"
+					"%s%s\r\n",
+					type, len,
+					gzip ? "Content-Encoding: gzip\r\n" : "",
+					vary ? "Vary: Accept-Encoding\r\n" : "");
+}
+
+static int http_file_send_body(struct http_client_t *client, int fd, off_t size)
+{
+	off_t offset = 0;
+	ssize_t ret;
+
+#ifdef CONFIG_NET_SECURITY_TLS
+	if (client->server->tls_init) {
+		char *buf = HTTP_MALLOC(HTTP_CONF_MAX_REQUEST_LENGTH);
+
+		if (buf == NULL) {
+			HTTP_LOGE("Error: Fail to malloc buffer\n");
+			return HTTP_ERROR;
+		}
+
+		while (offset < size) {
+			ret = read(fd, buf, HTTP_CONF_MAX_REQUEST_LENGTH);
+			if (ret <= 0 || http_send_buffer(client, buf, ret) < 0) {
+				HTTP_FREE(buf);
+				return HTTP_ERROR;
+			}
+			offset += ret;
+		}
+
+		HTTP_FREE(buf);
+		return HTTP_OK;
+	}
+#endif
+
+#ifdef CONFIG_NETUTILS_WEBSERVER_EVENT_LOOP
+	/* The body follows the queued header */
+
+	if (client->nonblock && http_client_pending(client)) {
+		return http_client_queue_file(client, fd, offset, size);
+	}
+#endif
+
+	while (offset < size) {
+		ret = sendfile(client->client_fd, fd, &offset, size - offset);
+#ifdef CONFIG_NETUTILS_WEBSERVER_EVENT_LOOP
+		if (ret < 0 && client->nonblock && (errno == EWOULDBLOCK || errno == EAGAIN)) {
+			/* The event loop sends the rest when the socket is writable */
+
+			return http_client_queue_file(client, fd, offset, size);
+		}
+#endif
+		if (ret <= 0) {
+			HTTP_LOGE("Error: Fail to send file errno[%d]\n", errno);
+			return HTTP_ERROR;
+		}
+	}
+
+	return HTTP_OK;
+}
+
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE_GZIP
+static void http_file_put_le32(char *buf, mz_ulong val)
+{
+	buf[0] = val & 0xff;
+	buf[1] = (val >> 8) & 0xff;
+	buf[2] = (val >> 16) & 0xff;
+	buf[3] = (val >> 24) & 0xff;
+}
+
+/* Returns the length of the gzip member, or 0 if it is not shorter than in */
+
+static int http_file_gzip(char *out, const char *in, int len)
+{
+	static const char header[GZIP_HEADER_LEN] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff };
+	size_t deflated;
+
+	if (len <= GZIP_HEADER_LEN + GZIP_TRAILER_LEN) {
+		return 0;
+	}
+
+	deflated = tdefl_compress_mem_to_mem(out + GZIP_HEADER_LEN, len - 1 - GZIP_HEADER_LEN - GZIP_TRAILER_LEN, in, len, TDEFL_DEFAULT_MAX_PROBES);
+	if (deflated == 0) {
+		return 0;
+	}
+
+	HTTP_MEMCPY(out, header, GZIP_HEADER_LEN);
+	http_file_put_le32(out + GZIP_HEADER_LEN + deflated, mz_crc32(MZ_CRC32_INIT, (const unsigned char *)in, len));
+	http_file_put_le32(out + GZIP_HEADER_LEN + deflated + 4, len);
+
+	return GZIP_HEADER_LEN + deflated + GZIP_TRAILER_LEN;
+}
+#endif
+
+/* Builds the response of a small file and adds it to the cache */
+
+static struct http_cache_entry_t *http_file_load(struct http_server_t *server, const char *path, const struct stat *st, const char *type, int compress, int gzip)
+{
+	struct http_cache_entry_t *entry = NULL;
+	char header[HTTP_FILE_HEADER_LENGTH];
+	char *body;
+	int body_len = st->st_size;
+	int encoded = 0;
+	int header_len;
+	int fd;
+	int len;
+	int ret;
+
+	body = HTTP_MALLOC(st->st_size + 1);
+	if (body == NULL) {
+		return NULL;
+	}
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		goto out;
+	}
+
+	for (len = 0; len < st->st_size; len += ret) {
+		ret = read(fd, body + len, st->st_size - len);
+		if (ret <= 0) {
+			break;
+		}
+	}
+	close(fd);
+
+	if (len != st->st_size) {
+		goto out;
+	}
+
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE_GZIP
+	if (compress && gzip) {
+		char *zbody = HTTP_MALLOC(st->st_size);
+
+		if (zbody != NULL) {
+			len = http_file_gzip(zbody, body, st->st_size);
+			if (len > 0) {
+				HTTP_FREE(body);
+				body = zbody;
+				body_len = len;
+				encoded = 1;
+			} else {
+				HTTP_FREE(zbody);
+			}
+		}
+	}
+#endif
+
+	header_len = http_file_content_header(header, sizeof(header), type, body_len, encoded, compress);
+
+	if (header_len < 0 || header_len >= sizeof(header)) {
+		goto out;
+	}
+
+	entry = http_cache_alloc(path, st, gzip, header_len + body_len);
+	if (entry == NULL) {
+		goto out;
+	}
+
+	HTTP_MEMCPY(entry->data, header, header_len);
+	HTTP_MEMCPY(entry->data + header_len, body, body_len);
+	http_cache_insert(server, entry);
+
+out:
+	HTTP_FREE(body);
+	return entry;
+}
+
+static int http_file_send_cached(struct http_client_t *client, struct http_cache_entry_t *entry)
+{
+	char status[HTTP_FILE_HEADER_LENGTH];
+	int len;
+
+	/* The status line depends on the connection, the rest is sent as stored.
+	 * Client sockets are TCP_NODELAY, so the entry does not wait for the ACK
+	 * of the status line.
+	 */
+
+	len = http_file_status_header(client, status, sizeof(status));
+	if (len >= sizeof(status) || http_send_buffer(client, status, len) < 0) {
+		return HTTP_ERROR;
+	}
+
+	return (http_send_buffer(client, entry->data, entry->len) < 0) ? HTTP_ERROR : HTTP_OK;
+}
+#endif
+
+int http_send_file_response(struct http_client_t *client, struct http_req_message *req, const char *path, const char *content_type)
+{
+	const struct http_file_type_t *file_type;
+	char header[HTTP_FILE_HEADER_LENGTH * 2];
+	struct stat st;
+	int len;
+	int fd;
+	int ret;
+
+	if (client == NULL || path == NULL) {
+		return HTTP_ERROR;
+	}
+
+	if (stat(path, &st) < 0 || !S_ISREG(st.st_mode)) {
+		HTTP_LOGD("No file %s\n", path);
+		http_send_response(client, 404, HTTP_ERROR_404, NULL);
+		return HTTP_ERROR;
+	}
+
+	file_type = http_file_type(path);
+	if (content_type == NULL) {
+		content_type = file_type ? file_type->type : "application/octet-stream";
+	}
+
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE
+	if (st.st_size <= CONFIG_NETUTILS_WEBSERVER_CACHE_MAX_FILE) {
+		struct http_cache_entry_t *entry;
+		int compress = 0;
+		int gzip = 0;
+
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE_GZIP
+		if (file_type != NULL && file_type->compress) {
+			char *encoding = (req && req->headers) ? http_keyvalue_list_find(req->headers, "Accept-Encoding") : NULL;
+
+			compress = 1;
+			gzip = (encoding != NULL && strstr(encoding, "gzip") != NULL);
+		}
+#endif
+
+		entry = http_cache_get(client->server, path, &st, gzip);
+		if (entry == NULL) {
+			entry = http_file_load(client->server, path, &st, content_type, compress, gzip);
+		}
+
+		if (entry != NULL) {
+			ret = http_file_send_cached(client, entry);
+			http_cache_put(client->server, entry);
+			return ret;
+		}
+	}
+#endif
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		HTTP_LOGE("Error: Fail to open %s\n", path);
+		http_send_response(client, 404, HTTP_ERROR_404, NULL);
+		return HTTP_ERROR;
+	}
+
+	len = http_file_status_header(client, header, sizeof(header));
+	len += http_file_content_header(header + len, sizeof(header) - len, content_type, st.st_size, 0, 0);
+	if (len >= sizeof(header) || http_send_buffer(client, header, len) < 0) {
+		close(fd);
+		return HTTP_ERROR;
+	}
+
+	ret = http_file_send_body(client, fd, st.st_size);
+	close(fd);
+
+	return ret;
+}
@@ -23,6 +23,9 @@
 #include "http_client.h"
 #include "http_arch.h"
 #include "http_log.h"
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE
+#include "http_cache.h"
+#endif
 
 struct http_server_t *http_server_init(int port)
 {
@@ -45,10 +48,22 @@ struct http_server_t *http_server_init(int port)
 	p->listen_fd = -1;
 	p->tls_init = 0;
 	p->state = HTTP_SERVER_INIT;
+#ifdef CONFIG_NETUTILS_WEBSERVER_EVENT_LOOP
+	p->mode = HTTP_SERVER_MODE_EVENT;
+#else
+	p->mode = HTTP_SERVER_MODE_THREAD;
+#endif
 
 	/* Init server query handler */
 	HTTP_MEMSET(p->query_handlers, 0, sizeof(struct http_query_handler_t *) * HTTP_CONF_MAX_QUERY_HANDLER_COUNT);
 
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE
+	if (http_cache_init(p) != HTTP_OK) {
+		HTTP_FREE(p);
+		return NULL;
+	}
+#endif
+
 	return p;
 }
 
@@ -65,6 +80,9 @@ void http_server_release(struct http_server_t **server)
 		if ((*server)->tls_init) {
 			http_server_tls_release(*server);
 		}
+#endif
+#ifdef CONFIG_NETUTILS_WEBSERVER_CACHE
+		http_cache_release(*server);
 #endif
 		HTTP_FREE(*server);
 		*server = NULL;
@@ -0,0 +1,825 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * Event-driven connection handling of the webserver.
+ *
+ * Instead of handing every accepted connection to a client handler thread,
+ * HTTP_CONF_MAX_CLIENT_HANDLE event loops share the listening socket and
+ * select() over their own connections. A connection only keeps its state
+ * between requests: the request buffer is allocated when data arrives and
+ * freed again when all received requests are served, so an idle keep-alive
+ * connection costs a few dozen bytes instead of a thread stack.
+ *
+ * A request is served once it is complete in the buffer, so a slow client
+ * never blocks the loop while the request is read. The responses are sent
+ * from the callbacks as in the thread mode, but the sockets are non-blocking:
+ * what a socket does not take at once is queued in the client, and a file
+ * body is continued from its offset, when the socket becomes writable. The
+ * next request of a connection is served after the queued response is sent,
+ * so requests following each other in the buffer (pipelining) are served in
+ * order.
+ */
+
+#include <sys/types.h>
+#include <pthread.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/sendfile.h>
+#include <protocols/webserver/http_err.h>
+#include <protocols/webserver/http_server.h>
+#include <protocols/webserver/http_keyvalue_list.h>
+
+#include "http.h"
+#include "http_client.h"
+#include "http_query.h"
+#include "http_string_util.h"
+#include "http_arch.h"
+#include "http_log.h"
+
+#define HTTP_EVENT_LOOP_STACKSIZE HTTP_CONF_CLIENT_STACKSIZE
+#define HTTP_EVENT_POLL_MS        100
+#define HTTP_EVENT_MAX_CONN       CONFIG_NETUTILS_WEBSERVER_EVENT_MAX_CONN
+
+/* Close the connection after the current request */
+
+#define HTTP_EVENT_CLOSE          1
+
+struct http_event_conn_t {
+	struct http_client_t *client;	/* NULL if the slot is free */
+	uint32_t client_ip;
+	time_t last_active;
+	char *buf;						/* Received data, NULL while idle */
+	int buf_len;
+	int ws_upgraded;				/* The socket was handed to a websocket */
+	int closing;					/* Close when the queued response is sent */
+};
+
+/*
+ * Output queue of a non-blocking client
+ */
+
+static int http_client_is_busy(void)
+{
+	return errno == EWOULDBLOCK || errno == EAGAIN;
+}
+
+/* Read len bytes of fd from offset into buf */
+
+static int http_client_read_at(int fd, off_t offset, char *buf, int len)
+{
+	int total;
+	int ret;
+
+	if (lseek(fd, offset, SEEK_SET) < 0) {
+		return HTTP_ERROR;
+	}
+
+	for (total = 0; total < len; total += ret) {
+		ret = read(fd, buf + total, len - total);
+		if (ret <= 0) {
+			return HTTP_ERROR;
+		}
+	}
+
+	return HTTP_OK;
+}
+
+/* Append data after the queued output. A queued file is read in first,
+ * as the data has to follow it.
+ */
+static int http_client_queue(struct http_client_t *client, const char *buf, int len)
+{
+	int queued = client->wbuf_len - client->wbuf_sent;
+	int flen = client->wfile_size - client->wfile_offset;
+	char *wbuf;
+
+	wbuf = HTTP_MALLOC(queued + flen + len);
+	if (wbuf == NULL) {
+		HTTP_LOGE("Error: Fail to malloc output buffer\n");
+		return HTTP_ERROR;
+	}
+
+	if (flen > 0) {
+		if (http_client_read_at(client->wfile, client->wfile_offset, wbuf + queued, flen) != HTTP_OK) {
+			HTTP_FREE(wbuf);
+			return HTTP_ERROR;
+		}
+		close(client->wfile);
+		client->wfile_offset = 0;
+		client->wfile_size = 0;
+	}
+
+	if (client->wbuf) {
+		HTTP_MEMCPY(wbuf, client->wbuf + client->wbuf_sent, queued);
+		HTTP_FREE(client->wbuf);
+	}
+	HTTP_MEMCPY(wbuf + queued + flen, buf, len);
+
+	client->wbuf = wbuf;
+	client->wbuf_len = queued + flen + len;
+	client->wbuf_sent = 0;
+	return HTTP_OK;
+}
+
+/* Send as much as the socket takes now and queue the rest */
+
+int http_client_write(struct http_client_t *client, const char *buf, int len)
+{
+	int sent = 0;
+	int ret;
+
+	while (!http_client_pending(client) && sent < len) {
+		ret = send(client->client_fd, buf + sent, len - sent, 0);
+		if (ret < 0 && http_client_is_busy()) {
+			break;
+		}
+		if (ret < 1) {
+			HTTP_LOGE("Fail to send buffer ret[%d] errno[%d]\n", ret, errno);
+			return HTTP_ERROR;
+		}
+		sent += ret;
+	}
+
+	if (sent < len) {
+		return http_client_queue(client, buf + sent, len - sent);
+	}
+
+	return HTTP_OK;
+}
+
+/* Queue the rest of a file. fd stays owned by the caller. */
+
+int http_client_queue_file(struct http_client_t *client, int fd, off_t offset, off_t size)
+{
+	int wfile;
+	int ret;
+
+	if (client->wfile_size > 0) {
+		/* Only one file is queued at a time, a second one is read in */
+
+		char *buf = HTTP_MALLOC(size - offset);
+
+		if (buf == NULL || http_client_read_at(fd, offset, buf, size - offset) != HTTP_OK) {
+			HTTP_LOGE("Error: Fail to queue file\n");
+			if (buf) {
+				HTTP_FREE(buf);
+			}
+			return HTTP_ERROR;
+		}
+
+		ret = http_client_queue(client, buf, size - offset);
+		HTTP_FREE(buf);
+		return ret;
+	}
+
+	wfile = dup(fd);
+	if (wfile < 0) {
+		HTTP_LOGE("Error: Fail to dup file errno[%d]\n", errno);
+		return HTTP_ERROR;
+	}
+
+	client->wfile = wfile;
+	client->wfile_offset = offset;
+	client->wfile_size = size;
+	return HTTP_OK;
+}
+
+/* Send the queued output until the socket would block */
+
+int http_client_flush(struct http_client_t *client)
+{
+	ssize_t ret;
+
+	while (client->wbuf_sent < client->wbuf_len) {
+		ret = send(client->client_fd, client->wbuf + client->wbuf_sent, client->wbuf_len - client->wbuf_sent, 0);
+		if (ret < 0 && http_client_is_busy()) {
+			return HTTP_OK;
+		}
+		if (ret < 1) {
+			return HTTP_ERROR;
+		}
+		client->wbuf_sent += ret;
+	}
+
+	if (client->wbuf) {
+		HTTP_FREE(client->wbuf);
+		client->wbuf = NULL;
+		client->wbuf_len = 0;
+		client->wbuf_sent = 0;
+	}
+
+	while (client->wfile_offset < client->wfile_size) {
+		ret = sendfile(client->client_fd, client->wfile, &client->wfile_offset, client->wfile_size - client->wfile_offset);
+		if (ret < 0 && http_client_is_busy()) {
+			return HTTP_OK;
+		}
+		if (ret <= 0) {
+			HTTP_LOGE("Error: Fail to send file errno[%d]\n", errno);
+			return HTTP_ERROR;
+		}
+	}
+
+	http_client_discard(client);
+	return HTTP_OK;
+}
+
+void http_client_discard(struct http_client_t *client)
+{
+	if (client->wbuf) {
+		HTTP_FREE(client->wbuf);
+		client->wbuf = NULL;
+	}
+	client->wbuf_len = 0;
+	client->wbuf_sent = 0;
+
+	if (client->wfile_size > 0) {
+		close(client->wfile);
+		client->wfile_offset = 0;
+		client->wfile_size = 0;
+	}
+}
+
+/*
+ * Request framing
+ */
+
+static int http_event_has_token(const char *src, int len, const char *token)
+{
+	int token_len = strlen(token);
+	int i;
+
+	for (i = 0; i + token_len <= len; i++) {
+		if (strncasecmp(src + i, token, token_len) == 0) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static int http_event_chunked_len(const char *buf, int buf_len, int pos)
+{
+	int sentence_end;
+	long chunk_len;
+
+	for (;;) {
+		sentence_end = http_find_first_crlf(buf, buf_len, pos);
+		if (sentence_end < 0) {
+			return 0;
+		}
+
+		chunk_len = strtol(buf + pos, NULL, 16);
+		if (chunk_len < 0 || chunk_len > HTTP_CONF_MAX_REQUEST_LENGTH) {
+			return HTTP_ERROR;
+		}
+		pos = sentence_end + 2;
+
+		if (chunk_len == 0) {
+			/* Trailer headers up to the empty line */
+			for (;;) {
+				sentence_end = http_find_first_crlf(buf, buf_len, pos);
+				if (sentence_end < 0) {
+					return 0;
+				}
+				if (sentence_end == pos) {
+					return pos + 2;
+				}
+				pos = sentence_end + 2;
+			}
+		}
+
+		pos += chunk_len + 2;
+		if (pos > buf_len) {
+			return 0;
+		}
+	}
+}
+
+/*
+ * Returns the length of the first request in buf, 0 if it is not complete
+ * yet or HTTP_ERROR if it can not be received in the request buffer.
+ * keep_alive is set by the protocol version and the Connection header.
+ */
+static int http_event_frame_request(const char *buf, int buf_len, int *keep_alive)
+{
+	int header_len = -1;
+	int content_len = 0;
+	int chunked = 0;
+	int sentence_start;
+	int sentence_end;
+	int req_len;
+
+	/* Find the end of the header */
+
+	sentence_end = http_find_first_crlf(buf, buf_len, 0);
+	if (sentence_end < 0) {
+		return (buf_len >= HTTP_CONF_MAX_REQUEST_LENGTH) ? HTTP_ERROR : 0;
+	}
+
+	/* HTTP/1.1 connections are persistent unless the client closes them */
+
+	*keep_alive = (sentence_end >= 8 && strncmp(buf + sentence_end - 8, "HTTP/1.1", 8) == 0);
+
+	sentence_start = sentence_end + 2;
+	while ((sentence_end = http_find_first_crlf(buf, buf_len, sentence_start)) > sentence_start) {
+		const char *line = buf + sentence_start;
+		int line_len = sentence_end - sentence_start;
+
+		if (strncasecmp(line, "Content-Length:", 15) == 0) {
+			content_len = HTTP_ATOI(line + 15);
+			if (content_len < 0) {
+				return HTTP_ERROR;
+			}
+		} else if (strncasecmp(line, "Transfer-Encoding:", 18) == 0) {
+			chunked = http_event_has_token(line, line_len, "chunked");
+		} else if (strncasecmp(line, "Connection:", 11) == 0) {
+			if (http_event_has_token(line, line_len, "close")) {
+				*keep_alive = 0;
+			} else if (http_event_has_token(line, line_len, "keep-alive")) {
+				*keep_alive = 1;
+			}
+		}
+		sentence_start = sentence_end + 2;
+	}
+
+	if (sentence_end == sentence_start) {
+		header_len = sentence_end + 2;
+	}
+
+	if (header_len < 0) {
+		return (buf_len >= HTTP_CONF_MAX_REQUEST_LENGTH) ? HTTP_ERROR : 0;
+	}
+
+	if (chunked) {
+		req_len = http_event_chunked_len(buf, buf_len, header_len);
+		if (req_len == 0 && buf_len >= HTTP_CONF_MAX_REQUEST_LENGTH) {
+			return HTTP_ERROR;
+		}
+		return req_len;
+	}
+
+	req_len = header_len + content_len;
+	if (req_len > HTTP_CONF_MAX_REQUEST_LENGTH) {
+		return HTTP_ERROR;
+	}
+
+	return (buf_len >= req_len) ? req_len : 0;
+}
+
+/*
+ * Request handling
+ */
+
+static int http_event_handle_request(struct http_event_conn_t *conn, char *buf, int buf_len)
+{
+	struct http_client_t *client = conn->client;
+	struct http_keyvalue_list_t request_params;
+	struct http_req_message req = {0, };
+	struct http_message_len_t mlen = {0, };
+	char url[HTTP_CONF_MAX_REQUEST_HEADER_URL_LENGTH] = { 0, };
+	int method = HTTP_METHOD_UNKNOWN;
+	int enc = HTTP_CONTENT_LENGTH;
+	int state = HTTP_REQUEST_HEADER;
+	int chunk_processed = 0;
+	char *body = NULL;
+	int read_finish;
+	int ret = HTTP_ERROR;
+
+	client->ws_state = 0;
+
+	if (http_keyvalue_list_init(&request_params) != HTTP_OK) {
+		return HTTP_ERROR;
+	}
+
+	req.req_msg = buf;
+	req.url = url;
+	req.headers = &request_params;
+	req.client_ip = conn->client_ip;
+	req.encoding = HTTP_CONTENT_LENGTH;
+
+	/* The whole request is in buf, so it is parsed in one go */
+
+	read_finish = http_parse_message(buf, buf_len, &method, url, &body, &enc, &state, &mlen, &request_params, client, NULL, &req, &chunk_processed);
+	if (read_finish == true && method != HTTP_METHOD_UNKNOWN) {
+		if (enc == HTTP_CONTENT_LENGTH) {
+			req.entity = body;
+			http_dispatch_url(client, &req);
+		}
+		ret = HTTP_OK;
+	}
+
+	if (enc == HTTP_CHUNKED_ENCODING) {
+		HTTP_FREE(body);
+	}
+	http_keyvalue_list_release(&request_params);
+
+	return ret;
+}
+
+#ifdef CONFIG_NETUTILS_WEBSOCKET
+static int http_event_set_blocking(struct http_client_t *client)
+{
+	int flags;
+
+	flags = fcntl(client->client_fd, F_GETFL, 0);
+	if (flags < 0 || fcntl(client->client_fd, F_SETFL, flags & ~O_NONBLOCK) < 0) {
+		HTTP_LOGE("Error: Fail to set blocking client socket\n");
+		return HTTP_ERROR;
+	}
+	client->nonblock = 0;
+
+	return HTTP_OK;
+}
+#endif
+
+/*
+ * Serve all complete requests in the buffer of conn.
+ * Returns HTTP_OK to keep the connection, HTTP_EVENT_CLOSE or HTTP_ERROR
+ * to close it.
+ */
+static int http_event_serve(struct http_event_conn_t *conn)
+{
+	struct http_client_t *client = conn->client;
+	int req_len = 0;
+	int keep_alive = 0;
+	char next;
+	int ret;
+
+	/* The next request waits until the queued response is sent */
+
+	while (!http_client_pending(client) && (req_len = http_event_frame_request(conn->buf, conn->buf_len, &keep_alive)) > 0) {
+		/* The response of the callback tells the client whether we keep the connection */
+
+		client->keep_alive = keep_alive && client->remaining_request > 1;
+
+		/* The parser terminates the request, keep the first byte of the next one */
+
+		next = conn->buf[req_len];
+		ret = http_event_handle_request(conn, conn->buf, req_len);
+		conn->buf[req_len] = next;
+
+		conn->buf_len -= req_len;
+		memmove(conn->buf, conn->buf + req_len, conn->buf_len);
+
+		if (ret != HTTP_OK) {
+			return HTTP_ERROR;
+		}
+
+#ifdef CONFIG_NETUTILS_WEBSOCKET
+		if (client->ws_state >= MIN_WS_HEADER_FIELD) {
+			/* The websocket thread uses a blocking socket, send the rest of
+			 * the handshake response before handing it over
+			 */
+			if (http_event_set_blocking(client) != HTTP_OK || http_client_flush(client) != HTTP_OK) {
+				return HTTP_ERROR;
+			}
+			if (http_client_upgrade_websocket(client) != HTTP_OK) {
+				return HTTP_ERROR;
+			}
+			conn->ws_upgraded = 1;
+			return HTTP_EVENT_CLOSE;
+		}
+#endif
+		client->remaining_request--;
+		if (!client->keep_alive) {
+			return HTTP_EVENT_CLOSE;
+		}
+	}
+
+	if (req_len < 0) {
+		HTTP_LOGE("Error: Request size is too large!!\n");
+		http_send_response(client, 413, "Payload Too Large\r\n", NULL);
+		return HTTP_ERROR;
+	}
+
+	return HTTP_OK;
+}
+
+/*
+ * Connection table of an event loop
+ */
+
+static void http_event_close(struct http_event_conn_t *conn)
+{
+	/* The websocket thread owns the socket after an upgrade */
+
+	if (!conn->ws_upgraded) {
+		close(conn->client->client_fd);
+	}
+
+	HTTP_LOGD("Release client %d\n", conn->client->client_fd);
+	http_client_discard(conn->client);
+	http_client_release(conn->client);
+	if (conn->buf) {
+		HTTP_FREE(conn->buf);
+	}
+	HTTP_MEMSET(conn, 0, sizeof(struct http_event_conn_t));
+}
+
+static void http_event_accept(struct http_server_t *server, struct http_event_conn_t *conns)
+{
+	struct sockaddr_in client_addr;
+	socklen_t addrlen = sizeof(struct sockaddr_in);
+	int nodelay = 1;
+	int sock_fd;
+	int flags;
+	int i;
+
+	/* Another event loop may have taken the connection already */
+
+	sock_fd = accept(server->listen_fd, (struct sockaddr *)&client_addr, &addrlen);
+	if (sock_fd < 0) {
+		if (errno != EWOULDBLOCK && errno != EAGAIN) {
+			HTTP_LOGE("Error: Accept client error!!\n");
+		}
+		return;
+	}
+
+	for (i = 0; i < HTTP_EVENT_MAX_CONN; i++) {
+		if (conns[i].client == NULL) {
+			break;
+		}
+	}
+
+	if (i == HTTP_EVENT_MAX_CONN || (conns[i].client = http_client_init(server, sock_fd)) == NULL) {
+		HTTP_LOGE("Error: Cannot init client!!\n");
+		close(sock_fd);
+		return;
+	}
+
+	/* A client which does not read its responses must not block the loop */
+
+	flags = fcntl(sock_fd, F_GETFL, 0);
+	if (flags < 0 || fcntl(sock_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+		HTTP_LOGE("Error: Fail to set non-blocking client socket\n");
+		http_client_release(conns[i].client);
+		conns[i].client = NULL;
+		close(sock_fd);
+		return;
+	}
+	conns[i].client->nonblock = 1;
+
+	/* Pipelined responses are sent back to back, do not hold them for the ACKs */
+
+	setsockopt(sock_fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+	conns[i].client_ip = client_addr.sin_addr.s_addr;
+	conns[i].last_active = time(NULL);
+	HTTP_LOGD("Client %d is accepted\n", sock_fd);
+}
+
+static int http_event_process(struct http_event_conn_t *conn)
+{
+	int ret;
+
+	if (conn->buf == NULL) {
+		return HTTP_OK;
+	}
+
+	ret = http_event_serve(conn);
+	if (ret == HTTP_EVENT_CLOSE && http_client_pending(conn->client)) {
+		/* Close once the rest of the response is sent */
+
+		conn->closing = 1;
+		return HTTP_OK;
+	}
+
+	if (ret != HTTP_OK) {
+		return ret;
+	}
+
+	if (conn->buf_len == 0) {
+		HTTP_FREE(conn->buf);
+		conn->buf = NULL;
+	}
+
+	return HTTP_OK;
+}
+
+static int http_event_read(struct http_event_conn_t *conn)
+{
+	int len;
+
+	if (conn->buf == NULL) {
+		/* One more byte for the terminator the parser puts after the request */
+		conn->buf = HTTP_MALLOC(HTTP_CONF_MAX_REQUEST_LENGTH + 1);
+		if (conn->buf == NULL) {
+			HTTP_LOGE("Error: Fail to malloc buf\n");
+			return HTTP_ERROR;
+		}
+	}
+
+	len = recv(conn->client->client_fd, conn->buf + conn->buf_len, HTTP_CONF_MAX_REQUEST_LENGTH - conn->buf_len, 0);
+	if (len <= 0) {
+		HTTP_LOGD("Client %d finished %d\n", conn->client->client_fd, len);
+		return HTTP_ERROR;
+	}
+
+	conn->buf_len += len;
+	conn->last_active = time(NULL);
+
+	return http_event_process(conn);
+}
+
+static int http_event_write(struct http_event_conn_t *conn)
+{
+	if (http_client_flush(conn->client) != HTTP_OK) {
+		HTTP_LOGD("Client %d failed to receive the response\n", conn->client->client_fd);
+		return HTTP_ERROR;
+	}
+	conn->last_active = time(NULL);
+
+	if (http_client_pending(conn->client)) {
+		return HTTP_OK;
+	}
+
+	if (conn->closing) {
+		return HTTP_EVENT_CLOSE;
+	}
+
+	/* Serve the requests which waited for the response */
+
+	return http_event_process(conn);
+}
+
+static pthread_addr_t http_event_loop(pthread_addr_t arg)
+{
+	struct http_server_t *server = (struct http_server_t *)arg;
+	struct http_event_conn_t conns[HTTP_EVENT_MAX_CONN];
+	struct timeval tv;
+	fd_set readfds;
+	fd_set writefds;
+	time_t now;
+	int nconn;
+	int maxfd;
+	int ret;
+	int i;
+
+	HTTP_MEMSET(conns, 0, sizeof(conns));
+
+	while (server->state == HTTP_SERVER_RUN) {
+		FD_ZERO(&readfds);
+		FD_ZERO(&writefds);
+		maxfd = -1;
+		nconn = 0;
+
+		for (i = 0; i < HTTP_EVENT_MAX_CONN; i++) {
+			if (conns[i].client) {
+				/* Nothing more is read from a client until it took its response */
+
+				if (http_client_pending(conns[i].client)) {
+					FD_SET(conns[i].client->client_fd, &writefds);
+				} else {
+					FD_SET(conns[i].client->client_fd, &readfds);
+				}
+				if (conns[i].client->client_fd > maxfd) {
+					maxfd = conns[i].client->client_fd;
+				}
+				nconn++;
+			}
+		}
+
+		/* Leave new connections to the other loops while this one is full */
+
+		if (nconn < HTTP_EVENT_MAX_CONN) {
+			FD_SET(server->listen_fd, &readfds);
+			if (server->listen_fd > maxfd) {
+				maxfd = server->listen_fd;
+			}
+		}
+
+		tv.tv_sec = 0;
+		tv.tv_usec = HTTP_EVENT_POLL_MS * 1000;
+		ret = select(maxfd + 1, &readfds, &writefds, NULL, &tv);
+		if (ret < 0) {
+			if (errno != EINTR) {
+				HTTP_LOGE("Error: select fail errno:[%d]\n", errno);
+				usleep(HTTP_EVENT_POLL_MS * 1000);
+			}
+			continue;
+		}
+
+		now = time(NULL);
+		for (i = 0; i < HTTP_EVENT_MAX_CONN; i++) {
+			if (conns[i].client == NULL) {
+				continue;
+			}
+
+			if (ret > 0 && FD_ISSET(conns[i].client->client_fd, &writefds)) {
+				if (http_event_write(&conns[i]) != HTTP_OK) {
+					http_event_close(&conns[i]);
+				}
+			} else if (ret > 0 && FD_ISSET(conns[i].client->client_fd, &readfds)) {
+				if (http_event_read(&conns[i]) != HTTP_OK) {
+					http_event_close(&conns[i]);
+				}
+			} else if (now - conns[i].last_active > conns[i].client->keep_alive_timeout) {
+				HTTP_LOGD("Client %d timed out\n", conns[i].client->client_fd);
+				http_event_close(&conns[i]);
+			}
+		}
+
+		if (ret > 0 && FD_ISSET(server->listen_fd, &readfds)) {
+			http_event_accept(server, conns);
+		}
+	}
+
+	for (i = 0; i < HTTP_EVENT_MAX_CONN; i++) {
+		if (conns[i].client) {
+			http_event_close(&conns[i]);
+		}
+	}
+
+	return NULL;
+}
+
+static pthread_addr_t http_event_handler(pthread_addr_t arg)
+{
+	struct http_server_t *server = (struct http_server_t *)arg;
+	pthread_attr_t attr;
+	int flags;
+	int nloop;
+
+	if (http_server_listen(server) != HTTP_OK) {
+		server->state = HTTP_SERVER_STOP;
+		return NULL;
+	}
+
+	/* The loops race for new connections, the losers must not block in accept */
+
+	flags = fcntl(server->listen_fd, F_GETFL, 0);
+	if (flags < 0 || fcntl(server->listen_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+		HTTP_LOGE("Error: Fail to set non-blocking listen socket\n");
+	}
+
+	server->state = HTTP_SERVER_RUN;
+	HTTP_LOGD("Accepting connections on port %d began.\n", server->port);
+
+	/* This thread is the first event loop, c_tid holds the others */
+
+	for (nloop = 1; nloop < HTTP_CONF_MAX_CLIENT_HANDLE; nloop++) {
+		if (pthread_attr_init(&attr) != 0) {
+			HTTP_LOGE("Error: Cannot initialize thread attribute\n");
+			break;
+		}
+		pthread_attr_setschedpolicy(&attr, SCHED_RR);
+		pthread_attr_setstacksize(&attr, HTTP_EVENT_LOOP_STACKSIZE);
+		if (pthread_create(&server->c_tid[nloop - 1], &attr, http_event_loop, (void *)server) != 0) {
+			HTTP_LOGE("Error: Cannot create event loop thread!!\n");
+			break;
+		}
+		pthread_setname_np(server->c_tid[nloop - 1], "webserver event loop");
+	}
+
+	http_event_loop(server);
+
+	while (--nloop > 0) {
+		pthread_join(server->c_tid[nloop - 1], NULL);
+	}
+
+	HTTP_LOGD("http_event_handler stop :%d\n", server->port);
+	server->state = HTTP_SERVER_STOP;
+	return NULL;
+}
+
+int http_server_event_start(struct http_server_t *server)
+{
+	pthread_attr_t attr;
+
+	if (pthread_attr_init(&attr) != 0) {
+		HTTP_LOGE("Error: Cannot initialize ptread attribute\n");
+		return HTTP_ERROR;
+	}
+	pthread_attr_setschedpolicy(&attr, SCHED_RR);
+	pthread_attr_setstacksize(&attr, HTTP_EVENT_LOOP_STACKSIZE);
+
+	if (pthread_create(&server->tid, &attr, http_event_handler, (void *)server) != 0) {
+		HTTP_LOGE("Error: Cannot create server thread!!\n");
+		return HTTP_ERROR;
+	}
+	pthread_setname_np(server->tid, "webserver event loop");
+	pthread_detach(server->tid);
+
+	return HTTP_OK;
+}
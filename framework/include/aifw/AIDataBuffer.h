@@ -27,11 +27,12 @@
 namespace aifw {
 
 class AIModel;
-class AIDataBufferNode;
 
 /**
  * @class AIDataBuffer
- * @brief This class creates a doubly linked list and provides API to perform operations on that list.
+ * @brief This class keeps rows of data in a contiguous ring buffer and provides API to perform operations on it.
+ * Every row is stored twice, at its slot and at slot + max rows, so that any run of consecutive rows can be read
+ * from a single contiguous memory area without copying.
  */
 class AIDataBuffer
 {
@@ -64,6 +65,18 @@ public:
 	 */
 	AIFW_RESULT readData(float *buffer, uint16_t startCol, uint16_t endCol, uint16_t row);
 
+	/**
+	 * @brief Gives a window of consecutive rows without copying them.
+	 * Rows in the window are stored one after the other with getRowSize() values each, starting from row and
+	 * going to older rows. Window can be passed directly as model input. It is valid until the next write or
+	 * clear operation on the buffer.
+	 * @param [out] window: Pointer to the first value of row.
+	 * @param [in] row: Index of first row of the window, 0 being latest row.
+	 * @param [in] count: Number of rows in the window.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT getWindow(const float **window, uint16_t row, uint16_t count);
+
 	/**
 	 * @brief Gives number of filled rows in the streaming buffer.
 	 * @return: Negative value indicates an error. Non negative value tells number of filled rows in buffer.
@@ -71,13 +84,19 @@ public:
 	uint16_t getRowCount();
 
 	/**
-	 * @brief Marks all nodes empty and sets number of filled nodes to 0 in AIDataBuffer
+	 * @brief Gives number of values in a single row of the streaming buffer.
+	 * @return: Number of values in a row.
+	 */
+	uint16_t getRowSize();
+
+	/**
+	 * @brief Marks all rows empty and sets number of filled rows to 0 in AIDataBuffer
 	 * @return: AIFW_RESULT enum object.
 	 */
 	AIFW_RESULT clear(void);
 
 	/**
-	 * @brief Marks specific nodes empty, move them to the end of AIDataBuffer, and decrement number of filled nodes in AIDataBuffer
+	 * @brief Marks specific rows empty, move them to the end of AIDataBuffer, and decrement number of filled rows in AIDataBuffer
 	 * @param [IN] offset: Offset of row to start clearing.
 	 * @param [IN] count: Count of rows to clear.
 	 * @return: AIFW_RESULT enum object.
@@ -87,16 +106,17 @@ public:
 	friend class AIModel;
 private:
 	/**
-	 * @brief Creates a doubly linked list with node count equal to row and node size equal to size.
-	 * @param [in] row: Number of rows/nodes needed in streaming buffer.
-	 * @param [in] size: Number of values in a single row/node.
+	 * @brief Allocates the ring buffer with row count equal to row and row size equal to size.
+	 * @param [in] row: Number of rows needed in streaming buffer.
+	 * @param [in] size: Number of values in a single row.
 	 * @return: AIFW_RESULT enum object. Before returning any error, it releases all the memory allocated.
 	 */
 	AIFW_RESULT init(uint16_t row, uint16_t size);
 
 	/**
 	 * @brief Modifies the streaming buffer.
-	 * It compares row and size with previous set value of row and size and according to that it modifies the existing nodes or create more nodes or both.
+	 * It compares row and size with previous set value of row and size and according to that it reallocates the ring buffer.
+	 * Filled rows are kept, truncated or zero padded to the new row size.
 	 * @param [in] row: Number of rows needed in the streaming buffer.
 	 * @param [in] size: Number of values in a single row.
 	 * @return: AIFW_RESULT enum object. In case of any error, previously allocated memory is not released.
@@ -105,13 +125,13 @@ private:
 
 	/**
 	 * @brief Deinitializes the streaming buffer.
-	 * It clears the memory allocated to doubly linked list and resets class member variables.
+	 * It frees the memory allocated to the ring buffer and resets class member variables.
 	 */
 	void deinit(void);
 
 	/**
 	 * @brief Writes a row into streaming buffer.
-	 * Last node is detached and attached at the starting of the linked list. Values are then written in that node.
+	 * Oldest row is reused as the latest row, 0th index row. Values are then written in that row.
 	 * @param [in] buffer: Input buffer from which data values are copied.
 	 * @param [in] size: Number of values in input buffer.
 	 * @return: AIFW_RESULT enum object.
@@ -135,21 +155,31 @@ private:
 	AIFW_RESULT deleteData(uint16_t row);
 
 	/**
-	 * @brief Clears the memory allocated to the list with head pointer equal to ptr.
-	 * @param [in] ptr: Pointer to the head of list.
+	 * @brief Gives address of a row in the ring buffer.
+	 * @param [in] row: Index of row, 0 being latest row.
+	 * @return: Pointer to the first value of row.
 	 */
-	void clearMemory(AIDataBufferNode *ptr);
+	float *getRowAddress(uint16_t row);
 
 	/**
-	 * @brief Insert count number of nodes in a doubly linked list.
-	 * @param [in] count: Number of nodes in the list.
-	 * @param [in] size: Number of values in a single node.
-	 * @return: AIFW_RESULT enum object.
+	 * @brief Copies values into a row and its mirror.
+	 * @param [in] row: Index of row, 0 being latest row.
+	 * @param [in] buffer: Input buffer from which data values are copied. NULL fills the values with zero.
+	 * @param [in] size: Number of values to copy.
+	 * @param [in] offset: Column from which copying values will start.
+	 */
+	void copyRow(uint16_t row, const float *buffer, uint16_t size, uint16_t offset);
+
+	/**
+	 * @brief Removes count rows starting from row offset and moves them to the end of the filled rows as empty rows.
+	 * Rows on the shorter side of the removed rows are moved to fill the gap.
+	 * @param [in] offset: Index of first row to remove.
+	 * @param [in] count: Number of rows to remove.
 	 */
-	AIFW_RESULT createList(uint16_t count, uint16_t size);
+	void removeRows(uint16_t offset, uint16_t count);
 
-	AIDataBufferNode *mStart;
-	AIDataBufferNode *mEnd;
+	float *mData;
+	uint16_t mHead;
 	uint16_t mMaxRows;
 	uint16_t mRowSize;
 	uint16_t mRowCount;
@@ -127,6 +127,18 @@ public:
 	 */
 	uint32_t getModelCode(void);
 
+	/**
+	 * @brief Gives time spent in pre-processing, engine invoke, and post-processing stages of model invokes.
+	 * @param [out] stageTime: Pointer to AIModelStageTime structure to fill.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT getStageTime(AIModelStageTime *stageTime);
+
+	/**
+	 * @brief Resets the time measured for each stage of model invokes.
+	 */
+	void resetStageTime(void);
+
 private:
 	/**
 	 * @brief It constructs AIDataBuffer object and initializes it.
@@ -140,6 +152,18 @@ private:
 	 */
 	AIFW_RESULT invoke(void);
 
+	/**
+	 * @brief It binds model input buffers to input tensors of engine and fills them by pre-processing or by reading latest row of AIDataBuffer.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT fillInvokeInput(void);
+
+	/**
+	 * @brief It binds model output buffers to output tensors of engine and writes them into latest row of AIDataBuffer.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT writeInvokeOutput(void);
+
 	/**
 	 * @brief It loads manifest information from file specified by scriptPath and fills it into mModelAttribute's member variables.
 	 * @param [in] path: Manifest file path.
@@ -174,7 +198,6 @@ private:
 #else
 	float **mInvokeInput;
 	float **mInvokeOutput;
-	float **mInvokeResult;
 	uint16_t *mInputSizeList;
 	uint16_t *mOutputSizeList;
 	uint16_t mInputSetCount;
@@ -184,6 +207,7 @@ private:
 	float *mParsedData;
 	float *mPostProcessedData;
 	std::shared_ptr<AIProcessHandler> mDataProcessor;
+	AIModelStageTime mStageTime;
 };
 
 } /* namespace aifw */
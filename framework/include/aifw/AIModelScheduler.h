@@ -0,0 +1,147 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/**
+ * @file aifw/AIModelScheduler.h
+ * @brief AIModelScheduler class runs model services from one pool of worker threads.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <stdint.h>
+#include "aifw/aifw.h"
+
+namespace aifw {
+
+class AIModelService;
+
+/**
+ * @class AIModelScheduler
+ * @brief AIModelScheduler class releases model services at their intervals and runs them from one pool of worker threads.
+ * Released services run in order of priority, and services of same priority run in order of deadline.
+ * A service is added by AIModelService::setScheduler instead of using its own timer.
+ */
+class AIModelScheduler
+{
+public:
+	/**
+	 * @brief Construct the AIModelScheduler class instance.
+	 * @param [in] workerCount: Number of worker threads which run model services.
+	 */
+	AIModelScheduler(uint16_t workerCount);
+
+	/**
+	 * @brief AIModelScheduler destructor. It stops the scheduler and removes all services.
+	 */
+	~AIModelScheduler();
+
+	/**
+	 * @brief Creates dispatcher and worker threads.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT start(void);
+
+	/**
+	 * @brief Stops and joins dispatcher and worker threads. Running services are completed first.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT stop(void);
+
+	/**
+	 * @brief Gives scheduling statistics of a service.
+	 * @param [in] service: Model service added to the scheduler.
+	 * @param [out] stats: Pointer to AIModelScheduleStats structure to fill.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT getStats(AIModelService *service, AIModelScheduleStats *stats);
+
+	friend class AIModelService;
+
+private:
+	/**
+	 * @struct ScheduleEntry
+	 * @brief Scheduling state of a service. Times are absolute in microseconds.
+	 */
+	struct ScheduleEntry {
+		AIModelService *service;
+		uint8_t priority;
+		uint16_t interval;
+		uint16_t deadline;
+		bool enabled;
+		bool pending;
+		bool running;
+		uint64_t nextRelease;
+		uint64_t release;
+		uint64_t absDeadline;
+		AIModelScheduleStats stats;
+		ScheduleEntry *next;
+	};
+
+	/**
+	 * @brief Adds a service in disabled state.
+	 * @param [in] service: Model service to add.
+	 * @param [in] priority: Priority of service, higher value runs first.
+	 * @param [in] deadline: Time in msec from release by which a run should complete. 0 means the interval.
+	 * @param [in] interval: Interval in msec at which service is released.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT addService(AIModelService *service, uint8_t priority, uint16_t deadline, uint16_t interval);
+
+	/**
+	 * @brief Removes a service after its running job, if any, is completed. It must not be called from a service callback.
+	 * @param [in] service: Model service to remove.
+	 */
+	void removeService(AIModelService *service);
+
+	/**
+	 * @brief Enables or disables releases of a service. Disabling drops a release which is not run yet.
+	 * @param [in] service: Model service added to the scheduler.
+	 * @param [in] enable: true to enable, false to disable.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT enableService(AIModelService *service, bool enable);
+
+	/**
+	 * @brief Changes release interval of a service. The next release is moved to one new interval after the previous one.
+	 * @param [in] service: Model service added to the scheduler.
+	 * @param [in] interval: Interval in msec.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT setInterval(AIModelService *service, uint16_t interval);
+
+	ScheduleEntry *findEntry(AIModelService *service);
+	ScheduleEntry *pickEntry(void);
+	void dispatch(void);
+	void work(void);
+	static void *dispatcherThread(void *arg);
+	static void *workerThread(void *arg);
+
+	uint16_t mWorkerCount;
+	bool mRunning;
+	ScheduleEntry *mEntries;
+	pthread_t mDispatcher;
+	pthread_t *mWorkers;
+	pthread_mutex_t mControlLock;
+	pthread_mutex_t mLock;
+	pthread_cond_t mTimerCond;
+	pthread_cond_t mJobCond;
+	pthread_cond_t mDoneCond;
+};
+
+} /* namespace aifw */
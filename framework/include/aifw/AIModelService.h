@@ -18,7 +18,7 @@
 
 /**
  * @file aifw/AIModelService.h
- * @brief AIModelService class uses TizenRT software timer to invoke data request at a set interval.
+ * @brief AIModelService class uses TizenRT software timer or AIModelScheduler to invoke data request at a set interval.
  */
 
 #pragma once
@@ -30,9 +30,12 @@
 
 namespace aifw {
 
+class AIModelScheduler;
+
 /**
  * @class AIModelService
  * @brief AIModelService class uses TizenRT software timer to invoke data request at a set interval.
+ * If a scheduler is set, the scheduler invokes data request instead of the timer.
  */
 class AIModelService
 {
@@ -59,6 +62,23 @@ public:
 	 */
 	AIFW_RESULT setInterval(uint16_t interval);
 
+	/**
+	 * @brief Makes scheduler invoke data request of this service instead of own timer.
+	 * It should be called before prepare API.
+	 * @param [in] scheduler: Scheduler shared by model services.
+	 * @param [in] priority: Priority of this service in scheduler, higher value runs first.
+	 * @param [in] deadline: Time in msec from each interval by which data request should complete. 0 means the interval.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT setScheduler(std::shared_ptr<AIModelScheduler> scheduler, uint8_t priority, uint16_t deadline);
+
+	/**
+	 * @brief Gives latency and deadline miss statistics of this service from scheduler.
+	 * @param [out] stats: Pointer to AIModelScheduleStats structure to fill.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT getScheduleStats(AIModelScheduleStats *stats);
+
 	/**
 	 * @brief mInterval > 0 : It starts the timer as per mInterval which is set in prepare API.
 	 * 		  After this, application will start recieving data collection callback after time interval specified by mInterval.
@@ -87,6 +107,7 @@ public:
 	 * @brief It calls prepare function of AIInferenceHandler which attaches data processing logic(if required) in each model and loads the models.
 	 * It then retrieves inference interval of model set from AIInferenceHandler.
 	 * If inference interval > 0, it allocate memory to timer structure and create/initialize the timer. It does not start the timer.
+	 * If scheduler is set, it adds this service to the scheduler instead of creating the timer.
 	 * @return: AIFW_RESULT enum object.
 	 */
 	AIFW_RESULT prepare(void);
@@ -130,6 +151,10 @@ private:
 	std::shared_ptr<AIInferenceHandler> mInferenceHandler;
 	CollectRawDataListener mCollectRawDataCallback;
 	aifw_timer *mTimer;
+	std::shared_ptr<AIModelScheduler> mScheduler;
+	uint8_t mPriority;
+	uint16_t mDeadline;
+	bool mScheduled;
 };
 
 } /* namespace aifw */
@@ -113,6 +113,44 @@ struct AIModelAttribute {
 	float *stdVals;
 };
 
+/**
+ * @brief This structure gives time spent in each stage of model invoke. Times are in microseconds.
+ * invokeCount: Number of invokes measured
+ * preProcessTime: Total time to fill model input, by preprocessing or by reading AI data buffer
+ * engineTime: Total time of inference in AI engine
+ * postProcessTime: Total time to write model output in AI data buffer and to postprocess it
+ * lastPreProcessTime: Time to fill model input in the latest invoke
+ * lastEngineTime: Time of inference in AI engine in the latest invoke
+ * lastPostProcessTime: Time to write and postprocess model output in the latest invoke
+ */
+struct AIModelStageTime {
+	uint32_t invokeCount;
+	uint64_t preProcessTime;
+	uint64_t engineTime;
+	uint64_t postProcessTime;
+	uint32_t lastPreProcessTime;
+	uint32_t lastEngineTime;
+	uint32_t lastPostProcessTime;
+};
+
+/**
+ * @brief This structure gives scheduling statistics of a model service run by AIModelScheduler. Times are in microseconds.
+ * runCount: Number of completed runs
+ * deadlineMissCount: Number of runs completed after their deadline
+ * skipCount: Number of releases skipped because the previous run was not completed yet
+ * lastLatency: Time from release to completion of the latest run
+ * maxLatency: Maximum time from release to completion of a run
+ * totalLatency: Total time from release to completion of all runs
+ */
+struct AIModelScheduleStats {
+	uint32_t runCount;
+	uint32_t deadlineMissCount;
+	uint32_t skipCount;
+	uint32_t lastLatency;
+	uint32_t maxLatency;
+	uint64_t totalLatency;
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -172,6 +172,9 @@ typedef struct _db_handle_s db_handle_t;
 struct _db_cursor_s;
 typedef struct _db_cursor_s db_cursor_t;
 
+struct db_stmt_s;
+typedef struct db_stmt_s db_stmt_t;
+
 typedef int db_storage_id_t;
 
 typedef uint32_t cursor_row_t;
@@ -180,6 +183,34 @@ typedef uint32_t tuple_id_t;
 
 typedef uint8_t attribute_id_t;
 
+/**
+ * @brief Statistics of the page buffer pool shared by all relations and indexes
+ */
+struct db_buffer_pool_stats_s {
+	uint32_t hits;				/* Page requests served from the pool */
+	uint32_t misses;			/* Page requests which read the storage */
+	uint32_t evictions;			/* Pages evicted to make room for another page */
+	uint32_t writebacks;		/* Dirty pages written back to the storage */
+	uint32_t flushes;			/* Write back batches issued */
+	uint32_t npages;			/* Number of pages in the pool */
+	uint32_t dirty;				/* Number of dirty pages in the pool */
+};
+typedef struct db_buffer_pool_stats_s db_buffer_pool_stats_t;
+
+/**
+ * @brief A value of one attribute, used to insert tuples without AQL
+ */
+struct db_value_s {
+	union {
+		int int_value;
+		long long_value;
+		double double_value;
+		unsigned char *string_value;
+	} u;
+	domain_t domain;
+};
+typedef struct db_value_s db_value_t;
+
 /****************************************************************************
 * Public Variables
 ****************************************************************************/
@@ -211,6 +242,27 @@ db_result_t db_init(void);
 */
 db_result_t db_deinit(void);
 
+/**
+* @brief change the number of pages in the buffer pool, dirty pages are written back first
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[in] npages number of pages, each page is CONFIG_ARASTORAGE_BUFFER_PAGE_SIZE bytes
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_set_buffer_pool_size(unsigned int npages);
+
+/**
+* @brief get hit, miss and write back counters of the buffer pool
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[out] stats pointer to the statistics to be filled
+* @param[in] reset if true, counters are cleared after being read
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_get_buffer_pool_stats(db_buffer_pool_stats_t *stats, bool reset);
+
 /**
 * @brief create or remove relations, attributes and indexes in arastorage
 *
@@ -222,6 +274,20 @@ db_result_t db_deinit(void);
 */
 db_result_t db_exec(char *format);
 
+/**
+* @brief insert many tuples into a relation at once, without parsing AQL statements
+*
+* @details @b #include <arastorage/arastorage.h>
+* Tuples are appended to the relation in large writes and the indexes of
+* the relation are updated once from the sorted keys.
+* @param[in] relation_name name of the relation
+* @param[in] values nrows tuples, each with one value for every attribute in attribute order
+* @param[in] nrows number of tuples
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_bulk_insert(char *relation_name, db_value_t *values, tuple_id_t nrows);
+
 /**
 * @brief process query of arastorage
 *
@@ -232,6 +298,76 @@ db_result_t db_exec(char *format);
 */
 db_cursor_t *db_query(char *format);
 
+/**
+* @brief parse a query sentence once so that it can be run many times
+*
+* @details @b #include <arastorage/arastorage.h>
+* A '?' can be used instead of a value in INSERT and instead of a number
+* in a WHERE clause. Parameters are numbered from 0 in the order they appear
+* and must be bound before the statement is run.
+* @param[in] format query sentence
+* @return On success, a pointer to db_stmt_t is returned. On failure, a NULL is returned.
+* @since TizenRT v3.1
+*/
+db_stmt_t *db_prepare(char *format);
+
+/**
+* @brief bind an integer value to a parameter of a prepared statement
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[in] stmt prepared statement
+* @param[in] index index of the parameter
+* @param[in] value value of the parameter
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_bind_int(db_stmt_t *stmt, int index, long value);
+
+/**
+* @brief bind a string value to a parameter of a prepared statement
+*
+* @details @b #include <arastorage/arastorage.h>
+* The string is copied. Strings can't be bound to a parameter in a WHERE clause,
+* DB_ARGUMENT_ERROR is returned for those.
+* @param[in] stmt prepared statement
+* @param[in] index index of the parameter
+* @param[in] value value of the parameter
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_bind_string(db_stmt_t *stmt, int index, char *value);
+
+/**
+* @brief run a prepared statement which is not a query with the bound values
+*
+* @details @b #include <arastorage/arastorage.h>
+* Bound values are kept, so only the changed ones need to be bound again.
+* @param[in] stmt prepared statement
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_step(db_stmt_t *stmt);
+
+/**
+* @brief run a prepared query with the bound values
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[in] stmt prepared statement
+* @return On success, a pointer to db_cursor_t is returned. On failure, a NULL is returned.
+* @since TizenRT v3.1
+*/
+db_cursor_t *db_step_query(db_stmt_t *stmt);
+
+/**
+* @brief free a prepared statement and its bound values
+*
+* @details @b #include <arastorage/arastorage.h>
+* @param[in] stmt prepared statement
+* @return On success, DB_OK is returned. On failure, a negative value is returned.
+* @since TizenRT v3.1
+*/
+db_result_t db_finalize(db_stmt_t *stmt);
+
 /**
 * @brief free allocated cursor data, it should be called before application terminated
 *
@@ -29,9 +29,29 @@
 #ifndef __UI_CORE_H__
 #define __UI_CORE_H__
 
+#include <tinyara/config.h>
 #include <araui/ui_commons.h>
 #include <araui/ui_widget.h>
 
+#if defined(CONFIG_UI_FRAME_STATS)
+/**
+ * @brief Statistics of the frames which redrew some area of the screen.
+ * Frames without any damaged area are not counted.
+ *
+ * @see ui_get_frame_stats()
+ */
+typedef struct {
+	uint32_t frame_count;       //!< Number of redrawn frames
+	uint32_t last_frame_time;   //!< Time to process and redraw the last frame in microseconds
+	uint32_t max_frame_time;    //!< Maximum frame time in microseconds
+	uint64_t total_frame_time;  //!< Sum of frame times in microseconds
+	uint32_t last_redraw_area;  //!< Area of redrawn region of the last frame in pixels
+	uint64_t total_redraw_area; //!< Sum of redrawn areas in pixels
+	uint32_t last_pixel_count;  //!< Number of pixels drawn by widgets in the last frame
+	uint64_t total_pixel_count; //!< Sum of pixels drawn by widgets
+} ui_frame_stats_t;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -91,6 +111,25 @@ ui_error_t ui_core_quick_panel_appear(ui_quick_panel_event_type_t event_type);
  */
 ui_error_t ui_core_quick_panel_disappear(ui_quick_panel_event_type_t event_type);
 
+#if defined(CONFIG_UI_FRAME_STATS)
+/**
+ * @brief Get the statistics of the redrawn frames.
+ *
+ * @param[out] stats Pointer to the structure to fill.
+ * @return On success, UI_OK is returned. On failure, the defined error type is returned.
+ *
+ * @see ui_reset_frame_stats()
+ */
+ui_error_t ui_get_frame_stats(ui_frame_stats_t *stats);
+
+/**
+ * @brief Reset the statistics of the redrawn frames.
+ *
+ * @return On success, UI_OK is returned. On failure, the defined error type is returned.
+ */
+ui_error_t ui_reset_frame_stats(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -210,7 +210,11 @@ int eventloop_del_event_handler(el_event_t *handle);
  * @details @b #include <eventloop/eventloop.h> \n
  * This API is almost similar to task_manager_broadcast.\n
  * The event will be sent with some data to tasks which registed handler for this event.\n
- * And then registered callback functions will be executed when they are polling events.
+ * And then registered callback functions will be executed when they are polling events.\n
+ * Events sent to a task before its loop handles them are handled together in one wake-up, in the order they were sent.\n
+ * If CONFIG_EVENTLOOP_EVENT_COALESCE is enabled, an event which is not handled yet is replaced with the latest one of the same type.
+ * @remarks The data is copied once and shared by all handlers which receive it. \n
+ *          Handlers should NOT modify or free the received data.
  * @param[in] type a value of event type
  * @param[in] event_data data to be passed to registered handler together
  * @param[in] data_size size of data
@@ -67,6 +67,22 @@ struct msg_recv_buf_s {
 };
 typedef struct msg_recv_buf_s msg_recv_buf_t;
 
+/**
+ * @brief The handle of a message port opened by messaging_port_open
+ */
+typedef struct msg_port_s msg_port_t;
+
+/**
+ * @brief The message which receivers get when a shared buffer is sent by messaging_port_send_shared
+ * @details The receiver reads the data from the shared buffer directly,\n
+ * and calls messaging_shared_release when it does not use the buffer anymore.
+ */
+struct msg_shared_ref_s {
+	void *data;
+	int datalen;
+};
+typedef struct msg_shared_ref_s msg_shared_ref_t;
+
 /**
  * @brief Called when a message is received
  */
@@ -203,6 +219,71 @@ int messaging_recv_nonblock(const char *port_name, msg_recv_buf_t *recv_buf, msg
  */
 int messaging_cleanup(const char *port_name);
 
+/**
+ * @brief Open a message port for sending many messages.
+ * @details @b #include <messaging/messaging.h>\n
+ * The port keeps the message queues of the receivers open and reuses its packet buffer,\n
+ * so that messaging_port_send does not open, allocate and close them for every message.\n
+ * A port should be used by one task/pthread.
+ * @param[in] port_name The message port name to send.
+ * @return On success, the handle of the port is returned. On failure, NULL is returned.
+ * @since TizenRT v3.1
+ */
+msg_port_t *messaging_port_open(const char *port_name);
+/**
+ * @brief Send message without reply through the opened message port.
+ * @details @b #include <messaging/messaging.h>\n
+ * The message is sent to all receivers which wait the port.
+ * @param[in] port The handle of the port which was opened by messaging_port_open.
+ * @param[in] send_data\n
+ *		  msg          : The message to be sent.\n
+ *		  msglen       : The length of message to be sent.\n
+ *		  priority     : A non-negative integer that specifies the priority of this message.
+ * @return On success, the number of receivers who received the message is returned. On failure, ERROR is returned.
+ * @since TizenRT v3.1
+ */
+int messaging_port_send(msg_port_t *port, msg_send_data_t *send_data);
+/**
+ * @brief Send a shared buffer without copying it through the opened message port.
+ * @details @b #include <messaging/messaging.h>\n
+ * Receivers get msg_shared_ref_t as the message and each of them holds a reference of the buffer.\n
+ * The sender keeps its own reference and should call messaging_shared_release after sending.\n
+ * The receivers should run in the same address space as the sender.
+ * @param[in] port The handle of the port which was opened by messaging_port_open.
+ * @param[in] shared_buf The buffer allocated by messaging_shared_alloc.
+ * @param[in] datalen The length of data in the buffer.
+ * @param[in] priority A non-negative integer that specifies the priority of this message.
+ * @return On success, the number of receivers who received the buffer is returned. On failure, ERROR is returned.
+ * @since TizenRT v3.1
+ */
+int messaging_port_send_shared(msg_port_t *port, void *shared_buf, int datalen, int priority);
+/**
+ * @brief Close the message port opened by messaging_port_open.
+ * @details @b #include <messaging/messaging.h>\n
+ * @param[in] port The handle of the port.
+ * @return On success, OK is returned. On failure, ERROR is returned.
+ * @since TizenRT v3.1
+ */
+int messaging_port_close(msg_port_t *port);
+/**
+ * @brief Allocate a reference counted buffer for messaging_port_send_shared.
+ * @details @b #include <messaging/messaging.h>\n
+ * The caller holds one reference of the buffer.
+ * @param[in] size The size of buffer.
+ * @return On success, the buffer is returned. On failure, NULL is returned.
+ * @since TizenRT v3.1
+ */
+void *messaging_shared_alloc(int size);
+/**
+ * @brief Release a reference of the shared buffer.
+ * @details @b #include <messaging/messaging.h>\n
+ * The buffer is freed when the last reference is released.
+ * @param[in] shared_buf The buffer allocated by messaging_shared_alloc.
+ * @return None
+ * @since TizenRT v3.1
+ */
+void messaging_shared_release(void *shared_buf);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -18,7 +18,6 @@
 
 #include "aifw/aifw_log.h"
 #include "aifw/AIDataBuffer.h"
-#include "include/AIDataBufferNode.h"
 #define _UNLOCK                                    \
 	{                                              \
 		int status = pthread_mutex_unlock(&mLock); \
@@ -55,7 +54,7 @@
 namespace aifw {
 
 AIDataBuffer::AIDataBuffer() :
-	mStart(NULL), mEnd(NULL), mMaxRows(0), mRowSize(0), mRowCount(0), mLock(PTHREAD_MUTEX_INITIALIZER)
+	mData(NULL), mHead(0), mMaxRows(0), mRowSize(0), mRowCount(0), mLock(PTHREAD_MUTEX_INITIALIZER)
 {
 	AIFW_LOGV("AIDataBuffer Constructor");
 }
@@ -68,45 +67,54 @@ AIDataBuffer::~AIDataBuffer()
 
 AIFW_RESULT AIDataBuffer::init(uint16_t row, uint16_t size)
 {
+	if (row == 0 || size == 0) {
+		AIFW_LOGE("Invalid argument - row %d size %d", row, size);
+		return AIFW_INVALID_ARG;
+	}
 	_LOCK
-	AIFW_RESULT ret = createList(row, size);
-	if (ret == AIFW_OK) {
-		mMaxRows = row;
-		mRowSize = size;
+	/* Each row is stored twice, so that a window of rows never wraps around. */
+	float *data = (float *)calloc((size_t)2 * row * size, sizeof(float));
+	if (!data) {
+		AIFW_LOGE("buffer allocation failed with errno %d, error message: %s", errno, strerror(errno));
+		_UNLOCK
+		return AIFW_NO_MEM;
 	}
+	free(mData);
+	mData = data;
+	mHead = 0;
+	mMaxRows = row;
+	mRowSize = size;
+	mRowCount = 0;
 	_UNLOCK
-	return ret;
+	return AIFW_OK;
 }
 
 AIFW_RESULT AIDataBuffer::reinit(uint16_t row, uint16_t size)
 {
-	if (row == mMaxRows && size == mRowSize) {
+	uint16_t maxRows = (row > mMaxRows) ? row : mMaxRows;
+	if (maxRows == mMaxRows && size == mRowSize) {
 		return AIFW_OK;
 	}
-	_LOCK
-	if (size != mRowSize) {
-		AIDataBufferNode *tempNode = mStart;
-		float *tempPtr = nullptr;
-		while (tempNode) {
-			tempPtr = (float *)realloc(tempNode->mData, size * sizeof(float));
-			if (!tempPtr) {
-				AIFW_LOGE("node creation failed with errno %d, error message: %s", errno, strerror(errno));
-				_UNLOCK
-				return AIFW_NO_MEM;
-			}
-			tempNode->mData = tempPtr;
-			tempNode = tempNode->mNext;
-		}
+	if (size == 0) {
+		AIFW_LOGE("Invalid argument - size %d", size);
+		return AIFW_INVALID_ARG;
 	}
-	if (row > mMaxRows) {
-		AIFW_RESULT ret = createList(row - mMaxRows, size);
-		if (ret == AIFW_OK) {
-			mMaxRows = row;
-			mRowSize = size;
-		}
+	_LOCK
+	float *data = (float *)calloc((size_t)2 * maxRows * size, sizeof(float));
+	if (!data) {
+		AIFW_LOGE("buffer allocation failed with errno %d, error message: %s", errno, strerror(errno));
 		_UNLOCK
-		return ret;
+		return AIFW_NO_MEM;
 	}
+	uint16_t copySize = (size < mRowSize) ? size : mRowSize;
+	for (uint16_t i = 0; i < mRowCount; i++) {
+		memcpy(data + (size_t)i * size, getRowAddress(i), copySize * sizeof(float));
+		memcpy(data + (size_t)(maxRows + i) * size, getRowAddress(i), copySize * sizeof(float));
+	}
+	free(mData);
+	mData = data;
+	mHead = 0;
+	mMaxRows = maxRows;
 	mRowSize = size;
 	_UNLOCK
 	return AIFW_OK;
@@ -114,34 +122,63 @@ AIFW_RESULT AIDataBuffer::reinit(uint16_t row, uint16_t size)
 
 void AIDataBuffer::deinit(void)
 {
-	clearMemory(mStart);
-	mStart = NULL;
-	mEnd = NULL;
+	free(mData);
+	mData = NULL;
+	mHead = 0;
 	mRowSize = 0;
 	mMaxRows = 0;
 	mRowCount = 0;
 }
 
-void AIDataBuffer::clearMemory(AIDataBufferNode *ptr)
+float *AIDataBuffer::getRowAddress(uint16_t row)
+{
+	return mData + (size_t)((mHead + row) % mMaxRows) * mRowSize;
+}
+
+void AIDataBuffer::copyRow(uint16_t row, const float *buffer, uint16_t size, uint16_t offset)
+{
+	float *first = getRowAddress(row) + offset;
+	float *second = first + (size_t)mMaxRows * mRowSize;
+	if (buffer) {
+		memcpy(first, buffer, size * sizeof(float));
+		memcpy(second, buffer, size * sizeof(float));
+	} else {
+		memset(first, 0, size * sizeof(float));
+		memset(second, 0, size * sizeof(float));
+	}
+}
+
+void AIDataBuffer::removeRows(uint16_t offset, uint16_t count)
 {
-	AIDataBufferNode *current = ptr;
-	AIDataBufferNode *temp = ptr;
-	while (current) {
-		temp = current->mNext;
-		delete current;
-		current = temp;
+	uint16_t older = mRowCount - offset - count;
+	uint16_t i;
+	if (offset < older) {
+		/* Move newer rows over the removed ones, then the head skips the emptied rows. */
+		for (i = offset; i > 0; i--) {
+			copyRow(i - 1 + count, getRowAddress(i - 1), mRowSize, 0);
+		}
+		for (i = 0; i < count; i++) {
+			copyRow(i, NULL, mRowSize, 0);
+		}
+		mHead = (mHead + count) % mMaxRows;
+	} else {
+		for (i = offset; i < offset + older; i++) {
+			copyRow(i, getRowAddress(i + count), mRowSize, 0);
+		}
+		for (; i < mRowCount; i++) {
+			copyRow(i, NULL, mRowSize, 0);
+		}
 	}
+	mRowCount -= count;
 }
 
 AIFW_RESULT AIDataBuffer::clear(void)
 {
 	_LOCK
-	AIDataBufferNode *current = mStart;
-	while (current) {
-		current->mIsEmpty = true;
-		memset(current->mData, '\0', mRowSize * sizeof(float));
-		current = current->mNext;
+	if (mData) {
+		memset(mData, '\0', (size_t)2 * mMaxRows * mRowSize * sizeof(float));
 	}
+	mHead = 0;
 	mRowCount = 0;
 	_UNLOCK
 	return AIFW_OK;
@@ -158,82 +195,11 @@ AIFW_RESULT AIDataBuffer::clear(uint16_t offset, uint16_t count)
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	AIDataBufferNode *current = mStart;
-	uint16_t i = 0;
-	while (i < offset) {
-		current = current->mNext;
-		i++;
-	}
-	AIDataBufferNode *firstNode = current;
-	AIDataBufferNode *prevToFirstNode = firstNode->mPrev;
-
-	i = 0;
-	while (i < count - 1) {
-		current->mIsEmpty = true;
-		memset(current->mData, '\0', mRowSize * sizeof(float));
-		current = current->mNext;
-		i++;
-	}
-	current->mIsEmpty = true;
-	memset(current->mData, '\0', mRowSize * sizeof(float));
-	mRowCount -= count;
-	AIDataBufferNode *lastNode = current;
-	AIDataBufferNode *nextToLastNode = lastNode->mNext;
-
-	if (!nextToLastNode) {
-		_UNLOCK;
-		return AIFW_OK;
-	} else if (!prevToFirstNode) {
-		mStart = nextToLastNode;
-	} else {
-		prevToFirstNode->mNext = nextToLastNode;
-	}
-	nextToLastNode->mPrev = prevToFirstNode;
-	lastNode->mNext = NULL;
-	firstNode->mPrev = mEnd;
-	mEnd->mNext = firstNode;
-	mEnd = lastNode;
+	removeRows(offset, count);
 	_UNLOCK
 	return AIFW_OK;
 }
 
-AIFW_RESULT AIDataBuffer::createList(uint16_t count, uint16_t size)
-{
-	AIDataBufferNode *newNode = nullptr;
-	AIDataBufferNode *firstNode = nullptr;
-	AIDataBufferNode *lastNode = nullptr;
-	for (uint16_t i = 0; i < count; i++) {
-		newNode = new AIDataBufferNode(size);
-		if (!newNode || !newNode->mData) {
-			AIFW_LOGE("node creation failed with errno %d, error message: %s", errno, strerror(errno));
-			if (newNode) {
-				delete newNode;
-			}
-			clearMemory(firstNode);
-			return AIFW_NO_MEM;
-		}
-		if (firstNode == NULL) {
-			firstNode = newNode;
-			lastNode = newNode;
-		} else {
-			lastNode->mNext = newNode;
-			newNode->mPrev = lastNode;
-			lastNode = newNode;
-		}
-	}
-	if (!mStart) {
-		mStart = firstNode;
-		mEnd = lastNode;
-		return AIFW_OK;
-	}
-	mEnd->mNext = firstNode;
-	if (firstNode) {
-		firstNode->mPrev = mEnd;
-		mEnd = lastNode;
-	}
-	return AIFW_OK;
-}
-
 AIFW_RESULT AIDataBuffer::readData(float *buffer, uint16_t row)
 {
 	if (buffer == NULL) {
@@ -245,13 +211,7 @@ AIFW_RESULT AIDataBuffer::readData(float *buffer, uint16_t row)
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	uint16_t temp = 0;
-	AIDataBufferNode *tempNode = mStart;
-	while (temp < row) {
-		tempNode = tempNode->mNext;
-		++temp;
-	}
-	memcpy(buffer, tempNode->mData, mRowSize * sizeof(float));
+	memcpy(buffer, getRowAddress(row), mRowSize * sizeof(float));
 	DUMP_BUFFER("buffer read done, values: ", mRowSize, buffer, 0)
 	_UNLOCK;
 	return AIFW_OK;
@@ -276,42 +236,48 @@ AIFW_RESULT AIDataBuffer::readData(float *buffer, uint16_t startCol, uint16_t en
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	uint16_t temp = 0;
-	AIDataBufferNode *tempNode = mStart;
-	while (temp < row) {
-		tempNode = tempNode->mNext;
-		++temp;
-	}
-	memcpy(buffer, (tempNode->mData + startCol), (endCol - startCol) * sizeof(float));
+	memcpy(buffer, (getRowAddress(row) + startCol), (endCol - startCol) * sizeof(float));
 	DUMP_BUFFER("buffer read done, values: ", endCol - startCol, buffer, 0)
 	_UNLOCK;
 	return AIFW_OK;
 }
 
+AIFW_RESULT AIDataBuffer::getWindow(const float **window, uint16_t row, uint16_t count)
+{
+	if (window == NULL) {
+		AIFW_LOGE("Invalid argument - window");
+		return AIFW_INVALID_ARG;
+	}
+	if (count == 0 || row + count > mRowCount) {
+		AIFW_LOGE("Invalid argument - row index %d count %d row count %d", row, count, mRowCount);
+		return AIFW_INVALID_ARG;
+	}
+	_LOCK
+	/* The mirror copy follows the last slot, so the window is contiguous even when it wraps around. */
+	*window = getRowAddress(row);
+	_UNLOCK
+	return AIFW_OK;
+}
+
 AIFW_RESULT AIDataBuffer::writeData(float *buffer, uint16_t size)
 {
 	if (buffer == NULL) {
 		AIFW_LOGE("Invalid argument - input buffer");
 		return AIFW_INVALID_ARG;
 	}
+	if (mData == NULL) {
+		AIFW_LOGE("Buffer is not initialized");
+		return AIFW_ERROR;
+	}
 	if (size > mRowSize) {
 		AIFW_LOGE("Size: %d passed > row size: %d", size, mRowSize);
 		return AIFW_NOT_ENOUGH_SPACE;
 	}
 	DUMP_BUFFER("buffer write operation, values: ", size, buffer, 0)
 	_LOCK
-	if (mStart != mEnd) {
-		AIDataBufferNode *last = mEnd;
-		mEnd = last->mPrev;
-		mEnd->mNext = NULL;
-		last->mPrev = NULL;
-		last->mNext = mStart;
-		mStart->mPrev = last;
-		mStart = last;
-	}
-	memcpy(mStart->mData, buffer, size * sizeof(float));
-	DUMP_BUFFER("buffer write operation done, values: ", size, mStart->mData, 0)
-	mStart->mIsEmpty = false;
+	mHead = (mHead + mMaxRows - 1) % mMaxRows;
+	copyRow(0, buffer, size, 0);
+	DUMP_BUFFER("buffer write operation done, values: ", size, getRowAddress(0), 0)
 	if (mRowCount < mMaxRows) {
 		++mRowCount;
 	}
@@ -326,14 +292,18 @@ AIFW_RESULT AIDataBuffer::writeData(float *buffer, uint16_t size, uint16_t offse
 		AIFW_LOGE("Invalid argument - input buffer");
 		return AIFW_INVALID_ARG;
 	}
+	if (mData == NULL) {
+		AIFW_LOGE("Buffer is not initialized");
+		return AIFW_ERROR;
+	}
 	if (size > (mRowSize - offset)) {
 		AIFW_LOGE("Size: %d passed > available size: %d", size, (mRowSize - offset));
 		return AIFW_NOT_ENOUGH_SPACE;
 	}
 	DUMP_BUFFER("buffer write operation, values: ", size, buffer, 0)
 	_LOCK
-	memcpy((mStart->mData + offset), buffer, size * sizeof(float));
-	DUMP_BUFFER("buffer write operation done, values: ", size, mStart->mData, offset)
+	copyRow(0, buffer, size, offset);
+	DUMP_BUFFER("buffer write operation done, values: ", size, getRowAddress(0), offset)
 	AIFW_LOGI("resultData Written");
 	_UNLOCK
 	return AIFW_OK;
@@ -346,30 +316,7 @@ AIFW_RESULT AIDataBuffer::deleteData(uint16_t row)
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	AIDataBufferNode *current = mStart;
-	uint16_t i = 0;
-	while (i < row) {
-		current = current->mNext;
-		i++;
-	}
-	memset(current->mData, 0, mRowSize * sizeof(float));
-	current->mIsEmpty = true;
-	mRowCount--;
-	AIDataBufferNode *nextToCurrent = current->mNext;
-	AIDataBufferNode *prevToCurrent = current->mPrev;
-	if (nextToCurrent == NULL) {
-		_UNLOCK
-		return AIFW_OK;
-	} else if (prevToCurrent == NULL) {
-		mStart = nextToCurrent;
-	} else {
-		prevToCurrent->mNext = nextToCurrent;
-	}
-	nextToCurrent->mPrev = prevToCurrent;
-	current->mNext = NULL;
-	current->mPrev = mEnd;
-	mEnd->mNext = current;
-	mEnd = current;
+	removeRows(row, 1);
 	_UNLOCK
 	return AIFW_OK;
 }
@@ -379,5 +326,9 @@ uint16_t AIDataBuffer::getRowCount()
 	return mRowCount;
 }
 
-} // namespace aifw
+uint16_t AIDataBuffer::getRowSize()
+{
+	return mRowSize;
+}
 
+} // namespace aifw
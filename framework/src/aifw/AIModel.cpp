@@ -17,6 +17,7 @@
  ****************************************************************************/
 
 #include "tinyara/config.h"
+#include <time.h>
 #include "aifw/aifw.h"
 #include "aifw/aifw_log.h"
 #ifdef CONFIG_AIFW_USE_ONERT_MICRO
@@ -31,13 +32,21 @@
 
 namespace aifw {
 
+static uint32_t getTimeUs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (uint32_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
 AIModel::AIModel(void) :
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	mInvokeResult(NULL), mInputSizeList(NULL), mOutputSizeList(NULL), mInputSetCount(0), mOutputSetCount(0),
+	mInputSizeList(NULL), mOutputSizeList(NULL), mInputSetCount(0), mOutputSetCount(0),
 #endif
 	mInvokeInput(NULL), mInvokeOutput(NULL), mParsedData(NULL), mPostProcessedData(NULL), mDataProcessor(nullptr), mBuffer(nullptr)
 {
 	memset(&mModelAttribute, '\0', sizeof(AIModelAttribute));
+	memset(&mStageTime, '\0', sizeof(AIModelStageTime));
 #ifdef CONFIG_AIFW_USE_ONERT_MICRO
 	mAIEngine = std::make_shared<ONERTM>();
 	AIFW_LOGE("Model Engine is OneRT");
@@ -52,11 +61,12 @@ AIModel::AIModel(void) :
 
 AIModel::AIModel(std::shared_ptr<AIProcessHandler> dataProcessor) :
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	mInvokeResult(NULL), mInputSizeList(NULL), mOutputSizeList(NULL), mInputSetCount(0), mOutputSetCount(0),
+	mInputSizeList(NULL), mOutputSizeList(NULL), mInputSetCount(0), mOutputSetCount(0),
 #endif
 	mInvokeInput(NULL), mInvokeOutput(NULL), mParsedData(NULL), mPostProcessedData(NULL), mDataProcessor(dataProcessor), mBuffer(nullptr)
 {
 	memset(&mModelAttribute, '\0', sizeof(AIModelAttribute));
+	memset(&mStageTime, '\0', sizeof(AIModelStageTime));
 #ifdef CONFIG_AIFW_USE_ONERT_MICRO
 	mAIEngine = std::make_shared<ONERTM>();
 	AIFW_LOGE("Model Engine is OneRT");
@@ -92,42 +102,17 @@ void AIModel::clearModelAttribute(void)
 AIModel::~AIModel()
 {
 	clearModelAttribute();
-#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	if (mInvokeInput) {
-		delete[] mInvokeInput;
-		mInvokeInput = NULL;
-	}
-
-	if (mInvokeOutput) {
-		delete[] mInvokeOutput;
-		mInvokeOutput = NULL;
-	}
-#else
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	/* Entries point to tensors of the engine, only the lists are owned. */
 	if (mInvokeInput) {
-		for (uint16_t i = 0; i < mInputSetCount; i++) {
-			if (mInvokeInput[i]) {
-				delete[] mInvokeInput[i];
-				mInvokeInput[i] = NULL;
-			}
-		}
 		delete[] mInvokeInput;
 		mInvokeInput = NULL;
 	}
 
 	if (mInvokeOutput) {
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			if (mInvokeOutput[i]) {
-				delete[] mInvokeOutput[i];
-				mInvokeOutput[i] = NULL;
-			}
-		}
 		delete[] mInvokeOutput;
 		mInvokeOutput = NULL;
 	}
-	if(mInvokeResult) {
-		delete[] mInvokeResult;
-		mInvokeResult = NULL;
-	}
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 
 	if (mParsedData) {
@@ -164,51 +149,21 @@ AIFW_RESULT AIModel::createDataBuffer(void)
 
 AIFW_RESULT AIModel::allocateMemory(void)
 {
-#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	mInvokeOutput = new float[mModelAttribute.invokeOutputCount];
-	if (!mInvokeOutput) {
-		AIFW_LOGE("Memory Allocation failed - model output buffer");
-		return AIFW_NO_MEM;
-	}
-	mInvokeInput = new float[mModelAttribute.invokeInputCount];
-	if (!mInvokeInput) {
-		AIFW_LOGE("Memory Allocation failed - model input buffer");
-		return AIFW_NO_MEM;
-	}
-#else
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	mAIEngine->getModelDimensions(&mInputSetCount, &mInputSizeList, &mOutputSetCount, &mOutputSizeList);
 	AIFW_LOGD("Model dimensions extracted");
-	mInvokeResult = new float *[mOutputSetCount];
-	if (!mInvokeResult) {
-		AIFW_LOGE("Memory Allocation failed - inference result buffer");
-		return AIFW_NO_MEM;
-	}
+	/* Model input and output buffers are tensors of the engine, they are bound at every invoke. */
 	mInvokeOutput = new float *[mOutputSetCount];
 	if (!mInvokeOutput) {
 		AIFW_LOGE("Memory Allocation failed - model output buffer");
 		return AIFW_NO_MEM;
 	}
-	for (uint16_t i = 0; i < mOutputSetCount; i++) {
-		mInvokeOutput[i] = new float[mOutputSizeList[i]];
-		if (!mInvokeOutput[i]) {
-			AIFW_LOGE("Memory Allocation failed - model output buffer");
-			return AIFW_NO_MEM;
-		}
-	}
-	AIFW_LOGD("model output memory allocated");
 	mInvokeInput = new float *[mInputSetCount];
 	if (!mInvokeInput) {
 		AIFW_LOGE("Memory Allocation failed - model input buffer");
 		return AIFW_NO_MEM;
 	}
-	for (uint16_t i = 0; i < mInputSetCount; i++) {
-		mInvokeInput[i] = new float[mInputSizeList[i]];
-		if (!mInvokeInput[i]) {
-			AIFW_LOGE("Memory Allocation failed - model input buffer");
-			return AIFW_NO_MEM;
-		}
-	}
-	AIFW_LOGD("model input memory allocated");
+	AIFW_LOGD("model input and output lists allocated");
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 	if (mDataProcessor) {
 		mParsedData = new float[mModelAttribute.rawDataCount];
@@ -367,214 +322,186 @@ AIFW_RESULT AIModel::loadModel(const AIModelAttribute &modelAttribute)
 }
 
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-AIFW_RESULT AIModel::invoke(void)
+AIFW_RESULT AIModel::fillInvokeInput(void)
 {
 	AIFW_RESULT res;
-	int outputOffset = 0; /* to write 2d output in 1d buffer. */
-	float **invokeResult = new float *[mOutputSetCount];
 	for (uint16_t i = 0; i < mInputSetCount; i++) {
-		memset(mInvokeInput[i], '\0', mInputSizeList[i] * sizeof(float));
-	}
-	for (uint16_t i = 0; i < mOutputSetCount; i++) {
-		memset(mInvokeOutput[i], '\0', mOutputSizeList[i] * sizeof(float));
+		mInvokeInput[i] = mAIEngine->getInputBuffer(i);
+		if (!mInvokeInput[i]) {
+			AIFW_LOGE("Engine input buffer %d is not available", i);
+			return AIFW_ERROR;
+		}
 	}
 	if (mDataProcessor) {
-		AIFW_LOGV("data processor is set");
-		memset(mPostProcessedData, '\0', mModelAttribute.postProcessResultCount * sizeof(float));
+		/* Data processor may fill only a part of the input. */
+		for (uint16_t i = 0; i < mInputSetCount; i++) {
+			memset(mInvokeInput[i], '\0', mInputSizeList[i] * sizeof(float));
+		}
 		res = mDataProcessor->preProcessData(mBuffer, mInputSetCount, mInvokeInput, &mModelAttribute);
 		if (res != AIFW_OK) {
 			AIFW_LOGE("preProcessData failed, error: %d", res);
 			return res;
 		}
-#ifdef CONFIG_AIFW_LOGV
-		printf("invoke Input\n");
-		for (uint16_t i = 0; i < mInputSetCount; i++) {
-			printf("inputset [%d]: ", i);
-			for (uint16_t j = 0; j < mInputSizeList[i]; j++) {
-				printf("%f,", mInvokeInput[i][j]);
-			}
-			printf("\n");
-		}
-#endif
-		res = mAIEngine->invoke(mInvokeInput, invokeResult);
-		if (res != AIFW_OK) {
-			AIFW_LOGE("Engine Invoke failed.");
-			return AIFW_ERROR;
-		}
-		AIFW_LOGV("invoke completed fine");
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
-				mInvokeOutput[i][j] = invokeResult[i][j];
-			}
-		}
-#ifdef CONFIG_AIFW_LOGV
-		printf("invoke Output\n");
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			printf("outputset [%d]: ", i);
-			for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
-				printf("%f,", mInvokeOutput[i][j]);
-			}
-			printf("\n");
-		}
-#endif
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			res = mBuffer->writeData(mInvokeOutput[i], mOutputSizeList[i], mModelAttribute.rawDataCount + outputOffset);
-			outputOffset += mOutputSizeList[i];
-			if (res != AIFW_OK) {
-				AIFW_LOGE("model output data write to buffer failed, error: %d", res);
-				return res;
-			}
-		}
-		res = mDataProcessor->postProcessData(mBuffer, mPostProcessedData, &mModelAttribute);
-		if (res < AIFW_OK) {
-			AIFW_LOGE("data post processing failed, error: %d", res);
-		}
-		AIFW_LOGV("pre-process, invoke and post-process completed OK");
-		return res;
 	} else {
-		AIFW_LOGV("No data processor case");
 		int inputOffset = 0;  /* to read 2d input from 1d buffer. */
 		for (uint16_t i = 0; i < mInputSetCount; i++) {
-			res = mBuffer->readData(mInvokeInput[i], inputOffset, inputOffset+mInputSizeList[i], 0);
+			res = mBuffer->readData(mInvokeInput[i], inputOffset, inputOffset + mInputSizeList[i], 0);
 			inputOffset += mInputSizeList[i];
 			if (res != AIFW_OK) {
 				AIFW_LOGE("Reading Data from the buffer failed, error: %d", res);
 				return res;
 			}
 		}
+	}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Input\n");
-		for (uint16_t i = 0; i < mInputSetCount; i++) {
-			printf("inputset [%d]: ", i);
-			for (uint16_t j = 0; j < mInputSizeList[i]; j++) {
-				printf("%f,", mInvokeInput[i][j]);
-			}
-			printf("\n");
+	printf("invoke Input\n");
+	for (uint16_t i = 0; i < mInputSetCount; i++) {
+		printf("inputset [%d]: ", i);
+		for (uint16_t j = 0; j < mInputSizeList[i]; j++) {
+			printf("%f,", mInvokeInput[i][j]);
 		}
+		printf("\n");
+	}
 #endif
-		res = mAIEngine->invoke(mInvokeInput, invokeResult);
-		if (res != AIFW_OK) {
-			AIFW_LOGE("Engine Invoke failed.");
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModel::writeInvokeOutput(void)
+{
+	AIFW_RESULT res;
+	/* to write 2d output in 1d buffer. */
+	int outputOffset = mDataProcessor ? mModelAttribute.rawDataCount : mModelAttribute.invokeInputCount;
+	for (uint16_t i = 0; i < mOutputSetCount; i++) {
+		mInvokeOutput[i] = mAIEngine->getOutputBuffer(i);
+		if (!mInvokeOutput[i]) {
+			AIFW_LOGE("Engine output buffer %d is not available", i);
 			return AIFW_ERROR;
 		}
-		AIFW_LOGV("invoke completed fine");
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
-				mInvokeOutput[i][j] = invokeResult[i][j];
-			}
-		}
+	}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Output\n");
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			printf("outputset [%d]: ", i);
-			for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
-				printf("%f,", mInvokeOutput[i][j]);
-			}
-			printf("\n");
+	printf("invoke Output\n");
+	for (uint16_t i = 0; i < mOutputSetCount; i++) {
+		printf("outputset [%d]: ", i);
+		for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
+			printf("%f,", mInvokeOutput[i][j]);
 		}
+		printf("\n");
+	}
 #endif
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			res = mBuffer->writeData(mInvokeOutput[i], mOutputSizeList[i], mModelAttribute.invokeInputCount + outputOffset);
-			outputOffset += mOutputSizeList[i];
-			if (res != AIFW_OK) {
-				AIFW_LOGE("Writing invoke result to the buffer failed, error: %d", res);
-				return res;
-			}
+	for (uint16_t i = 0; i < mOutputSetCount; i++) {
+		res = mBuffer->writeData(mInvokeOutput[i], mOutputSizeList[i], outputOffset);
+		outputOffset += mOutputSizeList[i];
+		if (res != AIFW_OK) {
+			AIFW_LOGE("Writing invoke result to the buffer failed, error: %d", res);
+			return res;
 		}
-		AIFW_LOGV("read data, invoke and write data completed OK");
-		return res;
 	}
+	return AIFW_OK;
 }
 #else
-AIFW_RESULT AIModel::invoke(void)
+AIFW_RESULT AIModel::fillInvokeInput(void)
 {
 	AIFW_RESULT res;
-	float *invokeResult = nullptr;
-	memset(mInvokeInput, '\0', mModelAttribute.invokeInputCount * sizeof(float));
-	memset(mInvokeOutput, '\0', mModelAttribute.invokeOutputCount * sizeof(float));
+	mInvokeInput = mAIEngine->getInputBuffer(0);
+	if (!mInvokeInput) {
+		AIFW_LOGE("Engine input buffer is not available");
+		return AIFW_ERROR;
+	}
 	if (mDataProcessor) {
-		AIFW_LOGV("data processor is set");
-		memset(mPostProcessedData, '\0', mModelAttribute.postProcessResultCount * sizeof(float));
-
+		/* Data processor may fill only a part of the input. */
+		memset(mInvokeInput, '\0', mModelAttribute.invokeInputCount * sizeof(float));
 		res = mDataProcessor->preProcessData(mBuffer, mInvokeInput, &mModelAttribute);
 		if (res != AIFW_OK) {
 			AIFW_LOGE("preProcessData failed, error: %d", res);
 			return res;
 		}
-#ifdef CONFIG_AIFW_LOGV
-		printf("invoke Input: ");
-		for (uint16_t i = 0; i < mModelAttribute.invokeInputCount; i++) {
-			printf("%f,", mInvokeInput[i]);
-		}
-		printf("\n");
-#endif
-		invokeResult = (float *)mAIEngine->invoke(mInvokeInput);
-		if (!invokeResult) {
-			AIFW_LOGE("Engine Invoke failed.");
-			return AIFW_ERROR;
-		}
-		AIFW_LOGV("invoke completed fine");
-		for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
-			mInvokeOutput[i] = invokeResult[i];
-		}
-#ifdef CONFIG_AIFW_LOGV
-		printf("invoke Output: ");
-		for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
-			printf("%f,", mInvokeOutput[i]);
-		}
-		printf("\n");
-#endif
-		res = mBuffer->writeData(mInvokeOutput, mModelAttribute.invokeOutputCount, mModelAttribute.rawDataCount);
-		if (res != AIFW_OK) {
-			AIFW_LOGE("model output data write to buffer failed, error: %d", res);
-			return res;
-		}
-		res = mDataProcessor->postProcessData(mBuffer, mPostProcessedData, &mModelAttribute);
-		if (res < AIFW_OK) {
-			AIFW_LOGE("data post processing failed, error: %d", res);
-		}
-		AIFW_LOGV("pre-process, invoke and post-process completed OK");
-		return res;
 	} else {
-		AIFW_LOGV("No data processor case");
 		res = mBuffer->readData(mInvokeInput, 0, mModelAttribute.invokeInputCount, 0);
 		if (res != AIFW_OK) {
 			AIFW_LOGE("Reading Data from the buffer failed, error: %d", res);
 			return res;
 		}
+	}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Input: ");
-		for (uint16_t i = 0; i < mModelAttribute.invokeInputCount; i++) {
-			printf("%f,", mInvokeInput[i]);
-		}
-		printf("\n");
+	printf("invoke Input: ");
+	for (uint16_t i = 0; i < mModelAttribute.invokeInputCount; i++) {
+		printf("%f,", mInvokeInput[i]);
+	}
+	printf("\n");
 #endif
-		invokeResult = (float *)mAIEngine->invoke(mInvokeInput);
-		if (!invokeResult) {
-			AIFW_LOGE("Engine Invoke failed.");
-			return AIFW_ERROR;
-		}
-		AIFW_LOGV("invoke completed fine");
-		for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
-			mInvokeOutput[i] = invokeResult[i];
-		}
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModel::writeInvokeOutput(void)
+{
+	AIFW_RESULT res;
+	mInvokeOutput = mAIEngine->getOutputBuffer(0);
+	if (!mInvokeOutput) {
+		AIFW_LOGE("Engine output buffer is not available");
+		return AIFW_ERROR;
+	}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Output: ");
-		for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
-			printf("%f,", mInvokeOutput[i]);
-		}
-		printf("\n");
+	printf("invoke Output: ");
+	for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
+		printf("%f,", mInvokeOutput[i]);
+	}
+	printf("\n");
 #endif
-		res = mBuffer->writeData(mInvokeOutput, mModelAttribute.invokeOutputCount, mModelAttribute.invokeInputCount);
+	res = mBuffer->writeData(mInvokeOutput, mModelAttribute.invokeOutputCount, mDataProcessor ? mModelAttribute.rawDataCount : mModelAttribute.invokeInputCount);
+	if (res != AIFW_OK) {
+		AIFW_LOGE("Writing invoke result to the buffer failed, error: %d", res);
+		return res;
+	}
+	return AIFW_OK;
+}
+#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+
+AIFW_RESULT AIModel::invoke(void)
+{
+	AIFW_RESULT res;
+	uint32_t start = getTimeUs();
+	/* Engine tensors are used from filling input to writing output. */
+	res = mAIEngine->acquire();
+	if (res != AIFW_OK) {
+		AIFW_LOGE("Engine acquire failed, error: %d", res);
+		return res;
+	}
+	res = fillInvokeInput();
+	uint32_t engineStart = getTimeUs();
+	if (res == AIFW_OK) {
+		res = mAIEngine->invoke();
 		if (res != AIFW_OK) {
-			AIFW_LOGE("Writing invoke result to the buffer failed, error: %d", res);
-			return res;
+			AIFW_LOGE("Engine Invoke failed.");
+			res = AIFW_ERROR;
 		}
-		AIFW_LOGV("read data, invoke and write data completed OK");
+	}
+	uint32_t engineEnd = getTimeUs();
+	if (res == AIFW_OK) {
+		AIFW_LOGV("invoke completed fine");
+		res = writeInvokeOutput();
+	}
+	mAIEngine->release();
+	if (res != AIFW_OK) {
 		return res;
 	}
+	if (mDataProcessor) {
+		memset(mPostProcessedData, '\0', mModelAttribute.postProcessResultCount * sizeof(float));
+		res = mDataProcessor->postProcessData(mBuffer, mPostProcessedData, &mModelAttribute);
+		if (res < AIFW_OK) {
+			AIFW_LOGE("data post processing failed, error: %d", res);
+		}
+	}
+	uint32_t end = getTimeUs();
+	mStageTime.lastPreProcessTime = engineStart - start;
+	mStageTime.lastEngineTime = engineEnd - engineStart;
+	mStageTime.lastPostProcessTime = end - engineEnd;
+	mStageTime.preProcessTime += mStageTime.lastPreProcessTime;
+	mStageTime.engineTime += mStageTime.lastEngineTime;
+	mStageTime.postProcessTime += mStageTime.lastPostProcessTime;
+	mStageTime.invokeCount++;
+	AIFW_LOGV("invoke done, pre-process %u us, engine %u us, post-process %u us", mStageTime.lastPreProcessTime, mStageTime.lastEngineTime, mStageTime.lastPostProcessTime);
+	return res;
 }
-#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 
 AIFW_RESULT AIModel::pushData(void *data, uint16_t count)
 {
@@ -665,16 +592,20 @@ AIFW_RESULT AIModel::getResultData(float *data, uint16_t count)
 		memcpy(data, mPostProcessedData, mModelAttribute.postProcessResultCount * sizeof(float));
 		return AIFW_OK;
 	}
+	/* Engine output buffers are reused by the next invoke, so the copy in latest row of buffer is read. */
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	int outputOffset = 0;
+	uint16_t outputCount = 0;
 	for (uint16_t i = 0; i < mOutputSetCount; i++) {
-		memcpy(data+outputOffset, mInvokeOutput[i], mOutputSizeList[i] * sizeof(float));
-		outputOffset += mOutputSizeList[i];
+		outputCount += mOutputSizeList[i];
 	}
 #else
-	memcpy(data, mInvokeOutput, mModelAttribute.postProcessResultCount * sizeof(float));
+	uint16_t outputCount = mModelAttribute.postProcessResultCount;
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
-	return AIFW_OK;
+	AIFW_RESULT res = mBuffer->readData(data, mModelAttribute.invokeInputCount, mModelAttribute.invokeInputCount + outputCount, 0);
+	if (res != AIFW_OK) {
+		AIFW_LOGE("Reading invoke output from the mBuffer failed.");
+	}
+	return res;
 }
 
 AIFW_RESULT AIModel::getRawData(float *data, uint16_t count)
@@ -720,5 +651,20 @@ uint32_t AIModel::getModelCode()
 	return mModelAttribute.modelCode;
 }
 
+AIFW_RESULT AIModel::getStageTime(AIModelStageTime *stageTime)
+{
+	if (!stageTime) {
+		AIFW_LOGE("stage time argument is null");
+		return AIFW_INVALID_ARG;
+	}
+	*stageTime = mStageTime;
+	return AIFW_OK;
+}
+
+void AIModel::resetStageTime(void)
+{
+	memset(&mStageTime, '\0', sizeof(AIModelStageTime));
+}
+
 } /* namespace aifw */
 
@@ -0,0 +1,404 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include "tinyara/config.h"
+#include <time.h>
+#include <sched.h>
+#include <string.h>
+#include "aifw/aifw.h"
+#include "aifw/aifw_log.h"
+#include "aifw/AIModelService.h"
+#include "aifw/AIModelScheduler.h"
+
+#ifndef CONFIG_AIFW_SCHEDULER_PRIORITY
+#define CONFIG_AIFW_SCHEDULER_PRIORITY 100
+#endif
+
+#ifndef CONFIG_AIFW_SCHEDULER_STACKSIZE
+#define CONFIG_AIFW_SCHEDULER_STACKSIZE 4096
+#endif
+
+namespace aifw {
+
+static uint64_t getTimeUs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+AIModelScheduler::AIModelScheduler(uint16_t workerCount) :
+	mWorkerCount(workerCount > 0 ? workerCount : 1), mRunning(false), mEntries(NULL), mDispatcher(0), mWorkers(NULL)
+{
+	pthread_mutex_init(&mControlLock, NULL);
+	pthread_mutex_init(&mLock, NULL);
+	pthread_cond_init(&mTimerCond, NULL);
+	pthread_cond_init(&mJobCond, NULL);
+	pthread_cond_init(&mDoneCond, NULL);
+}
+
+AIModelScheduler::~AIModelScheduler()
+{
+	stop();
+	while (mEntries) {
+		ScheduleEntry *entry = mEntries;
+		mEntries = entry->next;
+		delete entry;
+	}
+	pthread_cond_destroy(&mDoneCond);
+	pthread_cond_destroy(&mJobCond);
+	pthread_cond_destroy(&mTimerCond);
+	pthread_mutex_destroy(&mLock);
+	pthread_mutex_destroy(&mControlLock);
+	AIFW_LOGV("model scheduler object destroyed");
+}
+
+/* mControlLock serializes start and stop, mRunning is changed under mLock as threads read it. */
+AIFW_RESULT AIModelScheduler::start(void)
+{
+	pthread_mutex_lock(&mControlLock);
+	pthread_mutex_lock(&mLock);
+	bool running = mRunning;
+	mRunning = true;
+	pthread_mutex_unlock(&mLock);
+	if (running) {
+		pthread_mutex_unlock(&mControlLock);
+		AIFW_LOGV("Scheduler already running.");
+		return AIFW_OK;
+	}
+	mWorkers = new pthread_t[mWorkerCount];
+	if (!mWorkers) {
+		pthread_mutex_lock(&mLock);
+		mRunning = false;
+		pthread_mutex_unlock(&mLock);
+		pthread_mutex_unlock(&mControlLock);
+		AIFW_LOGE("Memory allocation failed for worker threads");
+		return AIFW_NO_MEM;
+	}
+
+	pthread_attr_t attr;
+	struct sched_param sparam;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CONFIG_AIFW_SCHEDULER_STACKSIZE);
+	sparam.sched_priority = CONFIG_AIFW_SCHEDULER_PRIORITY;
+	pthread_attr_setschedparam(&attr, &sparam);
+
+	uint16_t created = 0;
+	bool dispatcherCreated = false;
+	int status = pthread_create(&mDispatcher, &attr, dispatcherThread, (void *)this);
+	if (status == 0) {
+		dispatcherCreated = true;
+		pthread_setname_np(mDispatcher, "aifw_dispatcher");
+		for (; created < mWorkerCount; created++) {
+			status = pthread_create(&mWorkers[created], &attr, workerThread, (void *)this);
+			if (status != 0) {
+				break;
+			}
+			pthread_setname_np(mWorkers[created], "aifw_worker");
+		}
+	}
+	pthread_attr_destroy(&attr);
+	if (status != 0) {
+		AIFW_LOGE("Scheduler thread creation failed, error: %d", status);
+		pthread_mutex_lock(&mLock);
+		mRunning = false;
+		pthread_cond_broadcast(&mTimerCond);
+		pthread_cond_broadcast(&mJobCond);
+		pthread_mutex_unlock(&mLock);
+		if (dispatcherCreated) {
+			pthread_join(mDispatcher, NULL);
+		}
+		for (uint16_t i = 0; i < created; i++) {
+			pthread_join(mWorkers[i], NULL);
+		}
+		delete[] mWorkers;
+		mWorkers = NULL;
+		pthread_mutex_unlock(&mControlLock);
+		return AIFW_ERROR;
+	}
+	pthread_mutex_unlock(&mControlLock);
+	AIFW_LOGV("Scheduler started with %d workers", mWorkerCount);
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelScheduler::stop(void)
+{
+	pthread_mutex_lock(&mControlLock);
+	pthread_mutex_lock(&mLock);
+	bool running = mRunning;
+	mRunning = false;
+	pthread_cond_broadcast(&mTimerCond);
+	pthread_cond_broadcast(&mJobCond);
+	pthread_mutex_unlock(&mLock);
+	if (!running) {
+		pthread_mutex_unlock(&mControlLock);
+		return AIFW_OK;
+	}
+	pthread_join(mDispatcher, NULL);
+	for (uint16_t i = 0; i < mWorkerCount; i++) {
+		pthread_join(mWorkers[i], NULL);
+	}
+	delete[] mWorkers;
+	mWorkers = NULL;
+	pthread_mutex_unlock(&mControlLock);
+	AIFW_LOGV("Scheduler stopped");
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelScheduler::getStats(AIModelService *service, AIModelScheduleStats *stats)
+{
+	if (!stats) {
+		AIFW_LOGE("stats argument is null");
+		return AIFW_INVALID_ARG;
+	}
+	pthread_mutex_lock(&mLock);
+	ScheduleEntry *entry = findEntry(service);
+	if (entry) {
+		*stats = entry->stats;
+	}
+	pthread_mutex_unlock(&mLock);
+	if (!entry) {
+		AIFW_LOGE("Service is not added to scheduler");
+		return AIFW_INVALID_ARG;
+	}
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelScheduler::addService(AIModelService *service, uint8_t priority, uint16_t deadline, uint16_t interval)
+{
+	if (!service || interval == 0) {
+		AIFW_LOGE("Invalid argument - service or interval %d", interval);
+		return AIFW_INVALID_ARG;
+	}
+	ScheduleEntry *entry = new ScheduleEntry;
+	if (!entry) {
+		AIFW_LOGE("Memory allocation failed for schedule entry");
+		return AIFW_NO_MEM;
+	}
+	memset(entry, 0, sizeof(ScheduleEntry));
+	entry->service = service;
+	entry->priority = priority;
+	entry->interval = interval;
+	entry->deadline = (deadline > 0) ? deadline : interval;
+	pthread_mutex_lock(&mLock);
+	if (findEntry(service)) {
+		pthread_mutex_unlock(&mLock);
+		delete entry;
+		AIFW_LOGE("Service is already added to scheduler");
+		return AIFW_INVALID_ARG;
+	}
+	entry->next = mEntries;
+	mEntries = entry;
+	pthread_mutex_unlock(&mLock);
+	AIFW_LOGV("Service added, priority %d deadline %d interval %d msec", priority, entry->deadline, interval);
+	return AIFW_OK;
+}
+
+void AIModelScheduler::removeService(AIModelService *service)
+{
+	pthread_mutex_lock(&mLock);
+	ScheduleEntry **link = &mEntries;
+	while (*link && (*link)->service != service) {
+		link = &(*link)->next;
+	}
+	ScheduleEntry *entry = *link;
+	if (entry) {
+		entry->enabled = false;
+		entry->pending = false;
+		while (entry->running) {
+			pthread_cond_wait(&mDoneCond, &mLock);
+		}
+		/* Entries before this one may be removed while waiting */
+		link = &mEntries;
+		while (*link != entry) {
+			link = &(*link)->next;
+		}
+		*link = entry->next;
+		delete entry;
+	}
+	pthread_mutex_unlock(&mLock);
+}
+
+AIFW_RESULT AIModelScheduler::enableService(AIModelService *service, bool enable)
+{
+	pthread_mutex_lock(&mLock);
+	ScheduleEntry *entry = findEntry(service);
+	if (!entry) {
+		pthread_mutex_unlock(&mLock);
+		AIFW_LOGE("Service is not added to scheduler");
+		return AIFW_INVALID_ARG;
+	}
+	if (enable && !entry->enabled) {
+		entry->nextRelease = getTimeUs() + (uint64_t)entry->interval * 1000;
+		pthread_cond_signal(&mTimerCond);
+	} else if (!enable) {
+		entry->pending = false;
+	}
+	entry->enabled = enable;
+	pthread_mutex_unlock(&mLock);
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelScheduler::setInterval(AIModelService *service, uint16_t interval)
+{
+	if (interval == 0) {
+		AIFW_LOGE("Invalid interval=%d Ignoring request", interval);
+		return AIFW_INVALID_ARG;
+	}
+	pthread_mutex_lock(&mLock);
+	ScheduleEntry *entry = findEntry(service);
+	if (!entry) {
+		pthread_mutex_unlock(&mLock);
+		AIFW_LOGE("Service is not added to scheduler");
+		return AIFW_INVALID_ARG;
+	}
+	/* Deadline follows the interval if it was not set */
+	if (entry->deadline == entry->interval) {
+		entry->deadline = interval;
+	}
+	if (entry->enabled) {
+		/* Next release is one new interval after the previous one, or now if that has passed */
+		uint64_t now = getTimeUs();
+		entry->nextRelease = entry->nextRelease - (uint64_t)entry->interval * 1000 + (uint64_t)interval * 1000;
+		if (entry->nextRelease < now) {
+			entry->nextRelease = now;
+		}
+		pthread_cond_signal(&mTimerCond);
+	}
+	entry->interval = interval;
+	pthread_mutex_unlock(&mLock);
+	return AIFW_OK;
+}
+
+AIModelScheduler::ScheduleEntry *AIModelScheduler::findEntry(AIModelService *service)
+{
+	ScheduleEntry *entry = mEntries;
+	while (entry && entry->service != service) {
+		entry = entry->next;
+	}
+	return entry;
+}
+
+/* Highest priority first, then earliest deadline among same priority */
+AIModelScheduler::ScheduleEntry *AIModelScheduler::pickEntry(void)
+{
+	ScheduleEntry *best = NULL;
+	for (ScheduleEntry *entry = mEntries; entry; entry = entry->next) {
+		if (!entry->pending) {
+			continue;
+		}
+		if (!best || entry->priority > best->priority || (entry->priority == best->priority && entry->absDeadline < best->absDeadline)) {
+			best = entry;
+		}
+	}
+	return best;
+}
+
+void AIModelScheduler::dispatch(void)
+{
+	pthread_mutex_lock(&mLock);
+	while (mRunning) {
+		uint64_t now = getTimeUs();
+		uint64_t wakeup = 0;
+		bool released = false;
+		for (ScheduleEntry *entry = mEntries; entry; entry = entry->next) {
+			if (!entry->enabled) {
+				continue;
+			}
+			if (entry->nextRelease <= now) {
+				if (entry->pending || entry->running) {
+					/* Previous run is not completed, so this release is skipped */
+					entry->stats.skipCount++;
+				} else {
+					entry->pending = true;
+					entry->release = entry->nextRelease;
+					entry->absDeadline = entry->release + (uint64_t)entry->deadline * 1000;
+					released = true;
+				}
+				entry->nextRelease += (uint64_t)entry->interval * 1000;
+				if (entry->nextRelease <= now) {
+					entry->nextRelease = now + (uint64_t)entry->interval * 1000;
+				}
+			}
+			if (wakeup == 0 || entry->nextRelease < wakeup) {
+				wakeup = entry->nextRelease;
+			}
+		}
+		if (released) {
+			pthread_cond_broadcast(&mJobCond);
+		}
+		if (wakeup == 0) {
+			pthread_cond_wait(&mTimerCond, &mLock);
+		} else {
+			struct timespec ts;
+			ts.tv_sec = wakeup / 1000000;
+			ts.tv_nsec = (wakeup % 1000000) * 1000;
+			pthread_cond_timedwait(&mTimerCond, &mLock, &ts);
+		}
+	}
+	pthread_mutex_unlock(&mLock);
+}
+
+void AIModelScheduler::work(void)
+{
+	pthread_mutex_lock(&mLock);
+	while (mRunning) {
+		ScheduleEntry *entry = pickEntry();
+		if (!entry) {
+			pthread_cond_wait(&mJobCond, &mLock);
+			continue;
+		}
+		entry->pending = false;
+		entry->running = true;
+		CollectRawDataListener callback = entry->service->getCollectRawDataCallback();
+		pthread_mutex_unlock(&mLock);
+
+		callback();
+		uint64_t end = getTimeUs();
+
+		pthread_mutex_lock(&mLock);
+		entry->running = false;
+		uint32_t latency = (uint32_t)(end - entry->release);
+		entry->stats.runCount++;
+		entry->stats.lastLatency = latency;
+		entry->stats.totalLatency += latency;
+		if (latency > entry->stats.maxLatency) {
+			entry->stats.maxLatency = latency;
+		}
+		if (end > entry->absDeadline) {
+			entry->stats.deadlineMissCount++;
+			AIFW_LOGV("Deadline missed, latency %u us", latency);
+		}
+		pthread_cond_broadcast(&mDoneCond);
+	}
+	pthread_mutex_unlock(&mLock);
+}
+
+void *AIModelScheduler::dispatcherThread(void *arg)
+{
+	((AIModelScheduler *)arg)->dispatch();
+	return NULL;
+}
+
+void *AIModelScheduler::workerThread(void *arg)
+{
+	((AIModelScheduler *)arg)->work();
+	return NULL;
+}
+
+} /* namespace aifw */
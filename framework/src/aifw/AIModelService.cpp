@@ -22,17 +22,21 @@
 #include "aifw/aifw.h"
 #include "aifw/aifw_log.h"
 #include "aifw/AIModelService.h"
+#include "aifw/AIModelScheduler.h"
 #include "aifw/AIInferenceHandler.h"
 
 namespace aifw {
 
 AIModelService::AIModelService(CollectRawDataListener collectRawDataCallback, std::shared_ptr<AIInferenceHandler> inferenceHandler) :
-	mInterval(0), mServiceRunning(false), mInferenceHandler(inferenceHandler), mCollectRawDataCallback(collectRawDataCallback), mTimer(NULL)
+	mInterval(0), mServiceRunning(false), mInferenceHandler(inferenceHandler), mCollectRawDataCallback(collectRawDataCallback), mTimer(NULL), mPriority(0), mDeadline(0), mScheduled(false)
 {
 }
 
 AIModelService::~AIModelService()
 {
+	if (mScheduled) {
+		mScheduler->removeService(this);
+	}
 	freeTimer();
 	AIFW_LOGV("model service object destoyed");
 }
@@ -67,7 +71,12 @@ AIFW_RESULT AIModelService::start(void)
 		mServiceRunning = true;
 		return AIFW_OK;
 	}
-	AIFW_RESULT ret = setInterval(mInterval);
+	AIFW_RESULT ret;
+	if (mScheduled) {
+		ret = mScheduler->enableService(this, true);
+	} else {
+		ret = setInterval(mInterval);
+	}
 	if (ret != AIFW_OK) {
 		AIFW_LOGE("timer set Failed, interval = %d msec", mInterval);
 		return ret;
@@ -92,6 +101,11 @@ AIFW_RESULT AIModelService::stop(void)
 		mServiceRunning = false;
 		return AIFW_OK;
 	}
+	if (mScheduled) {
+		mScheduler->enableService(this, false);
+		mServiceRunning = false;
+		return AIFW_OK;
+	}
 	aifw_timer_result dret = AIFW_TIMER_SUCCESS;
 	dret = aifw_timer_stop(mTimer);
 	if (dret != AIFW_TIMER_SUCCESS) {
@@ -106,6 +120,13 @@ AIFW_RESULT AIModelService::stop(void)
 AIFW_RESULT AIModelService::setInterval(uint16_t interval)
 {
 	aifw_timer_result ret;
+	if (mScheduled) {
+		AIFW_RESULT res = mScheduler->setInterval(this, interval);
+		if (res == AIFW_OK) {
+			mInterval = interval;
+		}
+		return res;
+	}
 	if (!mTimer) {
 		AIFW_LOGE("Timer not created yet, Ignoring request");
 		return AIFW_ERROR;
@@ -124,6 +145,27 @@ AIFW_RESULT AIModelService::setInterval(uint16_t interval)
 	return AIFW_OK;
 }
 
+AIFW_RESULT AIModelService::setScheduler(std::shared_ptr<AIModelScheduler> scheduler, uint8_t priority, uint16_t deadline)
+{
+	if (mTimer || mScheduled) {
+		AIFW_LOGE("Service already prepared, Ignoring request");
+		return AIFW_ERROR;
+	}
+	mScheduler = scheduler;
+	mPriority = priority;
+	mDeadline = deadline;
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModelService::getScheduleStats(AIModelScheduleStats *stats)
+{
+	if (!mScheduled) {
+		AIFW_LOGE("Service is not scheduled");
+		return AIFW_ERROR;
+	}
+	return mScheduler->getStats(this, stats);
+}
+
 AIFW_RESULT AIModelService::pushData(void *data, uint16_t count)
 {
 	if (!mServiceRunning) {
@@ -142,6 +184,16 @@ AIFW_RESULT AIModelService::prepare(void)
 	}
 	mInterval = mInferenceHandler->getModelServiceInterval();
 	AIFW_LOGV("Timer interval %d", mInterval);
+	if (mInterval > 0 && mScheduler) {
+		res = mScheduler->addService(this, mPriority, mDeadline, mInterval);
+		if (res != AIFW_OK) {
+			AIFW_LOGE("Adding service to scheduler failed. ret: %d", res);
+			return res;
+		}
+		mScheduled = true;
+		AIFW_LOGV("Service added to scheduler");
+		return AIFW_OK;
+	}
 	if (mInterval > 0) {
 		mTimer = (aifw_timer *)calloc(1, sizeof(aifw_timer));
 		if (mTimer == NULL) {
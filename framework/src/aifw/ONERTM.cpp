@@ -159,42 +159,43 @@ void ONERTM::getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeLis
 }
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 
-#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-/* Run inference : with input data "features" and return output data ptr(Use output dimension to parse it) */
-void *ONERTM::invoke(void *inputData)
+/* Input tensors are allocated by the interpreter for every inference and released after it */
+float *ONERTM::getInputBuffer(uint16_t index)
 {
-	float *value = (float *)(inputData);
-	auto *data = this->mInterpreter->allocateInputTensor(0);
-	for (uint32_t i = 0; i < this->mModelInputSize/sizeof(float); ++i) {
-		reinterpret_cast<float *>(data)[i] = value[i];
+#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	if (index != 0) {
+		return NULL;
 	}
-	AIFW_START_TIMER
-	this->mInterpreter->interpret();
-	AIFW_END_TIMER
-	return this->mInterpreter->readOutputTensor(0);
-}
 #else
-/* Run inference : with input data "features", store output data in outputData parameter and return AIFW_OK on success */
-AIFW_RESULT ONERTM::invoke(void *inputData, void *outputData)
+	if (index >= this->mInputSetCount) {
+		return NULL;
+	}
+#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+	return reinterpret_cast<float *>(this->mInterpreter->allocateInputTensor(index));
+}
+
+float *ONERTM::getOutputBuffer(uint16_t index)
 {
-	float **value = (float **)(inputData);
-	float **output = (float **)(outputData);
-	for (uint16_t i = 0; i < this->mInputSetCount; i++) {
-		auto *data = this->mInterpreter->allocateInputTensor(i);
-		for (uint32_t j = 0; j < this->mInputSizeList[i]; j++) {
-			reinterpret_cast<float *>(data)[j] = value[i][j];
-		}
+#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	if (index != 0) {
+		return NULL;
 	}
+#else
+	if (index >= this->mOutputSetCount) {
+		return NULL;
+	}
+#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+	return reinterpret_cast<float *>(this->mInterpreter->readOutputTensor(index));
+}
 
+/* Run inference : with input data already written in input tensors, output data is left in output tensors */
+AIFW_RESULT ONERTM::invoke(void)
+{
 	AIFW_START_TIMER
 	this->mInterpreter->interpret();
 	AIFW_END_TIMER
-	for (uint16_t i = 0; i < this->mOutputSetCount; i++) {
-		output[i] = (float *)this->mInterpreter->readOutputTensor(i);
-	}
 	return AIFW_OK;
 }
 
-#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 } /* namespace aifw */
 
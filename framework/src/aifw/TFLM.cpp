@@ -18,9 +18,11 @@
 
 #include "tinyara/config.h"
 #include <iostream>
+#include <pthread.h>
 #include <tensorflow/lite/c/common.h>
 #include <tensorflow/lite/schema/schema_generated.h>
 #include <tensorflow/lite/micro/all_ops_resolver.h>
+#include <tensorflow/lite/micro/micro_allocator.h>
 #include <tensorflow/lite/micro/tflite_bridge/micro_error_reporter.h>
 #include <tensorflow/lite/micro/micro_interpreter.h>
 #include <tensorflow/lite/micro/micro_profiler.h>
@@ -34,10 +36,22 @@
 #define AIFW_TFLM_POOL_SIZE CONFIG_TFLM_MEM_POOL_SIZE
 #endif
 
+#ifdef CONFIG_AIFW_SHARED_TENSOR_ARENA
+#define AIFW_TFLM_PERSISTENT_POOL_SIZE CONFIG_AIFW_TFLM_PERSISTENT_POOL_SIZE
+#endif
+
 namespace aifw {
 
 tflite::AllOpsResolver g_Resolver;
 tflite::MicroProfiler g_Profiler;
+#ifdef CONFIG_AIFW_SHARED_TENSOR_ARENA
+/* All models use one arena in turn for activation and scratch buffers, planned at the same offsets by each model.
+ * g_SharedArenaLock guards g_SharedArena only, g_ArenaUseLock is held by the model using the arena. */
+static std::weak_ptr<uint8_t> g_SharedArena;
+static pthread_mutex_t g_SharedArenaLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t g_ArenaUseLock = PTHREAD_MUTEX_INITIALIZER;
+#endif /* CONFIG_AIFW_SHARED_TENSOR_ARENA */
+
 TFLM::TFLM() :
 	mModel(NULL), mBuf(NULL), mInterpreter(NULL), mErrorReporter(NULL),
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
@@ -48,7 +62,22 @@ TFLM::TFLM() :
 {
 	this->mTensorArenaSize = AIFW_TFLM_POOL_SIZE;
 	AIFW_LOGV("Tensor Arena size: %d", this->mTensorArenaSize);
+#ifdef CONFIG_AIFW_SHARED_TENSOR_ARENA
+	pthread_mutex_lock(&g_SharedArenaLock);
+	std::shared_ptr<uint8_t> tensorArena = g_SharedArena.lock();
+	if (!tensorArena) {
+		tensorArena = std::shared_ptr<uint8_t>(new uint8_t[this->mTensorArenaSize], std::default_delete<uint8_t[]>());
+		g_SharedArena = tensorArena;
+	}
+	pthread_mutex_unlock(&g_SharedArenaLock);
+	/* Interpreter, tensor descriptions and variable tensors of the model stay in its own pool. */
+	this->mPersistentArena = std::shared_ptr<uint8_t>(new uint8_t[AIFW_TFLM_PERSISTENT_POOL_SIZE], std::default_delete<uint8_t[]>());
+	if (this->mPersistentArena.get() == NULL) {
+		AIFW_LOGE("persistent arena memory allocation failed");
+	}
+#else
 	std::shared_ptr<uint8_t> tensorArena(new uint8_t[this->mTensorArenaSize], std::default_delete<uint8_t[]>());
+#endif /* CONFIG_AIFW_SHARED_TENSOR_ARENA */
 	if (tensorArena.get() == NULL) {
 		AIFW_LOGE("tensor arena memory allocation failed");
 	}
@@ -84,7 +113,14 @@ TFLM::~TFLM()
 		mBuf = NULL;
 	}
 	mErrorReporter.reset();
+#ifdef CONFIG_AIFW_SHARED_TENSOR_ARENA
+	/* Operators may free their data in the arena. */
+	pthread_mutex_lock(&g_ArenaUseLock);
+	mInterpreter.reset();
+	pthread_mutex_unlock(&g_ArenaUseLock);
+#else
 	mInterpreter.reset();
+#endif /* CONFIG_AIFW_SHARED_TENSOR_ARENA */
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	clearMemory();
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
@@ -92,7 +128,16 @@ TFLM::~TFLM()
 
 AIFW_RESULT TFLM::resetInferenceState(void)
 {
+#ifdef CONFIG_AIFW_SHARED_TENSOR_ARENA
+	AIFW_RESULT ret = acquire();
+	if (ret != AIFW_OK) {
+		return ret;
+	}
+	TfLiteStatus res = this->mInterpreter->Reset();
+	release();
+#else
 	TfLiteStatus res = this->mInterpreter->Reset();
+#endif /* CONFIG_AIFW_SHARED_TENSOR_ARENA */
 	if (res != kTfLiteOk) {
 		AIFW_LOGE("Failed to reset model state. ret: %d", res);
 		return AIFW_ERROR;
@@ -175,10 +220,26 @@ mem_alloc_error:
 }
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 
-AIFW_RESULT TFLM::_loadModel(void)
+/* Create the interpreter and plan tensors of the model in the arena */
+AIFW_RESULT TFLM::allocateTensors(void)
 {
-	AIFW_RESULT res;
-	mErrorReporter = std::make_shared<tflite::MicroErrorReporter>();
+#ifdef CONFIG_AIFW_SHARED_TENSOR_ARENA
+	if (!this->mPersistentArena || !this->mTensorArena || AIFW_TFLM_PERSISTENT_POOL_SIZE < tflite::MicroAllocator::GetDefaultTailUsage(false)) {
+		AIFW_LOGE("Tensor arena is not available");
+		return AIFW_NO_MEM;
+	}
+	tflite::MicroAllocator *allocator = tflite::MicroAllocator::Create(
+		this->mPersistentArena.get(),
+		AIFW_TFLM_PERSISTENT_POOL_SIZE,
+		this->mTensorArena.get(),
+		this->mTensorArenaSize);
+	this->mInterpreter = std::make_shared<tflite::MicroInterpreter>(
+		this->mModel,
+		g_Resolver,
+		allocator,
+		nullptr,
+		&g_Profiler);
+#else
 	this->mInterpreter = std::make_shared<tflite::MicroInterpreter>(
 		this->mModel,
 		g_Resolver,
@@ -186,6 +247,7 @@ AIFW_RESULT TFLM::_loadModel(void)
 		this->mTensorArenaSize,
 		nullptr,
 		&g_Profiler);
+#endif /* CONFIG_AIFW_SHARED_TENSOR_ARENA */
 
 	TfLiteStatus allocate_status = this->mInterpreter->AllocateTensors();
 	if (allocate_status != kTfLiteOk) {
@@ -193,11 +255,59 @@ AIFW_RESULT TFLM::_loadModel(void)
 		AIFW_LOGE("AllocateTensors() failed");
 		return AIFW_ERROR;
 	}
-	AIFW_LOGV("AllocateTensors success.");
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	this->mInput = this->mInterpreter->input(0);
 	this->mOutput = this->mInterpreter->output(0);
+#else
+	if (this->mInputList && this->mOutputList) {
+		for (uint16_t i = 0; i < this->mInputSetCount; i++) {
+			this->mInputList[i] = this->mInterpreter->input(i);
+		}
+		for (uint16_t i = 0; i < this->mOutputSetCount; i++) {
+			this->mOutputList[i] = this->mInterpreter->output(i);
+		}
+	}
+#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+	return AIFW_OK;
+}
+
+#ifdef CONFIG_AIFW_SHARED_TENSOR_ARENA
+/* The plan of the model is kept, only the contents of the shared arena are overwritten by other models. */
+AIFW_RESULT TFLM::acquire(void)
+{
+	pthread_mutex_lock(&g_ArenaUseLock);
+	return AIFW_OK;
+}
+
+void TFLM::release(void)
+{
+	pthread_mutex_unlock(&g_ArenaUseLock);
+}
+#endif /* CONFIG_AIFW_SHARED_TENSOR_ARENA */
+
+AIFW_RESULT TFLM::_loadModel(void)
+{
+#ifdef CONFIG_AIFW_SHARED_TENSOR_ARENA
+	/* Planning uses the shared arena for temporary allocations. */
+	pthread_mutex_lock(&g_ArenaUseLock);
+	AIFW_RESULT res = loadTensors();
+	pthread_mutex_unlock(&g_ArenaUseLock);
+	return res;
+#else
+	return loadTensors();
+#endif /* CONFIG_AIFW_SHARED_TENSOR_ARENA */
+}
 
+AIFW_RESULT TFLM::loadTensors(void)
+{
+	AIFW_RESULT res;
+	mErrorReporter = std::make_shared<tflite::MicroErrorReporter>();
+	res = allocateTensors();
+	if (res != AIFW_OK) {
+		return res;
+	}
+	AIFW_LOGV("AllocateTensors success.");
+#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	int input_dims_size = this->mInput->dims->size;
 	int output_dims_size = this->mOutput->dims->size;
 #if 0
@@ -293,34 +403,40 @@ void TFLM::getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList,
 }
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 
-#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-/* Run inference : with input data "features" and return output data ptr(Use output dimension to parse it) */
-void *TFLM::invoke(void *inputData)
+/* Input and output tensors stay in the tensor arena, so model buffers are bound to them without copying */
+float *TFLM::getInputBuffer(uint16_t index)
 {
-	float *value = (float *)(inputData);
-	for (int i = 0; i < this->mModelInputSize; i++) {
-		this->mInput->data.f[i] = value[i];
+#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	if (index != 0) {
+		return NULL;
 	}
-	AIFW_START_TIMER
-	TfLiteStatus invokeStatus = this->mInterpreter->Invoke();
-	AIFW_END_TIMER
-	if (invokeStatus != kTfLiteOk) {
-		this->mErrorReporter->Report("Invoke failed");
-		AIFW_LOGE("Invoke failed");
+	return this->mInput->data.f;
+#else
+	if (index >= this->mInputSetCount) {
 		return NULL;
 	}
-	return this->mOutput->data.data;
+	return this->mInputList[index]->data.f;
+#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 }
-#else
-/* Run inference : with input data "features", store output data in outputData parameter and return AIFW_OK on success */
-AIFW_RESULT TFLM::invoke(void *inputData, void *outputData)
+
+float *TFLM::getOutputBuffer(uint16_t index)
 {
-	float **value = (float **)(inputData);
-	for (uint16_t i = 0; i < this->mInputSetCount; i++) {
-		for (uint16_t j = 0; j < this->mInputSizeList[i]; j++) {
-			this->mInputList[i]->data.f[j] = value[i][j];
-		}
+#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	if (index != 0) {
+		return NULL;
 	}
+	return this->mOutput->data.f;
+#else
+	if (index >= this->mOutputSetCount) {
+		return NULL;
+	}
+	return this->mOutputList[index]->data.f;
+#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+}
+
+/* Run inference : with input data already written in input tensors, output data is left in output tensors */
+AIFW_RESULT TFLM::invoke(void)
+{
 	AIFW_START_TIMER
 	TfLiteStatus invokeStatus = this->mInterpreter->Invoke();
 	AIFW_END_TIMER
@@ -329,12 +445,7 @@ AIFW_RESULT TFLM::invoke(void *inputData, void *outputData)
 		AIFW_LOGE("Invoke failed");
 		return AIFW_ERROR;
 	}
-	float **outputRef = (float **)(outputData);
-	for (uint16_t i = 0; i < this->mOutputSetCount; i++) {
-		outputRef[i] = (float *)this->mOutputList[i]->data.data;
-	}
 	return AIFW_OK;
 }
-#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 } /* namespace aifw */
 
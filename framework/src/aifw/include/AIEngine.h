@@ -80,22 +80,29 @@ public:
 	 */
 	virtual AIFW_RESULT loadModel(const unsigned char *model) = 0;
 
-#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	/**
-	 * @brief Run the inference with the given inputData.
-	 * @param [in] inputData: Input data for model invoke.
-	 * @return: Void * pointer to output result data.
+	 * @brief Gives the buffer of a model input tensor. Input values for the next invoke are written directly in it.
+	 * Buffer is valid until the next invoke.
+	 * @param [in] index: Index of input tensor.
+	 * @return: Pointer to input tensor data. NULL if index is invalid.
 	 */
-	virtual void *invoke(void *inputData) = 0;
-#else
+	virtual float *getInputBuffer(uint16_t index) = 0;
+
+	/**
+	 * @brief Gives the buffer of a model output tensor which holds the output of the latest invoke.
+	 * Buffer is valid until the next invoke.
+	 * @param [in] index: Index of output tensor.
+	 * @return: Pointer to output tensor data. NULL if index is invalid.
+	 */
+	virtual float *getOutputBuffer(uint16_t index) = 0;
+
 	/**
-	 * @brief Run the inference with the given inputData.
-	 * @param [in] inputData: Input data for model invoke.
-	 * @param [out] outputData: Pointer to Output Data for storing output of invoke.
+	 * @brief Run the inference with the values written in the input tensor buffers.
 	 * @return: AIFW_RESULT enum object.
 	 */
-	virtual AIFW_RESULT invoke(void *inputData, void *outputData) = 0;
+	virtual AIFW_RESULT invoke(void) = 0;
 
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	/**
 	 * @brief Pass model dimensions to AIModel to allocate memory.
 	 * @param [in] inputSetCount: Number of Input sets for model invoke.
@@ -107,6 +114,23 @@ public:
 	virtual void getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList,  uint16_t *outputSetCount, uint16_t **outputSizeList) = 0;
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 
+	/**
+	 * @brief Takes the resources of the engine needed from filling input to reading output of an invoke.
+	 * Engines sharing a tensor arena with other models wait here until no other model uses it.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	virtual AIFW_RESULT acquire(void)
+	{
+		return AIFW_OK;
+	}
+
+	/**
+	 * @brief Gives back the resources taken by acquire.
+	 */
+	virtual void release(void)
+	{
+	}
+
 	/**
 	 * @brief: Reset the model state.
 	 * @return: AIFW_RESULT enum object.
@@ -51,10 +51,10 @@ public:
 	~ONERTM();
 	AIFW_RESULT loadModel(const char *file);
 	AIFW_RESULT loadModel(const unsigned char *model);
-#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	void *invoke(void *inputData);
-#else
-	AIFW_RESULT invoke(void *inputData, void *outputData);
+	float *getInputBuffer(uint16_t index);
+	float *getOutputBuffer(uint16_t index);
+	AIFW_RESULT invoke(void);
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	void getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList, uint16_t *outputSetCount, uint16_t **outputSizeList);
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 	AIFW_RESULT resetInferenceState(void);
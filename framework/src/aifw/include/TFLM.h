@@ -54,20 +54,29 @@ public:
 	~TFLM();
 	AIFW_RESULT loadModel(const char *file);
 	AIFW_RESULT loadModel(const unsigned char *model);
-#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	void *invoke(void *inputData);
-#else
-	AIFW_RESULT invoke(void *inputData, void *outputData);
+	float *getInputBuffer(uint16_t index);
+	float *getOutputBuffer(uint16_t index);
+	AIFW_RESULT invoke(void);
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	void getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList, uint16_t *outputSetCount, uint16_t **outputSizeList);
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 	AIFW_RESULT resetInferenceState(void);
+#ifdef CONFIG_AIFW_SHARED_TENSOR_ARENA
+	AIFW_RESULT acquire(void);
+	void release(void);
+#endif /* CONFIG_AIFW_SHARED_TENSOR_ARENA */
 
 private:
 	AIFW_RESULT _loadModel(void);
+	AIFW_RESULT loadTensors(void);
+	AIFW_RESULT allocateTensors(void);
 	void clearMemory(void);
 	AIFW_RESULT allocateMemory(void);
 	size_t mTensorArenaSize;
 	std::shared_ptr<uint8_t> mTensorArena;
+#ifdef CONFIG_AIFW_SHARED_TENSOR_ARENA
+	std::shared_ptr<uint8_t> mPersistentArena;
+#endif /* CONFIG_AIFW_SHARED_TENSOR_ARENA */
 	const tflite::Model *mModel;
 	char *mBuf;
 	std::shared_ptr<tflite::MicroInterpreter> mInterpreter;
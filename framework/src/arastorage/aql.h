@@ -194,6 +194,7 @@ enum token_e {
 	ATTRIBUTE,
 	BPLUSTREE,					/* 48 */
 
+	PARAMETER = 250,
 	INTEGER_VALUE = 251,
 	FLOAT_VALUE = 252,
 	STRING_VALUE = 253,
@@ -242,12 +243,21 @@ struct aql_adt_s {
 	uint8_t relation_count;
 	uint8_t attribute_count;
 	uint8_t value_count;
+	uint8_t param_count;
 	uint32_t optype;
 	uint8_t flags;
 	void *lvm_instance;
 };
 typedef struct aql_adt_s aql_adt_t;
 
+/* A parsed statement kept for repeated execution. Parameters in the value
+   list of INSERT have a value slot of DOMAIN_UNSPECIFIED holding the
+   parameter number, parameters in a WHERE clause are LVM_PARAMETER operands. */
+struct db_stmt_s {
+	aql_adt_t adt;
+	attribute_value_t params[AQL_PARAMETER_LIMIT];
+};
+
 /****************************************************************************
 * Global Function Prototypes
 ****************************************************************************/
@@ -260,5 +270,7 @@ void aql_add_relation(aql_adt_t *adt, char *rel);
 aql_status_t aql_parse(aql_adt_t *adt, char *query_string);
 db_result_t aql_add_attribute(aql_adt_t *adt, char *name, domain_t domain, unsigned element_size, int processed_only);
 db_result_t aql_add_value(aql_adt_t *adt, domain_t domain, void *value);
+db_result_t aql_add_parameter(aql_adt_t *adt, int is_value);
+void aql_free_values(aql_adt_t *adt);
 
 #endif							/* !AQL_H */
@@ -84,6 +84,7 @@ void aql_clear(aql_adt_t *adt)
 	adt->relation_count = 0;
 	adt->attribute_count = 0;
 	adt->value_count = 0;
+	adt->param_count = 0;
 	adt->flags = 0;
 	memset(adt->aggregators, 0, sizeof(adt->aggregators));
 }
@@ -160,3 +161,38 @@ db_result_t aql_add_value(aql_adt_t *adt, domain_t domain, void *value_ptr)
 
 	return DB_OK;
 }
+
+db_result_t aql_add_parameter(aql_adt_t *adt, int is_value)
+{
+	attribute_value_t *value;
+
+	if (adt->param_count == AQL_PARAMETER_LIMIT) {
+		return DB_LIMIT_ERROR;
+	}
+
+	if (is_value) {
+		/* The slot is filled with the bound value when the statement runs. */
+		if (adt->value_count == AQL_ATTRIBUTE_LIMIT) {
+			return DB_LIMIT_ERROR;
+		}
+		value = &adt->values[adt->value_count++];
+		value->domain = DOMAIN_UNSPECIFIED;
+		VALUE_LONG(value) = adt->param_count;
+	}
+	adt->param_count++;
+
+	return DB_OK;
+}
+
+void aql_free_values(aql_adt_t *adt)
+{
+	int i;
+
+	for (i = 0; i < adt->value_count; i++) {
+		if (adt->values[i].domain == DOMAIN_STRING && VALUE_STRING(&adt->values[i]) != NULL) {
+			free(VALUE_STRING(&adt->values[i]));
+			VALUE_STRING(&adt->values[i]) = NULL;
+		}
+	}
+	adt->value_count = 0;
+}
@@ -68,6 +68,7 @@
 #include "relation.h"
 #include "result.h"
 #include "aql.h"
+#include "lvm.h"
 
 /****************************************************************************
 * Private Functions
@@ -121,9 +122,6 @@ db_result_t aql_deinit_handle(db_handle_t **handle)
 	return res;
 }
 
-/****************************************************************************
-* Public Functions
-****************************************************************************/
 db_result_t aql_get_parse_result(char *format, aql_adt_t *adt)
 {
 	if (format == NULL) {
@@ -146,30 +144,23 @@ relation_t *aql_get_relation(aql_adt_t *adt)
 	return relation_load(adt->relations[first_rel_arg]);
 }
 
-db_result_t db_exec(char *format)
+static db_result_t aql_exec(aql_adt_t *adt)
 {
 	db_result_t res;
-	aql_adt_t adt;
 	relation_t *rel = NULL;
 	aql_attribute_t *attr;
 	attribute_t *relattr = NULL;
 	uint32_t optype;
-	res = aql_get_parse_result(format, &adt);
-
-	if (DB_ERROR(res)) {
-		DB_LOG_E("DB : Parsing Error in db_create : %d\n", res);
-		return DB_PARSING_ERROR;
-	}
 
-	optype = AQL_GET_OP_TYPE(AQL_GET_TYPE(&adt));
+	optype = AQL_GET_OP_TYPE(AQL_GET_TYPE(adt));
 	if (optype == AQL_OP_TYPE_QUERY) {
 		DB_LOG_E("DB : AQL OP TYPE Error \n");
 		return DB_ARGUMENT_ERROR;
 	}
 
-	optype = AQL_GET_EXEC_TYPE(AQL_GET_TYPE(&adt));
+	optype = AQL_GET_EXEC_TYPE(AQL_GET_TYPE(adt));
 	if (optype != AQL_TYPE_CREATE_RELATION) {
-		rel = aql_get_relation(&adt);
+		rel = aql_get_relation(adt);
 		if (rel == NULL) {
 			DB_LOG_E("DB : get relation Failed\n");
 			return DB_RELATIONAL_ERROR;
@@ -180,27 +171,27 @@ db_result_t db_exec(char *format)
 
 	switch (optype) {
 	case AQL_TYPE_CREATE_ATTRIBUTE:
-		attr = &(adt.attributes[0]);
+		attr = &(adt->attributes[0]);
 		if (relation_attribute_add(rel, DB_STORAGE, attr->name, attr->domain, attr->element_size) != NULL) {
 			res = DB_OK;
 		}
 		break;
 	case AQL_TYPE_CREATE_INDEX:
-		relattr = relation_attribute_get(rel, adt.attributes[0].name);
+		relattr = relation_attribute_get(rel, adt->attributes[0].name);
 		if (relattr == NULL) {
 			res = DB_NAME_ERROR;
 			break;
 		}
-		res = index_create(AQL_GET_INDEX_TYPE(&adt), rel, relattr);
+		res = index_create(AQL_GET_INDEX_TYPE(adt), rel, relattr);
 		break;
 	case AQL_TYPE_CREATE_RELATION:
-		if (relation_create(adt.relations[0], DB_STORAGE) != NULL) {
+		if (relation_create(adt->relations[0], DB_STORAGE) != NULL) {
 			res = DB_OK;
 		}
 		break;
 	case AQL_TYPE_INSERT:
 		if (relation_cardinality(rel) < DB_TUPLE_LIMIT) {
-			res = relation_insert(rel, adt.values);
+			res = relation_insert(rel, adt->values);
 			if (DB_SUCCESS(res)) {
 				res = DB_OK;
 			}
@@ -209,10 +200,10 @@ db_result_t db_exec(char *format)
 		}
 		break;
 	case AQL_TYPE_REMOVE_ATTRIBUTE:
-		res = relation_attribute_remove(rel, adt.attributes[0].name);
+		res = relation_attribute_remove(rel, adt->attributes[0].name);
 		break;
 	case AQL_TYPE_REMOVE_INDEX:
-		relattr = relation_attribute_get(rel, adt.attributes[0].name);
+		relattr = relation_attribute_get(rel, adt->attributes[0].name);
 		if (relattr != NULL) {
 			index_load(rel, relattr);
 			if (relattr->index != NULL) {
@@ -236,9 +227,8 @@ db_result_t db_exec(char *format)
 	return res;
 }
 
-db_cursor_t *db_query(char *format)
+static db_cursor_t *aql_query(aql_adt_t *adt)
 {
-	aql_adt_t adt;
 	relation_t *rel;
 	uint32_t optype;
 	db_handle_t *handler;
@@ -247,15 +237,12 @@ db_cursor_t *db_query(char *format)
 
 	handler = NULL;
 	cursor = NULL;
+	rel = NULL;
 
-	if (DB_ERROR(aql_get_parse_result(format, &adt))) {
-		DB_LOG_E("DB : Parsing Error in db_create\n");
-		return NULL;
-	}
-	optype = AQL_GET_OP_TYPE(AQL_GET_TYPE(&adt));
+	optype = AQL_GET_OP_TYPE(AQL_GET_TYPE(adt));
 	if (optype != AQL_OP_TYPE_QUERY) {
 		DB_LOG_E("DB : AQL OP TYPE Error \n");
-		return NULL;
+		goto errout;
 	}
 #ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
 	if (DB_SUCCESS(storage_flush_insert_buffer())) {
@@ -263,19 +250,19 @@ db_cursor_t *db_query(char *format)
 	}
 #endif
 
-	rel = aql_get_relation(&adt);
+	rel = aql_get_relation(adt);
 	if (rel == NULL) {
-		return NULL;
+		goto errout;
 	}
 
-	optype = AQL_GET_EXEC_TYPE(AQL_GET_TYPE(&adt));
+	optype = AQL_GET_EXEC_TYPE(AQL_GET_TYPE(adt));
 	switch (optype) {
 	case AQL_TYPE_REMOVE_TUPLES:
 		/* Overwrite the attribute array with a full copy of the original
 		   relation's attributes. */
-		adt.attribute_count = 0;
+		adt->attribute_count = 0;
 		for (attr_ptr = list_head(rel->attributes); attr_ptr != NULL; attr_ptr = attr_ptr->next) {
-			AQL_ADD_ATTRIBUTE(&adt, attr_ptr->name, DOMAIN_UNSPECIFIED, 0);
+			AQL_ADD_ATTRIBUTE(adt, attr_ptr->name, DOMAIN_UNSPECIFIED, 0);
 		}
 	/* FALLTHROUGH */
 	case AQL_TYPE_SELECT:
@@ -283,7 +270,7 @@ db_cursor_t *db_query(char *format)
 			DB_LOG_E("DB: Init handle failed\n");
 			goto errout;
 		}
-		if (DB_ERROR(relation_select(&handler, rel, &adt))) {
+		if (DB_ERROR(relation_select(&handler, rel, adt))) {
 			DB_LOG_E("DB: Failed relation_select\n");
 			goto errout;
 		}
@@ -304,6 +291,10 @@ db_cursor_t *db_query(char *format)
 			relation_release(rel);
 		}
 	}
+	if (handler == NULL) {
+		/* The handle owns the condition once the selection has started. */
+		free(adt->lvm_instance);
+	}
 	aql_deinit_handle(&handler);
 
 	return cursor;
@@ -312,8 +303,257 @@ errout:
 	if (rel != NULL) {
 		relation_release(rel);
 	}
+	if (handler == NULL) {
+		free(adt->lvm_instance);
+	}
 
 	aql_deinit_handle(&handler);
 
 	return NULL;
 }
+
+/* Build the statement to run from the prepared one and the bound values. */
+static db_result_t aql_bind_statement(db_stmt_t *stmt, aql_adt_t *adt)
+{
+	long operands[AQL_PARAMETER_LIMIT];
+	attribute_value_t *value;
+	lvm_instance_t *lvm;
+	int i;
+
+	memcpy(adt, &stmt->adt, sizeof(aql_adt_t));
+	adt->lvm_instance = NULL;
+
+	for (i = 0; i < adt->param_count; i++) {
+		if (stmt->params[i].domain == DOMAIN_UNSPECIFIED) {
+			DB_LOG_E("DB : Parameter %d is not bound\n", i);
+			return DB_ARGUMENT_ERROR;
+		}
+		operands[i] = VALUE_LONG(&stmt->params[i]);
+	}
+
+	for (i = 0; i < adt->value_count; i++) {
+		value = &adt->values[i];
+		if (value->domain == DOMAIN_UNSPECIFIED) {
+			memcpy(value, &stmt->params[VALUE_LONG(value)], sizeof(attribute_value_t));
+		}
+	}
+
+	if (stmt->adt.lvm_instance != NULL) {
+		/* The compiled condition is copied, the execution changes its variables. */
+		lvm = (lvm_instance_t *)malloc(sizeof(lvm_instance_t));
+		if (lvm == NULL) {
+			return DB_ALLOCATION_ERROR;
+		}
+		lvm_clone(lvm, (lvm_instance_t *)stmt->adt.lvm_instance);
+		if (LVM_ERROR(lvm_bind_parameters(lvm, operands, adt->param_count))) {
+			free(lvm);
+			return DB_ARGUMENT_ERROR;
+		}
+		AQL_SET_CONDITION(adt, lvm);
+	}
+
+	return DB_OK;
+}
+
+/* A parameter in the value list of INSERT has a value slot, the others are WHERE operands. */
+static int aql_is_value_parameter(db_stmt_t *stmt, int index)
+{
+	attribute_value_t *value;
+	int i;
+
+	for (i = 0; i < stmt->adt.value_count; i++) {
+		value = &stmt->adt.values[i];
+		if (value->domain == DOMAIN_UNSPECIFIED && VALUE_LONG(value) == index) {
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static db_result_t aql_bind_value(db_stmt_t *stmt, int index, domain_t domain)
+{
+	attribute_value_t *value;
+
+	if (stmt == NULL || index < 0 || index >= stmt->adt.param_count) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	value = &stmt->params[index];
+	if (value->domain == DOMAIN_STRING) {
+		free(VALUE_STRING(value));
+		VALUE_STRING(value) = NULL;
+	}
+	value->domain = domain;
+
+	return DB_OK;
+}
+
+/****************************************************************************
+* Public Functions
+****************************************************************************/
+db_result_t db_exec(char *format)
+{
+	db_result_t res;
+	aql_adt_t adt;
+
+	res = aql_get_parse_result(format, &adt);
+	if (DB_ERROR(res)) {
+		DB_LOG_E("DB : Parsing Error in db_create : %d\n", res);
+		return DB_PARSING_ERROR;
+	}
+
+	if (adt.param_count > 0) {
+		DB_LOG_E("DB : Parameters are allowed only in prepared statements\n");
+		res = DB_ARGUMENT_ERROR;
+	} else {
+		res = aql_exec(&adt);
+	}
+	aql_free_values(&adt);
+
+	return res;
+}
+
+db_cursor_t *db_query(char *format)
+{
+	aql_adt_t adt;
+
+	if (DB_ERROR(aql_get_parse_result(format, &adt))) {
+		DB_LOG_E("DB : Parsing Error in db_create\n");
+		return NULL;
+	}
+
+	if (adt.param_count > 0) {
+		DB_LOG_E("DB : Parameters are allowed only in prepared statements\n");
+		free(adt.lvm_instance);
+		return NULL;
+	}
+
+	return aql_query(&adt);
+}
+
+db_stmt_t *db_prepare(char *format)
+{
+	db_stmt_t *stmt;
+
+	stmt = (db_stmt_t *)malloc(sizeof(db_stmt_t));
+	if (stmt == NULL) {
+		DB_LOG_E("DB : Failed to allocate a statement\n");
+		return NULL;
+	}
+	memset(stmt, 0, sizeof(db_stmt_t));
+
+	if (DB_ERROR(aql_get_parse_result(format, &stmt->adt))) {
+		DB_LOG_E("DB : Parsing Error in db_prepare\n");
+		aql_free_values(&stmt->adt);
+		free(stmt);
+		return NULL;
+	}
+
+	return stmt;
+}
+
+db_result_t db_bind_int(db_stmt_t *stmt, int index, long value)
+{
+	db_result_t res;
+
+	res = aql_bind_value(stmt, index, DOMAIN_INT);
+	if (DB_SUCCESS(res)) {
+		VALUE_LONG(&stmt->params[index]) = value;
+	}
+
+	return res;
+}
+
+db_result_t db_bind_string(db_stmt_t *stmt, int index, char *value)
+{
+	db_result_t res;
+	unsigned char *str;
+	int str_size;
+
+	if (value == NULL || stmt == NULL || index < 0 || index >= stmt->adt.param_count) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	/* The conditions of a WHERE clause compare numbers only. */
+	if (!aql_is_value_parameter(stmt, index)) {
+		DB_LOG_E("DB : Parameter %d is in a WHERE clause, a string can't be bound\n", index);
+		return DB_ARGUMENT_ERROR;
+	}
+
+	str_size = strlen(value);
+	if (str_size >= AQL_MAX_VALUE_LENGTH) {
+		return DB_LIMIT_ERROR;
+	}
+
+	str = (unsigned char *)malloc(str_size + 1);
+	if (str == NULL) {
+		return DB_ALLOCATION_ERROR;
+	}
+	memcpy(str, value, str_size + 1);
+
+	res = aql_bind_value(stmt, index, DOMAIN_STRING);
+	if (DB_ERROR(res)) {
+		free(str);
+		return res;
+	}
+	VALUE_STRING(&stmt->params[index]) = str;
+
+	return DB_OK;
+}
+
+db_result_t db_step(db_stmt_t *stmt)
+{
+	db_result_t res;
+	aql_adt_t adt;
+
+	if (stmt == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	if (AQL_GET_OP_TYPE(AQL_GET_TYPE(&stmt->adt)) == AQL_OP_TYPE_QUERY) {
+		DB_LOG_E("DB : AQL OP TYPE Error \n");
+		return DB_ARGUMENT_ERROR;
+	}
+
+	res = aql_bind_statement(stmt, &adt);
+	if (DB_ERROR(res)) {
+		return res;
+	}
+
+	return aql_exec(&adt);
+}
+
+db_cursor_t *db_step_query(db_stmt_t *stmt)
+{
+	aql_adt_t adt;
+
+	if (stmt == NULL) {
+		return NULL;
+	}
+
+	if (DB_ERROR(aql_bind_statement(stmt, &adt))) {
+		free(adt.lvm_instance);
+		return NULL;
+	}
+
+	return aql_query(&adt);
+}
+
+db_result_t db_finalize(db_stmt_t *stmt)
+{
+	int i;
+
+	if (stmt == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	for (i = 0; i < stmt->adt.param_count; i++) {
+		aql_bind_value(stmt, i, DOMAIN_UNSPECIFIED);
+	}
+	aql_free_values(&stmt->adt);
+	free(stmt->adt.lvm_instance);
+	free(stmt);
+
+	return DB_OK;
+}
@@ -89,8 +89,9 @@ static const struct keyword keywords[] = {
 	{"*", MUL},
 	{"/", DIV},
 	{"#", COMMENT},
+	{"?", PARAMETER},
 
-	{">=", GEQ},				/* 13 */
+	{">=", GEQ},				/* 14 */
 	{"<=", LEQ},
 	{"<>", NOT_EQUAL},
 	{"<-", ASSIGN},
@@ -99,7 +100,7 @@ static const struct keyword keywords[] = {
 	{"ON", ON},
 	{"IN", IN},
 
-	{"ALL", ALL},				/* 21 */
+	{"ALL", ALL},				/* 22 */
 	{"AND", AND},
 	{"NOT", NOT},
 	{"SUM", SUM},
@@ -107,18 +108,18 @@ static const struct keyword keywords[] = {
 	{"MIN", MIN},
 	{"INT", INT},
 
-	{"INTO", INTO},				/* 28 */
+	{"INTO", INTO},				/* 29 */
 	{"FROM", FROM},
 	{"MEAN", MEAN},
 	{"JOIN", JOIN},
 	{"LONG", LONG},
 	{"TYPE", TYPE},
 
-	{"WHERE", WHERE},			/* 34 */
+	{"WHERE", WHERE},			/* 35 */
 	{"COUNT", COUNT},
 	{"INDEX", INDEX},
 
-	{"INSERT", INSERT},			/* 37 */
+	{"INSERT", INSERT},			/* 38 */
 	{"SELECT", SELECT},
 	{"REMOVE", REMOVE},
 	{"CREATE", CREATE},
@@ -128,16 +129,16 @@ static const struct keyword keywords[] = {
 	{"INLINE", INLINE},
 	{"REMAIN", REMAIN},
 
-	{"PROJECT", PROJECT},		/* 46 */
+	{"PROJECT", PROJECT},		/* 47 */
 
-	{"RELATION", RELATION},		/* 47 */
+	{"RELATION", RELATION},		/* 48 */
 
-	{"ATTRIBUTE", ATTRIBUTE},	/* 48 */
+	{"ATTRIBUTE", ATTRIBUTE},	/* 49 */
 	{"BPLUSTREE", BPLUSTREE}
 };
 
 /* Provides a pointer to the first keyword of a specific length. */
-static const int8_t skip_hint[] = { 0, 13, 21, 28, 34, 37, 46, 47, 48 };
+static const int8_t skip_hint[] = { 0, 14, 22, 29, 35, 38, 47, 48, 49 };
 
 static char separators[] = "#.;,() \t\n";
 
@@ -261,6 +261,11 @@ PARSER(values)
 	case INTEGER_VALUE:
 		AQL_ADD_VALUE(adt, DOMAIN_INT, VALUE);
 		break;
+	case PARAMETER:
+		if (DB_ERROR(aql_add_parameter(adt, 1))) {
+			RETURN(SYNTAX_ERROR);
+		}
+		break;
 	default:
 		RETURN(SYNTAX_ERROR);
 	}
@@ -298,6 +303,11 @@ PARSER(operand)
 			RETURN(SYNTAX_ERROR);
 		}
 		break;
+	case PARAMETER:
+		if (DB_ERROR(aql_add_parameter(adt, 0)) || LVM_ERROR(lvm_set_parameter(p, adt->param_count - 1))) {
+			RETURN(SYNTAX_ERROR);
+		}
+		break;
 	default:
 		RETURN(SYNTAX_ERROR);
 	}
@@ -65,6 +65,7 @@
 #include "db_debug.h"
 #include "result.h"
 #include "aql.h"
+#include "buffer_pool.h"
 #include <arastorage/arastorage.h>
 
 /****************************************************************************
@@ -73,6 +74,10 @@
 db_result_t db_init(void)
 {
 	db_result_t res;
+	res = buffer_pool_init(CONFIG_ARASTORAGE_BUFFER_POOL_PAGES);
+	if (res != DB_OK) {
+		return res;
+	}
 	res = relation_init();
 	if (res != DB_OK) {
 		return res;
@@ -97,9 +102,47 @@ db_result_t db_deinit()
 #endif
 	relation_deinit();
 	index_deinit();
+	buffer_pool_deinit();
+	return DB_OK;
+}
+
+db_result_t db_set_buffer_pool_size(unsigned int npages)
+{
+	return buffer_pool_resize(npages);
+}
+
+db_result_t db_get_buffer_pool_stats(db_buffer_pool_stats_t *stats, bool reset)
+{
+	if (stats == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+	buffer_pool_get_stats(stats);
+	if (reset) {
+		buffer_pool_reset_stats();
+	}
 	return DB_OK;
 }
 
+db_result_t db_bulk_insert(char *relation_name, db_value_t *values, tuple_id_t nrows)
+{
+	relation_t *rel;
+	db_result_t res;
+
+	if (relation_name == NULL || values == NULL) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	rel = relation_load(relation_name);
+	if (rel == NULL) {
+		DB_LOG_E("DB : get relation Failed\n");
+		return DB_RELATIONAL_ERROR;
+	}
+	res = relation_bulk_insert(rel, values, nrows);
+	relation_release(rel);
+
+	return res;
+}
+
 void db_set_output_function(db_output_function_t f)
 {
 	output = f;
@@ -88,17 +88,8 @@ struct attribute_s {
 
 typedef struct attribute_s attribute_t;
 
-struct attribute_value_s {
-	union {
-		int int_value;
-		long long_value;
-		double double_value;
-		unsigned char *string_value;
-	} u;
-	domain_t domain;
-};
-
-typedef struct attribute_value_s attribute_value_t;
+/* Same as the public db_value_t, so bulk inserted values are used as is */
+typedef struct db_value_s attribute_value_t;
 
 #define VALUE_LONG(value)   (value)->u.long_value
 #define VALUE_INT(value)    (value)->u.int_value
@@ -0,0 +1,565 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "buffer_pool.h"
+#include "db_debug.h"
+#include "storage.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define FRAME_STATE_VALID 1
+#define FRAME_STATE_LOCK  2
+#define FRAME_STATE_DIRTY 4
+#define FRAME_STATE_REF   8
+
+#define FRAME_NONE        -1
+
+#define IS_FRAME(f, s)    (((f)->state & (s)) == (s))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+struct frame_s {
+	db_storage_id_t storage;	/* Storage the page belongs to */
+	unsigned long offset;		/* Byte offset of the page in the storage */
+	uint16_t size;				/* Valid bytes of the page */
+	uint8_t state;				/* FRAME_STATE_* */
+	int16_t hash_next;			/* Next frame in the same hash chain */
+	unsigned char *data;
+};
+typedef struct frame_s frame_t;
+
+struct buffer_pool_s {
+	frame_t *frames;
+	unsigned char *pages;
+	int16_t *hash;				/* Heads of hash chains, FRAME_NONE if empty */
+	unsigned int npages;
+	unsigned int hash_mask;
+	unsigned int clock_hand;
+	db_buffer_pool_stats_t stats;
+	pthread_mutex_t lock;
+};
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+static struct buffer_pool_s g_pool = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static unsigned int pool_hash(db_storage_id_t storage, unsigned long offset)
+{
+	unsigned long h = offset ^ (offset >> 9) ^ ((unsigned long)storage * 2654435761UL);
+
+	return (unsigned int)(h ^ (h >> 16)) & g_pool.hash_mask;
+}
+
+static frame_t *pool_lookup(db_storage_id_t storage, unsigned long offset)
+{
+	int16_t i = g_pool.hash[pool_hash(storage, offset)];
+
+	while (i != FRAME_NONE) {
+		frame_t *frame = &g_pool.frames[i];
+		if (frame->storage == storage && frame->offset == offset) {
+			return frame;
+		}
+		i = frame->hash_next;
+	}
+	return NULL;
+}
+
+static void pool_unhash(frame_t *frame)
+{
+	int16_t idx = frame - g_pool.frames;
+	int16_t *link = &g_pool.hash[pool_hash(frame->storage, frame->offset)];
+
+	while (*link != FRAME_NONE) {
+		if (*link == idx) {
+			*link = frame->hash_next;
+			break;
+		}
+		link = &g_pool.frames[*link].hash_next;
+	}
+	frame->hash_next = FRAME_NONE;
+	frame->state = 0;
+}
+
+static void pool_hash_insert(frame_t *frame, db_storage_id_t storage, unsigned long offset)
+{
+	unsigned int h = pool_hash(storage, offset);
+
+	frame->storage = storage;
+	frame->offset = offset;
+	frame->hash_next = g_pool.hash[h];
+	g_pool.hash[h] = frame - g_pool.frames;
+}
+
+static int pool_write_frame(frame_t *frame)
+{
+	if (DB_ERROR(storage_write_to(frame->storage, frame->data, frame->offset, frame->size))) {
+		DB_LOG_E("DB: buffer pool write back failed, storage %d offset %lu\n", frame->storage, frame->offset);
+		return ERROR;
+	}
+	frame->state &= ~FRAME_STATE_DIRTY;
+	g_pool.stats.writebacks++;
+	return OK;
+}
+
+/* Write back a batch of dirty pages in offset order, so that the storage sees sequential writes */
+static void pool_write_batch(frame_t **batch, int count)
+{
+	int i;
+	int j;
+
+	for (i = 1; i < count; i++) {
+		frame_t *frame = batch[i];
+		for (j = i - 1; j >= 0 && batch[j]->offset > frame->offset; j--) {
+			batch[j + 1] = batch[j];
+		}
+		batch[j + 1] = frame;
+	}
+	for (i = 0; i < count; i++) {
+		pool_write_frame(batch[i]);
+	}
+	g_pool.stats.flushes++;
+}
+
+/*
+ * Write back a dirty victim together with other cold dirty pages of the same
+ * storage. The later evictions of those pages then need no I/O.
+ */
+static int pool_clean_victim(frame_t *victim)
+{
+	frame_t *batch[CONFIG_ARASTORAGE_BUFFER_WRITEBACK_BATCH];
+	int count = 0;
+	unsigned int i;
+
+	batch[count++] = victim;
+	for (i = 0; i < g_pool.npages && count < CONFIG_ARASTORAGE_BUFFER_WRITEBACK_BATCH; i++) {
+		frame_t *frame = &g_pool.frames[i];
+		if (frame == victim || frame->storage != victim->storage) {
+			continue;
+		}
+		if (IS_FRAME(frame, FRAME_STATE_VALID | FRAME_STATE_DIRTY) && !(frame->state & (FRAME_STATE_LOCK | FRAME_STATE_REF))) {
+			batch[count++] = frame;
+		}
+	}
+	pool_write_batch(batch, count);
+
+	return (victim->state & FRAME_STATE_DIRTY) ? ERROR : OK;
+}
+
+/* Find a frame to reuse with the clock algorithm, locked pages are skipped */
+static frame_t *pool_get_victim(void)
+{
+	unsigned int scanned;
+	frame_t *frame;
+
+	for (scanned = 0; scanned < 2 * g_pool.npages; scanned++) {
+		frame = &g_pool.frames[g_pool.clock_hand];
+		g_pool.clock_hand = (g_pool.clock_hand + 1) % g_pool.npages;
+
+		if (!(frame->state & FRAME_STATE_VALID)) {
+			return frame;
+		}
+		if (frame->state & FRAME_STATE_LOCK) {
+			continue;
+		}
+		if (frame->state & FRAME_STATE_REF) {
+			frame->state &= ~FRAME_STATE_REF;
+			continue;
+		}
+		if ((frame->state & FRAME_STATE_DIRTY) && pool_clean_victim(frame) != OK) {
+			continue;
+		}
+		g_pool.stats.evictions++;
+		pool_unhash(frame);
+		return frame;
+	}
+
+	DB_LOG_E("DB: no page available in buffer pool\n");
+	return NULL;
+}
+
+static db_result_t pool_alloc(unsigned int npages)
+{
+	unsigned int nhash = 1;
+	unsigned int i;
+
+	if (npages == 0 || npages > INT16_MAX) {
+		return DB_ARGUMENT_ERROR;
+	}
+	while (nhash < npages) {
+		nhash <<= 1;
+	}
+
+	g_pool.frames = (frame_t *)malloc(npages * sizeof(frame_t));
+	g_pool.pages = (unsigned char *)malloc(npages * CONFIG_ARASTORAGE_BUFFER_PAGE_SIZE);
+	g_pool.hash = (int16_t *)malloc(nhash * sizeof(int16_t));
+	if (g_pool.frames == NULL || g_pool.pages == NULL || g_pool.hash == NULL) {
+		free(g_pool.frames);
+		free(g_pool.pages);
+		free(g_pool.hash);
+		g_pool.frames = NULL;
+		g_pool.pages = NULL;
+		g_pool.hash = NULL;
+		g_pool.npages = 0;
+		return DB_ALLOCATION_ERROR;
+	}
+
+	for (i = 0; i < npages; i++) {
+		g_pool.frames[i].storage = INVALID_STORAGE_ID;
+		g_pool.frames[i].state = 0;
+		g_pool.frames[i].hash_next = FRAME_NONE;
+		g_pool.frames[i].data = g_pool.pages + i * CONFIG_ARASTORAGE_BUFFER_PAGE_SIZE;
+	}
+	for (i = 0; i < nhash; i++) {
+		g_pool.hash[i] = FRAME_NONE;
+	}
+	g_pool.npages = npages;
+	g_pool.hash_mask = nhash - 1;
+	g_pool.clock_hand = 0;
+	return DB_OK;
+}
+
+static void pool_free(void)
+{
+	free(g_pool.frames);
+	free(g_pool.pages);
+	free(g_pool.hash);
+	g_pool.frames = NULL;
+	g_pool.pages = NULL;
+	g_pool.hash = NULL;
+	g_pool.npages = 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+db_result_t buffer_pool_init(unsigned int npages)
+{
+	db_result_t result;
+
+	pthread_mutex_lock(&g_pool.lock);
+	if (g_pool.frames != NULL) {
+		pthread_mutex_unlock(&g_pool.lock);
+		return DB_OK;
+	}
+	result = pool_alloc(npages);
+	memset(&g_pool.stats, 0, sizeof(g_pool.stats));
+	pthread_mutex_unlock(&g_pool.lock);
+
+	return result;
+}
+
+void buffer_pool_deinit(void)
+{
+	unsigned int i;
+
+	pthread_mutex_lock(&g_pool.lock);
+	for (i = 0; i < g_pool.npages; i++) {
+		if (IS_FRAME(&g_pool.frames[i], FRAME_STATE_VALID | FRAME_STATE_DIRTY)) {
+			pool_write_frame(&g_pool.frames[i]);
+		}
+	}
+	pool_free();
+	pthread_mutex_unlock(&g_pool.lock);
+}
+
+/* Change the number of pages at runtime. Dirty pages are written back first. */
+db_result_t buffer_pool_resize(unsigned int npages)
+{
+	unsigned int i;
+
+	pthread_mutex_lock(&g_pool.lock);
+	for (i = 0; i < g_pool.npages; i++) {
+		if (g_pool.frames[i].state & FRAME_STATE_LOCK) {
+			pthread_mutex_unlock(&g_pool.lock);
+			return DB_BUSY_ERROR;
+		}
+	}
+	for (i = 0; i < g_pool.npages; i++) {
+		if (IS_FRAME(&g_pool.frames[i], FRAME_STATE_VALID | FRAME_STATE_DIRTY) && pool_write_frame(&g_pool.frames[i]) != OK) {
+			pthread_mutex_unlock(&g_pool.lock);
+			return DB_STORAGE_ERROR;
+		}
+	}
+	pool_free();
+	if (pool_alloc(npages) != DB_OK) {
+		/* Fall back to the default size so that the database keeps working */
+		pool_alloc(CONFIG_ARASTORAGE_BUFFER_POOL_PAGES);
+		pthread_mutex_unlock(&g_pool.lock);
+		return DB_ALLOCATION_ERROR;
+	}
+	pthread_mutex_unlock(&g_pool.lock);
+	return DB_OK;
+}
+
+size_t buffer_pool_page_size(void)
+{
+	return CONFIG_ARASTORAGE_BUFFER_PAGE_SIZE;
+}
+
+/*
+ * Return the page at 'offset' of 'storage', reading it from storage when it
+ * is not cached. The page is locked until buffer_pool_unlock() is called.
+ * NULL is returned if the page is already locked or no frame is available.
+ */
+void *buffer_pool_read(db_storage_id_t storage, unsigned long offset, size_t size, uint8_t flags)
+{
+	frame_t *frame;
+
+	if (size > CONFIG_ARASTORAGE_BUFFER_PAGE_SIZE) {
+		return NULL;
+	}
+
+	pthread_mutex_lock(&g_pool.lock);
+	if (g_pool.frames == NULL) {
+		pthread_mutex_unlock(&g_pool.lock);
+		return NULL;
+	}
+
+	frame = pool_lookup(storage, offset);
+	if (frame != NULL && size > frame->size) {
+		/* The cached page is shorter than the request, write it back and read all of it */
+		if (frame->state & FRAME_STATE_LOCK) {
+			pthread_mutex_unlock(&g_pool.lock);
+			return NULL;
+		}
+		g_pool.stats.misses++;
+		if (IS_FRAME(frame, FRAME_STATE_DIRTY) && pool_write_frame(frame) != OK) {
+			pthread_mutex_unlock(&g_pool.lock);
+			return NULL;
+		}
+		if (DB_ERROR(storage_read_from(storage, frame->data, offset, size))) {
+			DB_LOG_E("DB: buffer pool read failed, storage %d offset %lu\n", storage, offset);
+			pool_unhash(frame);
+			pthread_mutex_unlock(&g_pool.lock);
+			return NULL;
+		}
+		frame->size = size;
+	} else if (frame != NULL) {
+		if (frame->state & FRAME_STATE_LOCK) {
+			pthread_mutex_unlock(&g_pool.lock);
+			return NULL;
+		}
+		g_pool.stats.hits++;
+	} else {
+		g_pool.stats.misses++;
+		frame = pool_get_victim();
+		if (frame == NULL) {
+			pthread_mutex_unlock(&g_pool.lock);
+			return NULL;
+		}
+		if (DB_ERROR(storage_read_from(storage, frame->data, offset, size))) {
+			DB_LOG_E("DB: buffer pool read failed, storage %d offset %lu\n", storage, offset);
+			pthread_mutex_unlock(&g_pool.lock);
+			return NULL;
+		}
+		frame->size = size;
+		frame->state = FRAME_STATE_VALID;
+		pool_hash_insert(frame, storage, offset);
+	}
+
+	frame->state |= FRAME_STATE_LOCK | FRAME_STATE_REF;
+	if (flags & BUFFER_POOL_READ_DIRTY) {
+		frame->state |= FRAME_STATE_DIRTY;
+	}
+	pthread_mutex_unlock(&g_pool.lock);
+
+	return frame->data;
+}
+
+/*
+ * Put new contents of a page in the pool without reading it. The page is
+ * left dirty and unlocked. DB_BUSY_ERROR is returned if the page is locked.
+ */
+db_result_t buffer_pool_write(db_storage_id_t storage, unsigned long offset, void *data, size_t size)
+{
+	frame_t *frame;
+
+	if (size > CONFIG_ARASTORAGE_BUFFER_PAGE_SIZE) {
+		return DB_ARGUMENT_ERROR;
+	}
+
+	pthread_mutex_lock(&g_pool.lock);
+	if (g_pool.frames == NULL) {
+		pthread_mutex_unlock(&g_pool.lock);
+		return DB_ALLOCATION_ERROR;
+	}
+	frame = pool_lookup(storage, offset);
+	if (frame == NULL) {
+		frame = pool_get_victim();
+		if (frame == NULL) {
+			pthread_mutex_unlock(&g_pool.lock);
+			return DB_FULL_ERROR;
+		}
+		pool_hash_insert(frame, storage, offset);
+	} else if (frame->state & FRAME_STATE_LOCK) {
+		pthread_mutex_unlock(&g_pool.lock);
+		return DB_BUSY_ERROR;
+	}
+	memcpy(frame->data, data, size);
+	frame->size = size;
+	frame->state = FRAME_STATE_VALID | FRAME_STATE_DIRTY | FRAME_STATE_REF;
+	pthread_mutex_unlock(&g_pool.lock);
+
+	return DB_OK;
+}
+
+/* Replace the contents of a locked page, then unlock it */
+db_result_t buffer_pool_replace(db_storage_id_t storage, unsigned long offset, void *data, size_t size)
+{
+	frame_t *frame;
+
+	pthread_mutex_lock(&g_pool.lock);
+	frame = (g_pool.frames != NULL) ? pool_lookup(storage, offset) : NULL;
+	if (frame == NULL || !(frame->state & FRAME_STATE_LOCK) || size > frame->size) {
+		DB_LOG_E("DB: replace of a non existent or unlocked page\n");
+		pthread_mutex_unlock(&g_pool.lock);
+		return DB_ARGUMENT_ERROR;
+	}
+	memcpy(frame->data, data, size);
+	frame->state &= ~FRAME_STATE_LOCK;
+	frame->state |= FRAME_STATE_DIRTY;
+	pthread_mutex_unlock(&g_pool.lock);
+
+	return DB_OK;
+}
+
+static db_result_t pool_modify(db_storage_id_t storage, unsigned long offset, uint8_t set, uint8_t clear, bool drop)
+{
+	frame_t *frame;
+
+	pthread_mutex_lock(&g_pool.lock);
+	frame = (g_pool.frames != NULL) ? pool_lookup(storage, offset) : NULL;
+	if (frame == NULL) {
+		pthread_mutex_unlock(&g_pool.lock);
+		return DB_ARGUMENT_ERROR;
+	}
+	if (drop) {
+		pool_unhash(frame);
+	} else {
+		frame->state = (frame->state | set) & ~clear;
+	}
+	pthread_mutex_unlock(&g_pool.lock);
+
+	return DB_OK;
+}
+
+db_result_t buffer_pool_unlock(db_storage_id_t storage, unsigned long offset)
+{
+	return pool_modify(storage, offset, 0, FRAME_STATE_LOCK, false);
+}
+
+db_result_t buffer_pool_mark_dirty(db_storage_id_t storage, unsigned long offset)
+{
+	return pool_modify(storage, offset, FRAME_STATE_DIRTY, 0, false);
+}
+
+/* Drop a page without writing it back */
+db_result_t buffer_pool_invalidate(db_storage_id_t storage, unsigned long offset)
+{
+	return pool_modify(storage, offset, 0, 0, true);
+}
+
+/* Write back all dirty pages of a storage */
+db_result_t buffer_pool_flush(db_storage_id_t storage)
+{
+	frame_t *batch[CONFIG_ARASTORAGE_BUFFER_WRITEBACK_BATCH];
+	db_result_t result = DB_OK;
+	int count = 0;
+	unsigned int i;
+
+	pthread_mutex_lock(&g_pool.lock);
+	for (i = 0; i < g_pool.npages; i++) {
+		frame_t *frame = &g_pool.frames[i];
+		if (frame->storage != storage || !IS_FRAME(frame, FRAME_STATE_VALID | FRAME_STATE_DIRTY)) {
+			continue;
+		}
+		batch[count++] = frame;
+		if (count == CONFIG_ARASTORAGE_BUFFER_WRITEBACK_BATCH) {
+			pool_write_batch(batch, count);
+			count = 0;
+		}
+	}
+	if (count > 0) {
+		pool_write_batch(batch, count);
+	}
+	for (i = 0; i < g_pool.npages; i++) {
+		if (g_pool.frames[i].storage == storage && IS_FRAME(&g_pool.frames[i], FRAME_STATE_VALID | FRAME_STATE_DIRTY)) {
+			result = DB_STORAGE_ERROR;
+		}
+	}
+	pthread_mutex_unlock(&g_pool.lock);
+
+	return result;
+}
+
+/* Called before a storage is closed, its id may be reused by another file afterwards */
+void buffer_pool_release(db_storage_id_t storage)
+{
+	unsigned int i;
+
+	buffer_pool_flush(storage);
+
+	pthread_mutex_lock(&g_pool.lock);
+	for (i = 0; i < g_pool.npages; i++) {
+		frame_t *frame = &g_pool.frames[i];
+		if (frame->storage == storage && (frame->state & FRAME_STATE_VALID)) {
+			pool_unhash(frame);
+		}
+	}
+	pthread_mutex_unlock(&g_pool.lock);
+}
+
+void buffer_pool_get_stats(db_buffer_pool_stats_t *stats)
+{
+	unsigned int i;
+
+	pthread_mutex_lock(&g_pool.lock);
+	*stats = g_pool.stats;
+	stats->npages = g_pool.npages;
+	stats->dirty = 0;
+	for (i = 0; i < g_pool.npages; i++) {
+		if (IS_FRAME(&g_pool.frames[i], FRAME_STATE_VALID | FRAME_STATE_DIRTY)) {
+			stats->dirty++;
+		}
+	}
+	pthread_mutex_unlock(&g_pool.lock);
+}
+
+void buffer_pool_reset_stats(void)
+{
+	pthread_mutex_lock(&g_pool.lock);
+	memset(&g_pool.stats, 0, sizeof(g_pool.stats));
+	pthread_mutex_unlock(&g_pool.lock);
+}
@@ -0,0 +1,73 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __BUFFER_POOL_H__
+#define __BUFFER_POOL_H__
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <sys/types.h>
+#include <arastorage/arastorage.h>
+
+/****************************************************************************
+* Pre-processor Definitions
+****************************************************************************/
+#ifndef CONFIG_ARASTORAGE_BUFFER_POOL_PAGES
+#define CONFIG_ARASTORAGE_BUFFER_POOL_PAGES 24
+#endif
+
+#ifndef CONFIG_ARASTORAGE_BUFFER_PAGE_SIZE
+#define CONFIG_ARASTORAGE_BUFFER_PAGE_SIZE 512
+#endif
+
+#ifndef CONFIG_ARASTORAGE_BUFFER_WRITEBACK_BATCH
+#define CONFIG_ARASTORAGE_BUFFER_WRITEBACK_BATCH 4
+#endif
+
+/* Page is read from storage and marked dirty at once */
+#define BUFFER_POOL_READ_DIRTY 0x01
+
+/****************************************************************************
+* Global Function Prototypes
+****************************************************************************/
+/*
+ * All database pages (B+tree nodes, buckets and tuple pages) are cached in
+ * one pool of fixed size frames. A page is identified by its storage id and
+ * its byte offset in that storage. A page returned by buffer_pool_read() is
+ * locked, it is never evicted and can't be read again until it is unlocked.
+ */
+db_result_t buffer_pool_init(unsigned int npages);
+void buffer_pool_deinit(void);
+db_result_t buffer_pool_resize(unsigned int npages);
+size_t buffer_pool_page_size(void);
+
+void *buffer_pool_read(db_storage_id_t, unsigned long, size_t, uint8_t);
+db_result_t buffer_pool_write(db_storage_id_t, unsigned long, void *, size_t);
+db_result_t buffer_pool_replace(db_storage_id_t, unsigned long, void *, size_t);
+db_result_t buffer_pool_unlock(db_storage_id_t, unsigned long);
+db_result_t buffer_pool_mark_dirty(db_storage_id_t, unsigned long);
+db_result_t buffer_pool_invalidate(db_storage_id_t, unsigned long);
+
+db_result_t buffer_pool_flush(db_storage_id_t);
+void buffer_pool_release(db_storage_id_t);
+
+void buffer_pool_get_stats(db_buffer_pool_stats_t *);
+void buffer_pool_reset_stats(void);
+
+#endif							/* __BUFFER_POOL_H__ */
@@ -127,6 +127,11 @@
 #define AQL_ATTRIBUTE_LIMIT             9
 #endif							/* AQL_ATTRIBUTE_LIMIT */
 
+/* The maximum number of parameters in a prepared statement. */
+#ifndef AQL_PARAMETER_LIMIT
+#define AQL_PARAMETER_LIMIT             AQL_ATTRIBUTE_LIMIT
+#endif							/* AQL_PARAMETER_LIMIT */
+
 /*----------------------------------------------------------------------------*/
 
 /*
@@ -168,6 +173,11 @@
 #define DB_TUPLE_LIMIT          1000
 #endif							/* DB_TUPLE_LIMIT */
 
+/* The size of the buffer used to append tuples in a bulk insertion. */
+#ifndef CONFIG_ARASTORAGE_BULK_WRITE_SIZE
+#define CONFIG_ARASTORAGE_BULK_WRITE_SIZE 2048
+#endif
+
 /* The number of int array in a cursor. */
 #ifndef DB_CURSOR_LIMIT
 #define DB_CURSOR_LIMIT          ((DB_TUPLE_LIMIT / (sizeof(uint32_t)*8)) + 1)
@@ -226,10 +236,6 @@
 #define DB_HEAP_CACHE_LIMIT             6
 #endif							/* DB_HEAP_CACHE_LIMIT */
 
-#ifndef DB_TREE_CACHE_LIMIT
-#define DB_TREE_CACHE_LIMIT             10
-#endif
-
 #ifdef DB_WIP
 #undef DB_WIP						/* DB WORK IN PROGRESS */
 #endif
@@ -111,6 +111,13 @@ struct index_iterator_s {
 };
 typedef struct index_iterator_s index_iterator_t;
 
+/* A key and the tuple it points to, used for bulk insertion */
+struct index_entry_s {
+	long key;
+	tuple_id_t tuple_id;
+};
+typedef struct index_entry_s index_entry_t;
+
 struct index_api_s {
 	index_type_t type;
 	uint8_t flags;
@@ -121,6 +128,8 @@ struct index_api_s {
 	db_result_t(*insert)(index_t *, attribute_value_t *, tuple_id_t);
 	db_result_t(*delete)(index_t *, attribute_value_t *);
 	tuple_id_t(*get_next)(index_iterator_t *, uint8_t);
+	/* Optional, entries are inserted one by one when it is not given */
+	db_result_t(*bulk_insert)(index_t *, index_entry_t *, tuple_id_t);
 };
 
 typedef struct index_api_s index_api_t;
@@ -140,6 +149,7 @@ db_result_t index_destroy(index_t *);
 db_result_t index_load(relation_t *, attribute_t *);
 db_result_t index_release(index_t *);
 db_result_t index_insert(index_t *, attribute_value_t *, tuple_id_t);
+db_result_t index_bulk_insert(index_t *, index_entry_t *, tuple_id_t);
 db_result_t index_delete(index_t *, attribute_value_t *);
 db_result_t index_get_iterator(index_iterator_t *, index_t *, attribute_value_t *, attribute_value_t *);
 tuple_id_t index_get_next(index_iterator_t *, uint8_t);
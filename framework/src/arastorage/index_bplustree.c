@@ -63,6 +63,7 @@
 #include "storage.h"
 #include "random.h"
 #include "rw_locks.h"
+#include "buffer_pool.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -76,13 +77,8 @@
 #define EMPTY_NODE(node)        (node)->val[BRANCH_FACTOR-1] == 0
 #define KEY_MAX INT_MAX
 #define ROW_XOR 0xf6U
-#define NODE_STATE_VALID 1
-#define NODE_STATE_LOCK 2
-#define NODE_STATE_DIRTY 4
 #define ROOT_NODE_PARENT 255
 
-/* The total number of states possible of a node */
-#define NODE_STATES 255
 #define CONFIG_VACUUM_THRESHOLD 40
 
 #ifdef CONFIG_ARASTORAGE_ENABLE_VACUUM
@@ -92,37 +88,9 @@
 #define max(a, b) ({ __typeof__(a) _a = (a);  __typeof__(b) _b = (b); _a > _b ? _a : _b; })
 #define min(a, b) ({ __typeof__(a) _a = (a);  __typeof__(b) _b = (b); _a < _b ? _a : _b; })
 
-#define SET_NODE_STATE(node, type) \
-	do { \
-		node->node_state |= type; \
-	} while (0)
-
-#define UNSET_NODE_STATE(node, type) \
-	do { \
-		node->node_state &= ((type) ^ NODE_STATES); \
-	} while (0)
-
-#define REMOVE_ENTRY(node) \
-	do { \
-		node->prev->next = node->next; \
-		node->next->prev = node->prev; \
-	} while (0)
-
-#define PLACE_AT_HEAD(node, cache_type) \
-	do { \
-		cache_type->in_cache.head->next->prev = node; \
-		node->next = cache_type->in_cache.head->next; \
-		node->prev = cache_type->in_cache.head; \
-		cache_type->in_cache.head->next = node; \
-	} while (0)
-
-#define PLACE_AT_TAIL(node, cache_type) \
-	do { \
-		cache_type->in_cache.tail->prev->next = node; \
-		node->next = cache_type->in_cache.tail; \
-		node->prev = cache_type->in_cache.tail->prev; \
-		cache_type->in_cache.tail->prev = node; \
-	} while (0)
+/* Byte offsets of nodes and buckets, which identify them in the buffer pool */
+#define NODE_OFFSET(id) (base_offset + (unsigned long)(id) * sizeof(tree_node_t))
+#define BUCKET_OFFSET(id) ((unsigned long)(id) * sizeof(bucket_t))
 
 /****************************************************************************
  * Private Types
@@ -147,45 +115,6 @@ struct bucket_s {
 };
 typedef struct bucket_s bucket_t;
 
-struct qnode_s {
-	struct qnode_s *next;
-	struct qnode_s *prev;
-	uint8_t id;
-	uint8_t pos;
-	uint8_t node_state;
-};
-
-typedef struct qnode_s qnode_t;
-struct queue_s {
-	qnode_t *head;
-	qnode_t *tail;
-};
-typedef struct queue_s queue_t;
-
-/* A Bucket Cache Entry */
-struct bucket_cache_s {
-	bucket_t bucket;
-};
-
-/* A Tree Cache Entry */
-struct tree_cache_s {
-	tree_node_t node;
-};
-
-/* Bucket Cache Structure */
-typedef struct {
-	struct bucket_cache_s cache_t[DB_HEAP_CACHE_LIMIT];
-	queue_t in_cache;
-	uint8_t num;
-} bucket_cache_t;
-
-/* Tree Cache Structure */
-typedef struct {
-	struct tree_cache_s cache_t[DB_TREE_CACHE_LIMIT];
-	queue_t in_cache;
-	uint8_t num;
-} tree_cache_t;
-
 typedef enum {
 	NODE = 0,
 	BUCKET = 1
@@ -240,10 +169,8 @@ struct tree_s {
 	uint16_t inserted;			/*  Count of total number of tuples inserted  */
 	uint16_t deleted;			/*    Count of total number of tuples deleted  */
 	uint8_t levels;				/*  The depth of the bplus-tree including the buckets  */
-	tree_cache_t *node_cache;	/*  Structure to maintain node cache  */
-	bucket_cache_t *buck_cache;	/*   Structure to maintain bucket cache  */
-	pthread_mutex_t node_cache_lock;	/*  Maintains concurrency control over Node Cache  */
-	pthread_mutex_t buck_cache_lock;	/*  Maintains concurrency control over Bucket Cache  */
+	void *cache_reserved[2];	/*  Unused, nodes and buckets are cached in the buffer pool. Kept for the layout on flash  */
+	pthread_mutex_t cache_lock_reserved[2];
 	pthread_mutex_t bucket_lock;	/*  Maintains serialisability over in RAM Tree Structure  */
 	struct rw_lock_s tree_lock;	/*  A Reader Writer Lock used to maintain consistency in tree structure */
 };
@@ -259,13 +186,11 @@ static int base_offset = 0;
  ****************************************************************************/
 static int transform_key(int);
 static tree_node_t *tree_read(tree_t *, int);
-static int tree_write(tree_t *, int, tree_node_t *);
 static tree_result_t tree_insert(tree_t *, int);
 static pair_t *tree_find(tree_t *, int key);
 tree_result_t insert_item_btree(tree_t *, int, int);
 
 static bucket_t *bucket_read(tree_t *, int);
-static int bucket_write(tree_t *, int, bucket_t *);
 static bsplit_status_t bucket_split(tree_t *, int, int, pair_t *);
 static cache_result_t cache_bucket_append(tree_t *, int, pair_t *);
 static cache_result_t cache_write_bucket(tree_t *, int, bucket_t *);
@@ -282,6 +207,7 @@ static db_result_t release(index_t *);
 static db_result_t insert(index_t *, attribute_value_t *, tuple_id_t);
 static db_result_t delete(index_t *, attribute_value_t *);
 static tuple_id_t get_next(index_iterator_t *, uint8_t);
+static db_result_t bulk_insert(index_t *, index_entry_t *, tuple_id_t);
 
 #ifdef DB_WIP
 static db_result_t vacuum(tree_t *, relation_t *);
@@ -302,7 +228,8 @@ index_api_t index_bplustree = {
 	release,
 	insert,
 	delete,
-	get_next
+	get_next,
+	bulk_insert
 };
 
 /****************************************************************************
@@ -350,9 +277,13 @@ static db_result_t create(index_t *index)
 	size_t buck_size = 0;
 	int offset = 0;
 	db_result_t result;
-	uint8_t success = 0;
 	int curtime;
 
+	if (sizeof(bucket_t) > buffer_pool_page_size()) {
+		DB_LOG_E("DB: buffer pool page is smaller than a bucket\n");
+		return DB_LIMIT_ERROR;
+	}
+
 	curtime = time(NULL);
 	random_init(curtime);
 	tree_t *tree = bptree_malloc(sizeof(tree_t));
@@ -437,87 +368,11 @@ static db_result_t create(index_t *index)
 	/* Initialize the tree metadata. */
 	memset(&tree->lock_buckets, 0, sizeof(tree->lock_buckets));
 
-	/* Allocating node cache and initialising it */
-	tree->node_cache = bptree_malloc(sizeof(tree_cache_t));
-	if (tree->node_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->node_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->node_cache->in_cache.tail = end;
-				tree->node_cache->num = 0;
-			}
-		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE NODE CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		storage_remove(tree_filename);
-		storage_remove(bucket_filename);
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->node_cache->in_cache.head);
-			}
-			free(tree->node_cache);
-		}
-		free(tree);
-		return result;
-	}
-
-	/* Allocating bucket cache and initialising it */
-	tree->buck_cache = bptree_malloc(sizeof(bucket_cache_t));
-	success = 0;
-	if (tree->buck_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->buck_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->buck_cache->in_cache.tail = end;
-				tree->buck_cache->num = 0;
-			}
-		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE BUCKET CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		free(tree->node_cache->in_cache.tail);
-		free(tree->node_cache->in_cache.head);
-		free(tree->node_cache);
-		storage_remove(tree_filename);
-		storage_remove(bucket_filename);
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->buck_cache->in_cache.head);
-			}
-			free(tree->buck_cache);
-		}
-		free(tree);
-		return result;
-	}
-
 	tree->inserted = 0;
 	tree->deleted = 0;
 
 	/* Initialising Locks for concurrency control */
-	pthread_mutex_init(&(tree->node_cache_lock), NULL);
 	pthread_mutex_init(&(tree->bucket_lock), NULL);
-	pthread_mutex_init(&(tree->buck_cache_lock), NULL);
 	rw_init(&(tree->tree_lock));
 
 	tree->off_nodes = tree->off_buckets = 0;
@@ -562,8 +417,11 @@ static db_result_t load(index_t *index)
 	tree_t *tree;
 	db_storage_id_t fd;
 	char bucket_file[DB_MAX_FILENAME_LENGTH];
-	db_result_t result;
-	uint8_t success = 0;
+
+	if (sizeof(bucket_t) > buffer_pool_page_size()) {
+		DB_LOG_E("DB: buffer pool page is smaller than a bucket\n");
+		return DB_LIMIT_ERROR;
+	}
 
 	index->opaque_data = tree = bptree_malloc(sizeof(tree_t));
 	if (tree == NULL) {
@@ -592,75 +450,6 @@ static db_result_t load(index_t *index)
 	}
 	storage_close(fd);
 
-	tree->node_cache = bptree_malloc(sizeof(tree_cache_t));
-	if (tree->node_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->node_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->node_cache->in_cache.tail = end;
-				tree->node_cache->num = 0;
-			}
-		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE NODE CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->node_cache->in_cache.head);
-			}
-			free(tree->node_cache);
-		}
-		free(tree);
-		return result;
-	}
-
-	/* Allocating bucket cache and initialising it  */
-	tree->buck_cache = bptree_malloc(sizeof(bucket_cache_t));
-	success = 0;
-	if (tree->buck_cache != NULL) {
-		success |= 1;
-		qnode_t *head = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (head != NULL) {
-			success |= 2;
-			tree->buck_cache->in_cache.head = head;
-			qnode_t *end = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-			if (end != NULL) {
-				success |= 4;
-				head->prev = NULL;
-				end->next = NULL;
-				head->next = end;
-				end->prev = head;
-				tree->buck_cache->in_cache.tail = end;
-				tree->buck_cache->num = 0;
-			}
-		}
-	}
-	if (success != 7) {
-		DB_LOG_E("FAILED TO ALLOCATE BUCKET CACHE\n");
-		result = DB_ALLOCATION_ERROR;
-		free(tree->node_cache->in_cache.tail);
-		free(tree->node_cache->in_cache.head);
-		free(tree->node_cache);
-		if (success & 1) {
-			if (success & 2) {
-				free(tree->buck_cache->in_cache.head);
-			}
-			free(tree->buck_cache);
-		}
-		free(tree);
-		return result;
-	}
-
 	base_offset = sizeof(tree_t) + sizeof(bucket_file);
 	tree->tree_storage = storage_open(index->descriptor_file, O_RDWR);
 	tree->bucket_storage = storage_open(bucket_file, O_RDWR);
@@ -674,52 +463,19 @@ static db_result_t load(index_t *index)
 static db_result_t release(index_t *index)
 {
 	tree_t *tree;
-	qnode_t *tmp_node;
 
 	tree = index->opaque_data;
 	if (tree == NULL) {
 		return DB_ALLOCATION_ERROR;
 	}
-	if (tree->node_cache == NULL || tree->buck_cache == NULL) {
-		return DB_ALLOCATION_ERROR;
-	}
-	if ((tree->node_cache->in_cache.tail == NULL) || (tree->node_cache->in_cache.head == NULL)) {
-		return DB_ALLOCATION_ERROR;
-	}
-	if ((tree->buck_cache->in_cache.tail == NULL) || (tree->buck_cache->in_cache.head == NULL)) {
-		return DB_ALLOCATION_ERROR;
-	}
 	storage_write_to(tree->tree_storage, tree, 0, sizeof(tree_t));
-	/* Bucket Cache being flushed */
-	tmp_node = tree->buck_cache->in_cache.head->next;
-	free(tmp_node->prev);
-	while (tmp_node != tree->buck_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			bucket_write(tree, tmp_node->id, &(tree->buck_cache->cache_t[tmp_node->pos].bucket));
-		}
-		tmp_node = tmp_node->next;
-		if (tmp_node->prev) {
-			free(tmp_node->prev);
-		}
-	}
-	free(tree->buck_cache->in_cache.tail);
-	tmp_node = tree->node_cache->in_cache.head->next;
-	free(tmp_node->prev);
-	while (tmp_node != tree->node_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			tree_write(tree, tmp_node->id, &(tree->node_cache->cache_t[tmp_node->pos].node));
-		}
-		tmp_node = tmp_node->next;
-		if (tmp_node->prev) {
-			free(tmp_node->prev);
-		}
-	}
-	free(tree->node_cache->in_cache.tail);
+
+	/* Dirty buckets and nodes are written back from the buffer pool */
+	buffer_pool_flush(tree->bucket_storage);
+	buffer_pool_flush(tree->tree_storage);
 	storage_close(tree->bucket_storage);
 	storage_close(tree->tree_storage);
 
-	free(tree->node_cache);
-	free(tree->buck_cache);
 	free(tree);
 	return DB_OK;
 }
@@ -757,27 +513,9 @@ static db_result_t insert(index_t *index, attribute_value_t *key, tuple_id_t val
 	 *	and write back is preferred.
 	 ***************************************************************************************/
 #ifdef DB_WIP
-	qnode_t *tmp_node;
 	storage_write_to(tree->tree_storage, tree, 0, sizeof(tree_t));
-
-	/* Bucket Cache being flushed */
-
-	tmp_node = tree->buck_cache->in_cache.head->next;
-	while (tmp_node != tree->buck_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			bucket_write(tree, tmp_node->id, &(tree->buck_cache->cache_t[tmp_node->pos].bucket));
-			UNSET_NODE_STATE(tmp_node, NODE_STATE_DIRTY);
-		}
-		tmp_node = tmp_node->next;
-	}
-	tmp_node = tree->node_cache->in_cache.head->next;
-	while (tmp_node != tree->node_cache->in_cache.tail) {
-		if ((tmp_node->node_state & NODE_STATE_DIRTY) && (tmp_node->node_state & NODE_STATE_VALID)) {
-			tree_write(tree, tmp_node->id, &(tree->node_cache->cache_t[tmp_node->pos].node));
-			UNSET_NODE_STATE(tmp_node, NODE_STATE_DIRTY);
-		}
-		tmp_node = tmp_node->next;
-	}
+	buffer_pool_flush(tree->bucket_storage);
+	buffer_pool_flush(tree->tree_storage);
 #endif
 	return DB_OK;
 }
@@ -792,6 +530,237 @@ static db_result_t delete(index_t *index, attribute_value_t *value)
 	return delete_item_btree(index, i_key);
 }
 
+/****************************************************************************
+ * Name: compare_entry
+ *
+ * Description: Comparator to sort the index entries of a bulk insertion.
+ *              Entries with the same key are kept in tuple order.
+ *
+ ****************************************************************************/
+static int compare_entry(const void *p1, const void *p2)
+{
+	const index_entry_t *e1 = (const index_entry_t *)p1;
+	const index_entry_t *e2 = (const index_entry_t *)p2;
+
+	if ((int)e1->key != (int)e2->key) {
+		return ((int)e1->key < (int)e2->key) ? -1 : 1;
+	}
+	if (e1->tuple_id != e2->tuple_id) {
+		return (e1->tuple_id < e2->tuple_id) ? -1 : 1;
+	}
+	return 0;
+}
+
+/****************************************************************************
+ * Name: bulk_bucket_end
+ *
+ * Description: Returns the end of the bucket which starts at start. A lookup
+ *              of a key begins at the bucket holding its first occurrence,
+ *              so a run of equal keys is not split between two buckets
+ *              unless it is longer than a bucket.
+ *
+ ****************************************************************************/
+static tuple_id_t bulk_bucket_end(index_entry_t *entries, tuple_id_t start, tuple_id_t count, tuple_id_t target)
+{
+	tuple_id_t end = start + target;
+	tuple_id_t run;
+
+	if (end >= count) {
+		return count;
+	}
+	run = end;
+	while (run > start && (int)entries[run - 1].key == (int)entries[end].key) {
+		run--;
+	}
+	return (run > start) ? run : end;
+}
+
+/****************************************************************************
+ * Name: tree_bulk_build
+ *
+ * Description: Builds an empty tree bottom-up from sorted entries. Buckets
+ *              are filled evenly and chained in key order, then each level
+ *              of nodes is built from the first keys of the level below.
+ *              Returns DB_LIMIT_ERROR without touching the tree when it is
+ *              not empty or the entries don't fit, the caller then inserts
+ *              them one by one.
+ *
+ ****************************************************************************/
+static db_result_t tree_bulk_build(tree_t *tree, index_entry_t *entries, tuple_id_t count)
+{
+	bucket_t buck;
+	tree_node_t node;
+	bucket_t *bucket;
+	pair_t *children;
+	tuple_id_t target;
+	tuple_id_t start;
+	tuple_id_t end;
+	int nbuckets;
+	int nchildren;
+	int ngroups;
+	int nnodes;
+	int levels;
+	int node_id;
+	int i;
+	int j;
+	int c;
+
+	/* Only a tree holding nothing but its first root and bucket is rebuilt */
+	if (tree->off_nodes != 1 || tree->off_buckets != 1 || tree->levels != 2) {
+		return DB_LIMIT_ERROR;
+	}
+	bucket = bucket_read(tree, 0);
+	if (bucket == NULL) {
+		return DB_LIMIT_ERROR;
+	}
+	nbuckets = bucket->next_free_slot;
+	modify_cache(tree, 0, BUCKET, UNLOCK);
+	if (nbuckets != 0 || (int)entries[count - 1].key == KEY_MAX) {
+		return DB_LIMIT_ERROR;
+	}
+	for (i = 0; i < count; i++) {
+		if (entries[i].tuple_id > UINT16_MAX) {
+			return DB_LIMIT_ERROR;
+		}
+	}
+
+	/* Count buckets and nodes first, so that nothing is written when they don't fit */
+	target = (count + BUCKET_SIZE - 1) / BUCKET_SIZE;
+	target = (count + target - 1) / target;
+	for (start = 0; start < count; start = end) {
+		end = bulk_bucket_end(entries, start, count, target);
+		nbuckets++;
+	}
+	nnodes = 0;
+	levels = 1;
+	nchildren = nbuckets + 1;
+	do {
+		ngroups = (nchildren + BRANCH_FACTOR - 1) / BRANCH_FACTOR;
+		nnodes += ngroups;
+		levels++;
+		nchildren = ngroups;
+	} while (nchildren > 1);
+
+	if (nbuckets > CONFIG_BUCKETS_LIMIT - 1 || nnodes > CONFIG_NODE_LIMIT) {
+		DB_LOG_D("DB: %d buckets and %d nodes needed for bulk build\n", nbuckets, nnodes);
+		return DB_LIMIT_ERROR;
+	}
+
+	/* First key and id of every child of the level being built, the last bucket is the KEY_MAX one */
+	children = bptree_malloc(sizeof(pair_t) * (nbuckets + 1));
+	if (children == NULL) {
+		return DB_ALLOCATION_ERROR;
+	}
+
+	start = 0;
+	for (i = 0; i < nbuckets; i++) {
+		end = bulk_bucket_end(entries, start, count, target);
+		memset(&buck, 0, sizeof(buck));
+		for (j = 0; j < end - start; j++) {
+			buck.pairs[j].key = (int)entries[start + j].key;
+			buck.pairs[j].value = entries[start + j].tuple_id;
+		}
+		buck.next_free_slot = end - start;
+		buck.info[0] = (i == nbuckets - 1) ? CONFIG_BUCKETS_LIMIT - 1 : i + 1;
+		buck.info[1] = buck.pairs[0].key;
+		buck.info[2] = buck.pairs[buck.next_free_slot - 1].key;
+		if (cache_write_bucket(tree, i, &buck) != CACHE_OK) {
+			free(children);
+			return DB_STORAGE_ERROR;
+		}
+		children[i].key = buck.pairs[0].key;
+		children[i].value = i;
+		start = end;
+	}
+	children[nbuckets].key = KEY_MAX;
+	children[nbuckets].value = CONFIG_BUCKETS_LIMIT - 1;
+
+	node_id = 0;
+	nchildren = nbuckets + 1;
+	node.is_leaf = 1;
+	do {
+		ngroups = (nchildren + BRANCH_FACTOR - 1) / BRANCH_FACTOR;
+		start = 0;
+		for (i = 0; i < ngroups; i++) {
+			/* Spread the children evenly, so that every node gets at least one key */
+			c = nchildren / ngroups + (i < nchildren % ngroups);
+			memset(node.val, 0, sizeof(node.val));
+			memset(node.id, 0, sizeof(node.id));
+			node.id[0] = children[start].value;
+			for (j = 1; j < c; j++) {
+				node.val[j - 1] = children[start + j].key;
+				node.id[j] = children[start + j].value;
+			}
+			node.val[BRANCH_FACTOR - 1] = c - 1;
+			if (cache_write_node(tree, node_id, &node) != CACHE_OK) {
+				free(children);
+				return DB_STORAGE_ERROR;
+			}
+
+			/* The parent level is built in place, i is never past start */
+			children[i].key = children[start].key;
+			children[i].value = node_id++;
+			start += c;
+		}
+		nchildren = ngroups;
+		node.is_leaf = 0;
+	} while (nchildren > 1);
+	free(children);
+
+	tree->root = node_id - 1;
+	tree->off_nodes = nnodes;
+	tree->off_buckets = nbuckets;
+	tree->levels = levels;
+	tree->inserted += count;
+
+	DB_LOG_D("DB: Built a bplus-tree of %d levels from %u keys\n", levels, (unsigned)count);
+	return DB_OK;
+}
+
+/****************************************************************************
+ * Name: bulk_insert
+ *
+ * Description: Inserts many index entries at once. An empty tree is built
+ *              bottom-up, otherwise the entries are inserted in key order
+ *              so that consecutive insertions hit the same cached nodes.
+ *
+ ****************************************************************************/
+static db_result_t bulk_insert(index_t *index, index_entry_t *entries, tuple_id_t count)
+{
+	tree_t *tree;
+	attribute_value_t value;
+	db_result_t result;
+	tuple_id_t i;
+
+	if (count == 0) {
+		return DB_OK;
+	}
+	tree = (tree_t *)index->opaque_data;
+	qsort(entries, count, sizeof(index_entry_t), compare_entry);
+
+	result = DB_LIMIT_ERROR;
+#ifdef CONFIG_ARASTORAGE_ENABLE_FLUSHING
+	if (count < DB_TUPLES_LIMIT)
+#endif
+	{
+		rw_lock_write(&(tree->tree_lock));
+		result = tree_bulk_build(tree, entries, count);
+		rw_unlock_write(&(tree->tree_lock));
+	}
+	if (result != DB_LIMIT_ERROR) {
+		return result;
+	}
+
+	value.domain = DOMAIN_LONG;
+	for (i = 0; i < count; i++) {
+		VALUE_LONG(&value) = entries[i].key;
+		if (DB_ERROR(insert(index, &value, entries[i].tuple_id))) {
+			return DB_INDEX_ERROR;
+		}
+	}
+	return DB_OK;
+}
+
 /****************************************************************************
  * Name: next_bucket
  *
@@ -1050,44 +1019,27 @@ static db_result_t vacuum(tree_t *tree, relation_t *rel)
  ****************************************************************************/
 static cache_result_t modify_cache(tree_t *tree, int id, cache_type_t cache, op_type_t op)
 {
-	qnode_t *temp;
-	qnode_t *end;
+	db_storage_id_t storage;
+	unsigned long offset;
+	db_result_t result;
+
 	if (cache == NODE) {
-		pthread_mutex_lock(&(tree->node_cache_lock));
-		temp = tree->node_cache->in_cache.tail->prev;
-		end = tree->node_cache->in_cache.head;
+		storage = tree->tree_storage;
+		offset = NODE_OFFSET(id);
 	} else {
-		pthread_mutex_lock(&(tree->buck_cache_lock));
-		temp = tree->buck_cache->in_cache.tail->prev;
-		end = tree->buck_cache->in_cache.head;
-	}
-	while (temp != end) {
-		if ((temp->id == id) && (temp->node_state & NODE_STATE_VALID)) {
-			if (op == UNLOCK) {
-				UNSET_NODE_STATE(temp, NODE_STATE_LOCK);
-			} else if (op == DIRTY) {
-				SET_NODE_STATE(temp, NODE_STATE_DIRTY);
-			} else {
-				UNSET_NODE_STATE(temp, NODE_STATE_VALID | NODE_STATE_DIRTY | NODE_STATE_LOCK);
-				REMOVE_ENTRY(temp);
-				if (cache == NODE) {
-					PLACE_AT_HEAD(temp, tree->node_cache);
-				} else {
-					PLACE_AT_HEAD(temp, tree->buck_cache);
-				}
-			}
-			break;
-		}
-		temp = temp->prev;
+		storage = tree->bucket_storage;
+		offset = BUCKET_OFFSET(id);
 	}
 
-	if (cache == NODE) {
-		pthread_mutex_unlock(&(tree->node_cache_lock));
+	if (op == UNLOCK) {
+		result = buffer_pool_unlock(storage, offset);
+	} else if (op == DIRTY) {
+		result = buffer_pool_mark_dirty(storage, offset);
 	} else {
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
+		result = buffer_pool_invalidate(storage, offset);
 	}
 
-	if (temp == end) {
+	if (DB_ERROR(result)) {
 		DB_LOG_E("PANIC CACHE OPERATION FOR A NON EXISTENT ENTRY\n");
 		return CACHE_NOT_EXIST;
 	}
@@ -1104,50 +1056,11 @@ static cache_result_t modify_cache(tree_t *tree, int id, cache_type_t cache, op_
  ****************************************************************************/
 static cache_result_t cache_write_node(tree_t *tree, int id, tree_node_t *node)
 {
-	pthread_mutex_lock(&(tree->node_cache_lock));
-
-	qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-	if (new_node == NULL) {
-		DB_LOG_E("Failed allocation of node\n");
-		pthread_mutex_unlock(&(tree->node_cache_lock));
-		return CACHE_ALLOCATION_ERROR;
+	if (DB_ERROR(buffer_pool_write(tree->tree_storage, NODE_OFFSET(id), node, sizeof(tree_node_t)))) {
+		DB_LOG_E("NO SLOT AVAIABLE IN CACHE\n");
+		return CACHE_FULL;
 	}
 
-	if (tree->node_cache->num < DB_TREE_CACHE_LIMIT) {
-		new_node->pos = tree->node_cache->num++;
-	} else {
-		qnode_t *iter_node;
-		iter_node = tree->node_cache->in_cache.head->next;
-		while ((iter_node->node_state & NODE_STATE_LOCK) && iter_node != tree->node_cache->in_cache.tail) {
-			iter_node = iter_node->next;
-		}
-		if (iter_node == tree->node_cache->in_cache.tail) {
-			free(new_node);
-			DB_LOG_E("NO SLOT AVAIABLE IN CACHE\n");
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return CACHE_FULL;
-		}
-		if ((iter_node->node_state & NODE_STATE_DIRTY) && (iter_node->node_state & NODE_STATE_DIRTY)) {
-			tree_write(tree, iter_node->id, &(tree->node_cache->cache_t[iter_node->pos].node));
-		}
-		new_node->pos = iter_node->pos;
-		/* iter_node is the node which has to be evicted from cache.
-		 * It is removed the queue maintaining the LRU status.
-		 */
-		REMOVE_ENTRY(iter_node);
-		free(iter_node);
-	}
-
-	PLACE_AT_TAIL(new_node, tree->node_cache);
-	new_node->id = id;
-	UNSET_NODE_STATE(new_node, NODE_STATE_LOCK);
-	SET_NODE_STATE(new_node, NODE_STATE_VALID);
-	SET_NODE_STATE(new_node, NODE_STATE_DIRTY);
-
-	memcpy(&(tree->node_cache->cache_t[new_node->pos].node), node, sizeof(tree_node_t));
-
-	pthread_mutex_unlock(&(tree->node_cache_lock));
-
 	return CACHE_OK;
 }
 
@@ -1160,25 +1073,10 @@ static cache_result_t cache_write_node(tree_t *tree, int id, tree_node_t *node)
  ****************************************************************************/
 static cache_result_t cache_replace_node(tree_t *tree, int id, tree_node_t *node)
 {
-	pthread_mutex_lock(&(tree->node_cache_lock));
-
-	qnode_t *replace_node;
-	replace_node = tree->node_cache->in_cache.head->next;
-
-	while ((replace_node->id != id) && (replace_node != tree->node_cache->in_cache.tail)) {
-		replace_node = replace_node->next;
-	}
-	if (replace_node == tree->node_cache->in_cache.tail || !(replace_node->node_state & NODE_STATE_LOCK)) {
+	if (DB_ERROR(buffer_pool_replace(tree->tree_storage, NODE_OFFSET(id), node, sizeof(tree_node_t)))) {
 		DB_LOG_E("PANIC REPLACE FOR NON_EXISTENT OR NON_LOCKED ENTRY\n");
-		pthread_mutex_unlock(&(tree->node_cache_lock));
 		return CACHE_NOT_EXIST;
 	}
-	UNSET_NODE_STATE(replace_node, NODE_STATE_LOCK);
-	SET_NODE_STATE(replace_node, NODE_STATE_VALID | NODE_STATE_DIRTY);
-
-	memcpy(&(tree->node_cache->cache_t[replace_node->pos].node), node, sizeof(tree_node_t));
-
-	pthread_mutex_unlock(&(tree->node_cache_lock));
 
 	return CACHE_OK;
 }
@@ -1192,44 +1090,10 @@ static cache_result_t cache_replace_node(tree_t *tree, int id, tree_node_t *node
  ****************************************************************************/
 static cache_result_t cache_write_bucket(tree_t *tree, int id, bucket_t *bucket)
 {
-	pthread_mutex_lock(&(tree->buck_cache_lock));
-
-	qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-	if (new_node == NULL) {
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
-		return CACHE_ALLOCATION_ERROR;
-	}
-
-	if (tree->buck_cache->num < DB_HEAP_CACHE_LIMIT) {
-		new_node->pos = tree->buck_cache->num++;
-	} else {
-		qnode_t *iter_node;
-		iter_node = tree->buck_cache->in_cache.head->next;
-		while ((iter_node->node_state & NODE_STATE_LOCK) && (iter_node != tree->buck_cache->in_cache.tail)) {
-			iter_node = iter_node->next;
-		}
-		if (iter_node == tree->buck_cache->in_cache.tail) {
-			free(new_node);
-			DB_LOG_E("NO SLOT AVAILABLE IN CACHE bucket\n");
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return CACHE_FULL;
-		}
-
-		if ((iter_node->node_state & NODE_STATE_DIRTY) && (iter_node->node_state & NODE_STATE_VALID)) {
-			bucket_write(tree, iter_node->id, &(tree->buck_cache->cache_t[iter_node->pos].bucket));
-		}
-		new_node->pos = iter_node->pos;
-		REMOVE_ENTRY(iter_node);
-		free(iter_node);
+	if (DB_ERROR(buffer_pool_write(tree->bucket_storage, BUCKET_OFFSET(id), bucket, sizeof(bucket_t)))) {
+		DB_LOG_E("NO SLOT AVAILABLE IN CACHE bucket\n");
+		return CACHE_FULL;
 	}
-	PLACE_AT_TAIL(new_node, tree->buck_cache);
-	new_node->id = id;
-	UNSET_NODE_STATE(new_node, NODE_STATE_LOCK);
-	SET_NODE_STATE(new_node, NODE_STATE_DIRTY | NODE_STATE_VALID);
-
-	memcpy(&(tree->buck_cache->cache_t[new_node->pos].bucket), bucket, sizeof(bucket_t));
-
-	pthread_mutex_unlock(&(tree->buck_cache_lock));
 
 	return CACHE_OK;
 }
@@ -1256,104 +1120,8 @@ static int transform_key(int key)
  ****************************************************************************/
 static tree_node_t *tree_read(tree_t *tree, int bucket_id)
 {
-	pthread_mutex_lock(&(tree->node_cache_lock));
-
-	bool found = false;
-	qnode_t *iter = (tree->node_cache->in_cache.tail)->prev;
-
-	while (iter != (tree->node_cache->in_cache.head)) {
-		if (bucket_id == iter->id && (iter->node_state & NODE_STATE_VALID)) {
-			found = true;
-			break;
-		}
-		iter = iter->prev;
-	}
-	if (found) {
-		/* Case when node is found in the cache */
-		if (iter->node_state & NODE_STATE_LOCK) {
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return NULL;
-		}
-		SET_NODE_STATE(iter, NODE_STATE_LOCK);
-		REMOVE_ENTRY(iter);
-		PLACE_AT_TAIL(iter, tree->node_cache);
-		pthread_mutex_unlock(&(tree->node_cache_lock));
-		return &(tree->node_cache->cache_t[iter->pos].node);
-	} else {
-		qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (new_node == NULL) {
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return NULL;
-		}
-		if (tree->node_cache->num < DB_TREE_CACHE_LIMIT) {
-			new_node->pos = tree->node_cache->num++;
-		} else {
-			/* Case when the least recently used node needs to be evicted to make place for new node */
-			qnode_t *replace_node = tree->node_cache->in_cache.head->next;
-			while ((replace_node->node_state & NODE_STATE_LOCK) && replace_node != tree->node_cache->in_cache.tail) {
-				replace_node = replace_node->next;
-			}
-			if (replace_node == tree->node_cache->in_cache.tail) {
-				free(new_node);
-				pthread_mutex_unlock(&(tree->node_cache_lock));
-				return NULL;
-			}
-			if ((replace_node->node_state & NODE_STATE_DIRTY) && (replace_node->node_state & NODE_STATE_VALID)) {
-				tree_write(tree, replace_node->id, &(tree->node_cache->cache_t[replace_node->pos].node));
-			}
-			new_node->pos = replace_node->pos;
-			REMOVE_ENTRY(replace_node);
-			free(replace_node);
-		}
-		/* Adjusting the pointers */
-		PLACE_AT_TAIL(new_node, tree->node_cache);
-		new_node->id = bucket_id;
-		SET_NODE_STATE(new_node, NODE_STATE_LOCK | NODE_STATE_VALID | NODE_STATE_DIRTY);
-
-		/* Reading from flash */
-		if (DB_ERROR(storage_read_from(tree->tree_storage, &(tree->node_cache->cache_t[new_node->pos].node), base_offset + (unsigned long)bucket_id * sizeof(tree_node_t), sizeof(tree_node_t)))) {
-			DB_LOG_E("PANIC TREE READ FAILED AT NODE ID %d\n", new_node->id);
-			UNSET_NODE_STATE(new_node, NODE_STATE_LOCK | NODE_STATE_VALID);
-			pthread_mutex_unlock(&(tree->node_cache_lock));
-			return NULL;
-		}
-
-		pthread_mutex_unlock(&(tree->node_cache_lock));
-
-		return &(tree->node_cache->cache_t[new_node->pos].node);
-	}
-}
-
-/****************************************************************************
- * Name: tree_write
- *
- * Description: Routine to issue a flash write of node in the tree.
- *              Required while evicting dirty cache entries
- *
- ****************************************************************************/
-static int tree_write(tree_t *tree, int offset, tree_node_t *node)
-{
-	if (DB_ERROR(storage_write_to(tree->tree_storage, node, base_offset + (unsigned long)offset * sizeof(*node), sizeof(*node)))) {
-		DB_LOG_E("TREE WRITE FAILED AT NODE ID %d\n", offset);
-		return 0;
-	}
-	return 1;
-}
-
-/****************************************************************************
- * Name: bucket_write
- *
- * Description: Routine to issue a flash write of bucket in the tree.
- *              Required while evicting dirty cache entries
- *
- ****************************************************************************/
-static int bucket_write(tree_t *tree, int pos, bucket_t *bucket)
-{
-	if (DB_ERROR(storage_write_to(tree->bucket_storage, bucket, (unsigned long)pos * sizeof(bucket_t), sizeof(bucket_t)))) {
-		DB_LOG_E("BUCKET WRITE FAILED AT BUCKET ID %d\n", pos);
-		return 0;
-	}
-	return 1;
+	/* Nodes are modified in place by callers, so they are written back on eviction */
+	return (tree_node_t *)buffer_pool_read(tree->tree_storage, NODE_OFFSET(bucket_id), sizeof(tree_node_t), BUFFER_POOL_READ_DIRTY);
 }
 
 /****************************************************************************
@@ -1529,73 +1297,7 @@ void tree_print(tree_t *tree, int id)
  ****************************************************************************/
 static bucket_t *bucket_read(tree_t *tree, int bucket_id)
 {
-	pthread_mutex_lock(&(tree->buck_cache_lock));
-
-	bool found = false;
-	qnode_t *iter = (tree->buck_cache->in_cache.tail)->prev;
-
-	while (iter != (tree->buck_cache->in_cache.head)) {
-		if (bucket_id == iter->id && (iter->node_state & NODE_STATE_VALID)) {
-			found = true;
-			break;
-		}
-		iter = iter->prev;
-	}
-	if (found) {
-		/* If the bucket is found in the cache */
-		if (iter->node_state & NODE_STATE_LOCK) {
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return NULL;
-		}
-		SET_NODE_STATE(iter, NODE_STATE_LOCK);
-		REMOVE_ENTRY(iter);
-		PLACE_AT_TAIL(iter, tree->buck_cache);
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
-		return &(tree->buck_cache->cache_t[iter->pos].bucket);
-	} else {
-		/* Bucket has to be read from flash into the cache */
-		qnode_t *new_node = (qnode_t *)bptree_malloc(sizeof(qnode_t));
-		if (new_node == NULL) {
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return NULL;
-		}
-		if (tree->buck_cache->num < DB_HEAP_CACHE_LIMIT) {
-			new_node->pos = tree->buck_cache->num++;
-		} else {
-			/* Cache doesn't have enough space and the least recently used bucket needs to be evicted */
-			qnode_t *replace_node = tree->buck_cache->in_cache.head->next;
-			while ((replace_node->node_state & NODE_STATE_LOCK) && (replace_node != tree->buck_cache->in_cache.tail)) {
-				replace_node = replace_node->next;
-			}
-			if (replace_node == tree->buck_cache->in_cache.tail) {
-				free(new_node);
-				pthread_mutex_unlock(&(tree->buck_cache_lock));
-				return NULL;
-			}
-			if ((replace_node->node_state & NODE_STATE_DIRTY) && (replace_node->node_state & NODE_STATE_VALID)) {
-				bucket_write(tree, replace_node->id, &(tree->buck_cache->cache_t[replace_node->pos].bucket));
-			}
-			new_node->pos = replace_node->pos;
-			REMOVE_ENTRY(replace_node);
-			free(replace_node);
-		}
-
-		/* Adjust the pointers */
-		PLACE_AT_TAIL(new_node, tree->buck_cache);
-		new_node->id = bucket_id;
-		SET_NODE_STATE(new_node, NODE_STATE_LOCK | NODE_STATE_VALID);
-		UNSET_NODE_STATE(new_node, NODE_STATE_DIRTY);
-
-		/* Read from flash */
-		if (DB_ERROR(storage_read_from(tree->bucket_storage, (void *)&(tree->buck_cache->cache_t[new_node->pos].bucket), (unsigned long)bucket_id * sizeof(bucket_t), sizeof(bucket_t)))) {
-			DB_LOG_E("PANIC BUCKET READ FAILED AT ID %d\n", bucket_id);
-			UNSET_NODE_STATE(new_node, (NODE_STATE_LOCK | NODE_STATE_VALID));
-			pthread_mutex_unlock(&(tree->buck_cache_lock));
-			return NULL;
-		}
-		pthread_mutex_unlock(&(tree->buck_cache_lock));
-		return &(tree->buck_cache->cache_t[new_node->pos].bucket);
-	}
+	return (bucket_t *)buffer_pool_read(tree->bucket_storage, BUCKET_OFFSET(bucket_id), sizeof(bucket_t), 0);
 }
 
 /****************************************************************************
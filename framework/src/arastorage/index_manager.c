@@ -307,6 +307,26 @@ db_result_t index_insert(index_t *index, attribute_value_t *value, tuple_id_t tu
 	return index->api->insert(index, value, tuple_id);
 }
 
+db_result_t index_bulk_insert(index_t *index, index_entry_t *entries, tuple_id_t count)
+{
+	attribute_value_t value;
+	tuple_id_t i;
+
+	if (index->api->bulk_insert != NULL) {
+		return index->api->bulk_insert(index, entries, count);
+	}
+
+	value.domain = DOMAIN_LONG;
+	for (i = 0; i < count; i++) {
+		VALUE_LONG(&value) = entries[i].key;
+		if (DB_ERROR(index->api->insert(index, &value, entries[i].tuple_id))) {
+			return DB_INDEX_ERROR;
+		}
+	}
+
+	return DB_OK;
+}
+
 db_result_t index_delete(index_t *index, attribute_value_t *value)
 {
 	if (index->state != INDEX_READY) {
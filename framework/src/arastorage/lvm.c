@@ -285,6 +285,13 @@ void lvm_reset(lvm_instance_t *p)
 	memset(p->derivations, 0, sizeof(p->derivations));
 }
 
+void lvm_clone(lvm_instance_t *dst, lvm_instance_t *src)
+{
+	memcpy(dst, src, sizeof(*dst));
+	dst->ip = 0;
+	dst->error = 0;
+}
+
 lvm_ip_t lvm_jump_to_operand(lvm_instance_t *p)
 {
 	lvm_ip_t old_end;
@@ -453,6 +460,50 @@ lvm_status_t lvm_set_long(lvm_instance_t *p, long l)
 	return lvm_set_operand(p, &op);
 }
 
+/* A parameter is a placeholder operand which is replaced by a long value
+   before the code is executed, see lvm_bind_parameters(). */
+lvm_status_t lvm_set_parameter(lvm_instance_t *p, unsigned id)
+{
+	operand_t op;
+
+	op.type = LVM_PARAMETER;
+	op.value.l = id;
+
+	return lvm_set_operand(p, &op);
+}
+
+lvm_status_t lvm_bind_parameters(lvm_instance_t *p, const long *values, unsigned count)
+{
+	lvm_ip_t ip;
+	operand_t operand;
+
+	for (ip = 0; ip < p->end;) {
+		switch (*(node_type_t *)(p->code + ip)) {
+		case LVM_CMP_OP:
+		case LVM_ARITH_OP:
+			ip += sizeof(node_type_t) + sizeof(operator_t);
+			break;
+		case LVM_OPERAND:
+			ip += sizeof(node_type_t);
+			memcpy(&operand, p->code + ip, sizeof(operand));
+			if (operand.type == LVM_PARAMETER) {
+				if (operand.value.l < 0 || (unsigned long)operand.value.l >= count) {
+					return INVALID_IDENTIFIER;
+				}
+				operand.type = LVM_LONG;
+				operand.value.l = values[operand.value.l];
+				memcpy(p->code + ip, &operand, sizeof(operand));
+			}
+			ip += sizeof(operand_t);
+			break;
+		default:
+			return EXECUTION_ERROR;
+		}
+	}
+
+	return LVM_TRUE;
+}
+
 lvm_status_t lvm_register_variable(lvm_instance_t *p, char *name, operand_type_t type)
 {
 	variable_id_t id;
@@ -756,6 +807,9 @@ static lvm_ip_t print_operand(lvm_instance_t *p, lvm_ip_t index)
 	case LVM_LONG:
 		DB_LOG_D("long:%ld ", operand.value.l);
 		break;
+	case LVM_PARAMETER:
+		DB_LOG_D("param:%ld ", operand.value.l);
+		break;
 	default:
 		DB_LOG_D("?? ");
 		break;
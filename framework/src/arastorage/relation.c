@@ -581,6 +581,124 @@ db_result_t relation_insert(relation_t *rel, attribute_value_t *values)
 	return storage_put_row(rel, record, FALSE);
 }
 
+/*
+ * Insert nrows tuples at once. The tuples are appended to the relation in
+ * writes of CONFIG_ARASTORAGE_BULK_WRITE_SIZE bytes, then each index is
+ * given all of its new keys together.
+ */
+db_result_t relation_bulk_insert(relation_t *rel, attribute_value_t *values, tuple_id_t nrows)
+{
+	attribute_t *attr;
+	attribute_value_t *value;
+	index_entry_t *entries;
+	unsigned char *buffer;
+	unsigned char *ptr;
+	tuple_id_t first_row;
+	tuple_id_t rows_per_write;
+	tuple_id_t count;
+	tuple_id_t i;
+	tuple_id_t j;
+	db_result_t result;
+
+	if (nrows == 0) {
+		return DB_OK;
+	}
+	if (rel->row_length == 0 || rel->attribute_count == 0) {
+		return DB_RELATIONAL_ERROR;
+	}
+	if (relation_cardinality(rel) + nrows > DB_TUPLE_LIMIT) {
+		return DB_LIMIT_ERROR;
+	}
+
+	/* Check every value first, so that a bad one is found before anything is written */
+	value = values;
+	for (i = 0; i < nrows; i++) {
+		for (attr = list_head(rel->attributes); attr != NULL; attr = attr->next, value++) {
+			if (attr->flags & ATTRIBUTE_FLAG_INVALID) {
+				continue;
+			}
+			if (attr->domain != value->domain && !(attr->domain == DOMAIN_LONG && value->domain == DOMAIN_INT)) {
+				DB_LOG_E("DB: The value domain %d does not match the domain %d of attribute %s\n", value->domain, attr->domain, attr->name);
+				return DB_RELATIONAL_ERROR;
+			}
+		}
+	}
+
+	rows_per_write = CONFIG_ARASTORAGE_BULK_WRITE_SIZE / rel->row_length;
+	if (rows_per_write == 0) {
+		rows_per_write = 1;
+	}
+	if (rows_per_write > nrows) {
+		rows_per_write = nrows;
+	}
+	buffer = malloc(rows_per_write * rel->row_length);
+	if (buffer == NULL) {
+		return DB_ALLOCATION_ERROR;
+	}
+
+	first_row = rel->next_row;
+	value = values;
+	for (i = 0; i < nrows; i += count) {
+		count = nrows - i;
+		if (count > rows_per_write) {
+			count = rows_per_write;
+		}
+		ptr = buffer;
+		for (j = 0; j < count; j++) {
+			for (attr = list_head(rel->attributes); attr != NULL; attr = attr->next, value++) {
+				/* Set the data area for removed attributes to 0. */
+				if (attr->flags & ATTRIBUTE_FLAG_INVALID) {
+					memset(ptr, 0, attr->element_size);
+				} else {
+					result = db_value_to_phy(ptr, attr, value);
+					if (DB_ERROR(result)) {
+						free(buffer);
+						return result;
+					}
+				}
+				ptr += attr->element_size;
+			}
+		}
+		result = storage_put_rows(rel, buffer, count);
+		if (DB_ERROR(result)) {
+			free(buffer);
+			return result;
+		}
+	}
+	free(buffer);
+
+	entries = NULL;
+	j = 0;
+	for (attr = list_head(rel->attributes); attr != NULL; attr = attr->next, j++) {
+		if (attr->flags & ATTRIBUTE_FLAG_INVALID) {
+			continue;
+		}
+		if (attr->index == NULL) {
+			index_load(rel, attr);
+		}
+		if (attr->index == NULL) {
+			continue;
+		}
+		if (entries == NULL) {
+			entries = malloc(nrows * sizeof(index_entry_t));
+			if (entries == NULL) {
+				return DB_ALLOCATION_ERROR;
+			}
+		}
+		for (i = 0; i < nrows; i++) {
+			entries[i].key = db_value_to_long(&values[i * rel->attribute_count + j]);
+			entries[i].tuple_id = first_row + i;
+		}
+		if (DB_ERROR(index_bulk_insert(attr->index, entries, nrows))) {
+			free(entries);
+			return DB_INDEX_ERROR;
+		}
+	}
+	free(entries);
+
+	return DB_OK;
+}
+
 /*
  * Update aggregation value whenever each tuple is read.
  */
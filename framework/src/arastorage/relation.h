@@ -192,6 +192,7 @@ db_result_t relation_attribute_remove(relation_t *, char *);
 db_result_t relation_set_primary_key(relation_t *, char *);
 db_result_t relation_remove(relation_t *, int);
 db_result_t relation_insert(relation_t *, attribute_value_t *);
+db_result_t relation_bulk_insert(relation_t *, attribute_value_t *, tuple_id_t);
 db_result_t relation_select(db_handle_t **, relation_t *, void *);
 tuple_id_t relation_cardinality(relation_t *);
 
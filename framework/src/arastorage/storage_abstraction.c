@@ -28,6 +28,7 @@
 #endif
 #include "db_debug.h"
 #include "storage.h"
+#include "buffer_pool.h"
 
 /****************************************************************************
 * Public Functions
@@ -56,6 +57,8 @@ db_storage_id_t storage_open(const char *filename, int oflag)
 /* It mapped with close function in specific file system */
 db_storage_id_t storage_close(db_storage_id_t fd)
 {
+	/* The fd may be reused by another file, don't keep its pages */
+	buffer_pool_release(fd);
 	return close(fd);
 }
 
@@ -67,6 +67,7 @@
 #include "db_debug.h"
 #include "random.h"
 #include "storage.h"
+#include "buffer_pool.h"
 
 /****************************************************************************
 * Private Types
@@ -505,6 +506,10 @@ db_result_t storage_get_row(relation_t *rel, tuple_id_t *tuple_id, storage_row_t
 {
 	ssize_t r;
 	tuple_id_t nrows;
+	unsigned long offset;
+	unsigned long page_offset;
+	size_t page_size;
+	unsigned char *page;
 
 	if (DB_ERROR(storage_get_row_amount(rel, &nrows))) {
 		return DB_STORAGE_ERROR;
@@ -515,6 +520,22 @@ db_result_t storage_get_row(relation_t *rel, tuple_id_t *tuple_id, storage_row_t
 		return DB_FINISHED;
 	}
 
+	/* Rows are read through the buffer pool when the whole row lies in one
+	 * page. Only full pages are cached, the last page still grows on insert.
+	 */
+	offset = (unsigned long)*tuple_id * rel->row_length;
+	page_size = buffer_pool_page_size();
+	page_offset = offset - (offset % page_size);
+	if (offset + rel->row_length <= page_offset + page_size && page_offset + page_size <= (unsigned long)nrows * rel->row_length) {
+		page = buffer_pool_read(rel->tuple_storage, page_offset, page_size, 0);
+		if (page != NULL) {
+			memcpy(row, page + (offset - page_offset), rel->row_length);
+			buffer_pool_unlock(rel->tuple_storage, page_offset);
+			DB_LOG_D("DB: Read %d bytes from relation %s in buffer pool\n", rel->row_length, rel->name);
+			return DB_OK;
+		}
+	}
+
 	if (storage_seek(rel->tuple_storage, *tuple_id * rel->row_length, SEEK_SET) == (off_t)-1) {
 		return DB_STORAGE_ERROR;
 	}
@@ -555,6 +576,27 @@ db_result_t storage_put_row(relation_t *rel, storage_row_t row, uint8_t flag)
 	return result;
 }
 
+db_result_t storage_put_rows(relation_t *rel, storage_row_t rows, tuple_id_t count)
+{
+	unsigned length;
+
+#ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
+	/* Rows in the insert buffer go first to keep the tuple ids in order */
+	if (DB_ERROR(storage_flush_insert_buffer())) {
+		return DB_STORAGE_ERROR;
+	}
+#endif
+	length = rel->row_length * count;
+	if (storage_write(rel->tuple_storage, rows, length) != length) {
+		DB_LOG_D("DB: Failed to store %u bytes\n", length);
+		return DB_STORAGE_ERROR;
+	}
+
+	rel->cardinality += count;
+	rel->next_row += count;
+	return DB_OK;
+}
+
 db_result_t storage_write_row(db_storage_id_t fd, storage_row_t row, unsigned length, char *filename)
 {
 #ifdef CONFIG_ARASTORAGE_ENABLE_WRITE_BUFFER
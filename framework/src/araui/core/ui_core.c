@@ -29,6 +29,7 @@
 #include <unistd.h>
 #include <time.h>
 #include <vec/vec.h>
+#include <araui/ui_core.h>
 #include <araui/ui_commons.h>
 #include <araui/ui_animation.h>
 #include "ui_renderer.h"
@@ -68,11 +69,18 @@ typedef struct {
 
 static ui_core_t g_core;
 static ui_widget_body_t *g_quick_panel_info[UI_QUICK_PANEL_TYPE_NUM];
+#if defined(CONFIG_UI_FRAME_STATS)
+static ui_frame_stats_t g_frame_stats;
+static pthread_mutex_t g_frame_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
 
 static ui_error_t _ui_process_widget(ui_widget_body_t *widget, uint32_t dt);
 static void _ui_call_anim_finished_cb(void *userdata);
 static void *_ui_core_thread_loop(void *param);
 static bool _ui_core_quick_panel_visible(void);
+#if defined(CONFIG_UI_FRAME_STATS)
+static void _ui_update_frame_stats(uint32_t frame_time, uint32_t area);
+#endif
 
 #if defined(CONFIG_UI_ENABLE_TOUCH)
 static void _ui_core_dispatch_touch_event(void);
@@ -292,10 +300,15 @@ static ui_error_t _ui_render_widget(ui_widget_body_t *widget, ui_rect_t draw_are
 		if (curr_widget->visible) {
 			if (curr_widget->render_cb) {
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
+				// Widget out of the draw area is not rendered, but its children can be in the area
 				new_vp = ui_rect_intersect(draw_area, curr_widget->global_rect);
-				ui_dal_set_viewport(new_vp.x, new_vp.y, new_vp.width, new_vp.height);
-				curr_widget->render_cb((ui_widget_t)curr_widget, dt);
-				ui_dal_set_viewport(draw_area.x, draw_area.y, draw_area.width, draw_area.height);
+				if (new_vp.width > 0 && new_vp.height > 0) {
+					ui_dal_set_viewport(new_vp.x, new_vp.y, new_vp.width, new_vp.height);
+					ui_renderer_set_clip(new_vp);
+					curr_widget->render_cb((ui_widget_t)curr_widget, dt);
+					ui_dal_set_viewport(draw_area.x, draw_area.y, draw_area.width, draw_area.height);
+					ui_renderer_set_clip(draw_area);
+				}
 #else
 				curr_widget->render_cb((ui_widget_t)curr_widget, dt);
 #endif
@@ -327,18 +340,34 @@ static void _ui_call_anim_finished_cb(void *userdata)
 	}
 }
 
-static void _ui_redraw(uint32_t dt)
+/**
+ * @brief Redraw the damaged area of the screen.
+ * @return Area of the redrawn region in pixels. 0 if nothing is redrawn.
+ */
+static uint32_t _ui_redraw(uint32_t dt)
 {
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
 	ui_rect_t *redraw_rect;
+	vec_void_t *redraw_list;
 	int iter;
 #else
 	ui_rect_t redraw_rect;
 #endif
 	ui_window_body_t *window;
+	uint32_t area = 0;
 
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
-	vec_foreach(ui_window_get_redraw_list(), redraw_rect, iter) {
+	redraw_list = ui_window_get_redraw_list();
+	if (redraw_list->length == 0) {
+		return 0;
+	}
+
+	ui_dal_clear();
+
+	vec_foreach(redraw_list, redraw_rect, iter) {
+		ui_dal_set_viewport(redraw_rect->x, redraw_rect->y, redraw_rect->width, redraw_rect->height);
+		ui_renderer_set_clip(*redraw_rect);
+
 		window = ui_window_get_current();
 		if (window) {
 			_ui_render_widget(window->root, *redraw_rect, dt);
@@ -350,6 +379,7 @@ static void _ui_redraw(uint32_t dt)
 
 		if (window || _ui_core_quick_panel_visible()) {
 			ui_dal_redraw(redraw_rect->x, redraw_rect->y, redraw_rect->width, redraw_rect->height);
+			area += redraw_rect->width * redraw_rect->height;
 		}
 	}
 
@@ -360,7 +390,9 @@ static void _ui_redraw(uint32_t dt)
 	redraw_rect.width = CONFIG_UI_DISPLAY_WIDTH;
 	redraw_rect.height = CONFIG_UI_DISPLAY_HEIGHT;
 
+	ui_dal_clear();
 	ui_dal_set_viewport(redraw_rect.x, redraw_rect.y, redraw_rect.width, redraw_rect.height);
+	ui_renderer_set_clip(redraw_rect);
 
 	window = ui_window_get_current();
 	if (window) {
@@ -373,8 +405,11 @@ static void _ui_redraw(uint32_t dt)
 
 	if (window || _ui_core_quick_panel_visible()) {
 		ui_dal_redraw(redraw_rect.x, redraw_rect.y, redraw_rect.width, redraw_rect.height);
+		area = redraw_rect.width * redraw_rect.height;
 	}
 #endif // CONFIG_UI_PARTIAL_UPDATE
+
+	return area;
 }
 
 static void _ui_update_redraw_list(ui_widget_body_t *widget)
@@ -445,6 +480,11 @@ static void *_ui_core_thread_loop(void *param)
 	struct timespec before;
 	struct timespec now;
 	uint32_t dt;
+#if defined(CONFIG_UI_FRAME_STATS)
+	struct timespec frame_start;
+	struct timespec frame_end;
+	uint32_t area;
+#endif
 
 #if (CONFIG_UI_MAXIMUM_FPS > 0)
 	const uint32_t ms_per_frame = 1000 / CONFIG_UI_MAXIMUM_FPS;
@@ -456,8 +496,6 @@ static void *_ui_core_thread_loop(void *param)
 	clock_gettime(CLOCK_MONOTONIC, &before);
 
 	while (g_core.state == UI_CORE_STATE_RUNNING) {
-		ui_dal_clear();
-
 		clock_gettime(CLOCK_MONOTONIC, &now);
 
 		dt = ((now.tv_sec - before.tv_sec) * 1000) + ((now.tv_nsec - before.tv_nsec) / 1000000);
@@ -469,6 +507,11 @@ static void *_ui_core_thread_loop(void *param)
 		}
 #endif
 
+#if defined(CONFIG_UI_FRAME_STATS)
+		clock_gettime(CLOCK_MONOTONIC, &frame_start);
+		ui_renderer_reset_pixel_count();
+#endif
+
 		window = ui_window_get_current();
 		if (window) {
 			root = window->root;
@@ -484,7 +527,15 @@ static void *_ui_core_thread_loop(void *param)
 			_ui_update_redraw_list(g_quick_panel_info[g_core.visible_event_type]);
 		}
 
+#if defined(CONFIG_UI_FRAME_STATS)
+		area = _ui_redraw(dt);
+		if (area > 0) {
+			clock_gettime(CLOCK_MONOTONIC, &frame_end);
+			_ui_update_frame_stats(((frame_end.tv_sec - frame_start.tv_sec) * 1000000) + ((frame_end.tv_nsec - frame_start.tv_nsec) / 1000), area);
+		}
+#else
 		_ui_redraw(dt);
+#endif
 
 #if defined(CONFIG_UI_ENABLE_TOUCH)
 		_ui_core_dispatch_touch_event();
@@ -505,6 +556,50 @@ bool ui_is_running(void)
 	return (g_core.state != UI_CORE_STATE_STOP);
 }
 
+#if defined(CONFIG_UI_FRAME_STATS)
+
+static void _ui_update_frame_stats(uint32_t frame_time, uint32_t area)
+{
+	uint32_t pixels = ui_renderer_get_pixel_count();
+
+	pthread_mutex_lock(&g_frame_stats_lock);
+	g_frame_stats.frame_count++;
+	g_frame_stats.last_frame_time = frame_time;
+	g_frame_stats.total_frame_time += frame_time;
+	if (frame_time > g_frame_stats.max_frame_time) {
+		g_frame_stats.max_frame_time = frame_time;
+	}
+	g_frame_stats.last_redraw_area = area;
+	g_frame_stats.total_redraw_area += area;
+	g_frame_stats.last_pixel_count = pixels;
+	g_frame_stats.total_pixel_count += pixels;
+	pthread_mutex_unlock(&g_frame_stats_lock);
+}
+
+ui_error_t ui_get_frame_stats(ui_frame_stats_t *stats)
+{
+	if (!stats) {
+		return UI_INVALID_PARAM;
+	}
+
+	pthread_mutex_lock(&g_frame_stats_lock);
+	*stats = g_frame_stats;
+	pthread_mutex_unlock(&g_frame_stats_lock);
+
+	return UI_OK;
+}
+
+ui_error_t ui_reset_frame_stats(void)
+{
+	pthread_mutex_lock(&g_frame_stats_lock);
+	memset(&g_frame_stats, 0, sizeof(ui_frame_stats_t));
+	pthread_mutex_unlock(&g_frame_stats_lock);
+
+	return UI_OK;
+}
+
+#endif // CONFIG_UI_FRAME_STATS
+
 #if defined(CONFIG_UI_ENABLE_TOUCH)
 
 static void _ui_deliver_touch_event(ui_widget_body_t *widget, ui_touch_event_t touch_event, ui_coord_t coord)
@@ -31,15 +31,25 @@
 static vec_void_t g_window_list;
 static ui_window_body_t *g_current_window = UI_NULL;
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
+#define UI_TILE_SIZE CONFIG_UI_PARTIAL_UPDATE_TILE_SIZE
+#define UI_TILE_COLS ((CONFIG_UI_DISPLAY_WIDTH + UI_TILE_SIZE - 1) / UI_TILE_SIZE)
+#define UI_TILE_ROWS ((CONFIG_UI_DISPLAY_HEIGHT + UI_TILE_SIZE - 1) / UI_TILE_SIZE)
+
+/**
+ * Damaged areas are marked on the tile map, so overlapped areas are merged by the tiles.
+ * The redraw list is built from the dirty tiles when it is requested.
+ */
 static vec_void_t g_window_redraw_list;
 static ui_rect_t g_rect_mempool[CONFIG_UI_UPDATE_MEMPOOL_SIZE];
 static int g_rect_mempool_idx = 0;
+static bool g_dirty_tiles[UI_TILE_ROWS][UI_TILE_COLS];
+static bool g_dirty = false;
 #endif
 
 static void _ui_window_create_func(void *userdata);
 static void _ui_window_destroy_func(void *userdata);
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
-static ui_rect_t *_ui_window_get_mempool_rect(void);
+static void _ui_window_build_redraw_list(void);
 #endif
 
 ui_error_t ui_window_list_init(void)
@@ -251,78 +261,36 @@ ui_error_t ui_window_add_widget(ui_window_t window, ui_widget_t widget, int32_t
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
 vec_void_t *ui_window_get_redraw_list(void)
 {
+	if (g_dirty) {
+		_ui_window_build_redraw_list();
+		g_dirty = false;
+	}
+
 	return &g_window_redraw_list;
 }
 
 ui_error_t ui_window_add_redraw_list(ui_rect_t redraw_rect)
 {
-	ui_rect_t *window;
-	ui_rect_t *new_area;
-	ui_rect_t previous;
-	ui_rect_t ret;
-	int iter;
-
-	if (redraw_rect.x < 0) {
-		redraw_rect.width += redraw_rect.x;
-		redraw_rect.x = 0;
-	} else if (redraw_rect.x >= CONFIG_UI_DISPLAY_WIDTH) {
-		return UI_OK;
-	}
+	int32_t x2;
+	int32_t y2;
+	int row;
+	int col;
 
-	if (redraw_rect.y < 0) {
-		redraw_rect.height += redraw_rect.y;
-		redraw_rect.y = 0;
-	} else if (redraw_rect.y >= CONFIG_UI_DISPLAY_HEIGHT) {
-		return UI_OK;
-	}
+	x2 = UI_MIN(redraw_rect.x + redraw_rect.width, CONFIG_UI_DISPLAY_WIDTH);
+	y2 = UI_MIN(redraw_rect.y + redraw_rect.height, CONFIG_UI_DISPLAY_HEIGHT);
+	redraw_rect.x = UI_MAX(redraw_rect.x, 0);
+	redraw_rect.y = UI_MAX(redraw_rect.y, 0);
 
-	if (redraw_rect.width <= 0 || redraw_rect.height <= 0) {
+	if (x2 <= redraw_rect.x || y2 <= redraw_rect.y) {
 		return UI_OK;
 	}
 
-	new_area = _ui_window_get_mempool_rect();
-
-	new_area->x = redraw_rect.x;
-	new_area->y = redraw_rect.y;
-	new_area->width = redraw_rect.width;
-	new_area->height = redraw_rect.height;
-
-	if (new_area->x + new_area->width >= CONFIG_UI_DISPLAY_WIDTH) {
-		new_area->width = CONFIG_UI_DISPLAY_WIDTH - new_area->x;
-	}
-	if (new_area->y + new_area->height >= CONFIG_UI_DISPLAY_HEIGHT) {
-		new_area->height = CONFIG_UI_DISPLAY_HEIGHT - new_area->y;
-	}
-
-	vec_foreach(&g_window_redraw_list, window, iter) {
-		// window is whole screen case
-		if ((window->x == 0) && (window->y == 0) &&
-			(window->width == CONFIG_UI_DISPLAY_WIDTH) &&
-			(window->height == CONFIG_UI_DISPLAY_HEIGHT)) {
-			return UI_OK;
-		}
-
-		previous.x = window->x;
-		previous.y = window->y;
-		previous.width = window->width;
-		previous.height = window->height;
-
-		ret = ui_rect_intersect(previous, *new_area);
-		if (ret.x == 0 && ret.y == 0 && ret.width == 0 && ret.height == 0) {
-			continue;
+	for (row = redraw_rect.y / UI_TILE_SIZE; row <= (y2 - 1) / UI_TILE_SIZE; row++) {
+		for (col = redraw_rect.x / UI_TILE_SIZE; col <= (x2 - 1) / UI_TILE_SIZE; col++) {
+			g_dirty_tiles[row][col] = true;
 		}
-
-		ret = ui_get_contain_rect(previous, *new_area);
-		new_area->x = ret.x;
-		new_area->y = ret.y;
-		new_area->width = ret.width;
-		new_area->height = ret.height;
-
-		vec_remove(&g_window_redraw_list, window);
-		iter--;
 	}
-
-	vec_push(&g_window_redraw_list, new_area);
+	g_dirty = true;
 
 	return UI_OK;
 }
@@ -330,20 +298,90 @@ ui_error_t ui_window_add_redraw_list(ui_rect_t redraw_rect)
 ui_error_t ui_window_redraw_list_clear(void)
 {
 	vec_clear(&g_window_redraw_list);
+	memset(g_dirty_tiles, 0, sizeof(g_dirty_tiles));
+	g_dirty = false;
 
 	return UI_OK;
 }
 
-static ui_rect_t *_ui_window_get_mempool_rect(void)
+/**
+ * @brief Merge the dirty tiles into rectangles which don't overlap each other.
+ *
+ * Adjacent dirty tiles of a tile row are merged into a span, and a span is merged into
+ * the rectangle of the previous tile row if that rectangle has the same horizontal range.
+ * If the mempool is not enough, the bounding rectangle of all dirty tiles is used.
+ */
+static void _ui_window_build_redraw_list(void)
 {
-	int alloc_idx = g_rect_mempool_idx;
+	ui_rect_t *prev_row[UI_TILE_COLS];
+	ui_rect_t *curr_row[UI_TILE_COLS];
+	ui_rect_t *rect;
+	ui_rect_t bound = {0, 0, 0, 0};
+	int32_t x;
+	int32_t y;
+	int32_t width;
+	int32_t height;
+	bool overflow = false;
+	int row;
+	int col;
+	int start;
+
+	vec_clear(&g_window_redraw_list);
+	g_rect_mempool_idx = 0;
+	memset(prev_row, 0, sizeof(prev_row));
+
+	for (row = 0; row < UI_TILE_ROWS; row++) {
+		memset(curr_row, 0, sizeof(curr_row));
+		y = row * UI_TILE_SIZE;
+		height = UI_MIN(y + UI_TILE_SIZE, CONFIG_UI_DISPLAY_HEIGHT) - y;
+
+		col = 0;
+		while (col < UI_TILE_COLS) {
+			if (!g_dirty_tiles[row][col]) {
+				col++;
+				continue;
+			}
+
+			start = col;
+			while (col < UI_TILE_COLS && g_dirty_tiles[row][col]) {
+				col++;
+			}
+
+			x = start * UI_TILE_SIZE;
+			width = UI_MIN(col * UI_TILE_SIZE, CONFIG_UI_DISPLAY_WIDTH) - x;
+
+			rect = prev_row[start];
+			if (rect && rect->width == width) {
+				rect->height = y + height - rect->y;
+			} else if (g_rect_mempool_idx < CONFIG_UI_UPDATE_MEMPOOL_SIZE) {
+				rect = &g_rect_mempool[g_rect_mempool_idx++];
+				rect->x = x;
+				rect->y = y;
+				rect->width = width;
+				rect->height = height;
+				vec_push(&g_window_redraw_list, rect);
+			} else {
+				rect = NULL;
+				overflow = true;
+			}
+			curr_row[start] = rect;
+
+			if (bound.width == 0) {
+				bound = (ui_rect_t){ x, y, width, height };
+			} else {
+				bound = ui_get_contain_rect(bound, (ui_rect_t){ x, y, width, height });
+			}
+		}
 
-	g_rect_mempool_idx++;
-	if (g_rect_mempool_idx >= CONFIG_UI_UPDATE_MEMPOOL_SIZE) {
-		g_rect_mempool_idx = 0;
+		memcpy(prev_row, curr_row, sizeof(prev_row));
 	}
 
-	return &g_rect_mempool[alloc_idx];
+	if (overflow) {
+		UI_LOGD("redraw list is full, use the bounding rect\n");
+		vec_clear(&g_window_redraw_list);
+		g_rect_mempool[0] = bound;
+		vec_push(&g_window_redraw_list, &g_rect_mempool[0]);
+	}
 }
 #endif // CONFIG_UI_PARTIAL_UPDATE
 
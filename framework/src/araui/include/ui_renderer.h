@@ -18,7 +18,9 @@
 #ifndef __UI_RENDERER_H__
 #define __UI_RENDERER_H__
 
+#include <tinyara/config.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <araui/ui_commons.h>
 
 /**
@@ -75,6 +77,12 @@ void ui_renderer_rotate(ui_mat3_t *mat, int32_t deg);
 void ui_renderer_scale(ui_mat3_t *mat, float x, float y);
 void ui_renderer_set_texture(uint8_t *bitmap, int32_t width, int32_t height, ui_pixel_format_t pf);
 void ui_renderer_set_fill_color(ui_color_t color);
+void ui_renderer_set_clip(ui_rect_t clip);
+bool ui_renderer_get_translation(ui_mat3_t *mat, float x, float y, int32_t *tx, int32_t *ty);
+#if defined(CONFIG_UI_FRAME_STATS)
+uint32_t ui_renderer_get_pixel_count(void);
+void ui_renderer_reset_pixel_count(void);
+#endif
 
 /**
  * @brief Rendering geometry functions
@@ -90,4 +98,11 @@ void ui_render_quad_uv(ui_mat3_t *trans_mat,
 	ui_vec3_t v1, ui_vec3_t v2, ui_vec3_t v3, ui_vec3_t v4,
 	ui_uv_t uv1, ui_uv_t uv2, ui_uv_t uv3, ui_uv_t uv4);
 
+/**
+ * @brief Draw the texture without any transform, with its top-left corner at (x, y).
+ * It copies pixels of the texture straightly, so it is used instead of ui_render_quad_uv()
+ * when ui_renderer_get_translation() says the matrix of the widget has translation only.
+ */
+void ui_render_bitmap(int32_t x, int32_t y);
+
 #endif // __UI_RENDERER_H__
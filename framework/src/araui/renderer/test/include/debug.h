@@ -0,0 +1,10 @@
+/* debug.h of the host build of ui_renderer_test */
+
+#ifndef __UI_RENDERER_TEST_DEBUG_H
+#define __UI_RENDERER_TEST_DEBUG_H
+
+#include <stdio.h>
+
+#define dbg printf
+
+#endif
@@ -0,0 +1,13 @@
+/* Configuration of the host build of ui_renderer_test */
+
+#ifndef __UI_RENDERER_TEST_CONFIG_H
+#define __UI_RENDERER_TEST_CONFIG_H
+
+#define CONFIG_UI 1
+#define CONFIG_UI_DISPLAY_WIDTH 250
+#define CONFIG_UI_DISPLAY_HEIGHT 96
+#define CONFIG_UI_UPDATE_MEMPOOL_SIZE 128
+#define CONFIG_UI_STACK_SIZE 4096
+#define CONFIG_UI_MAXIMUM_FPS 30
+
+#endif
@@ -0,0 +1,251 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * Host test of the textured triangle rasterizer in ui_renderer.c.
+ *
+ * A texture whose texels encode their own position is drawn as a quad with
+ * many rotations, scales and pixel formats. Each drawn pixel is compared
+ * against a float reference, which maps the pixel back into the texture
+ * with the inverse of the transform and takes the nearest texel:
+ *  - no pixel is drawn outside of the display or twice,
+ *  - the pixels well inside of the quad are all drawn and none is drawn
+ *    more than a pixel outside of it,
+ *  - the texel of a pixel is the reference one or its neighbour.
+ *
+ * Build and run it from framework/src/araui/renderer:
+ *   gcc -O1 -std=gnu99 -Itest/include -I../../../include -I../include \
+ *       -I../../../../external/include -o ui_renderer_test \
+ *       test/ui_renderer_test.c ui_renderer.c -lm
+ *   ./ui_renderer_test
+ */
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <araui/ui_commons.h>
+#include "ui_renderer.h"
+
+#define TEST_WIDTH   CONFIG_UI_DISPLAY_WIDTH
+#define TEST_HEIGHT  CONFIG_UI_DISPLAY_HEIGHT
+#define TEX_WIDTH    64
+#define TEX_HEIGHT   48
+#define TEX_MARK     0x5a
+#define FILL_COLOR   0x123456
+
+/* Share of the drawn pixels which may pick a neighbouring texel */
+
+#define MAX_NEIGHBOUR_PERMILLE 5
+
+static ui_color_t g_fb[TEST_HEIGHT][TEST_WIDTH];
+static uint8_t g_drawn[TEST_HEIGHT][TEST_WIDTH];
+static uint8_t g_tex[TEX_WIDTH * TEX_HEIGHT * 4];
+static long g_errors;
+
+/* Display stubs */
+
+static void test_put_pixel(int32_t x, int32_t y, ui_color_t color)
+{
+	if (x < 0 || y < 0 || x >= TEST_WIDTH || y >= TEST_HEIGHT) {
+		printf("pixel (%d, %d) is outside of the display\n", x, y);
+		g_errors++;
+		return;
+	}
+	g_fb[y][x] = color;
+	g_drawn[y][x]++;
+}
+
+void ui_dal_put_pixel_rgba8888(int32_t x, int32_t y, ui_color_t color)
+{
+	test_put_pixel(x, y, color);
+}
+
+void ui_dal_put_pixel_rgb888(int32_t x, int32_t y, ui_color_t color)
+{
+	test_put_pixel(x, y, color);
+}
+
+ui_rect_t ui_rect_intersect(ui_rect_t r1, ui_rect_t r2)
+{
+	ui_rect_t rect = { 0, 0, 0, 0 };
+
+	return rect;
+}
+
+/* The texel (x, y) is (x, y, TEX_MARK) in RGB, its alpha and its A8 value
+ * are unique within a row, so the texel of a drawn pixel can be told.
+ */
+static void test_make_texture(ui_pixel_format_t pf)
+{
+	int bpp = (pf == UI_PIXEL_FORMAT_RGBA8888) ? 4 : (pf == UI_PIXEL_FORMAT_RGB888) ? 3 : 1;
+	uint8_t *p = g_tex;
+	int x;
+	int y;
+
+	for (y = 0; y < TEX_HEIGHT; y++) {
+		for (x = 0; x < TEX_WIDTH; x++) {
+			if (bpp == 1) {
+				*p++ = (uint8_t)(x * 3 + y * 67);
+			} else {
+				*p++ = x;
+				*p++ = y;
+				*p++ = TEX_MARK;
+				if (bpp == 4) {
+					*p++ = 0xff;
+				}
+			}
+		}
+	}
+}
+
+/* Returns true if the drawn color is the one of texel (tx, ty) */
+
+static bool test_is_texel(ui_pixel_format_t pf, ui_color_t color, int tx, int ty)
+{
+	if (tx < 0 || ty < 0 || tx >= TEX_WIDTH || ty >= TEX_HEIGHT) {
+		return false;
+	}
+
+	if (pf == UI_PIXEL_FORMAT_RGBA8888) {
+		return color == UI_COLOR_RGBA8888(tx, ty, TEX_MARK, 0xff);
+	} else if (pf == UI_PIXEL_FORMAT_RGB888) {
+		return color == UI_COLOR_RGB888(tx, ty, TEX_MARK);
+	}
+
+	return color == UI_COLOR_RGBA8888((FILL_COLOR >> 16) & 0xff, (FILL_COLOR >> 8) & 0xff, FILL_COLOR & 0xff, g_tex[ty * TEX_WIDTH + tx]);
+}
+
+static void test_quad(ui_pixel_format_t pf, int deg, float sx, float sy, long *drawn, long *neighbours)
+{
+	ui_mat3_t mat = ui_mat3_identity();
+	ui_mat3_t tmp;
+	float rad = deg * UI_RENDERER_PI / 180.0f;
+	float cx = 120.3f;
+	float cy = 100.7f - 60.0f;
+	float margin = 1.5f / fminf(sx, sy);
+	float dx;
+	float dy;
+	float ox;
+	float oy;
+	int tx;
+	int ty;
+	int x;
+	int y;
+
+	memset(g_fb, 0, sizeof(g_fb));
+	memset(g_drawn, 0, sizeof(g_drawn));
+
+	/* Centered at (cx, cy), rotated by deg and scaled by (sx, sy) */
+
+	ui_renderer_translate(&mat, &tmp, cx, cy);
+	ui_renderer_rotate(&tmp, deg);
+	ui_renderer_scale(&tmp, sx, sy);
+	ui_renderer_translate(&tmp, &mat, -TEX_WIDTH / 2.0f, -TEX_HEIGHT / 2.0f);
+
+	ui_renderer_set_texture(g_tex, TEX_WIDTH, TEX_HEIGHT, pf);
+	ui_renderer_set_fill_color(FILL_COLOR);
+	ui_render_quad_uv(&mat,
+		(ui_vec3_t){ 0, 0, 1 }, (ui_vec3_t){ TEX_WIDTH, 0, 1 },
+		(ui_vec3_t){ TEX_WIDTH, TEX_HEIGHT, 1 }, (ui_vec3_t){ 0, TEX_HEIGHT, 1 },
+		(ui_uv_t){ 0, 0 }, (ui_uv_t){ 1, 0 }, (ui_uv_t){ 1, 1 }, (ui_uv_t){ 0, 1 });
+
+	for (y = 0; y < TEST_HEIGHT; y++) {
+		for (x = 0; x < TEST_WIDTH; x++) {
+			/* The pixel is sampled at its integer position */
+
+			dx = x - cx;
+			dy = y - cy;
+			ox = (dx * cosf(rad) + dy * sinf(rad)) / sx + TEX_WIDTH / 2.0f;
+			oy = (-dx * sinf(rad) + dy * cosf(rad)) / sy + TEX_HEIGHT / 2.0f;
+
+			if (g_drawn[y][x] > 1) {
+				printf("pf %d deg %d scale %.2f: pixel (%d, %d) is drawn %d times\n", pf, deg, sx, x, y, g_drawn[y][x]);
+				g_errors++;
+			}
+
+			if (!g_drawn[y][x]) {
+				if (ox > margin && ox < TEX_WIDTH - margin && oy > margin && oy < TEX_HEIGHT - margin) {
+					printf("pf %d deg %d scale %.2f: pixel (%d, %d) inside of the quad is not drawn\n", pf, deg, sx, x, y);
+					g_errors++;
+				}
+				continue;
+			}
+
+			if (ox < -margin || ox > TEX_WIDTH + margin || oy < -margin || oy > TEX_HEIGHT + margin) {
+				printf("pf %d deg %d scale %.2f: pixel (%d, %d) outside of the quad is drawn\n", pf, deg, sx, x, y);
+				g_errors++;
+				continue;
+			}
+
+			/* The renderer spreads uv 0..1 over the texels 0..size - 1
+			 * and takes the nearest one
+			 */
+
+			tx = (int)floorf(ox / TEX_WIDTH * (TEX_WIDTH - 1) + 0.5f);
+			ty = (int)floorf(oy / TEX_HEIGHT * (TEX_HEIGHT - 1) + 0.5f);
+			tx = (tx < 0) ? 0 : (tx >= TEX_WIDTH) ? TEX_WIDTH - 1 : tx;
+			ty = (ty < 0) ? 0 : (ty >= TEX_HEIGHT) ? TEX_HEIGHT - 1 : ty;
+
+			(*drawn)++;
+			if (test_is_texel(pf, g_fb[y][x], tx, ty)) {
+				continue;
+			}
+
+			(*neighbours)++;
+			if (!test_is_texel(pf, g_fb[y][x], tx - 1, ty) && !test_is_texel(pf, g_fb[y][x], tx + 1, ty) &&
+				!test_is_texel(pf, g_fb[y][x], tx, ty - 1) && !test_is_texel(pf, g_fb[y][x], tx, ty + 1) &&
+				!test_is_texel(pf, g_fb[y][x], tx - 1, ty - 1) && !test_is_texel(pf, g_fb[y][x], tx + 1, ty - 1) &&
+				!test_is_texel(pf, g_fb[y][x], tx - 1, ty + 1) && !test_is_texel(pf, g_fb[y][x], tx + 1, ty + 1)) {
+				printf("pf %d deg %d scale %.2f: pixel (%d, %d) has color 0x%08x, expected texel (%d, %d)\n",
+					   pf, deg, sx, x, y, g_fb[y][x], tx, ty);
+				g_errors++;
+			}
+		}
+	}
+}
+
+int main(void)
+{
+	ui_pixel_format_t pfs[] = { UI_PIXEL_FORMAT_RGBA8888, UI_PIXEL_FORMAT_RGB888, UI_PIXEL_FORMAT_A8 };
+	long drawn = 0;
+	long neighbours = 0;
+	unsigned int i;
+	int deg;
+	float scale;
+
+	for (i = 0; i < sizeof(pfs) / sizeof(pfs[0]); i++) {
+		test_make_texture(pfs[i]);
+		for (deg = 0; deg < 360; deg += 7) {
+			for (scale = 0.5f; scale < 3.0f; scale += 0.45f) {
+				test_quad(pfs[i], deg, scale, scale * 0.8f, &drawn, &neighbours);
+			}
+		}
+	}
+
+	printf("%ld pixels drawn, %ld picked a neighbouring texel\n", drawn, neighbours);
+	if (neighbours * 1000 > drawn * MAX_NEIGHBOUR_PERMILLE) {
+		printf("too many pixels picked a neighbouring texel\n");
+		g_errors++;
+	}
+
+	printf("%s\n", g_errors ? "FAIL" : "PASS");
+	return g_errors ? 1 : 0;
+}
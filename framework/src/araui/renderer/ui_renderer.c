@@ -34,16 +34,20 @@
 #define MAX_RENDERER_MATRIX_STACK (256)
 #define UI_TM (g_rc.tm_stack[g_rc.sp])
 
-#define UI_SUB_DIVIDE_SHIFT (4)
-#define UI_SUB_DIVIDE_SIZE (1 << UI_SUB_DIVIDE_SHIFT)
 #define UI_SUB_PIX(a) (ceilf(a) - (a))
 
+// Texture coordinates in the spans are 16.16 fixed-point texel positions
+#define UI_FIXED_SHIFT (16)
+#define UI_FIXED_ONE (1 << UI_FIXED_SHIFT)
+
 #define CONFIG_UI_DEFAULT_FILL_COLOR 0x000000
 
 /****************************************************************************
  * Private function declaration
  ****************************************************************************/
 static void ui_draw_triangle_segment(int32_t y1, int32_t y2);
+static void ui_draw_texture_span(int32_t x, int32_t y, int32_t u, int32_t v, int32_t du, int32_t dv, int32_t width);
+static void ui_draw_bitmap_span(int32_t x, int32_t y, uint8_t *src, int32_t width);
 
 /****************************************************************************
  * Private types
@@ -52,8 +56,13 @@ typedef struct {
 	uint8_t          *texture;
 	int32_t           tex_width;
 	int32_t           tex_height;
+	int32_t           tex_bpp;
 	ui_pixel_format_t tex_pf;
 	ui_color_t        fill_color;
+	ui_rect_t         clip;
+#if defined(CONFIG_UI_FRAME_STATS)
+	uint32_t          pixel_count;
+#endif
 } ui_render_context_t;
 
 //!< Render context (global instance)
@@ -61,8 +70,10 @@ ui_render_context_t g_rc = {
 	.texture = NULL,
 	.tex_width = 0,
 	.tex_height = 0,
+	.tex_bpp = 0,
 	.tex_pf = UI_PIXEL_FORMAT_UNKNOWN,
-	.fill_color = CONFIG_UI_DEFAULT_FILL_COLOR
+	.fill_color = CONFIG_UI_DEFAULT_FILL_COLOR,
+	.clip = { 0, 0, CONFIG_UI_DISPLAY_WIDTH, CONFIG_UI_DISPLAY_HEIGHT }
 };
 
 float g_left_dxdy;
@@ -73,14 +84,12 @@ float g_left_dudy;
 float g_leftu;
 float g_left_dvdy;
 float g_leftv;
-float g_left_dzdy;
-float g_leftz;
 float g_pk_dudx;
 float g_pk_dvdx;
-float g_pk_dzdx;
-float g_pk_dudx_;
-float g_pk_dvdx_;
-float g_pk_dzdx_;
+float g_tex_uscale;
+float g_tex_vscale;
+int32_t g_pk_du;
+int32_t g_pk_dv;
 
 /****************************************************************************
  * Public function implementation
@@ -178,9 +187,19 @@ void ui_renderer_set_texture(uint8_t *bitmap, int32_t width, int32_t height, ui_
 		g_rc.tex_width = width;
 		g_rc.tex_height = height;
 		g_rc.tex_pf = pf;
+		if (pf == UI_PIXEL_FORMAT_RGBA8888) {
+			g_rc.tex_bpp = 4;
+		} else if (pf == UI_PIXEL_FORMAT_RGB888) {
+			g_rc.tex_bpp = 3;
+		} else if (pf == UI_PIXEL_FORMAT_A8) {
+			g_rc.tex_bpp = 1;
+		} else {
+			g_rc.tex_bpp = 0;
+		}
 	} else {
 		g_rc.tex_width = 0;
 		g_rc.tex_height = 0;
+		g_rc.tex_bpp = 0;
 		g_rc.tex_pf = UI_PIXEL_FORMAT_UNKNOWN;
 	}
 }
@@ -190,19 +209,93 @@ void ui_renderer_set_fill_color(ui_color_t color)
 	g_rc.fill_color = color;
 }
 
+void ui_renderer_set_clip(ui_rect_t clip)
+{
+	g_rc.clip = clip;
+}
+
+/**
+ * @brief Check whether the matrix only translates, by whole pixels.
+ * On true, (tx, ty) is the point where (x, y) is transformed to.
+ */
+bool ui_renderer_get_translation(ui_mat3_t *mat, float x, float y, int32_t *tx, int32_t *ty)
+{
+	float fx;
+	float fy;
+
+	if (mat->m[0][0] != 1.0f || mat->m[0][1] != 0.0f ||
+		mat->m[1][0] != 0.0f || mat->m[1][1] != 1.0f) {
+		return false;
+	}
+
+	fx = mat->m[0][2] + x;
+	fy = mat->m[1][2] + y;
+	if (fx != floorf(fx) || fy != floorf(fy)) {
+		return false;
+	}
+
+	*tx = (int32_t)fx;
+	*ty = (int32_t)fy;
+
+	return true;
+}
+
+#if defined(CONFIG_UI_FRAME_STATS)
+uint32_t ui_renderer_get_pixel_count(void)
+{
+	return g_rc.pixel_count;
+}
+
+void ui_renderer_reset_pixel_count(void)
+{
+	g_rc.pixel_count = 0;
+}
+#endif
+
+void ui_render_bitmap(int32_t x, int32_t y)
+{
+	ui_rect_t area;
+	int32_t row;
+
+	if (!g_rc.texture) {
+		return;
+	}
+
+	area = ui_rect_intersect(g_rc.clip, (ui_rect_t){ x, y, g_rc.tex_width, g_rc.tex_height });
+	if (area.width <= 0 || area.height <= 0) {
+		return;
+	}
+
+#if defined(CONFIG_UI_ENABLE_HW_ACC_CHROM_ART)
+	if (area.width == g_rc.tex_width && area.height == g_rc.tex_height && g_rc.tex_pf != UI_PIXEL_FORMAT_A8) {
+		ui_dal_draw_bitmap_dma2d(x, y, g_rc.texture, g_rc.tex_width, g_rc.tex_height, g_rc.tex_pf);
+#if defined(CONFIG_UI_FRAME_STATS)
+		g_rc.pixel_count += area.width * area.height;
+#endif
+		return;
+	}
+#endif
+
+	if (!g_rc.tex_bpp) {
+		return;
+	}
+
+	for (row = area.y; row < area.y + area.height; row++) {
+		ui_draw_bitmap_span(area.x, row,
+			g_rc.texture + (((row - y) * g_rc.tex_width) + (area.x - x)) * g_rc.tex_bpp, area.width);
+	}
+}
+
 void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 	ui_vec3_t v1, ui_vec3_t v2, ui_vec3_t v3,
 	ui_uv_t uv1, ui_uv_t uv2, ui_uv_t uv3)
 {
 	float u_a;
 	float v_a;
-	float z_a;
 	float u_b;
 	float v_b;
-	float z_b;
 	float u_c;
 	float v_c;
-	float z_c;
 	int32_t y1i;
 	int32_t y2i;
 	int32_t y3i;
@@ -216,11 +309,12 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 	float dVdY_V1V3;
 	float dVdY_V2V3;
 	float dVdY_V1V2;
-	float dZdY_V1V3;
-	float dZdY_V2V3;
-	float dZdY_V1V2;
 	float denom;
 
+	if (!g_rc.texture || !g_rc.tex_bpp) {
+		return;
+	}
+
 	v1 = ui_mat3_vec3_multiply(trans_mat, &v1);
 	v2 = ui_mat3_vec3_multiply(trans_mat, &v2);
 	v3 = ui_mat3_vec3_multiply(trans_mat, &v3);
@@ -252,9 +346,6 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 	v_a = uv1.v;
 	v_b = uv2.v;
 	v_c = uv3.v;
-	z_a = 1.0f;
-	z_b = 1.0f;
-	z_c = 1.0f;
 
 	dXdY_V1V3 = (v3.x - v1.x) / (v3.y - v1.y);
 	dXdY_V2V3 = (v3.x - v2.x) / (v3.y - v2.y);
@@ -268,10 +359,6 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 	dVdY_V2V3 = (v_c - v_b) / (v3.y - v2.y);
 	dVdY_V1V2 = (v_b - v_a) / (v2.y - v1.y);
 
-	dZdY_V1V3 = (z_c - z_a) / (v3.y - v1.y);
-	dZdY_V2V3 = (z_c - z_b) / (v3.y - v2.y);
-	dZdY_V1V2 = (z_b - z_a) / (v2.y - v1.y);
-
 	denom = ((v3.x - v1.x) * (v2.y - v1.y) - (v2.x - v1.x) * (v3.y - v1.y));
 
 	if (!denom) {
@@ -282,11 +369,13 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 
 	g_pk_dudx = ((u_c - u_a) * (v2.y - v1.y) - (u_b - u_a) * (v3.y - v1.y)) * denom;
 	g_pk_dvdx = ((v_c - v_a) * (v2.y - v1.y) - (v_b - v_a) * (v3.y - v1.y)) * denom;
-	g_pk_dzdx = ((z_c - z_a) * (v2.y - v1.y) - (z_b - z_a) * (v3.y - v1.y)) * denom;
 
-	g_pk_dudx_ = g_pk_dudx * UI_SUB_DIVIDE_SIZE;
-	g_pk_dvdx_ = g_pk_dvdx * UI_SUB_DIVIDE_SIZE;
-	g_pk_dzdx_ = g_pk_dzdx * UI_SUB_DIVIDE_SIZE;
+	// The mapping is affine, so u and v step by a constant per pixel along a span.
+	// They are stepped as fixed-point texel positions, which is all the span loops need.
+	g_tex_uscale = (float)((g_rc.tex_width - 1) * UI_FIXED_ONE);
+	g_tex_vscale = (float)((g_rc.tex_height - 1) * UI_FIXED_ONE);
+	g_pk_du = (int32_t)(g_pk_dudx * g_tex_uscale);
+	g_pk_dv = (int32_t)(g_pk_dvdx * g_tex_vscale);
 
 	bool mid = dXdY_V1V3 < dXdY_V1V2;
 	if (!mid) {
@@ -295,13 +384,11 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 
 			g_left_dudy = dUdY_V2V3;
 			g_left_dvdy = dVdY_V2V3;
-			g_left_dzdy = dZdY_V2V3;
 			g_left_dxdy = dXdY_V2V3;
 			g_right_dxdy = dXdY_V1V3;
 
 			g_leftu = u_b + UI_SUB_PIX(v2.y) * g_left_dudy;
 			g_leftv = v_b + UI_SUB_PIX(v2.y) * g_left_dvdy;
-			g_leftz = z_b + UI_SUB_PIX(v2.y) * g_left_dzdy;
 			g_leftx = v2.x + UI_SUB_PIX(v2.y) * g_left_dxdy;
 			g_rightx = v1.x + prestep * g_right_dxdy;
 
@@ -316,12 +403,10 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 
 			g_left_dudy = dUdY_V1V2;
 			g_left_dvdy = dVdY_V1V2;
-			g_left_dzdy = dZdY_V1V2;
 			g_left_dxdy = dXdY_V1V2;
 
 			g_leftu = u_a + prestep * g_left_dudy;
 			g_leftv = v_a + prestep * g_left_dvdy;
-			g_leftz = z_a + prestep * g_left_dzdy;
 			g_leftx = v1.x + prestep * g_left_dxdy;
 			g_rightx = v1.x + prestep * g_right_dxdy;
 
@@ -333,11 +418,9 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 			g_left_dxdy = dXdY_V2V3;
 			g_left_dudy = dUdY_V2V3;
 			g_left_dvdy = dVdY_V2V3;
-			g_left_dzdy = dZdY_V2V3;
 
 			g_leftu = u_b + UI_SUB_PIX(v2.y) * g_left_dudy;
 			g_leftv = v_b + UI_SUB_PIX(v2.y) * g_left_dvdy;
-			g_leftz = z_b + UI_SUB_PIX(v2.y) * g_left_dzdy;
 			g_leftx = v2.x + UI_SUB_PIX(v2.y) * g_left_dxdy;
 
 			ui_draw_triangle_segment(y2i, y3i);
@@ -350,13 +433,11 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 
 			g_left_dudy = dUdY_V1V3;
 			g_left_dvdy = dVdY_V1V3;
-			g_left_dzdy = dZdY_V1V3;
 			g_left_dxdy = dXdY_V1V3;
 			g_right_dxdy = dXdY_V2V3;
 
 			g_leftu = u_a + prestep * g_left_dudy;
 			g_leftv = v_a + prestep * g_left_dvdy;
-			g_leftz = z_a + prestep * g_left_dzdy;
 			g_leftx = v1.x + prestep * g_left_dxdy;
 			g_rightx = v2.x + UI_SUB_PIX(v2.y) * g_right_dxdy;
 
@@ -367,7 +448,6 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 		g_left_dxdy = dXdY_V1V3;
 		g_left_dudy = dUdY_V1V3;
 		g_left_dvdy = dVdY_V1V3;
-		g_left_dzdy = dZdY_V1V3;
 
 		if (y1i < y2i) {
 
@@ -375,7 +455,6 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 
 			g_leftu = u_a + prestep * g_left_dudy;
 			g_leftv = v_a + prestep * g_left_dvdy;
-			g_leftz = z_a + prestep * g_left_dzdy;
 			g_leftx = v1.x + prestep * g_left_dxdy;
 			g_rightx = v1.x + prestep * g_right_dxdy;
 
@@ -404,153 +483,143 @@ void ui_render_quad_uv(ui_mat3_t *trans_mat,
  ****************************************************************************/
 static void ui_draw_triangle_segment(int32_t y1, int32_t y2)
 {
-	float u;
-	float v;
-	float z;
-	float Z;
-	int32_t du;
-	int32_t dv;
+	float sub_pix;
 	int32_t width;
-	int32_t U;
-	int32_t V;
-	int32_t U1;
-	int32_t V1;
-	int32_t U2;
-	int32_t V2;
 	int32_t x1;
 	int32_t x2;
 	int32_t y;
-	int32_t x;
-	int32_t iu;
-	int32_t iv;
-	int32_t uv_offset;
+	int32_t skip;
+
+	// Rows above the clip are stepped over at once, and rows below the clip are not drawn.
+	// If the bottom is cut, the next segment is also below the clip, so edges need not be stepped.
+	if (y1 < g_rc.clip.y) {
+		skip = UI_MIN(g_rc.clip.y, y2) - y1;
+		g_leftu += g_left_dudy * skip;
+		g_leftv += g_left_dvdy * skip;
+		g_leftx += g_left_dxdy * skip;
+		g_rightx += g_right_dxdy * skip;
+		y1 += skip;
+	}
+	if (y2 > g_rc.clip.y + g_rc.clip.height) {
+		y2 = g_rc.clip.y + g_rc.clip.height;
+	}
 
 	for (y = y1; y < y2; y++) {
 
 		x1 = ceilf(g_leftx);
 		x2 = ceilf(g_rightx);
-
-		u = g_leftu + UI_SUB_PIX(g_leftx) * g_pk_dudx;
-		v = g_leftv + UI_SUB_PIX(g_leftx) * g_pk_dvdx;
-		z = g_leftz + UI_SUB_PIX(g_leftx) * g_pk_dzdx;
-
-		Z = 65536.0f;
-		U2 = u * Z;
-		V2 = v * Z;
 		width = x2 - x1;
 
-		while (width >= UI_SUB_DIVIDE_SIZE) {
-
-			u += g_pk_dudx_;
-			v += g_pk_dvdx_;
-			z += g_pk_dzdx_;
-
-			U1 = U2;
-			V1 = V2;
-
-			Z = 65536.0f;
-			U2 = u * Z;
-			V2 = v * Z;
-
-			du = (U2 - U1) >> UI_SUB_DIVIDE_SHIFT;
-			dv = (V2 - V1) >> UI_SUB_DIVIDE_SHIFT;
-			U = U1;
-			V = V1;
-			x = UI_SUB_DIVIDE_SIZE;
-
-			while (x--) {
-				iu = (int32_t)((U / 65536.0f) * (g_rc.tex_width - 1) + 0.5f);
-				iv = (int32_t)((V / 65536.0f) * (g_rc.tex_height - 1) + 0.5f);
-
-				if (g_rc.tex_pf == UI_PIXEL_FORMAT_RGBA8888) {
-					uv_offset = ((iv * g_rc.tex_width) + iu) * 4;
-					ui_dal_put_pixel_rgba8888(x1++, y, UI_COLOR_RGBA8888(
-						g_rc.texture[uv_offset + 0],
-						g_rc.texture[uv_offset + 1],
-						g_rc.texture[uv_offset + 2],
-						g_rc.texture[uv_offset + 3]
-					));
-				} else if (g_rc.tex_pf == UI_PIXEL_FORMAT_RGB888) {
-					uv_offset = ((iv * g_rc.tex_width) + iu) * 3;
-					ui_dal_put_pixel_rgb888(x1++, y, UI_COLOR_RGB888(
-						g_rc.texture[uv_offset + 0],
-						g_rc.texture[uv_offset + 1],
-						g_rc.texture[uv_offset + 2]
-					));
-				} else if (g_rc.tex_pf == UI_PIXEL_FORMAT_A8) {
-					uv_offset = ((iv * g_rc.tex_width) + iu);
-					ui_dal_put_pixel_rgba8888(x1++, y, UI_COLOR_RGBA8888(
-						(g_rc.fill_color & 0xff0000) >> 16,
-						(g_rc.fill_color & 0x00ff00) >> 8,
-						(g_rc.fill_color & 0x0000ff) >> 0,
-						g_rc.texture[uv_offset]
-					));
-				}
-
-				U += du;
-				V += dv;
-			}
-
-			width -= UI_SUB_DIVIDE_SIZE;
-		}
-
 		if (width > 0) {
+			sub_pix = UI_SUB_PIX(g_leftx);
 
-			U1 = U2;
-			V1 = V2;
-
-			u += (g_pk_dudx * width);
-			v += (g_pk_dvdx * width);
-			z += (g_pk_dzdx * width);
-
-			Z = 65536.0f;
-			U2 = u * Z;
-			V2 = v * Z;
-
-			du = (U2 - U1) / width;
-			dv = (V2 - V1) / width;
-			U = U1;
-			V = V1;
-
-			while (width--) {
-				iu = (int32_t)((U / 65536.0f) * (g_rc.tex_width - 1) + 0.5f);
-				iv = (int32_t)((V / 65536.0f) * (g_rc.tex_height - 1) + 0.5f);
-
-				if (g_rc.tex_pf == UI_PIXEL_FORMAT_RGBA8888) {
-					uv_offset = ((iv * g_rc.tex_width) + iu) * 4;
-					ui_dal_put_pixel_rgba8888(x1++, y, UI_COLOR_RGBA8888(
-						g_rc.texture[uv_offset + 0],
-						g_rc.texture[uv_offset + 1],
-						g_rc.texture[uv_offset + 2],
-						g_rc.texture[uv_offset + 3]
-					));
-				} else if (g_rc.tex_pf == UI_PIXEL_FORMAT_RGB888) {
-					uv_offset = ((iv * g_rc.tex_width) + iu) * 3;
-					ui_dal_put_pixel_rgb888(x1++, y, UI_COLOR_RGB888(
-						g_rc.texture[uv_offset + 0],
-						g_rc.texture[uv_offset + 1],
-						g_rc.texture[uv_offset + 2]
-					));
-				} else if (g_rc.tex_pf == UI_PIXEL_FORMAT_A8) {
-					uv_offset = ((iv * g_rc.tex_width) + iu);
-					ui_dal_put_pixel_rgba8888(x1++, y, UI_COLOR_RGBA8888(
-						(g_rc.fill_color & 0xff0000) >> 16,
-						(g_rc.fill_color & 0x00ff00) >> 8,
-						(g_rc.fill_color & 0x0000ff) >> 0,
-						g_rc.texture[uv_offset]
-					));
-				}
-
-				U += du;
-				V += dv;
-			}
+			// Half a texel is added to round to the nearest texel in the span
+			ui_draw_texture_span(x1, y,
+				(int32_t)((g_leftu + sub_pix * g_pk_dudx) * g_tex_uscale + (UI_FIXED_ONE / 2)),
+				(int32_t)((g_leftv + sub_pix * g_pk_dvdx) * g_tex_vscale + (UI_FIXED_ONE / 2)),
+				g_pk_du, g_pk_dv, width);
 		}
 
 		g_leftu += g_left_dudy;
 		g_leftv += g_left_dvdy;
-		g_leftz += g_left_dzdy;
 		g_leftx += g_left_dxdy;
 		g_rightx += g_right_dxdy;
 	}
 }
 
+/**
+ * @brief Clamp the span to the texture, so that the loops need not check each texel.
+ * Rounding errors at the edges of a triangle may step a little out of the texture.
+ */
+static void ui_clamp_texture_span(int32_t *t, int32_t *dt, int32_t width, int32_t limit)
+{
+	int64_t end;
+
+	end = (int64_t)*t + (int64_t)*dt * (width - 1);
+	if (*t >= 0 && *t <= limit && end >= 0 && end <= limit) {
+		return;
+	}
+
+	*t = UI_MAX(0, UI_MIN(*t, limit));
+	end = UI_MAX(0, UI_MIN(end, limit));
+	*dt = (width > 1) ? (int32_t)((end - *t) / (width - 1)) : 0;
+}
+
+static void ui_draw_texture_span(int32_t x, int32_t y, int32_t u, int32_t v, int32_t du, int32_t dv, int32_t width)
+{
+	const uint8_t *src;
+	uint8_t r;
+	uint8_t g;
+	uint8_t b;
+
+	ui_clamp_texture_span(&u, &du, width, (g_rc.tex_width << UI_FIXED_SHIFT) - 1);
+	ui_clamp_texture_span(&v, &dv, width, (g_rc.tex_height << UI_FIXED_SHIFT) - 1);
+
+#if defined(CONFIG_UI_FRAME_STATS)
+	g_rc.pixel_count += width;
+#endif
+
+	// One loop per pixel format, so that the format is not checked for every pixel
+	if (g_rc.tex_pf == UI_PIXEL_FORMAT_RGBA8888) {
+		while (width--) {
+			src = g_rc.texture + (((v >> UI_FIXED_SHIFT) * g_rc.tex_width) + (u >> UI_FIXED_SHIFT)) * 4;
+			ui_dal_put_pixel_rgba8888(x++, y, UI_COLOR_RGBA8888(src[0], src[1], src[2], src[3]));
+			u += du;
+			v += dv;
+		}
+	} else if (g_rc.tex_pf == UI_PIXEL_FORMAT_RGB888) {
+		while (width--) {
+			src = g_rc.texture + (((v >> UI_FIXED_SHIFT) * g_rc.tex_width) + (u >> UI_FIXED_SHIFT)) * 3;
+			ui_dal_put_pixel_rgb888(x++, y, UI_COLOR_RGB888(src[0], src[1], src[2]));
+			u += du;
+			v += dv;
+		}
+	} else if (g_rc.tex_pf == UI_PIXEL_FORMAT_A8) {
+		r = (g_rc.fill_color & 0xff0000) >> 16;
+		g = (g_rc.fill_color & 0x00ff00) >> 8;
+		b = (g_rc.fill_color & 0x0000ff) >> 0;
+		while (width--) {
+			src = g_rc.texture + ((v >> UI_FIXED_SHIFT) * g_rc.tex_width) + (u >> UI_FIXED_SHIFT);
+			ui_dal_put_pixel_rgba8888(x++, y, UI_COLOR_RGBA8888(r, g, b, *src));
+			u += du;
+			v += dv;
+		}
+	}
+}
+
+static void ui_draw_bitmap_span(int32_t x, int32_t y, uint8_t *src, int32_t width)
+{
+#if defined(CONFIG_UI_FRAME_STATS)
+	g_rc.pixel_count += width;
+#endif
+
+	if (g_rc.tex_pf == UI_PIXEL_FORMAT_RGBA8888) {
+		while (width--) {
+			if (src[3]) {
+				ui_dal_put_pixel_rgba8888(x, y, UI_COLOR_RGBA8888(src[0], src[1], src[2], src[3]));
+			}
+			src += 4;
+			x++;
+		}
+	} else if (g_rc.tex_pf == UI_PIXEL_FORMAT_RGB888) {
+		while (width--) {
+			ui_dal_put_pixel_rgb888(x, y, UI_COLOR_RGB888(src[0], src[1], src[2]));
+			src += 3;
+			x++;
+		}
+	} else if (g_rc.tex_pf == UI_PIXEL_FORMAT_A8) {
+		while (width--) {
+			// Fully transparent pixels of glyphs are skipped
+			if (*src) {
+				ui_dal_put_pixel_rgba8888(x, y, UI_COLOR_RGBA8888(
+					(g_rc.fill_color & 0xff0000) >> 16,
+					(g_rc.fill_color & 0x00ff00) >> 8,
+					(g_rc.fill_color & 0x0000ff) >> 0,
+					*src
+				));
+			}
+			src++;
+			x++;
+		}
+	}
+}
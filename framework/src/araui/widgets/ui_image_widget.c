@@ -116,6 +116,8 @@ static void ui_image_widget_render_func(ui_widget_t widget, uint32_t dt)
 	ui_vec3_t v2;
 	ui_vec3_t v3;
 	ui_vec3_t v4;
+	int32_t x;
+	int32_t y;
 
 	if (!widget) {
 		UI_LOGE("error: Invalid Parameter!\n");
@@ -126,6 +128,17 @@ static void ui_image_widget_render_func(ui_widget_t widget, uint32_t dt)
 	if (body->image) {
 		ui_renderer_set_texture(body->image->buf, body->image->width, body->image->height, body->image->pixel_format);
 
+		// Whole image at its own size without rotation and scale is copied straightly
+		if (body->base.local_rect.width == body->image->width &&
+			body->base.local_rect.height == body->image->height &&
+			body->uv[UV_TOP_LEFT].u == 0.0f && body->uv[UV_TOP_LEFT].v == 0.0f &&
+			body->uv[UV_BOTTOM_RIGHT].u == 1.0f && body->uv[UV_BOTTOM_RIGHT].v == 1.0f &&
+			ui_renderer_get_translation(&body->base.trans_mat, -body->base.pivot_x, -body->base.pivot_y, &x, &y)) {
+			ui_render_bitmap(x, y);
+			ui_renderer_set_texture(NULL, 0, 0, UI_PIXEL_FORMAT_UNKNOWN);
+			return;
+		}
+
 		v1 = (ui_vec3_t){
 			.x = -body->base.pivot_x,
 			.y = -body->base.pivot_y,
@@ -440,6 +440,8 @@ static void _ui_text_widget_render_func(ui_widget_t widget, uint32_t dt)
 	int out_h;
 	int x;
 	int y;
+	int32_t glyph_x;
+	int32_t glyph_y;
 	int32_t text_width;
 	size_t utf_idx = 0;
 	size_t draw_idx = 0;
@@ -579,36 +581,42 @@ static void _ui_text_widget_render_func(ui_widget_t widget, uint32_t dt)
 					scale, scale,
 					body->utf_code[draw_idx]);
 
-				ui_renderer_translate(&body->base.trans_mat, &text_mat, (float)x, (float)(y + ascent + c_y1));
 				ui_renderer_set_texture(g_glyph_bitmap, out_w, out_h, UI_PIXEL_FORMAT_A8);
 				ui_renderer_set_fill_color(body->font_color);
 
-				v1 = (ui_vec3_t){
-					.x = 0.0f,
-					.y = 0.0f,
-					1.0f
-				};
-				v2 = (ui_vec3_t){
-					.x = 0.0f,
-					.y = out_h,
-					1.0f
-				};
-				v3 = (ui_vec3_t){
-					.x = out_w,
-					.y = out_h,
-					1.0f
-				};
-				v4 = (ui_vec3_t){
-					.x = out_w,
-					.y = 0.0f,
-					1.0f
-				};
-
-				ui_render_quad_uv(&text_mat, v1, v2, v3, v4,
-							(ui_uv_t){ 0.0f, 0.0f },
-							(ui_uv_t){ 0.0f, 1.0f },
-							(ui_uv_t){ 1.0f, 1.0f },
-							(ui_uv_t){ 1.0f, 0.0f });
+				// Glyph is copied straightly if the text is not rotated or scaled
+				if (ui_renderer_get_translation(&body->base.trans_mat, (float)x, (float)(y + ascent + c_y1), &glyph_x, &glyph_y)) {
+					ui_render_bitmap(glyph_x, glyph_y);
+				} else {
+					ui_renderer_translate(&body->base.trans_mat, &text_mat, (float)x, (float)(y + ascent + c_y1));
+
+					v1 = (ui_vec3_t){
+						.x = 0.0f,
+						.y = 0.0f,
+						1.0f
+					};
+					v2 = (ui_vec3_t){
+						.x = 0.0f,
+						.y = out_h,
+						1.0f
+					};
+					v3 = (ui_vec3_t){
+						.x = out_w,
+						.y = out_h,
+						1.0f
+					};
+					v4 = (ui_vec3_t){
+						.x = out_w,
+						.y = 0.0f,
+						1.0f
+					};
+
+					ui_render_quad_uv(&text_mat, v1, v2, v3, v4,
+								(ui_uv_t){ 0.0f, 0.0f },
+								(ui_uv_t){ 0.0f, 1.0f },
+								(ui_uv_t){ 1.0f, 1.0f },
+								(ui_uv_t){ 1.0f, 0.0f });
+				}
 
 				ui_renderer_set_texture(NULL, 0, 0, UI_PIXEL_FORMAT_UNKNOWN);
 				ui_renderer_set_fill_color(CONFIG_UI_DEFAULT_FILL_COLOR);
@@ -1,363 +1,592 @@
-/****************************************************************************
- *
- * Copyright 2018 Samsung Electronics All Rights Reserved.
- *
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- * http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing,
- * software distributed under the License is distributed on an
- * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
- * either express or implied. See the License for the specific
- * language governing permissions and limitations under the License.
- *
- ****************************************************************************/
- /****************************************************************************
- * Included Files
- ****************************************************************************/
-#include <debug.h>
-#include <signal.h>
-#include <queue.h>
-#include <stdbool.h>
-#include <unistd.h>
-#include <string.h>
-#include <sys/types.h>
-#include <libtuv/uv.h>
-#include <libtuv/uv__types.h>
-#include <eventloop/eventloop.h>
-
-#include "eventloop_internal.h"
-
-/* The structure for a group of event nodes which have same event type, event_group_t */
-struct event_group_s {
-	struct event_group_s *flink;
-	int type;
-	sq_queue_t event_list; // list node type : event_node_t
-};
-typedef struct event_group_s event_group_t;
-
-/* The structure for wrapping of event handle to be kept in a list internally. */
-struct event_node_s {
-	struct event_node_s *flink;
-	el_event_t *handle;
-};
-typedef struct event_node_s event_node_t;
-
-/* The structure which has information of event handle user registered.
- * The handle of event_node_t has it in data field, and use data values when calling callback function.
- */
-struct event_data_s {
-	int type;
-	int pid;
-	int event_in;
-	event_callback func;
-	void *cb_data;
-	void *event_data;
-};
-typedef struct event_data_s event_data_t;
-
-sq_queue_t g_event_list;  // list node type : event_group_t
-
-static event_group_t *get_event_group(int type)
-{
-	event_group_t *ptr;
-
-	if (type < 0) {
-		eldbg("Invalid parameter\n");
-		return NULL;
-	}
-
-	ptr = (event_group_t *)sq_peek(&g_event_list);
-	while (ptr != NULL) {
-		if (ptr->type == type) {
-			return ptr;
-		}
-		ptr = (event_group_t *)sq_next(ptr);
-	}
-
-	return ptr;
-}
-
-static bool is_registered_event_cb(el_event_t *handle)
-{
-	event_group_t *group_ptr;
-	event_node_t *node_ptr;
-
-	if (handle == NULL) {
-		return false;
-	}
-
-	group_ptr = (event_group_t *)sq_peek(&g_event_list);
-	while (group_ptr != NULL) {
-		node_ptr = (event_node_t *)sq_peek(&group_ptr->event_list);
-		while (node_ptr != NULL && node_ptr->handle != NULL) {
-			if (node_ptr->handle == handle) {
-				return true;
-			}
-			node_ptr = (event_node_t *)sq_next(node_ptr);
-		}
-		group_ptr = (event_group_t *)sq_next(group_ptr);
-	}
-
-	return false;
-}
-
-static event_group_t *eventloop_new_event_group(int type)
-{
-	event_group_t *event_group;
-
-	event_group = (event_group_t *)EL_ALLOC(sizeof(event_group_t));
-	if (event_group == NULL) {
-		eldbg("Failed to allocate event group\n");
-		return NULL;
-	}
-
-	sq_init(&event_group->event_list);
-	event_group->flink = NULL;
-	event_group->type = type;
-	sq_addlast((FAR sq_entry_t *)event_group, &g_event_list);
-
-	return event_group;
-}
-static int eventloop_register_event_cb(el_event_t *handle)
-{
-	event_group_t *event_group;
-	event_node_t *event_node;
-	int type;
-	
-	if (handle == NULL || handle->data == NULL) {
-		eldbg("Invalid Parameter\n");
-		return ERROR;
-	}
-
-	type = ((event_data_t *)handle->data)->type;
-	event_group = get_event_group(type);
-	if (event_group == NULL) {
-		event_group = eventloop_new_event_group(type);
-		if (event_group == NULL) {
-			return ERROR;
-		}
-	}
-	event_node = (event_node_t *)EL_ALLOC(sizeof(event_node_t));
-	if (event_node == NULL) {
-		eldbg("Failed to allocate event node\n");
-		if (sq_empty(&event_group->event_list)) {
-			sq_rem((FAR sq_entry_t *)event_group, &g_event_list);
-			EL_FREE(event_group);
-		}
-		return ERROR;
-	}
-	event_node->flink = NULL;
-	event_node->handle = handle;
-	sq_addlast((FAR sq_entry_t *)event_node, &event_group->event_list);
-
-	return OK;
-}
-
-void eventloop_unregister_event_cb(el_event_t *handle)
-{
-	event_group_t *event_group;
-	event_node_t *ptr;
-	event_data_t *data;
-
-	if (handle == NULL || handle->data == NULL) {
-		return;
-	}
-
-	data = (event_data_t *)handle->data;
-
-	event_group = get_event_group(data->type);
-	if (event_group != NULL) {
-		ptr = (event_node_t *)sq_peek(&event_group->event_list);
-		while (ptr != NULL && ptr->handle != NULL) {
-			if (ptr->handle == handle) {
-				sq_rem((FAR sq_entry_t *)ptr, &event_group->event_list);
-				if (data->event_data != NULL) {
-					EL_FREE(data->event_data);
-				}
-				EL_FREE(data);
-				EL_FREE(handle);
-				EL_FREE(ptr);
-				break;
-			}
-			ptr = (event_node_t *)sq_next(ptr);
-		}
-		if (sq_empty(&event_group->event_list)) {
-			sq_rem((FAR sq_entry_t *)event_group, &g_event_list);
-			EL_FREE(event_group);
-		}
-	}
-}
-
-static void event_callback_func(el_event_t *event, int signum)
-{
-	int ret;
-	event_data_t *data = NULL;
-
-	if (event == NULL || event->data == NULL) {
-		eldbg("Invalid event callback\n");
-		return;
-	}
-
-	data = (event_data_t *)event->data;
-
-	elvdbg("[%d] Event callback!! type : %d\n", getpid(), data->type);
-	if (data->event_in == data->type && data->func) {
-		ret = data->func(data->cb_data, data->event_data);
-		/* It is true if eventloop_loop_stop is called in callback function. */
-		if (LOOP_IS_STOPPED(event->loop)) {
-			return;
-		}
-		/* If callback function returns EVENTLOOP_CALLBACK_STOP, close and unregister the event handler.  */
-		if (ret == EVENTLOOP_CALLBACK_STOP) {
-			uv_close((uv_handle_t *)event, (uv_close_cb)eventloop_unregister_event_cb);
-			return;
-		}
-	}
-	if (data->event_data != NULL) {
-		EL_FREE(data->event_data);
-	}
-	data->event_data = NULL;
-	data->event_in = -1;
-
-	return;
-}
-
-static int eventloop_send_event_sig(int type, void *event_data, int data_size)
-{
-	event_group_t *event_group;
-	event_node_t *ptr;
-
-	if (type < 0 || type >= EL_EVENT_MAX || data_size < 0) {
-		eldbg("Invalid Parameter\n");
-		return EVENTLOOP_INVALID_PARAM;
-	}
-
-	event_group = get_event_group(type);
-	if (event_group != NULL) {
-		ptr = (event_node_t *)sq_peek(&event_group->event_list);
-		while (ptr != NULL && ptr->handle != NULL) {
-			event_data_t *cb_data = (event_data_t *)ptr->handle->data;
-			cb_data->event_in = type;
-			if (data_size == 0) {
-				cb_data->event_data = NULL;
-			} else {
-				cb_data->event_data = EL_ALLOC(data_size);
-				if (cb_data->event_data == NULL) {
-					eldbg("Failed to allocate callback info\n");
-					return EVENTLOOP_OUT_OF_MEMORY;
-				}
-				memcpy(cb_data->event_data, event_data, data_size);
-			}
-			/* Send signal to task which registered event */
-			int ret = kill(cb_data->pid, SIGEL_EVENT);
-			if (ret < 0) {
-				eldbg("kill failed %d \n", errno);
-				if (cb_data->event_data != NULL) {
-					EL_FREE(cb_data->event_data);
-					cb_data->event_data = NULL;
-				}
-			}
-			ptr = (event_node_t *)sq_next(ptr);
-		}
-	}
-
-	return OK;
-}
-
-el_event_t *eventloop_add_event_handler(int type, event_callback func, void *data)
-{
-	int ret;
-	el_loop_t *loop;
-	el_event_t *handle;
-	event_data_t *event_cb;
-
-	if (type < 0 || type >= EL_EVENT_MAX || func == NULL) {
-		eldbg("Invalid Parameter\n");
-		return NULL;
-	}
-
-	loop = get_app_loop();
-	if (loop == NULL) {
-		eldbg("Failed to get loop\n");
-		return NULL;
-	}
-
-	handle = (el_event_t *)EL_ALLOC(sizeof(el_event_t));
-	if (handle == NULL) {
-		eldbg("Failed to allocate event\n");
-		return NULL;
-	}
-
-	event_cb = (event_data_t *)EL_ALLOC(sizeof(event_data_t));
-	if (event_cb == NULL) {
-		eldbg("Failed to allocate callback\n");
-		EL_FREE(handle);
-		return NULL;
-	}
-
-	event_cb->type = type;
-	event_cb->pid = getpid();
-	event_cb->event_in = -1;
-	event_cb->func = func;
-	event_cb->cb_data = data;
-	event_cb->event_data = NULL;
-	handle->data = (void *)event_cb;
-
-	ret = uv_signal_init(loop, handle);
-	if (ret != 0) {
-		eldbg("Failed to initialize event\n");
-		goto errout;
-	}
-
-	ret = uv_signal_start(handle, event_callback_func, SIGEL_EVENT);
-	if (ret != 0) {
-		eldbg("Failed to initialize event\n");
-		goto errout;
-	}
-
-	/* Add event handle to a list of handles */
-	ret = eventloop_register_event_cb(handle);
-	if (ret != OK) {
-		eldbg("Failed to register signal for event\n");
-		uv_close((uv_handle_t *)handle, NULL);
-		goto errout;
-	}
-	elvdbg("created event handle %p, type = %d\n", handle, type);
-
-	return handle;
-errout:
-	EL_FREE(event_cb);
-	EL_FREE(handle);
-
-	return NULL;
-}
-
-int eventloop_del_event_handler(el_event_t *handle)
-{
-	if (handle == NULL) {
-		eldbg("Invalid Parameter\n");
-		return EVENTLOOP_INVALID_PARAM;
-	}
-
-	if (!is_registered_event_cb(handle) || uv__is_closing(handle)) {
-		return EVENTLOOP_INVALID_HANDLE;
-	}
-
-	uv_close((uv_handle_t *)handle, (uv_close_cb)eventloop_unregister_event_cb);
-
-	return OK;
-}
-
-int eventloop_send_event(int type, void *event_data, int data_size)
-{
-	if (type < 0 || type >= EL_EVENT_MAX || data_size < 0) {
-		eldbg("Invalid Parameter\n");
-		return EVENTLOOP_INVALID_PARAM;
-	}
-
-	return eventloop_send_event_sig(type, event_data, data_size);
-}
+/****************************************************************************
+ *
+ * Copyright 2018 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+ /****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <debug.h>
+#include <errno.h>
+#include <signal.h>
+#include <queue.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/types.h>
+#include <tinyara/sched.h>
+#include <libtuv/uv.h>
+#include <libtuv/uv__types.h>
+#include <eventloop/eventloop.h>
+
+#include "eventloop_internal.h"
+
+/* The structure for a group of event nodes which have same event type, event_group_t */
+struct event_group_s {
+	struct event_group_s *flink;
+	int type;
+	sq_queue_t event_list; // list node type : event_node_t
+};
+typedef struct event_group_s event_group_t;
+
+/* The structure for wrapping of event handle to be kept in a list internally. */
+struct event_node_s {
+	struct event_node_s *flink;
+	el_event_t *handle;
+};
+typedef struct event_node_s event_node_t;
+
+/* The structure which has information of event handle user registered.
+ * The handle of event_node_t has it in data field, and use data values when calling callback function.
+ */
+struct event_data_s {
+	int type;
+	int pid;
+	event_callback func;
+	void *cb_data;
+};
+typedef struct event_data_s event_data_t;
+
+/* The data of an event sent once and shared by all tasks which receive it. */
+struct event_payload_s {
+	int refs;
+};
+typedef struct event_payload_s event_payload_t;
+
+#define EVENT_PAYLOAD_DATA(payload) ((void *)((char *)(payload) + sizeof(event_payload_t)))
+
+/* An event queued for a task, waiting to be handled in the loop of the task. */
+struct event_entry_s {
+	struct event_entry_s *flink;
+	int type;
+	event_payload_t *payload;
+};
+typedef struct event_entry_s event_entry_t;
+
+/* The queue of events for a task. A task is signaled only when its queue
+ * becomes pending, and all queued events are handled in that wake-up.
+ */
+struct event_inbox_s {
+	sq_queue_t queue; // list node type : event_entry_t
+	int pid;
+	bool pending;
+};
+typedef struct event_inbox_s event_inbox_t;
+
+sq_queue_t g_event_list;  // list node type : event_group_t
+
+static event_inbox_t g_event_inbox[CONFIG_MAX_TASKS];
+
+/* Protects event inboxes and event payloads which are shared between tasks */
+static sem_t g_event_sem = SEM_INITIALIZER(1);
+
+static event_group_t *get_event_group(int type)
+{
+	event_group_t *ptr;
+
+	if (type < 0) {
+		eldbg("Invalid parameter\n");
+		return NULL;
+	}
+
+	ptr = (event_group_t *)sq_peek(&g_event_list);
+	while (ptr != NULL) {
+		if (ptr->type == type) {
+			return ptr;
+		}
+		ptr = (event_group_t *)sq_next(ptr);
+	}
+
+	return ptr;
+}
+
+static bool is_registered_event_cb(el_event_t *handle)
+{
+	event_group_t *group_ptr;
+	event_node_t *node_ptr;
+
+	if (handle == NULL) {
+		return false;
+	}
+
+	group_ptr = (event_group_t *)sq_peek(&g_event_list);
+	while (group_ptr != NULL) {
+		node_ptr = (event_node_t *)sq_peek(&group_ptr->event_list);
+		while (node_ptr != NULL && node_ptr->handle != NULL) {
+			if (node_ptr->handle == handle) {
+				return true;
+			}
+			node_ptr = (event_node_t *)sq_next(node_ptr);
+		}
+		group_ptr = (event_group_t *)sq_next(group_ptr);
+	}
+
+	return false;
+}
+
+static event_group_t *eventloop_new_event_group(int type)
+{
+	event_group_t *event_group;
+
+	event_group = (event_group_t *)EL_ALLOC(sizeof(event_group_t));
+	if (event_group == NULL) {
+		eldbg("Failed to allocate event group\n");
+		return NULL;
+	}
+
+	sq_init(&event_group->event_list);
+	event_group->flink = NULL;
+	event_group->type = type;
+	sq_addlast((FAR sq_entry_t *)event_group, &g_event_list);
+
+	return event_group;
+}
+static int eventloop_register_event_cb(el_event_t *handle)
+{
+	event_group_t *event_group;
+	event_node_t *event_node;
+	int type;
+	
+	if (handle == NULL || handle->data == NULL) {
+		eldbg("Invalid Parameter\n");
+		return ERROR;
+	}
+
+	type = ((event_data_t *)handle->data)->type;
+	event_group = get_event_group(type);
+	if (event_group == NULL) {
+		event_group = eventloop_new_event_group(type);
+		if (event_group == NULL) {
+			return ERROR;
+		}
+	}
+	event_node = (event_node_t *)EL_ALLOC(sizeof(event_node_t));
+	if (event_node == NULL) {
+		eldbg("Failed to allocate event node\n");
+		if (sq_empty(&event_group->event_list)) {
+			sq_rem((FAR sq_entry_t *)event_group, &g_event_list);
+			EL_FREE(event_group);
+		}
+		return ERROR;
+	}
+	event_node->flink = NULL;
+	event_node->handle = handle;
+	sq_addlast((FAR sq_entry_t *)event_node, &event_group->event_list);
+
+	return OK;
+}
+
+/* Drop a reference of a payload. Must be called with g_event_sem. */
+static void event_payload_release(event_payload_t *payload)
+{
+	if (payload != NULL && --payload->refs == 0) {
+		EL_FREE(payload);
+	}
+}
+
+/* Release all events in a list. Must be called with g_event_sem. */
+static void event_entry_release_all(sq_queue_t *queue)
+{
+	event_entry_t *entry;
+
+	while ((entry = (event_entry_t *)sq_remfirst(queue)) != NULL) {
+		event_payload_release(entry->payload);
+		EL_FREE(entry);
+	}
+}
+
+/* Get the inbox of a task. Events left by a previous task which had the same
+ * slot are dropped. Must be called with g_event_sem.
+ */
+static event_inbox_t *get_event_inbox(int pid)
+{
+	event_inbox_t *inbox;
+
+	inbox = &g_event_inbox[PIDHASH(pid)];
+	if (inbox->pid != pid) {
+		event_entry_release_all(&inbox->queue);
+		inbox->pid = pid;
+		inbox->pending = false;
+	}
+
+	return inbox;
+}
+
+/* Drop all events which are not handled yet by a task */
+static void event_inbox_flush(int pid)
+{
+	event_inbox_t *inbox;
+
+	while (sem_wait(&g_event_sem) != OK);
+	inbox = get_event_inbox(pid);
+	event_entry_release_all(&inbox->queue);
+	inbox->pending = false;
+	sem_post(&g_event_sem);
+}
+
+static bool has_event_handler(int pid, el_event_t *except)
+{
+	event_group_t *group_ptr;
+	event_node_t *node_ptr;
+
+	group_ptr = (event_group_t *)sq_peek(&g_event_list);
+	while (group_ptr != NULL) {
+		node_ptr = (event_node_t *)sq_peek(&group_ptr->event_list);
+		while (node_ptr != NULL && node_ptr->handle != NULL) {
+			if (node_ptr->handle != except && ((event_data_t *)node_ptr->handle->data)->pid == pid) {
+				return true;
+			}
+			node_ptr = (event_node_t *)sq_next(node_ptr);
+		}
+		group_ptr = (event_group_t *)sq_next(group_ptr);
+	}
+
+	return false;
+}
+
+void eventloop_unregister_event_cb(el_event_t *handle)
+{
+	event_group_t *event_group;
+	event_node_t *ptr;
+	event_data_t *data;
+
+	if (handle == NULL || handle->data == NULL) {
+		return;
+	}
+
+	data = (event_data_t *)handle->data;
+
+	/* Events which are not handled yet are dropped with the last handler of a task */
+	if (!has_event_handler(data->pid, handle)) {
+		event_inbox_flush(data->pid);
+	}
+
+	event_group = get_event_group(data->type);
+	if (event_group != NULL) {
+		ptr = (event_node_t *)sq_peek(&event_group->event_list);
+		while (ptr != NULL && ptr->handle != NULL) {
+			if (ptr->handle == handle) {
+				sq_rem((FAR sq_entry_t *)ptr, &event_group->event_list);
+				EL_FREE(data);
+				EL_FREE(handle);
+				EL_FREE(ptr);
+				break;
+			}
+			ptr = (event_node_t *)sq_next(ptr);
+		}
+		if (sq_empty(&event_group->event_list)) {
+			sq_rem((FAR sq_entry_t *)event_group, &g_event_list);
+			EL_FREE(event_group);
+		}
+	}
+}
+
+/* Call all handlers of this task for an event. It returns false if the loop is stopped in a callback. */
+static bool event_dispatch(el_loop_t *loop, event_entry_t *entry)
+{
+	int ret;
+	int pid;
+	event_group_t *event_group;
+	event_node_t *ptr;
+	event_data_t *data;
+	void *event_data;
+
+	pid = getpid();
+	event_data = entry->payload ? EVENT_PAYLOAD_DATA(entry->payload) : NULL;
+
+	event_group = get_event_group(entry->type);
+	if (event_group == NULL) {
+		return true;
+	}
+
+	ptr = (event_node_t *)sq_peek(&event_group->event_list);
+	while (ptr != NULL && ptr->handle != NULL) {
+		el_event_t *handle = ptr->handle;
+		data = (event_data_t *)handle->data;
+		ptr = (event_node_t *)sq_next(ptr);
+
+		if (data->pid != pid || data->func == NULL || uv__is_closing(handle)) {
+			continue;
+		}
+
+		ret = data->func(data->cb_data, event_data);
+		/* It is true if eventloop_loop_stop is called in callback function. */
+		if (LOOP_IS_STOPPED(loop)) {
+			return false;
+		}
+		/* If callback function returns EVENTLOOP_CALLBACK_STOP, close and unregister the event handler.  */
+		if (ret == EVENTLOOP_CALLBACK_STOP) {
+			uv_close((uv_handle_t *)handle, (uv_close_cb)eventloop_unregister_event_cb);
+		}
+	}
+
+	return true;
+}
+
+/* All event handlers of a task are called for one SIGEL_EVENT. The first of them
+ * takes all queued events of the task and handles them, and the others find nothing.
+ */
+static void event_callback_func(el_event_t *event, int signum)
+{
+	sq_queue_t events;
+	event_inbox_t *inbox;
+	event_entry_t *entry;
+	bool running = true;
+
+	if (event == NULL || event->data == NULL) {
+		eldbg("Invalid event callback\n");
+		return;
+	}
+
+	while (sem_wait(&g_event_sem) != OK);
+	inbox = get_event_inbox(getpid());
+	events = inbox->queue;
+	sq_init(&inbox->queue);
+	inbox->pending = false;
+	sem_post(&g_event_sem);
+
+	while (running && (entry = (event_entry_t *)sq_remfirst(&events)) != NULL) {
+		elvdbg("[%d] Event callback!! type : %d\n", getpid(), entry->type);
+		running = event_dispatch(event->loop, entry);
+
+		while (sem_wait(&g_event_sem) != OK);
+		event_payload_release(entry->payload);
+		sem_post(&g_event_sem);
+		EL_FREE(entry);
+	}
+
+	if (!sq_empty(&events)) {
+		eldbg("Loop is stopped, drop remaining events\n");
+		while (sem_wait(&g_event_sem) != OK);
+		event_entry_release_all(&events);
+		sem_post(&g_event_sem);
+	}
+}
+
+/* Queue an event to a task. need_signal is set if the task has had no pending
+ * events, so that it should be signaled. Must be called with g_event_sem.
+ */
+static int event_enqueue(int pid, int type, event_payload_t *payload, bool *need_signal)
+{
+	event_inbox_t *inbox;
+	event_entry_t *entry;
+
+	inbox = get_event_inbox(pid);
+
+#ifdef CONFIG_EVENTLOOP_EVENT_COALESCE
+	/* Replace the data of the same event which is not handled yet */
+	entry = (event_entry_t *)sq_peek(&inbox->queue);
+	while (entry != NULL) {
+		if (entry->type == type) {
+			event_payload_release(entry->payload);
+			entry->payload = payload;
+			if (payload != NULL) {
+				payload->refs++;
+			}
+			*need_signal = false;
+			return OK;
+		}
+		entry = (event_entry_t *)sq_next(entry);
+	}
+#endif
+
+	entry = (event_entry_t *)EL_ALLOC(sizeof(event_entry_t));
+	if (entry == NULL) {
+		return EVENTLOOP_OUT_OF_MEMORY;
+	}
+
+	entry->flink = NULL;
+	entry->type = type;
+	entry->payload = payload;
+	if (payload != NULL) {
+		payload->refs++;
+	}
+	sq_addlast((FAR sq_entry_t *)entry, &inbox->queue);
+
+	*need_signal = !inbox->pending;
+	inbox->pending = true;
+
+	return OK;
+}
+
+static bool is_listener_handled(event_group_t *event_group, event_node_t *node)
+{
+	event_node_t *ptr;
+	int pid = ((event_data_t *)node->handle->data)->pid;
+
+	for (ptr = (event_node_t *)sq_peek(&event_group->event_list); ptr != node; ptr = (event_node_t *)sq_next(ptr)) {
+		if (((event_data_t *)ptr->handle->data)->pid == pid) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int eventloop_send_event_sig(int type, void *event_data, int data_size)
+{
+	int ret;
+	int pid;
+	bool need_signal;
+	event_group_t *event_group;
+	event_node_t *ptr;
+	event_payload_t *payload = NULL;
+
+	if (type < 0 || type >= EL_EVENT_MAX || data_size < 0) {
+		eldbg("Invalid Parameter\n");
+		return EVENTLOOP_INVALID_PARAM;
+	}
+
+	event_group = get_event_group(type);
+	if (event_group == NULL) {
+		return OK;
+	}
+
+	/* One copy of the data is shared by all tasks which registered the event */
+	if (data_size > 0) {
+		payload = (event_payload_t *)EL_ALLOC(sizeof(event_payload_t) + data_size);
+		if (payload == NULL) {
+			eldbg("Failed to allocate event data\n");
+			return EVENTLOOP_OUT_OF_MEMORY;
+		}
+		payload->refs = 1;
+		memcpy(EVENT_PAYLOAD_DATA(payload), event_data, data_size);
+	}
+
+	ret = OK;
+	ptr = (event_node_t *)sq_peek(&event_group->event_list);
+	while (ptr != NULL && ptr->handle != NULL) {
+		if (is_listener_handled(event_group, ptr)) {
+			ptr = (event_node_t *)sq_next(ptr);
+			continue;
+		}
+		pid = ((event_data_t *)ptr->handle->data)->pid;
+
+		while (sem_wait(&g_event_sem) != OK);
+		ret = event_enqueue(pid, type, payload, &need_signal);
+		sem_post(&g_event_sem);
+		if (ret != OK) {
+			eldbg("Failed to allocate event\n");
+			break;
+		}
+
+		/* Send signal to task only when it has no pending events */
+		if (need_signal && kill(pid, SIGEL_EVENT) < 0) {
+			eldbg("kill failed %d \n", errno);
+			event_inbox_flush(pid);
+		}
+		ptr = (event_node_t *)sq_next(ptr);
+	}
+
+	while (sem_wait(&g_event_sem) != OK);
+	event_payload_release(payload);
+	sem_post(&g_event_sem);
+
+	return ret;
+}
+
+el_event_t *eventloop_add_event_handler(int type, event_callback func, void *data)
+{
+	int ret;
+	el_loop_t *loop;
+	el_event_t *handle;
+	event_data_t *event_cb;
+
+	if (type < 0 || type >= EL_EVENT_MAX || func == NULL) {
+		eldbg("Invalid Parameter\n");
+		return NULL;
+	}
+
+	loop = get_app_loop();
+	if (loop == NULL) {
+		eldbg("Failed to get loop\n");
+		return NULL;
+	}
+
+	handle = (el_event_t *)EL_ALLOC(sizeof(el_event_t));
+	if (handle == NULL) {
+		eldbg("Failed to allocate event\n");
+		return NULL;
+	}
+
+	event_cb = (event_data_t *)EL_ALLOC(sizeof(event_data_t));
+	if (event_cb == NULL) {
+		eldbg("Failed to allocate callback\n");
+		EL_FREE(handle);
+		return NULL;
+	}
+
+	event_cb->type = type;
+	event_cb->pid = getpid();
+	event_cb->func = func;
+	event_cb->cb_data = data;
+	handle->data = (void *)event_cb;
+
+	ret = uv_signal_init(loop, handle);
+	if (ret != 0) {
+		eldbg("Failed to initialize event\n");
+		goto errout;
+	}
+
+	ret = uv_signal_start(handle, event_callback_func, SIGEL_EVENT);
+	if (ret != 0) {
+		eldbg("Failed to initialize event\n");
+		goto errout;
+	}
+
+	/* Add event handle to a list of handles */
+	ret = eventloop_register_event_cb(handle);
+	if (ret != OK) {
+		eldbg("Failed to register signal for event\n");
+		uv_close((uv_handle_t *)handle, NULL);
+		goto errout;
+	}
+	elvdbg("created event handle %p, type = %d\n", handle, type);
+
+	return handle;
+errout:
+	EL_FREE(event_cb);
+	EL_FREE(handle);
+
+	return NULL;
+}
+
+int eventloop_del_event_handler(el_event_t *handle)
+{
+	if (handle == NULL) {
+		eldbg("Invalid Parameter\n");
+		return EVENTLOOP_INVALID_PARAM;
+	}
+
+	if (!is_registered_event_cb(handle) || uv__is_closing(handle)) {
+		return EVENTLOOP_INVALID_HANDLE;
+	}
+
+	uv_close((uv_handle_t *)handle, (uv_close_cb)eventloop_unregister_event_cb);
+
+	return OK;
+}
+
+int eventloop_send_event(int type, void *event_data, int data_size)
+{
+	if (type < 0 || type >= EL_EVENT_MAX || data_size < 0) {
+		eldbg("Invalid Parameter\n");
+		return EVENTLOOP_INVALID_PARAM;
+	}
+
+	return eventloop_send_event_sig(type, event_data, data_size);
+}
@@ -92,7 +92,10 @@ int FocusManager::abandonFocus(std::shared_ptr<FocusRequest> focusRequest)
 		meddbg("FocusManagerWorker is not alive\n");
 		return FOCUS_REQUEST_FAIL;
 	}
-	fmw.enQueue(&FocusManager::removeFocusAndNotify, this, focusRequest);
+	if (!fmw.enQueue(&FocusManager::removeFocusAndNotify, this, focusRequest)) {
+		meddbg("%s Fail : command queue is full\n", __func__);
+		return FOCUS_REQUEST_FAIL;
+	}
 	/*
 	@ToDo
 	return value FOCUS_REQUEST_SUCCESS means, focusrequest item is removed from queue, however now it is scheduled for removal.
@@ -112,7 +115,10 @@ int FocusManager::requestFocus(std::shared_ptr<FocusRequest> focusRequest)
 		meddbg("FocusManagerWorker is not alive\n");
 		return FOCUS_REQUEST_FAIL;
 	}
-	fmw.enQueue(&FocusManager::insertFocusElement, this, focusRequest, false);
+	if (!fmw.enQueue(&FocusManager::insertFocusElement, this, focusRequest, false)) {
+		meddbg("%s Fail : command queue is full\n", __func__);
+		return FOCUS_REQUEST_FAIL;
+	}
 	return FOCUS_REQUEST_SUCCESS;
 }
 
@@ -127,7 +133,10 @@ int FocusManager::requestFocusTransient(std::shared_ptr<FocusRequest> focusReque
 		meddbg("FocusManagerWorker is not alive\n");
 		return FOCUS_REQUEST_FAIL;
 	}
-	fmw.enQueue(&FocusManager::insertFocusElement, this, focusRequest, true);
+	if (!fmw.enQueue(&FocusManager::insertFocusElement, this, focusRequest, true)) {
+		meddbg("%s Fail : command queue is full\n", __func__);
+		return FOCUS_REQUEST_FAIL;
+	}
 	return FOCUS_REQUEST_SUCCESS;
 }
 
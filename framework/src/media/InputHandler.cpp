@@ -21,6 +21,7 @@
 #include <debug.h>
 #include <pthread.h>
 #include <limits.h>
+#include <stdio.h>
 #include <media/MediaUtils.h>
 
 #include "InputHandler.h"
@@ -117,6 +118,43 @@ ssize_t InputHandler::read(unsigned char *buf, size_t size)
 	return (ssize_t)rlen;
 }
 
+size_t InputHandler::peek(rb_span_t spans[2], size_t size)
+{
+	if (mBufferReader) {
+		return mBufferReader->peek(spans, size);
+	}
+	return 0;
+}
+
+size_t InputHandler::consume(size_t size)
+{
+	if (mBufferReader) {
+		return mBufferReader->consume(size);
+	}
+	return 0;
+}
+
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+void InputHandler::printCopyStats()
+{
+	if (!mStreamBuffer || !mInputDataSource) {
+		return;
+	}
+
+	size_t copied = mStreamBuffer->getCopiedBytes();
+	size_t inPlace = mStreamBuffer->getInPlaceBytes();
+	// 16bit-PCM bytes per second
+	size_t bytesPerSec = mInputDataSource->getSampleRate() * mInputDataSource->getChannels() * 2;
+	size_t seconds = bytesPerSec ? mStreamBuffer->getOutputBytes() / bytesPerSec : 0;
+
+	printf("[MEDIA STATS] copied %u bytes, in place %u bytes", copied, inPlace);
+	if (seconds > 0) {
+		printf(", %u copied/%u in place bytes per second of audio", copied / seconds, inPlace / seconds);
+	}
+	printf("\n");
+}
+#endif
+
 void InputHandler::setLoop(bool loop)
 {
 	mIsLooping = loop;
@@ -124,6 +162,7 @@ void InputHandler::setLoop(bool loop)
 
 void InputHandler::resetWorker()
 {
+	std::lock_guard<std::mutex> lock(mStateMutex);
 	mState = BUFFER_STATE_EMPTY;
 	mTotalBytes = 0;
 }
@@ -131,6 +170,12 @@ void InputHandler::resetWorker()
 bool InputHandler::processWorker()
 {
 	size_t size = getAvailSpace();
+#ifdef CONFIG_MEDIA_STREAM_ZEROCOPY
+	if (size > 0 && !mDemuxer && !mDecoder) {
+		// PCM data can be read from source into stream buffer directly
+		return readSourceInPlace(size);
+	}
+#endif
 	if (size > 0) {
 		auto buf = new unsigned char[size];
 		if (!buf) {
@@ -185,8 +230,8 @@ void InputHandler::sleepWorker()
 
 void InputHandler::setBufferState(buffer_state_t state)
 {
-	if (mState != state) {
-		mState = state;
+	// Called with mStateMutex held, so a state change is notified once and in order.
+	if (mState.exchange(state) != state) {
 		if (state >= BUFFER_STATE_BUFFERED) {
 			// Notify buffering done
 			std::unique_lock<std::mutex> lock(mMutex);
@@ -222,14 +267,20 @@ void InputHandler::onBufferUpdated(ssize_t change, size_t current)
 		wakenWorker();
 	}
 
-	if (current == 0) {
-		setBufferState(BUFFER_STATE_EMPTY);
-	} else if (current == mStreamBuffer->getBufferSize()) {
-		setBufferState(BUFFER_STATE_FULL);
-	} else if (current >= mStreamBuffer->getThreshold()) {
-		setBufferState(BUFFER_STATE_BUFFERED);
-	} else {
-		setBufferState(BUFFER_STATE_BUFFERING);
+	{
+		// Buffer is updated by both writer and reader. Classify the size at the time of the
+		// notification, not the caller's snapshot, or a stale EMPTY could follow a newer FULL.
+		std::lock_guard<std::mutex> lock(mStateMutex);
+		current = mStreamBuffer->sizeOfData();
+		if (current == 0) {
+			setBufferState(BUFFER_STATE_EMPTY);
+		} else if (current == mStreamBuffer->getBufferSize()) {
+			setBufferState(BUFFER_STATE_FULL);
+		} else if (current >= mStreamBuffer->getThreshold()) {
+			setBufferState(BUFFER_STATE_BUFFERED);
+		} else {
+			setBufferState(BUFFER_STATE_BUFFERING);
+		}
 	}
 
 	if (change > 0) {
@@ -278,6 +329,21 @@ ssize_t InputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
 
 		size_t usedES = 0;
 		while (1) {
+#ifdef CONFIG_MEDIA_STREAM_ZEROCOPY
+			if (mDecoder) {
+				// Decode PCM data into stream buffer directly
+				ret = decodeInPlace(buffES, sizeES, &usedES);
+				if (ret < 0) {
+					meddbg("decodeInPlace failed! error: %d\n", ret);
+					return ret;
+				}
+				if (ret == 0) {
+					// want more data
+					break;
+				}
+				continue;
+			}
+#endif
 			unsigned char *buffPCM = buf;
 			size_t sizePCM = used;
 			ret = getPCM(buffES, sizeES, &usedES, &buffPCM, &sizePCM);
@@ -301,6 +367,95 @@ ssize_t InputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
 	return size;
 }
 
+#ifdef CONFIG_MEDIA_STREAM_ZEROCOPY
+bool InputHandler::readSourceInPlace(size_t size)
+{
+	rb_span_t spans[2];
+	if (mBufferWriter->reserve(spans, size, false) == 0) {
+		// No space, worker would sleep until reader consumes data
+		return true;
+	}
+
+	// Fill the first contiguous span only, the wrapped one is filled in next turn
+	ssize_t readLen = readFromSource((unsigned char *)spans[0].ptr, spans[0].len);
+	if (readLen <= 0) {
+		// Error occurred, or inputting finished
+		if (!mIsLooping) {
+			mBufferWriter->setEndOfStream();
+			return false;
+		}
+		/* If it is looping mode, then seek to 0 and readFromSource again */
+		if (mInputDataSource->seekTo(0) == OK) {
+			readLen = readFromSource((unsigned char *)spans[0].ptr, spans[0].len);
+		} else {
+			meddbg("seek failed!!\n");
+		}
+		if (readLen <= 0) {
+			mBufferWriter->setEndOfStream();
+			return false;
+		}
+	}
+
+	if (readLen > (ssize_t)spans[0].len) {
+		meddbg("WARNING!! it read more larger than available space!! readLen : %d size : %d\n", readLen, spans[0].len);
+		readLen = spans[0].len;
+	}
+
+	mBufferWriter->commit((size_t)readLen);
+	return true;
+}
+
+ssize_t InputHandler::decodeInPlace(unsigned char *buf, size_t size, size_t *used)
+{
+	if (*used < size) {
+		ssize_t ret = mDecoder->pushData(buf + *used, size - *used);
+		if (ret <= 0) {
+			meddbg("push data to decoder failed! error: %d\n", ret);
+			return EOF;
+		}
+		*used += (size_t)ret;
+	}
+
+	rb_span_t spans[2];
+	size_t reserved = mBufferWriter->reserve(spans, mStreamBuffer->getBufferSize());
+	if (reserved == 0) {
+		medvdbg("End of writting!\n");
+		return EOF;
+	}
+
+	size_t decoded = 0;
+	for (int i = 0; i < 2; i++) {
+		// 16bit-PCM samples are decoded, so the length should be 2 bytes aligned.
+		size_t len = spans[i].len & ~0x1;
+		if (len == 0 || !getDecodeFrames((unsigned char *)spans[i].ptr, &len)) {
+			break;
+		}
+		decoded += len;
+		if (len != spans[i].len) {
+			// Decoder wants more data, or next span is not contiguous with decoded data.
+			break;
+		}
+	}
+
+	if (decoded == 0 && spans[0].len == 1 && reserved > 1) {
+		// Only one byte is left before the end of ring buffer, so a sample can not be
+		// decoded in place. Decode one sample and write it across the boundary.
+		unsigned char sample[2];
+		size_t len = sizeof(sample);
+		if (!getDecodeFrames(sample, &len)) {
+			return 0;
+		}
+		return (ssize_t)mBufferWriter->write(sample, len);
+	}
+
+	if (decoded > 0) {
+		mBufferWriter->commit(decoded);
+	}
+
+	return (ssize_t)decoded;
+}
+#endif
+
 bool InputHandler::registerCodec(audio_type_t audioType, unsigned int channels, unsigned int sampleRate)
 {
 	if (mDecoder) {
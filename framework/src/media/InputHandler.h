@@ -18,6 +18,7 @@
 #ifndef __MEDIA_INPUTHANDLER_H
 #define __MEDIA_INPUTHANDLER_H
 
+#include <tinyara/config.h>
 #include <memory>
 #include <mutex>
 #include <atomic>
@@ -51,8 +52,12 @@ public:
 	bool close() override;
 	int seekTo(off_t offset);
 	ssize_t read(unsigned char *buf, size_t size);
+	size_t peek(rb_span_t spans[2], size_t size);
+	size_t consume(size_t size);
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+	void printCopyStats();
+#endif
 	void setLoop(bool loop);
-	void setBufferState(buffer_state_t state);
 
 	virtual void onBufferOverrun() override;
 	virtual void onBufferUnderrun() override;
@@ -65,6 +70,7 @@ public:
 	ssize_t writeToStreamBuffer(unsigned char *buf, size_t size);
 
 private:
+	void setBufferState(buffer_state_t state);
 	bool probeDataSource() override;
 	bool registerCodec(audio_type_t audioType, unsigned int channels, unsigned int sampleRate) override;
 	void unregisterCodec() override;
@@ -78,16 +84,21 @@ private:
 	ssize_t getPCM(unsigned char *buf, size_t size, size_t *used, unsigned char **out, size_t *expect);
 	size_t fetchData(unsigned char *buf, size_t size, size_t *used, unsigned char **out, size_t *expect);
 	ssize_t readFromSource(unsigned char *buf, size_t size);
+#ifdef CONFIG_MEDIA_STREAM_ZEROCOPY
+	bool readSourceInPlace(size_t size);
+	ssize_t decodeInPlace(unsigned char *buf, size_t size, size_t *used);
+#endif
 
 	std::mutex mMutex;
 	std::condition_variable mCondv;
+	std::mutex mStateMutex;
 	std::shared_ptr<StreamBuffer> mPreloadBuffer;
 	std::shared_ptr<InputDataSource> mInputDataSource;
 	std::shared_ptr<Decoder> mDecoder;
 	std::shared_ptr<Demuxer> mDemuxer;
 	std::weak_ptr<MediaPlayerImpl> mPlayer;
 	std::atomic<bool> mIsLooping;
-	buffer_state_t mState;
+	std::atomic<buffer_state_t> mState;
 	size_t mTotalBytes;
 };
 } // namespace stream
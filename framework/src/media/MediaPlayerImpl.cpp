@@ -55,7 +55,11 @@ player_result_t MediaPlayerImpl::create()
 	PlayerWorker &mpw = PlayerWorker::getWorker();
 	mpw.startWorker();
 
-	mpw.enQueue(&MediaPlayerImpl::createPlayer, shared_from_this(), std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::createPlayer, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		mpw.stopWorker();
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("createPlayer enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 
@@ -96,7 +100,10 @@ player_result_t MediaPlayerImpl::destroy()
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::destroyPlayer, shared_from_this(), std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::destroyPlayer, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("destroyPlayer enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 }
@@ -149,7 +156,10 @@ player_result_t MediaPlayerImpl::prepare()
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::preparePlayer, shared_from_this(), std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::preparePlayer, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("preparePlayer enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 
@@ -233,7 +243,10 @@ player_result_t MediaPlayerImpl::prepareAsync()
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::prepareAsyncPlayer, shared_from_this());
+	if (!mpw.enQueue(&MediaPlayerImpl::prepareAsyncPlayer, shared_from_this())) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 
 	meddbg("%s returned. player: %x\n", __func__, &mPlayer);
 	return PLAYER_OK;
@@ -272,7 +285,10 @@ player_result_t MediaPlayerImpl::unprepare()
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::unpreparePlayer, shared_from_this(), std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::unpreparePlayer, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("unpreparePlayer enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 
@@ -361,7 +377,10 @@ player_result_t MediaPlayerImpl::start()
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::startPlayer, shared_from_this(), std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::startPlayer, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	mSyncCv.wait(lock);
 	meddbg("%s returned. player: %x\n", __func__, &mPlayer);
 	return ret;
@@ -442,7 +461,10 @@ player_result_t MediaPlayerImpl::stop()
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::stopPlayer, shared_from_this(), std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::stopPlayer, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	mSyncCv.wait(lock);
 	meddbg("%s returned. player: %x\n", __func__, &mPlayer);
 	return ret;
@@ -476,6 +498,9 @@ player_result_t MediaPlayerImpl::stopPlayback(bool drain)
 		return PLAYER_OK;
 	}
 
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+	mInputHandler.printCopyStats();
+#endif
 	audio_manager_result_t result = stop_audio_stream_out(drain);
 	if (result != AUDIO_MANAGER_SUCCESS) {
 		meddbg("stop_audio_stream_out failed ret : %d\n", result);
@@ -526,7 +551,10 @@ player_result_t MediaPlayerImpl::pause()
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::pausePlayer, shared_from_this(), std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::pausePlayer, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	mSyncCv.wait(lock);
 	meddbg("%s returned. player: %x\n", __func__, &mPlayer);
 	return ret;
@@ -585,7 +613,10 @@ player_result_t MediaPlayerImpl::getVolume(uint8_t *vol)
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::getPlayerVolume, shared_from_this(), vol, std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::getPlayerVolume, shared_from_this(), vol, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("getPlayerVolume enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 
@@ -625,7 +656,10 @@ player_result_t MediaPlayerImpl::getMaxVolume(uint8_t *vol)
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::getPlayerMaxVolume, shared_from_this(), vol, std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::getPlayerMaxVolume, shared_from_this(), vol, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("getPlayerMaxVolume enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 
@@ -665,7 +699,10 @@ player_result_t MediaPlayerImpl::setVolume(uint8_t vol)
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::setPlayerVolume, shared_from_this(), vol, std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::setPlayerVolume, shared_from_this(), vol, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("setPlayerVolume enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 
@@ -707,7 +744,10 @@ player_result_t MediaPlayerImpl::setDataSource(std::unique_ptr<stream::InputData
 	}
 
 	std::shared_ptr<stream::InputDataSource> sharedDataSource = std::move(source);
-	mpw.enQueue(&MediaPlayerImpl::setPlayerDataSource, shared_from_this(), sharedDataSource, std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::setPlayerDataSource, shared_from_this(), sharedDataSource, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("setPlayerDataSource enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 
@@ -757,7 +797,10 @@ player_result_t MediaPlayerImpl::setObserver(std::shared_ptr<MediaPlayerObserver
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::setPlayerObserver, shared_from_this(), observer);
+	if (!mpw.enQueue(&MediaPlayerImpl::setPlayerObserver, shared_from_this(), observer)) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("setPlayerObserver enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 
@@ -794,7 +837,10 @@ player_result_t MediaPlayerImpl::setStreamInfo(std::shared_ptr<stream_info_t> st
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::setPlayerStreamInfo, shared_from_this(), stream_info, std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::setPlayerStreamInfo, shared_from_this(), stream_info, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("setPlayerStreamInfo enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 
@@ -839,12 +885,15 @@ bool MediaPlayerImpl::isPlaying()
 	}
 
 	/* Wait for other commands to complete. */
-	mpw.enQueue([&]() {
+	if (!mpw.enQueue([&]() {
 		if (getState() == PLAYER_STATE_PLAYING) {
 			ret = true;
 		}
 		notifySync();
-	});
+	})) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return ret;
+	}
 	meddbg("getState() enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 
@@ -866,7 +915,10 @@ player_result_t MediaPlayerImpl::setLooping(bool loop)
 		return PLAYER_ERROR_NOT_ALIVE;
 	}
 
-	mpw.enQueue(&MediaPlayerImpl::setPlayerLooping, shared_from_this(), loop, std::ref(ret));
+	if (!mpw.enQueue(&MediaPlayerImpl::setPlayerLooping, shared_from_this(), loop, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. player: %x\n", __func__, &mPlayer);
+		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("setPlayerLooping enqueued. player: %x\n", &mPlayer);
 	mSyncCv.wait(lock);
 
@@ -905,24 +957,26 @@ void MediaPlayerImpl::notifyObserver(player_observer_command_t cmd, ...)
 
 	if (mPlayerObserver != nullptr) {
 		PlayerObserverWorker &pow = PlayerObserverWorker::getWorker();
+		/* Completion callbacks may use the reserved slots of the observer queue */
+		bool queued = true;
 		switch (cmd) {
 		case PLAYER_OBSERVER_COMMAND_FINISHED:
-			pow.enQueue(&MediaPlayerObserverInterface::onPlaybackFinished, mPlayerObserver, mPlayer);
+			queued = pow.enQueueReserved(&MediaPlayerObserverInterface::onPlaybackFinished, mPlayerObserver, mPlayer);
 			break;
 		case PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR:
-			pow.enQueue(&MediaPlayerObserverInterface::onPlaybackError, mPlayerObserver, mPlayer, (player_error_t)va_arg(ap, int));
+			queued = pow.enQueueReserved(&MediaPlayerObserverInterface::onPlaybackError, mPlayerObserver, mPlayer, (player_error_t)va_arg(ap, int));
 			break;
 		case PLAYER_OBSERVER_COMMAND_BUFFER_OVERRUN:
-			pow.enQueue(&MediaPlayerObserverInterface::onPlaybackBufferOverrun, mPlayerObserver, mPlayer);
+			queued = pow.enQueue(&MediaPlayerObserverInterface::onPlaybackBufferOverrun, mPlayerObserver, mPlayer);
 			break;
 		case PLAYER_OBSERVER_COMMAND_BUFFER_UNDERRUN:
-			pow.enQueue(&MediaPlayerObserverInterface::onPlaybackBufferUnderrun, mPlayerObserver, mPlayer);
+			queued = pow.enQueue(&MediaPlayerObserverInterface::onPlaybackBufferUnderrun, mPlayerObserver, mPlayer);
 			break;
 		case PLAYER_OBSERVER_COMMAND_BUFFER_UPDATED:
-			pow.enQueue(&MediaPlayerObserverInterface::onPlaybackBufferUpdated, mPlayerObserver, mPlayer, (size_t)va_arg(ap, size_t));
+			queued = pow.enQueue(&MediaPlayerObserverInterface::onPlaybackBufferUpdated, mPlayerObserver, mPlayer, (size_t)va_arg(ap, size_t));
 			break;
 		case PLAYER_OBSERVER_COMMAND_BUFFER_STATECHANGED:
-			pow.enQueue(&MediaPlayerObserverInterface::onPlaybackBufferStateChanged, mPlayerObserver, mPlayer, (buffer_state_t)va_arg(ap, int));
+			queued = pow.enQueue(&MediaPlayerObserverInterface::onPlaybackBufferStateChanged, mPlayerObserver, mPlayer, (buffer_state_t)va_arg(ap, int));
 			break;
 		case PLAYER_OBSERVER_COMMAND_BUFFER_DATAREACHED: {
 			medvdbg("OBSERVER_COMMAND_BUFFER_DATAREACHED\n");
@@ -937,9 +991,12 @@ void MediaPlayerImpl::notifyObserver(player_observer_command_t cmd, ...)
 			if (error != PLAYER_ERROR_NONE) {
 				mCurState = PLAYER_STATE_CONFIGURED;
 			}
-			pow.enQueue(&MediaPlayerObserverInterface::onAsyncPrepared, mPlayerObserver, mPlayer, error);
+			queued = pow.enQueueReserved(&MediaPlayerObserverInterface::onAsyncPrepared, mPlayerObserver, mPlayer, error);
 			break;
 		}
+		if (!queued) {
+			meddbg("observer queue is full, callback %d dropped. player: %x\n", cmd, &mPlayer);
+		}
 	}
 
 	va_end(ap);
@@ -999,20 +1056,36 @@ void MediaPlayerImpl::playback()
 	unsigned int framesToRead = get_card_output_bytes_to_frame(mBufSize) / outputSampleRateRatio;
 	unsigned int bufferSize = get_user_output_frames_to_byte(framesToRead);
 
-	ssize_t num_read = mInputHandler.read(mBuffer, (int)bufferSize);
+	unsigned char *data = mBuffer;
+	ssize_t num_read;
+#ifdef CONFIG_MEDIA_STREAM_ZEROCOPY
+	rb_span_t spans[2];
+	bool inPlace = false;
+	if (mInputHandler.peek(spans, bufferSize) >= bufferSize && spans[0].len >= bufferSize) {
+		// PCM data is contiguous in stream buffer, render it in place.
+		data = (unsigned char *)spans[0].ptr;
+		num_read = (ssize_t)bufferSize;
+		inPlace = true;
+	} else
+#endif
+	num_read = mInputHandler.read(mBuffer, (int)bufferSize);
 	medvdbg("num_read : %d player : %x\n", num_read, &mPlayer);
 	if (num_read > 0) {
-		int ret = start_audio_stream_out(mBuffer, get_user_output_bytes_to_frame((unsigned int)bufferSize));
+		int ret = start_audio_stream_out(data, get_user_output_bytes_to_frame((unsigned int)bufferSize));
+#ifdef CONFIG_MEDIA_STREAM_ZEROCOPY
+		if (inPlace) {
+			mInputHandler.consume(bufferSize);
+		}
+#endif
 		if (ret < 0) {
-			PlayerWorker &mpw = PlayerWorker::getWorker();
 			switch (ret) {
 			case AUDIO_MANAGER_XRUN_STATE:
 				meddbg("AUDIO_MANAGER_XRUN_STATE\n");
-				mpw.enQueue(&MediaPlayerImpl::stopPlaybackInternal, shared_from_this(), false);
+				stopPlaybackOnError();
 				break;
 			default:
 				meddbg("audio manager error : %d\n", ret);
-				mpw.enQueue(&MediaPlayerImpl::stopPlaybackInternal, shared_from_this(), false);
+				stopPlaybackOnError();
 				break;
 			}
 		}
@@ -1021,14 +1094,26 @@ void MediaPlayerImpl::playback()
 	} else {
 		/*@ToDo: It is not possible for num_read to be negative according to code in InputHandler read() API.*/
 		meddbg("InputDatasource read error\n");
-		PlayerWorker &mpw = PlayerWorker::getWorker();
-		mpw.enQueue(&MediaPlayerImpl::stopPlaybackInternal, shared_from_this(), false);
+		stopPlaybackOnError();
+	}
+}
+
+void MediaPlayerImpl::stopPlaybackOnError()
+{
+	/* Called on the player thread, so stop here if the queue has no room */
+	PlayerWorker &mpw = PlayerWorker::getWorker();
+	if (!mpw.enQueue(&MediaPlayerImpl::stopPlaybackInternal, shared_from_this(), false)) {
+		meddbg("command queue is full, stop playback now. player: %x\n", &mPlayer);
+		stopPlaybackInternal(false);
 	}
 }
 
 player_result_t MediaPlayerImpl::playbackFinished()
 {
 	mCurState = PLAYER_STATE_COMPLETED;
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+	mInputHandler.printCopyStats();
+#endif
 	audio_manager_result_t result = stop_audio_stream_out(true);
 	if (result != AUDIO_MANAGER_SUCCESS) {
 		meddbg("stop_audio_stream_out failed ret : %d\n", result);
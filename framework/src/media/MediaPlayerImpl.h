@@ -132,6 +132,7 @@ private:
 	void stopPlayer(player_result_t &ret);
 	player_result_t stopPlayback(bool drain);
 	void stopPlaybackInternal(bool drain);
+	void stopPlaybackOnError();
 	void pausePlayer(player_result_t &ret);
 	void getPlayerVolume(uint8_t *vol, player_result_t &ret);
 	void getPlayerMaxVolume(uint8_t *vol, player_result_t &ret);
@@ -19,36 +19,50 @@
 #include "MediaQueue.h"
 
 namespace media {
-MediaQueue::MediaQueue()
+MediaQueue::MediaQueue(size_t capacity, size_t reserved) :
+	mQueueData(new MediaCommand[capacity]),
+	mCapacity(capacity),
+	mReserved(reserved < capacity ? reserved : 0),
+	mHead(0),
+	mCount(0)
 {
 }
 MediaQueue::~MediaQueue()
 {
+	delete[] mQueueData;
 }
 
-std::function<void()> MediaQueue::deQueue()
+void MediaQueue::deQueue(MediaCommand &command)
 {
 	std::unique_lock<std::mutex> lock(mQueueMtx);
-	if (mQueueData.empty()) {
+	while (mCount == 0) {
 		mQueueCv.wait(lock);
 	}
 
-	auto data = std::move(mQueueData.front());
-	mQueueData.pop();
-	return data;
+	/* Move the command out of the ring, so that clearQueue() never destroys a running command */
+	mQueueData[mHead].moveTo(command);
+	mHead = (mHead + 1) % mCapacity;
+	mCount--;
 }
 
 bool MediaQueue::isEmpty()
 {
 	std::unique_lock<std::mutex> lock(mQueueMtx);
-	return mQueueData.empty();
+	return mCount == 0;
+}
+
+size_t MediaQueue::getCapacity()
+{
+	return mCapacity;
 }
 
 void MediaQueue::clearQueue(void)
 {
 	std::unique_lock<std::mutex> lock(mQueueMtx);
-   	std::queue<std::function<void()>> empty;
-	empty.push(std::move(std::function<void()>())); //push an empty function so, that pop() in dequeue will not crash if called after clearQueue().
-   	std::swap(mQueueData, empty);
+	while (mCount > 0) {
+		mQueueData[mHead].reset();
+		mHead = (mHead + 1) % mCapacity;
+		mCount--;
+	}
 }
 } // namespace media
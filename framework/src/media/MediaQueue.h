@@ -19,32 +19,129 @@
 #ifndef __MEDIA_QUEUE_H
 #define __MEDIA_QUEUE_H
 
+#include <tinyara/config.h>
+#include <debug.h>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
 #include <atomic>
-#include <iostream>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef CONFIG_MEDIA_COMMAND_SIZE
+#define CONFIG_MEDIA_COMMAND_SIZE 48
+#endif
+
+#ifndef CONFIG_MEDIA_WORKER_QUEUE_SIZE
+#define CONFIG_MEDIA_WORKER_QUEUE_SIZE 16
+#endif
 
 namespace media {
+/**
+ * A callable stored in place, without heap allocation.
+ * The bound object must fit in CONFIG_MEDIA_COMMAND_SIZE bytes,
+ * which is checked at compile time.
+ */
+class MediaCommand
+{
+public:
+	MediaCommand() : mInvoke(nullptr), mMove(nullptr), mDestroy(nullptr) {}
+	~MediaCommand() { reset(); }
+	MediaCommand(const MediaCommand &) = delete;
+	MediaCommand &operator=(const MediaCommand &) = delete;
+
+	template <typename _Fn>
+	void assign(_Fn &&__fn) {
+		typedef typename std::decay<_Fn>::type _Stored;
+		static_assert(sizeof(_Stored) <= CONFIG_MEDIA_COMMAND_SIZE, "media command is too big, increase CONFIG_MEDIA_COMMAND_SIZE");
+		static_assert(alignof(_Stored) <= alignof(Storage), "media command is over-aligned");
+		reset();
+		new (&mStorage) _Stored(std::forward<_Fn>(__fn));
+		mInvoke = [](void *p) { (*static_cast<_Stored *>(p))(); };
+		mMove = [](void *dst, void *src) {
+			new (dst) _Stored(std::move(*static_cast<_Stored *>(src)));
+			static_cast<_Stored *>(src)->~_Stored();
+		};
+		mDestroy = [](void *p) { static_cast<_Stored *>(p)->~_Stored(); };
+	}
+
+	/* Move the stored callable into 'dst', leaving this command empty */
+	void moveTo(MediaCommand &dst) {
+		dst.reset();
+		if (mInvoke) {
+			mMove(&dst.mStorage, &mStorage);
+			dst.mInvoke = mInvoke;
+			dst.mMove = mMove;
+			dst.mDestroy = mDestroy;
+			mInvoke = nullptr;
+			mMove = nullptr;
+			mDestroy = nullptr;
+		}
+	}
+
+	void reset() {
+		if (mDestroy) {
+			mDestroy(&mStorage);
+		}
+		mInvoke = nullptr;
+		mMove = nullptr;
+		mDestroy = nullptr;
+	}
+
+	void operator()() { mInvoke(&mStorage); }
+	explicit operator bool() const { return mInvoke != nullptr; }
+
+private:
+	typedef std::aligned_storage<CONFIG_MEDIA_COMMAND_SIZE, 8>::type Storage;
+	Storage mStorage;
+	void (*mInvoke)(void *);
+	void (*mMove)(void *, void *);
+	void (*mDestroy)(void *);
+};
+
+/**
+ * Fixed-capacity command ring. All slots are allocated once at construction,
+ * enQueue() never touches the heap and fails when the ring is full.
+ * The last 'reserved' slots are only used by enQueueReserved().
+ */
 class MediaQueue
 {
 public:
-	MediaQueue();
+	MediaQueue(size_t capacity = CONFIG_MEDIA_WORKER_QUEUE_SIZE, size_t reserved = 0);
 	~MediaQueue();
 	template <typename _Callable, typename... _Args>
-	void enQueue(_Callable &&__f, _Args &&... __args) {
-		std::unique_lock<std::mutex> lock(mQueueMtx);
-		std::function<void()> func = std::bind(std::forward<_Callable>(__f), std::forward<_Args>(__args)...);
-		mQueueData.push(func);
-		mQueueCv.notify_one();
+	bool enQueue(_Callable &&__f, _Args &&... __args) {
+		return push(mCapacity - mReserved, std::forward<_Callable>(__f), std::forward<_Args>(__args)...);
 	}
-	std::function<void()> deQueue();
+	template <typename _Callable, typename... _Args>
+	bool enQueueReserved(_Callable &&__f, _Args &&... __args) {
+		return push(mCapacity, std::forward<_Callable>(__f), std::forward<_Args>(__args)...);
+	}
+	void deQueue(MediaCommand &command);
 	bool isEmpty();
+	size_t getCapacity();
 	void clearQueue(void);
 
 private:
-	std::queue<std::function<void()>> mQueueData;
+	template <typename _Callable, typename... _Args>
+	bool push(size_t limit, _Callable &&__f, _Args &&... __args) {
+		std::unique_lock<std::mutex> lock(mQueueMtx);
+		if (mCount >= limit) {
+			meddbg("MediaQueue is full, capacity : %u reserved : %u\n", mCapacity, mReserved);
+			return false;
+		}
+		mQueueData[(mHead + mCount) % mCapacity].assign(std::bind(std::forward<_Callable>(__f), std::forward<_Args>(__args)...));
+		mCount++;
+		mQueueCv.notify_one();
+		return true;
+	}
+
+	MediaCommand *mQueueData;
+	size_t mCapacity;
+	size_t mReserved;
+	size_t mHead;
+	size_t mCount;
 	std::condition_variable mQueueCv;
 	std::mutex mQueueMtx;
 };
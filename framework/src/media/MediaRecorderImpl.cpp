@@ -52,7 +52,11 @@ recorder_result_t MediaRecorderImpl::create()
 	mrw.startWorker();
 
 	recorder_result_t ret = RECORDER_OK;
-	mrw.enQueue(&MediaRecorderImpl::createRecorder, shared_from_this(), std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::createRecorder, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		mrw.stopWorker();
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("createRecorder enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 
@@ -91,7 +95,10 @@ recorder_result_t MediaRecorderImpl::destroy()
 		return RECORDER_ERROR_NOT_ALIVE;
 	}
 
-	mrw.enQueue(&MediaRecorderImpl::destroyRecorder, shared_from_this(), std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::destroyRecorder, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("destroyRecorder enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 }
@@ -135,7 +142,10 @@ recorder_result_t MediaRecorderImpl::prepare()
 		return RECORDER_ERROR_NOT_ALIVE;
 	}
 	recorder_result_t ret = RECORDER_OK;
-	mrw.enQueue(&MediaRecorderImpl::prepareRecorder, shared_from_this(), std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::prepareRecorder, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("prepareRecorder enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 
@@ -209,7 +219,10 @@ recorder_result_t MediaRecorderImpl::unprepare()
 		return RECORDER_ERROR_NOT_ALIVE;
 	}
 	recorder_result_t ret = RECORDER_OK;
-	mrw.enQueue(&MediaRecorderImpl::unprepareRecorder, shared_from_this(), std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::unprepareRecorder, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("unprepareRecorder enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 
@@ -294,7 +307,10 @@ recorder_result_t MediaRecorderImpl::start()
 	if (!mrw.isAlive()) {
 		return RECORDER_ERROR_NOT_ALIVE;
 	}
-	mrw.enQueue(&MediaRecorderImpl::startRecorder, shared_from_this(), std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::startRecorder, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	mSyncCv.wait(lock);
 	meddbg("%s returned. recorder: %x\n", __func__, &mRecorder);
 	return ret;
@@ -339,7 +355,10 @@ recorder_result_t MediaRecorderImpl::stop()
 		return RECORDER_ERROR_NOT_ALIVE;
 	}
 
-	mrw.enQueue(&MediaRecorderImpl::stopRecorder, shared_from_this(), std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::stopRecorder, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	mSyncCv.wait(lock);
 	meddbg("%s returned. recorder: %x\n", __func__, &mRecorder);
 	return ret;
@@ -400,7 +419,10 @@ recorder_result_t MediaRecorderImpl::pause()
 	if (!mrw.isAlive()) {
 		return RECORDER_ERROR_NOT_ALIVE;
 	}
-	mrw.enQueue(&MediaRecorderImpl::pauseRecorder, shared_from_this(), std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::pauseRecorder, shared_from_this(), std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	mSyncCv.wait(lock);
 	meddbg("%s returned. recorder: %x\n", __func__, &mRecorder);
 	return ret;
@@ -445,7 +467,10 @@ recorder_result_t MediaRecorderImpl::getVolume(uint8_t *vol)
 		return ret;
 	}
 
-	mrw.enQueue(&MediaRecorderImpl::getRecorderVolume, shared_from_this(), vol, std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::getRecorderVolume, shared_from_this(), vol, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("getRecorderVolume enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 
@@ -483,7 +508,10 @@ recorder_result_t MediaRecorderImpl::getMaxVolume(uint8_t *vol)
 		return ret;
 	}
 
-	mrw.enQueue(&MediaRecorderImpl::getRecorderMaxVolume, shared_from_this(), vol, std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::getRecorderMaxVolume, shared_from_this(), vol, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("getRecorderMaxVolume enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 
@@ -515,7 +543,10 @@ recorder_result_t MediaRecorderImpl::setVolume(uint8_t vol)
 	}
 
 	recorder_result_t ret = RECORDER_OK;
-	mrw.enQueue(&MediaRecorderImpl::setRecorderVolume, shared_from_this(), vol, std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::setRecorderVolume, shared_from_this(), vol, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("setRecorderVolume enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 
@@ -555,7 +586,10 @@ recorder_result_t MediaRecorderImpl::setDataSource(std::unique_ptr<stream::Outpu
 
 	recorder_result_t ret = RECORDER_OK;
 	std::shared_ptr<stream::OutputDataSource> sharedDataSource = std::move(dataSource);
-	mrw.enQueue(&MediaRecorderImpl::setRecorderDataSource, shared_from_this(), sharedDataSource, std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::setRecorderDataSource, shared_from_this(), sharedDataSource, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("setRecorderDataSource enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 
@@ -602,7 +636,10 @@ recorder_result_t MediaRecorderImpl::setObserver(std::shared_ptr<MediaRecorderOb
 		return RECORDER_ERROR_NOT_ALIVE;
 	}
 
-	mrw.enQueue(&MediaRecorderImpl::setRecorderObserver, shared_from_this(), observer);
+	if (!mrw.enQueue(&MediaRecorderImpl::setRecorderObserver, shared_from_this(), observer)) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("setRecorderObserver enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 
@@ -641,12 +678,15 @@ bool MediaRecorderImpl::isRecording()
 	}
 
 	/* Wait for other commands to complete. */
-	mrw.enQueue([&]() {
+	if (!mrw.enQueue([&]() {
 		if (getState() == RECORDER_STATE_RECORDING) {
 			ret = true;
 		}
 		notifySync();
-	});
+	})) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return ret;
+	}
 	meddbg("getState() enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 
@@ -666,7 +706,10 @@ recorder_result_t MediaRecorderImpl::setDuration(int second)
 	}
 
 	recorder_result_t ret = RECORDER_OK;
-	mrw.enQueue(&MediaRecorderImpl::setRecorderDuration, shared_from_this(), second, std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::setRecorderDuration, shared_from_this(), second, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("setRecorderDuration enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 
@@ -706,7 +749,10 @@ recorder_result_t MediaRecorderImpl::setFileSize(int byte)
 		return RECORDER_ERROR_NOT_ALIVE;
 	}
 	recorder_result_t ret = RECORDER_OK;
-	mrw.enQueue(&MediaRecorderImpl::setRecorderFileSize, shared_from_this(), byte, std::ref(ret));
+	if (!mrw.enQueue(&MediaRecorderImpl::setRecorderFileSize, shared_from_this(), byte, std::ref(ret))) {
+		meddbg("%s Fail : command queue is full. recorder: %x\n", __func__, &mRecorder);
+		return RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
 	meddbg("setRecorderFileSize enqueued. recorder: %x\n", &mRecorder);
 	mSyncCv.wait(lock);
 
@@ -768,9 +814,8 @@ void MediaRecorderImpl::capture()
 			if (written == EOF) {
 				std::lock_guard<std::mutex> lock(mCmdMtx);
 				meddbg("MediaRecorderImpl::capture() failed : errno : %d written : %d. recorder: %x\n", errno, written, &mRecorder);
-				RecorderWorker& mrw = RecorderWorker::getWorker();
 				res = RECORDER_ERROR_INTERNAL_OPERATION_FAILED;
-				mrw.enQueue(&MediaRecorderImpl::stopRecorderInternal, shared_from_this(), RECORDER_OBSERVER_COMMAND_STOPPED, res);
+				stopRecorderOnError(RECORDER_OBSERVER_COMMAND_STOPPED, res);
 				break;
 			}
 
@@ -778,8 +823,7 @@ void MediaRecorderImpl::capture()
 			if ((written == 0) || (mTotalFrames == mCapturedFrames)) {
 				std::lock_guard<std::mutex> lock(mCmdMtx);
 				medvdbg("File write Ended\n");
-				RecorderWorker& mrw = RecorderWorker::getWorker();
-				mrw.enQueue(&MediaRecorderImpl::stopRecorderInternal, shared_from_this(), RECORDER_OBSERVER_COMMAND_FINISHIED, res);
+				stopRecorderOnError(RECORDER_OBSERVER_COMMAND_FINISHIED, res);
 				break;
 			}
 			size -= written;
@@ -788,21 +832,28 @@ void MediaRecorderImpl::capture()
 	} else if (frames == AUDIO_MANAGER_DEVICE_SUSPENDED) {
 		std::lock_guard<std::mutex> lock(mCmdMtx);
 		meddbg("Too small frames : %d, audio device suspended. recorder: %x\n", frames, &mRecorder);
-		RecorderWorker& mrw = RecorderWorker::getWorker();
 		res = RECORDER_ERROR_DEVICE_SUSPENDED;
-		mrw.enQueue(&MediaRecorderImpl::stopRecorderInternal, shared_from_this(), RECORDER_OBSERVER_COMMAND_STOPPED, res);
+		stopRecorderOnError(RECORDER_OBSERVER_COMMAND_STOPPED, res);
 	} else if (frames == AUDIO_MANAGER_DEVICE_DEAD) {
 		std::lock_guard<std::mutex> lock(mCmdMtx);
 		meddbg("audio device dead. recorder: %x\n", &mRecorder);
-		RecorderWorker& mrw = RecorderWorker::getWorker();
 		res = RECORDER_ERROR_DEVICE_DEAD;
-		mrw.enQueue(&MediaRecorderImpl::stopRecorderInternal, shared_from_this(), RECORDER_OBSERVER_COMMAND_STOPPED, res);
+		stopRecorderOnError(RECORDER_OBSERVER_COMMAND_STOPPED, res);
 	} else {
 		std::lock_guard<std::mutex> lock(mCmdMtx);
 		meddbg("Too small frames : %d. recorder: %x\n", frames, &mRecorder);
-		RecorderWorker& mrw = RecorderWorker::getWorker();
 		res = RECORDER_ERROR_INVALID_PARAM;
-		mrw.enQueue(&MediaRecorderImpl::stopRecorderInternal, shared_from_this(), RECORDER_OBSERVER_COMMAND_STOPPED, res);
+		stopRecorderOnError(RECORDER_OBSERVER_COMMAND_STOPPED, res);
+	}
+}
+
+void MediaRecorderImpl::stopRecorderOnError(recorder_observer_command_e command, recorder_result_t ret)
+{
+	/* Called on the recorder thread, so stop here if the queue has no room */
+	RecorderWorker &mrw = RecorderWorker::getWorker();
+	if (!mrw.enQueue(&MediaRecorderImpl::stopRecorderInternal, shared_from_this(), command, ret)) {
+		meddbg("command queue is full, stop recording now. recorder: %x\n", &mRecorder);
+		stopRecorderInternal(command, ret);
 	}
 }
 
@@ -820,32 +871,37 @@ void MediaRecorderImpl::notifyObserver(recorder_observer_command_t cmd, ...)
 		va_start(ap, cmd);
 
 		RecorderObserverWorker& row = RecorderObserverWorker::getWorker();
+		/* Completion callbacks may use the reserved slots of the observer queue */
+		bool queued = true;
 		switch (cmd) {
 		case RECORDER_OBSERVER_COMMAND_FINISHIED: {
 			medvdbg("RECORDER_OBSERVER_COMMAND_FINISHIED\n");
-			row.enQueue(&MediaRecorderObserverInterface::onRecordFinished, mRecorderObserver, mRecorder);
+			queued = row.enQueueReserved(&MediaRecorderObserverInterface::onRecordFinished, mRecorderObserver, mRecorder);
 		} break;
 		case RECORDER_OBSERVER_COMMAND_STOPPED: {
 			medvdbg("RECORDER_OBSERVER_COMMAND_STOPPED\n");
 			recorder_error_t errCode = (recorder_error_t)va_arg(ap, int);
-			row.enQueue(&MediaRecorderObserverInterface::onRecordStopped, mRecorderObserver, mRecorder, errCode);
+			queued = row.enQueueReserved(&MediaRecorderObserverInterface::onRecordStopped, mRecorderObserver, mRecorder, errCode);
 		} break;
 		case RECORDER_OBSERVER_COMMAND_BUFFER_OVERRUN: {
 			medvdbg("RECORDER_OBSERVER_COMMAND_BUFFER_OVERRUN\n");
-			row.enQueue(&MediaRecorderObserverInterface::onRecordBufferOverrun, mRecorderObserver, mRecorder);
+			queued = row.enQueue(&MediaRecorderObserverInterface::onRecordBufferOverrun, mRecorderObserver, mRecorder);
 		} break;
 		case RECORDER_OBSERVER_COMMAND_BUFFER_UNDERRUN: {
 			medvdbg("RECORDER_OBSERVER_COMMAND_BUFFER_UNDERRUN\n");
-			row.enQueue(&MediaRecorderObserverInterface::onRecordBufferUnderrun, mRecorderObserver, mRecorder);
+			queued = row.enQueue(&MediaRecorderObserverInterface::onRecordBufferUnderrun, mRecorderObserver, mRecorder);
 		} break;
 		case RECORDER_OBSERVER_COMMAND_BUFFER_DATAREACHED: {
 			medvdbg("RECORDER_OBSERVER_COMMAND_BUFFER_DATAREACHED\n");
 			unsigned char *data = va_arg(ap, unsigned char *);
 			size_t size = va_arg(ap, size_t);
 			std::shared_ptr<unsigned char> autodata(data, [](unsigned char *p){ delete[] p; });
-			row.enQueue(&MediaRecorderObserverInterface::onRecordBufferDataReached, mRecorderObserver, mRecorder, autodata, size);
+			queued = row.enQueue(&MediaRecorderObserverInterface::onRecordBufferDataReached, mRecorderObserver, mRecorder, autodata, size);
 		} break;
 		}
+		if (!queued) {
+			meddbg("observer queue is full, callback %d dropped. recorder: %x\n", cmd, &mRecorder);
+		}
 
 		va_end(ap);
 	}
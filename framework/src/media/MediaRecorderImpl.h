@@ -120,6 +120,7 @@ private:
 	void pauseRecorder(recorder_result_t& ret);
 	void stopRecorder(recorder_result_t& ret);
 	void stopRecorderInternal(recorder_observer_command_e command, recorder_result_t ret);
+	void stopRecorderOnError(recorder_observer_command_e command, recorder_result_t ret);
 	void getRecorderVolume(uint8_t *vol, recorder_result_t& ret);
 	void getRecorderMaxVolume(uint8_t *vol, recorder_result_t& ret);
 	void setRecorderVolume(uint8_t vol, recorder_result_t& ret);
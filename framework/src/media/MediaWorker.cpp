@@ -23,10 +23,15 @@
 
 namespace media {
 
-MediaWorker::MediaWorker() :
+MediaWorker::MediaWorker() : MediaWorker(CONFIG_MEDIA_WORKER_QUEUE_SIZE)
+{
+}
+
+MediaWorker::MediaWorker(size_t queueSize, size_t reservedSize) :
 	mStacksize(PTHREAD_STACK_DEFAULT),
 	mPriority(100),
 	mThreadName("MediaWorker"),
+	mWorkerQueue(queueSize, reservedSize),
 	mIsRunning(false),
 	mRefCnt(0),
 	mWorkerThread(0),
@@ -93,18 +98,22 @@ void MediaWorker::stopWorker()
 			meddbg("%s::stopWorker() - setting exit condition of mWorkerthread\n", mThreadName);
 		} else {
 			std::atomic<bool> &refBool = mIsRunning;
-			mWorkerQueue.enQueue([&refBool]() {
+			if (!mWorkerQueue.enQueue([&refBool]() {
 				refBool = false;
-			});
+			})) {
+				/* Queue is full, so the looper never blocks; let it exit after the current command */
+				meddbg("%s::stopWorker() - queue is full, pending commands are dropped\n", mThreadName);
+				mIsRunning = false;
+			}
 			pthread_join(mWorkerThread, NULL);
 			meddbg("%s::stopWorker() - mWorkerthread exited\n", mThreadName);
 		}
 	}
 }
 
-std::function<void()> MediaWorker::deQueue()
+void MediaWorker::deQueue(MediaCommand &command)
 {
-	return mWorkerQueue.deQueue();
+	mWorkerQueue.deQueue(command);
 }
 
 bool MediaWorker::processLoop()
@@ -115,6 +124,7 @@ bool MediaWorker::processLoop()
 void *MediaWorker::mediaLooper(void *arg)
 {
 	auto worker = static_cast<MediaWorker *>(arg);
+	MediaCommand run;
 	worker->mInsideThreadFunc = true;
 	medvdbg("MediaWorker : mediaLooper\n");
 
@@ -126,10 +136,11 @@ void *MediaWorker::mediaLooper(void *arg)
 			pthread_yield();
 		}
 
-		std::function<void()> run = worker->deQueue();
+		worker->deQueue(run);
 		medvdbg("MediaWorker : deQueue\n");
-		if (run != nullptr) {
+		if (run) {
 			run();
+			run.reset();
 		}
 	}
 	worker->mInsideThreadFunc = false;
@@ -36,14 +36,19 @@ public:
 	void stopWorker();
 
 	template <typename _Callable, typename... _Args>
-	void enQueue(_Callable &&__f, _Args &&... __args) {
-		mWorkerQueue.enQueue(__f, __args...);
+	bool enQueue(_Callable &&__f, _Args &&... __args) {
+		return mWorkerQueue.enQueue(__f, __args...);
 	}
-	std::function<void()> deQueue();
+	template <typename _Callable, typename... _Args>
+	bool enQueueReserved(_Callable &&__f, _Args &&... __args) {
+		return mWorkerQueue.enQueueReserved(__f, __args...);
+	}
+	void deQueue(MediaCommand &command);
 	bool isAlive();
 	void clearQueue(void);
 
 protected:
+	MediaWorker(size_t queueSize, size_t reservedSize = 0);
 	long mStacksize;
 	int mPriority;
 	const char *mThreadName;
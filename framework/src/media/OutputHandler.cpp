@@ -124,6 +124,27 @@ void OutputHandler::resetWorker()
 
 void OutputHandler::writeToSource(size_t size)
 {
+#ifdef CONFIG_MEDIA_STREAM_ZEROCOPY
+	// Write data in stream buffer to output data source directly
+	rb_span_t spans[2];
+	auto peeked = mBufferReader->peek(spans, size, false);
+	if (peeked != size) {
+		meddbg("StreamBufferReader::peek failed! size : %u, peeked : %u\n", size, peeked);
+		return;
+	}
+
+	for (int i = 0; i < 2 && spans[i].len > 0; i++) {
+		auto written = mOutputDataSource->write((unsigned char *)spans[i].ptr, spans[i].len);
+		if (written <= 0) {
+			// Error occurred, stop outputting
+			meddbg("OutputDataSource::write returned <= 0! size : %u, written : %d\n", spans[i].len, written);
+			mBufferWriter->setEndOfStream();
+			break;
+		}
+	}
+
+	mBufferReader->consume(size);
+#else
 	auto buf = new unsigned char[size];
 	auto readed = mBufferReader->read(buf, size);
 	if (readed != size) {
@@ -140,6 +161,7 @@ void OutputHandler::writeToSource(size_t size)
 	}
 
 	delete[] buf;
+#endif
 }
 
 bool OutputHandler::processWorker()
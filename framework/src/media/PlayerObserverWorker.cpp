@@ -27,9 +27,15 @@
 #ifndef CONFIG_MEDIA_PLAYER_OBSERVER_THREAD_PRIORITY
 #define CONFIG_MEDIA_PLAYER_OBSERVER_THREAD_PRIORITY 199
 #endif
+#ifndef CONFIG_MEDIA_PLAYER_OBSERVER_QUEUE_SIZE
+#define CONFIG_MEDIA_PLAYER_OBSERVER_QUEUE_SIZE 32
+#endif
+#ifndef CONFIG_MEDIA_PLAYER_OBSERVER_RESERVED_SIZE
+#define CONFIG_MEDIA_PLAYER_OBSERVER_RESERVED_SIZE 8
+#endif
 
 namespace media {
-PlayerObserverWorker::PlayerObserverWorker()
+PlayerObserverWorker::PlayerObserverWorker() : MediaWorker(CONFIG_MEDIA_PLAYER_OBSERVER_QUEUE_SIZE, CONFIG_MEDIA_PLAYER_OBSERVER_RESERVED_SIZE)
 {
 	mThreadName = "PlayerObserverWorker";
 	mStacksize = CONFIG_MEDIA_PLAYER_OBSERVER_STACKSIZE;
@@ -29,11 +29,14 @@
 #ifndef CONFIG_MEDIA_PLAYER_THREAD_PRIORITY
 #define CONFIG_MEDIA_PLAYER_THREAD_PRIORITY 199
 #endif
+#ifndef CONFIG_MEDIA_PLAYER_QUEUE_SIZE
+#define CONFIG_MEDIA_PLAYER_QUEUE_SIZE 16
+#endif
 
 using namespace std;
 
 namespace media {
-PlayerWorker::PlayerWorker() : mCurPlayer(nullptr)
+PlayerWorker::PlayerWorker() : MediaWorker(CONFIG_MEDIA_PLAYER_QUEUE_SIZE), mCurPlayer(nullptr)
 {
 	mThreadName = "PlayerWorker";
 	mStacksize = CONFIG_MEDIA_PLAYER_STACKSIZE;
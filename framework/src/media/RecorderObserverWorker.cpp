@@ -25,10 +25,16 @@
 #ifndef CONFIG_MEDIA_RECORDER_OBSERVER_THREAD_PRIORITY
 #define CONFIG_MEDIA_RECORDER_OBSERVER_THREAD_PRIORITY 100
 #endif
+#ifndef CONFIG_MEDIA_RECORDER_OBSERVER_QUEUE_SIZE
+#define CONFIG_MEDIA_RECORDER_OBSERVER_QUEUE_SIZE 32
+#endif
+#ifndef CONFIG_MEDIA_RECORDER_OBSERVER_RESERVED_SIZE
+#define CONFIG_MEDIA_RECORDER_OBSERVER_RESERVED_SIZE 8
+#endif
 
 namespace media {
 
-RecorderObserverWorker::RecorderObserverWorker()
+RecorderObserverWorker::RecorderObserverWorker() : MediaWorker(CONFIG_MEDIA_RECORDER_OBSERVER_QUEUE_SIZE, CONFIG_MEDIA_RECORDER_OBSERVER_RESERVED_SIZE)
 {
 	mThreadName = "RecorderObserverWorker";
 	mStacksize = CONFIG_MEDIA_RECORDER_OBSERVER_STACKSIZE;
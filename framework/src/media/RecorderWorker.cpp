@@ -26,10 +26,13 @@
 #ifndef CONFIG_MEDIA_RECORDER_THREAD_PRIORITY
 #define CONFIG_MEDIA_RECORDER_THREAD_PRIORITY 100
 #endif
+#ifndef CONFIG_MEDIA_RECORDER_QUEUE_SIZE
+#define CONFIG_MEDIA_RECORDER_QUEUE_SIZE 16
+#endif
 
 namespace media {
 
-RecorderWorker::RecorderWorker()
+RecorderWorker::RecorderWorker() : MediaWorker(CONFIG_MEDIA_RECORDER_QUEUE_SIZE)
 {
 	medvdbg("RecorderWorker::RecorderWorker()\n");
 	mThreadName = "RecorderWorker";
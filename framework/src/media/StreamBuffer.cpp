@@ -45,8 +45,11 @@
 namespace media {
 namespace stream {
 
-StreamBuffer::StreamBuffer(size_t bufferSize, size_t threshold)
-	: mObserver(nullptr), mEOS(false), mBufferSize(bufferSize), mThreshold(threshold)
+StreamBuffer::StreamBuffer(size_t bufferSize, size_t threshold, bool spsc)
+	: mObserver(nullptr), mEOS(false), mBufferSize(bufferSize), mThreshold(threshold), mSpsc(spsc), mWaiters(0)
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+	, mCopiedBytes(0), mInPlaceBytes(0), mOutputBytes(0)
+#endif
 {
 	mRingBuf.buf = nullptr;
 	mRingBuf.depth = 0;
@@ -77,19 +80,86 @@ bool StreamBuffer::reset()
 	return rb_reset(&mRingBuf);
 }
 
+std::unique_lock<std::mutex> StreamBuffer::lockAccess()
+{
+	if (mSpsc) {
+		return std::unique_lock<std::mutex>(mMutex, std::defer_lock);
+	}
+	return std::unique_lock<std::mutex>(mMutex);
+}
+
+void StreamBuffer::wakeUp()
+{
+	if (!mSpsc) {
+		// Caller holds the lock
+		mCondv.notify_one();
+		return;
+	}
+
+	// Order index update before checking waiters, pairs with the fence in waitUntil().
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (mWaiters.load() > 0) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCondv.notify_all();
+	}
+}
+
 size_t StreamBuffer::copy(unsigned char *buf, size_t size, size_t offset)
 {
-	return rb_read_ext(&mRingBuf, (void *)buf, size, offset);
+	size_t len = rb_read_ext(&mRingBuf, (void *)buf, size, offset);
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+	mCopiedBytes += len;
+#endif
+	return len;
 }
 
 size_t StreamBuffer::read(unsigned char *buf, size_t size)
 {
-	return rb_read(&mRingBuf, buf, size);
+	size_t len = rb_read(&mRingBuf, buf, size);
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+	mCopiedBytes += len;
+	mOutputBytes += len;
+#endif
+	return len;
 }
 
 size_t StreamBuffer::write(unsigned char *buf, size_t size)
 {
-	return rb_write(&mRingBuf, buf, size);
+	size_t len = rb_write(&mRingBuf, buf, size);
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+	mCopiedBytes += len;
+#endif
+	return len;
+}
+
+size_t StreamBuffer::peek(rb_span_t spans[2], size_t size)
+{
+	return rb_peek(&mRingBuf, spans, size);
+}
+
+size_t StreamBuffer::consume(size_t size)
+{
+	// rd_idx is just increased, in case of NULL buffer
+	size_t len = rb_read(&mRingBuf, nullptr, size);
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+	mInPlaceBytes += len;
+	mOutputBytes += len;
+#endif
+	return len;
+}
+
+size_t StreamBuffer::reserve(rb_span_t spans[2], size_t size)
+{
+	return rb_reserve(&mRingBuf, spans, size);
+}
+
+size_t StreamBuffer::commit(size_t size)
+{
+	size_t len = rb_commit(&mRingBuf, size);
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+	mInPlaceBytes += len;
+#endif
+	return len;
 }
 
 size_t StreamBuffer::sizeOfSpace()
@@ -140,7 +210,7 @@ void StreamBuffer::notifyObserver(State st, ...)
 }
 
 StreamBuffer::Builder::Builder()
-	: mBufferSize(CONFIG_STREAM_BUFFER_SIZE_DEFAULT), mThreshold(CONFIG_STREAM_BUFFER_THRESHOLD_DEFAULT)
+	: mBufferSize(CONFIG_STREAM_BUFFER_SIZE_DEFAULT), mThreshold(CONFIG_STREAM_BUFFER_THRESHOLD_DEFAULT), mSpsc(false)
 {
 }
 
@@ -166,13 +236,19 @@ StreamBuffer::Builder &StreamBuffer::Builder::setThreshold(size_t threshold)
 	return *this;
 }
 
+StreamBuffer::Builder &StreamBuffer::Builder::setSingleProducerConsumer(bool spsc)
+{
+	mSpsc = spsc;
+	return *this;
+}
+
 std::shared_ptr<StreamBuffer> StreamBuffer::Builder::build()
 {
 	if (mThreshold > mBufferSize) {
 		mThreshold = mBufferSize;
 	}
 
-	auto instance = std::make_shared<StreamBuffer>(mBufferSize, mThreshold);
+	auto instance = std::make_shared<StreamBuffer>(mBufferSize, mThreshold, mSpsc);
 	if (instance->init(mBufferSize)) {
 		return instance;
 	}
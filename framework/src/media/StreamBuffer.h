@@ -19,8 +19,10 @@
 #ifndef __MEDIA_STREAMBUFFER_H
 #define __MEDIA_STREAMBUFFER_H
 
+#include <tinyara/config.h>
 #include <memory>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include "utils/rb.h"
 
@@ -38,14 +40,20 @@ public:
 		Builder();
 		Builder &setBufferSize(size_t bufferSize);
 		Builder &setThreshold(size_t threshold);
+		/**
+		 * Stream buffer is accessed by only one writer thread and one reader thread.
+		 * Then data is read/written without lock, see lockAccess().
+		 */
+		Builder &setSingleProducerConsumer(bool spsc);
 		std::shared_ptr<StreamBuffer> build();
 
 	private:
 		size_t mBufferSize;
 		size_t mThreshold;
+		bool mSpsc;
 	};
 
-	StreamBuffer(size_t bufferSize, size_t threshold);
+	StreamBuffer(size_t bufferSize, size_t threshold, bool spsc = false);
 	virtual ~StreamBuffer();
 	/**
 	 * Initialize stream buffer with specific buffer size.
@@ -63,6 +71,22 @@ public:
 	void setObserver(BufferObserverInterface *observer);
 	std::mutex &getMutex() { return mMutex; }
 	std::condition_variable &getCondv() { return mCondv; }
+	/**
+	 * Lock stream buffer for reading/writing. In single-producer/single-consumer
+	 * mode, data is accessed lock-free and the returned lock is not owned.
+	 */
+	std::unique_lock<std::mutex> lockAccess();
+	/**
+	 * Block until cond() is satisfied. Other side wakes it up by wakeUp().
+	 * In single-producer/single-consumer mode, the mutex is taken only here.
+	 */
+	template <typename Cond>
+	void waitUntil(std::unique_lock<std::mutex> &lock, Cond cond);
+	/**
+	 * Wake up the other side blocked in waitUntil().
+	 */
+	void wakeUp();
+	bool isSingleProducerConsumer() { return mSpsc; }
 
 public:
 	enum class State {
@@ -87,6 +111,26 @@ public:
 	 * Write(push) data into stream buffer.
 	 */
 	size_t write(unsigned char *buf, size_t size);
+	/**
+	 * Get data in stream buffer as contiguous spans without copying.
+	 * Data wrapped around the end of ring buffer is given by spans[1].
+	 * Data is not removed until consume() is called.
+	 */
+	size_t peek(rb_span_t spans[2], size_t size);
+	/**
+	 * Remove data which was used in place through peek().
+	 */
+	size_t consume(size_t size);
+	/**
+	 * Get free space in stream buffer as contiguous spans to be written in place.
+	 * Space wrapped around the end of ring buffer is given by spans[1].
+	 * Data is not pushed until commit() is called.
+	 */
+	size_t reserve(rb_span_t spans[2], size_t size);
+	/**
+	 * Push data which was written in place through reserve().
+	 */
+	size_t commit(size_t size);
 	/**
 	 * Get bytes of data available in stream buffer.
 	 */
@@ -105,17 +149,54 @@ public:
 	bool isEndOfStream();
 	size_t getBufferSize() { return mBufferSize; }
 	size_t getThreshold() { return mThreshold; }
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+	/**
+	 * Bytes memcpy'd through read/write/copy, bytes passed in place
+	 * through peek/reserve, and bytes removed by read/consume.
+	 */
+	size_t getCopiedBytes() { return mCopiedBytes; }
+	size_t getInPlaceBytes() { return mInPlaceBytes; }
+	size_t getOutputBytes() { return mOutputBytes; }
+#endif
 
 private:
 	std::mutex mMutex;
 	std::condition_variable mCondv;
 	BufferObserverInterface *mObserver;
 	rb_t mRingBuf;
-	bool mEOS;
+	std::atomic<bool> mEOS;
 	size_t mBufferSize;
 	size_t mThreshold;
+	bool mSpsc;
+	std::atomic<int> mWaiters;
+#ifdef CONFIG_MEDIA_STREAM_COPY_STATS
+	std::atomic<size_t> mCopiedBytes;
+	std::atomic<size_t> mInPlaceBytes;
+	std::atomic<size_t> mOutputBytes;
+#endif
 };
 
+template <typename Cond>
+void StreamBuffer::waitUntil(std::unique_lock<std::mutex> &lock, Cond cond)
+{
+	if (!mSpsc) {
+		// Caller holds the lock
+		while (!cond()) {
+			mCondv.wait(lock);
+		}
+		return;
+	}
+
+	std::unique_lock<std::mutex> waitLock(mMutex);
+	// Publish waiting before checking condition, pairs with the fence in wakeUp().
+	mWaiters++;
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	while (!cond()) {
+		mCondv.wait(waitLock);
+	}
+	mWaiters--;
+}
+
 } // namespace stream
 } // namespace media
 
@@ -36,7 +36,7 @@ StreamBufferReader::StreamBufferReader(std::shared_ptr<StreamBuffer> stream)
 size_t StreamBufferReader::copy(unsigned char *buf, size_t size, size_t offset)
 {
 	medvdbg("offset %lu, size %lu\n", offset, size);
-	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->lockAccess();
 	size_t len = mStream->copy(buf, size, offset);
 	medvdbg("copied %lu\n", len);
 	return len;
@@ -45,7 +45,7 @@ size_t StreamBufferReader::copy(unsigned char *buf, size_t size, size_t offset)
 size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 {
 	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
-	std::unique_lock<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->lockAccess();
 
 	size_t rlen = 0;
 
@@ -57,7 +57,7 @@ size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 			rlen += temp;
 			if (rlen < size) {
 				// There's not enough data
-				if (mStream->isEndOfStream()) {
+				if (mStream->isEndOfStream() && mStream->sizeOfData() == 0) {
 					// End of stream, break reading
 					medvdbg("EOS break\n");
 					break;
@@ -67,9 +67,9 @@ size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 				// Notify observer, shouldn't be blocked.
 				mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
 				// Writer may be waiting for more spaces, so it's necessary to notify after reading.
-				mStream->getCondv().notify_one();
+				mStream->wakeUp();
 				// Then wait notification from writer.
-				mStream->getCondv().wait(lock);
+				mStream->waitUntil(lock, [this] { return mStream->sizeOfData() > 0 || mStream->isEndOfStream(); });
 			}
 		}
 
@@ -80,21 +80,58 @@ size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 	}
 
 	// Writer may be waiting for more spaces, so it's necessary to notify after reading.
-	mStream->getCondv().notify_one();
+	mStream->wakeUp();
 
 	medvdbg("read %lu\n", rlen);
 	return rlen;
 }
 
+size_t StreamBufferReader::peek(rb_span_t spans[2], size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	auto lock = mStream->lockAccess();
+
+	if (size > mStream->getBufferSize()) {
+		size = mStream->getBufferSize();
+	}
+
+	if (sync && mStream->sizeOfData() < size && !mStream->isEndOfStream()) {
+		medvdbg("peek %lu/%lu\n", mStream->sizeOfData(), size);
+		// Notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
+		// Writer may be waiting, then wait notification from writer.
+		mStream->wakeUp();
+		mStream->waitUntil(lock, [this, size] { return mStream->sizeOfData() >= size || mStream->isEndOfStream(); });
+	}
+
+	size_t plen = mStream->peek(spans, size);
+	medvdbg("peek %lu\n", plen);
+	return plen;
+}
+
+size_t StreamBufferReader::consume(size_t size)
+{
+	auto lock = mStream->lockAccess();
+
+	size_t clen = mStream->consume(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, -((ssize_t) clen));
+
+	// Writer may be waiting for more spaces, so it's necessary to notify after consuming.
+	mStream->wakeUp();
+
+	medvdbg("consumed %lu\n", clen);
+	return clen;
+}
+
 size_t StreamBufferReader::sizeOfData()
 {
-	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->lockAccess();
 	return mStream->sizeOfData();
 }
 
 bool StreamBufferReader::isEndOfStream()
 {
-	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->lockAccess();
 	return mStream->isEndOfStream();
 }
 
@@ -20,6 +20,7 @@
 #define __MEDIA_STREAMBUFFERREADER_H
 
 #include <memory>
+#include "utils/rb.h"
 
 namespace media {
 namespace stream {
@@ -34,6 +35,16 @@ public:
 	virtual size_t copy(unsigned char *buf, size_t size, size_t offset = 0);
 	virtual size_t read(unsigned char *buf, size_t size, bool sync = true);
 	virtual size_t sizeOfData();
+	/**
+	 * Get data as contiguous spans of stream buffer, without copying.
+	 * In sync mode, it waits until 'size' bytes are available or end of stream.
+	 * The spans stay valid until consume() is called.
+	 */
+	virtual size_t peek(rb_span_t spans[2], size_t size, bool sync = true);
+	/**
+	 * Remove data which was used in place through peek().
+	 */
+	virtual size_t consume(size_t size);
 
 public:
 	bool isEndOfStream();
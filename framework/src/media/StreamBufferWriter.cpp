@@ -36,7 +36,7 @@ StreamBufferWriter::StreamBufferWriter(std::shared_ptr<StreamBuffer> stream)
 size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
 {
 	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
-	std::unique_lock<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->lockAccess();
 
 	size_t wlen = 0;
 
@@ -59,9 +59,9 @@ size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
 				// Notify observer, shouldn't be blocked.
 				mStream->notifyObserver(StreamBuffer::State::OVERRUN);
 				// Reader may be waiting for more data, so it's necessary to notify after writing.
-				mStream->getCondv().notify_one();
+				mStream->wakeUp();
 				// Then wait notification from reader.
-				mStream->getCondv().wait(lock);
+				mStream->waitUntil(lock, [this] { return mStream->sizeOfSpace() > 0 || mStream->isEndOfStream(); });
 			}
 		}
 	} else {
@@ -70,27 +70,65 @@ size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
 	}
 
 	// Reader may be waiting for more data, so it's necessary to notify after writing.
-	mStream->getCondv().notify_one();
+	mStream->wakeUp();
 
 	medvdbg("written %lu\n", wlen);
 	return wlen;
 }
 
+size_t StreamBufferWriter::reserve(rb_span_t spans[2], size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	auto lock = mStream->lockAccess();
+
+	if (sync && mStream->sizeOfSpace() == 0 && !mStream->isEndOfStream()) {
+		// There's no space, notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::OVERRUN);
+		// Reader may be waiting, then wait notification from reader.
+		mStream->wakeUp();
+		mStream->waitUntil(lock, [this] { return mStream->sizeOfSpace() > 0 || mStream->isEndOfStream(); });
+	}
+
+	if (mStream->isEndOfStream()) {
+		// Don't need to write anymore
+		medvdbg("EOS break\n");
+		return 0;
+	}
+
+	size_t rlen = mStream->reserve(spans, size);
+	medvdbg("reserved %lu\n", rlen);
+	return rlen;
+}
+
+size_t StreamBufferWriter::commit(size_t size)
+{
+	auto lock = mStream->lockAccess();
+
+	size_t clen = mStream->commit(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, (ssize_t) clen);
+
+	// Reader may be waiting for more data, so it's necessary to notify after committing.
+	mStream->wakeUp();
+
+	medvdbg("committed %lu\n", clen);
+	return clen;
+}
+
 size_t StreamBufferWriter::sizeOfSpace()
 {
-	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->lockAccess();
 	return mStream->sizeOfSpace();
 }
 
 void StreamBufferWriter::setEndOfStream()
 {
-	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->lockAccess();
 
 	// Set EOS flag in stream.
 	mStream->setEndOfStream();
 
 	// Reader may be waiting for more data, so it's necessary to notify.
-	mStream->getCondv().notify_one();
+	mStream->wakeUp();
 }
 
 } // namespace stream
@@ -20,6 +20,7 @@
 #define __MEDIA_STREAMBUFFERWRITER_H
 
 #include <memory>
+#include "utils/rb.h"
 
 namespace media {
 namespace stream {
@@ -33,6 +34,16 @@ public:
 public:
 	virtual size_t write(unsigned char *buf, size_t size, bool sync = true);
 	virtual size_t sizeOfSpace();
+	/**
+	 * Get free space as contiguous spans of stream buffer to write in place.
+	 * In sync mode, it waits until any space is available or end of stream.
+	 * Written data is pushed by commit().
+	 */
+	virtual size_t reserve(rb_span_t spans[2], size_t size, bool sync = true);
+	/**
+	 * Push data which was written in place through reserve().
+	 */
+	virtual size_t commit(size_t size);
 
 public:
 	void setEndOfStream();
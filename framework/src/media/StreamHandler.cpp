@@ -24,6 +24,12 @@
 #define CONFIG_HANDLER_STREAM_THREAD_PRIORITY 199
 #endif
 
+#ifdef CONFIG_MEDIA_STREAM_SPSC
+#define HANDLER_STREAM_BUFFER_SPSC true
+#else
+#define HANDLER_STREAM_BUFFER_SPSC false
+#endif
+
 namespace media {
 namespace stream {
 
@@ -45,6 +51,7 @@ bool StreamHandler::open()
 		auto streamBuffer = StreamBuffer::Builder()
 								.setBufferSize(CONFIG_HANDLER_STREAM_BUFFER_SIZE)
 								.setThreshold(CONFIG_HANDLER_STREAM_BUFFER_THRESHOLD)
+								.setSingleProducerConsumer(HANDLER_STREAM_BUFFER_SPSC)
 								.build();
 
 		if (!streamBuffer) {
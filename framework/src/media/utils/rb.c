@@ -24,8 +24,10 @@
 #include "rb.h"
 #include "internal_defs.h"
 
-#define IS_EMPTY(rbp) (rbp->rd_idx == rbp->wr_idx)
-#define IS_FULL(rbp) ((rbp->rd_idx & IDX_MASK) == (rbp->wr_idx & IDX_MASK) && (rbp->rd_idx & MSB_MASK) != (rbp->wr_idx & MSB_MASK))
+/* Indices are published with release and observed with acquire semantics,
+ * so one writer and one reader can access the ring-buffer without lock. */
+#define LOAD_IDX(idx) __atomic_load_n(&(idx), __ATOMIC_ACQUIRE)
+#define STORE_IDX(idx, val) __atomic_store_n(&(idx), (val), __ATOMIC_RELEASE)
 
 /**
  * @brief  Increase the buffer index while writing or reading the ring-buffer.
@@ -64,12 +66,16 @@ size_t rb_used(rb_p rbp)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
 
-	if (IS_EMPTY(rbp)) {
+	size_t wr_idx = LOAD_IDX(rbp->wr_idx);
+	size_t rd_idx = LOAD_IDX(rbp->rd_idx);
+
+	if (wr_idx == rd_idx) {
+		// Empty
 		return SIZE_ZERO;
 	}
 
-	size_t wr_idx = (rbp->wr_idx & IDX_MASK);
-	size_t rd_idx = (rbp->rd_idx & IDX_MASK);
+	wr_idx = (wr_idx & IDX_MASK);
+	rd_idx = (rd_idx & IDX_MASK);
 
 	if (wr_idx > rd_idx) {
 		return (wr_idx - rd_idx);
@@ -155,12 +161,65 @@ size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset)
 	return len;
 }
 
+/**
+ * @brief  Split 'len' bytes from index 'idx' into contiguous spans.
+ */
+static size_t _split(rb_p rbp, size_t idx, rb_span_t span[2], size_t len)
+{
+	idx = (idx & IDX_MASK);
+	size_t len_part = rbp->depth - idx;
+
+	span[0].ptr = (void *)((uint8_t *)rbp->buf + idx);
+	if (len > len_part) {
+		// Region wraps around the end of ring buffer
+		span[0].len = len_part;
+		span[1].ptr = rbp->buf;
+		span[1].len = len - len_part;
+	} else {
+		span[0].len = len;
+		span[1].ptr = NULL;
+		span[1].len = SIZE_ZERO;
+	}
+
+	return len;
+}
+
+size_t rb_peek(rb_p rbp, rb_span_t span[2], size_t len)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+	RETURN_VAL_IF_FAIL(span != NULL, SIZE_ZERO);
+
+	size_t used = rb_used(rbp);
+	len = MINIMUM(len, used);
+	return _split(rbp, rbp->rd_idx, span, len);
+}
+
+size_t rb_reserve(rb_p rbp, rb_span_t span[2], size_t len)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+	RETURN_VAL_IF_FAIL(span != NULL, SIZE_ZERO);
+
+	size_t avail = rb_avail(rbp);
+	len = MINIMUM(len, avail);
+	return _split(rbp, rbp->wr_idx, span, len);
+}
+
+size_t rb_commit(rb_p rbp, size_t len)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+
+	size_t avail = rb_avail(rbp);
+	len = MINIMUM(len, avail);
+	_incr(rbp, &rbp->wr_idx, len);
+	return len;
+}
+
 bool rb_reset(rb_p rbp)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, false);
 
-	rbp->rd_idx = 0;
-	rbp->wr_idx = 0;
+	STORE_IDX(rbp->rd_idx, 0);
+	STORE_IDX(rbp->wr_idx, 0);
 
 	return true;
 }
@@ -176,5 +235,5 @@ static void _incr(rb_p rbp, volatile size_t *p_idx, size_t len)
 		idx -= rbp->depth;
 	}
 
-	*p_idx = msb | idx;
+	STORE_IDX(*p_idx, msb | idx);
 }
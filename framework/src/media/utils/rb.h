@@ -41,6 +41,14 @@ struct rb_s {
 typedef struct rb_s  rb_t;
 typedef struct rb_s *rb_p;
 
+/* contiguous region of the ring-buffer */
+struct rb_span_s {
+	void *ptr;                  /* start address in the buffer       */
+	size_t len;                 /* length of the region in bytes     */
+};
+
+typedef struct rb_span_s rb_span_t;
+
 /**
  * @brief  Initialize the ring-buffer. Allocate necessary memory for the buffer.
  * @param  rbp : Pointer to the ring-buffer object
@@ -102,6 +110,37 @@ size_t rb_read(rb_p rbp, void *ptr, size_t len);
  */
 size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset);
 
+/**
+ * @brief  Get data in the ring-buffer as contiguous regions without copying.
+ *         Data wrapped around the end of buffer is given by the second span.
+ *         rd_idx will not be increased, call rb_read(rbp, NULL, len) after use.
+ * @param  rbp : Pointer to the ring-buffer object
+ * @param  span: Array of two spans to be filled, unused span has len 0
+ * @param  len : maximum length of the data to be peeked
+ * @return total length of the spans, range[0, len]
+ */
+size_t rb_peek(rb_p rbp, rb_span_t span[2], size_t len);
+
+/**
+ * @brief  Get free space in the ring-buffer as contiguous regions
+ *         to be written in place. Space wrapped around the end of buffer
+ *         is given by the second span. wr_idx will not be increased,
+ *         call rb_commit() after data is written.
+ * @param  rbp : Pointer to the ring-buffer object
+ * @param  span: Array of two spans to be filled, unused span has len 0
+ * @param  len : maximum length of the space to be reserved
+ * @return total length of the spans, range[0, len]
+ */
+size_t rb_reserve(rb_p rbp, rb_span_t span[2], size_t len);
+
+/**
+ * @brief  Push data written in place through rb_reserve().
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  len: length of the data written
+ * @return size wr_idx increased, range[0, len]
+ */
+size_t rb_commit(rb_p rbp, size_t len);
+
 /**
  * @brief  Reset ring-buffer, data in ring-buffer will be dropped.
  * @param  rbp: Pointer to the ring-buffer object
@@ -17,6 +17,7 @@
  ****************************************************************************/
 #include <tinyara/compiler.h>
 #include <mqueue.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <queue.h>
@@ -106,6 +107,36 @@ struct msg_port_info_s {
 };
 typedef struct msg_port_info_s msg_port_info_t;
 
+/**
+ * @brief The internal structure for a receiver of the opened message port
+ */
+struct msg_port_recv_s {
+	pid_t pid;
+	int regid;
+	mqd_t mqdes;
+};
+
+/**
+ * @brief The internal structure for the message port opened by messaging_port_open.
+ */
+struct msg_port_s {
+	char name[MAX_PORT_NAME_SIZE];
+	char *packet;
+	int packet_size;
+	bool shared;		/* References of shared buffers were sent */
+	int nrecv;
+	struct msg_port_recv_s recv[CONFIG_MESSAGING_RECV_LIST_SIZE];
+};
+
+/**
+ * @brief The internal structure placed in front of the shared buffer
+ */
+struct msg_shared_s {
+	int refs;
+	int size;
+};
+typedef struct msg_shared_s msg_shared_t;
+
 /**
  * @brief Internal function for setting callback function to the messaging signal.
  */
@@ -126,6 +157,10 @@ int messaging_send_internal(const char *port_name, msg_send_type_t msg_type, msg
  * @brief Internal function for sending message packet which has header and message.
  */
 int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_send_data_t *send_data, msg_callback_info_t *cb_info);
+/**
+ * @brief Internal function for filling the header of message packet.
+ */
+void messaging_set_header(char *packet, msg_send_type_t msg_type);
 /**
  * @brief Internal function for receiving APIs.
  */
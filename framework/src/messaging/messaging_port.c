@@ -0,0 +1,378 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <debug.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <mqueue.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/prctl.h>
+#include <sys/types.h>
+#include <messaging/messaging.h>
+#include "messaging_internal.h"
+
+#define MSG_SHARED_HDR(buf) ((msg_shared_t *)((char *)(buf) - sizeof(msg_shared_t)))
+
+/* Protects the reference counts of the shared buffers */
+static sem_t g_shared_sem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * private functions
+ ****************************************************************************/
+static void messaging_port_close_recv(msg_port_t *port, int recv_idx)
+{
+	mq_close(port->recv[recv_idx].mqdes);
+	port->nrecv--;
+	port->recv[recv_idx] = port->recv[port->nrecv];
+}
+
+/****************************************************************************
+ * Name : messaging_port_drop_recv
+ *
+ * Description:
+ *  Close the queue of a receiver which does not wait it anymore. The queue
+ *  is unlinked already, so the messages left in it are never received.
+ *  Take them out to give back the references of shared buffers they hold.
+ ****************************************************************************/
+static void messaging_port_drop_recv(msg_port_t *port, int recv_idx)
+{
+	struct mq_attr attr;
+	char *packet;
+	msg_shared_ref_t *ref;
+	mqd_t mqdes = port->recv[recv_idx].mqdes;
+
+	if (port->shared && mq_getattr(mqdes, &attr) == OK && attr.mq_curmsgs > 0) {
+		packet = (char *)MSG_ALLOC(attr.mq_msgsize);
+		if (packet != NULL) {
+			attr.mq_flags = O_NONBLOCK;
+			mq_setattr(mqdes, &attr, NULL);
+			while (mq_receive(mqdes, packet, attr.mq_msgsize, NULL) == MSG_HEADER_SIZE + sizeof(msg_shared_ref_t)) {
+				ref = (msg_shared_ref_t *)(packet + MSG_HEADER_SIZE);
+				messaging_shared_release(ref->data);
+			}
+			MSG_FREE(packet);
+		}
+	}
+
+	mq_close(mqdes);
+	port->nrecv--;
+	port->recv[recv_idx] = port->recv[port->nrecv];
+}
+
+/****************************************************************************
+ * Name : messaging_port_update
+ *
+ * Description:
+ *  Synchronize the opened message queues of the port with the receivers
+ *  which wait the port now. A receiver which registered again got a new
+ *  message queue, so its old queue is closed and the new one is opened.
+ *
+ * Return Value:
+ *  On success, the number of receivers is returned.
+ *  On failure, -1 (ERROR) is returned.
+ ****************************************************************************/
+static int messaging_port_update(msg_port_t *port)
+{
+	int recv_cnt;
+	int recv_idx;
+	int arr_idx;
+	int pid_arr[CONFIG_MESSAGING_RECV_LIST_SIZE];
+	int regid_arr[CONFIG_MESSAGING_RECV_LIST_SIZE];
+	char internal_portname[MAX_PORT_NAME_SIZE + 12];
+	mqd_t mqdes;
+
+	recv_cnt = prctl(PR_MSG_READ_ID, port->name, pid_arr, regid_arr, CONFIG_MESSAGING_RECV_LIST_SIZE);
+	if (recv_cnt < 0) {
+		msgdbg("[Messaging] port send fail : reading receivers fail.\n");
+		return ERROR;
+	}
+
+	if (recv_cnt > CONFIG_MESSAGING_RECV_LIST_SIZE) {
+		msgdbg("[Messaging] port send fail : too many receivers(%d) are waiting.\n", recv_cnt);
+		return ERROR;
+	}
+
+	/* Close the queues of receivers which are gone or registered again. */
+	recv_idx = 0;
+	while (recv_idx < port->nrecv) {
+		for (arr_idx = 0; arr_idx < recv_cnt; arr_idx++) {
+			if (pid_arr[arr_idx] == port->recv[recv_idx].pid && regid_arr[arr_idx] == port->recv[recv_idx].regid) {
+				break;
+			}
+		}
+
+		if (arr_idx == recv_cnt) {
+			messaging_port_drop_recv(port, recv_idx);
+		} else {
+			recv_idx++;
+		}
+	}
+
+	if (port->nrecv == recv_cnt) {
+		return recv_cnt;
+	}
+
+	/* Open the queues of new receivers. */
+	for (arr_idx = 0; arr_idx < recv_cnt; arr_idx++) {
+		for (recv_idx = 0; recv_idx < port->nrecv; recv_idx++) {
+			if (pid_arr[arr_idx] == port->recv[recv_idx].pid && regid_arr[arr_idx] == port->recv[recv_idx].regid) {
+				break;
+			}
+		}
+
+		if (recv_idx < port->nrecv) {
+			continue;
+		}
+
+		snprintf(internal_portname, sizeof(internal_portname), "%s%d", port->name, pid_arr[arr_idx]);
+		/* Opened for reading too, to drain the queue when it gets stale. */
+		mqdes = mq_open(internal_portname, O_RDWR);
+		if (mqdes == (mqd_t)ERROR) {
+			/* The receiver can finish receiving in the meantime. */
+			msgdbg("[Messaging] port send : open fail for %d, errno %d.\n", pid_arr[arr_idx], errno);
+			continue;
+		}
+
+		port->recv[port->nrecv].pid = pid_arr[arr_idx];
+		port->recv[port->nrecv].regid = regid_arr[arr_idx];
+		port->recv[port->nrecv].mqdes = mqdes;
+		port->nrecv++;
+	}
+
+	return port->nrecv;
+}
+
+/****************************************************************************
+ * Name : messaging_port_send_packet
+ *
+ * Description:
+ *  Send 'msglen' bytes of message to all receivers of the port.
+ ****************************************************************************/
+static int messaging_port_send_packet(msg_port_t *port, const char *msg, int msglen, int priority)
+{
+	int ret;
+	int recv_idx;
+	int send_cnt;
+	int send_size;
+	char *packet;
+
+	ret = messaging_port_update(port);
+	if (ret <= 0) {
+		if (ret == 0) {
+			msgdbg("[Messaging] port send fail : no receiver.\n");
+		}
+		return ERROR;
+	}
+
+	send_size = MSG_HEADER_SIZE + msglen;
+	if (send_size > port->packet_size) {
+		packet = (char *)realloc(port->packet, send_size);
+		if (packet == NULL) {
+			msgdbg("[Messaging] port send fail : out of memory for including header.\n");
+			return ERROR;
+		}
+		port->packet = packet;
+		port->packet_size = send_size;
+		messaging_set_header(port->packet, MSG_SEND_NOREPLY);
+	}
+
+	memcpy(port->packet + MSG_HEADER_SIZE, msg, msglen);
+
+	send_cnt = 0;
+	recv_idx = 0;
+	while (recv_idx < port->nrecv) {
+		ret = mq_send(port->recv[recv_idx].mqdes, port->packet, send_size, priority);
+		if (ret != OK) {
+			msgdbg("[Messaging] port send fail to %d : errno %d.\n", port->recv[recv_idx].pid, errno);
+			messaging_port_close_recv(port, recv_idx);
+			continue;
+		}
+		send_cnt++;
+		recv_idx++;
+	}
+
+	if (send_cnt == 0) {
+		return ERROR;
+	}
+
+	return send_cnt;
+}
+
+/****************************************************************************
+ * public functions
+ ****************************************************************************/
+/****************************************************************************
+ * messaging_port_open
+ ****************************************************************************/
+msg_port_t *messaging_port_open(const char *port_name)
+{
+	msg_port_t *port;
+
+	if (port_name == NULL || strlen(port_name) >= MAX_PORT_NAME_SIZE) {
+		msgdbg("[Messaging] port open fail : invalid port name.\n");
+		return NULL;
+	}
+
+	port = (msg_port_t *)MSG_ALLOC(sizeof(msg_port_t));
+	if (port == NULL) {
+		msgdbg("[Messaging] port open fail : out of memory.\n");
+		return NULL;
+	}
+
+	strncpy(port->name, port_name, MAX_PORT_NAME_SIZE);
+	port->packet = NULL;
+	port->packet_size = 0;
+	port->shared = false;
+	port->nrecv = 0;
+
+	return port;
+}
+
+/****************************************************************************
+ * messaging_port_send
+ ****************************************************************************/
+int messaging_port_send(msg_port_t *port, msg_send_data_t *send_data)
+{
+	if (port == NULL) {
+		msgdbg("[Messaging] port send fail : invalid port.\n");
+		return ERROR;
+	}
+
+	if (send_data == NULL || send_data->msg == NULL || send_data->msglen <= 0 || send_data->priority < 0) {
+		msgdbg("[Messaging] port send fail : invalid param of send data.\n");
+		return ERROR;
+	}
+
+	return messaging_port_send_packet(port, send_data->msg, send_data->msglen, send_data->priority);
+}
+
+/****************************************************************************
+ * messaging_port_send_shared
+ ****************************************************************************/
+int messaging_port_send_shared(msg_port_t *port, void *shared_buf, int datalen, int priority)
+{
+	int ret;
+	msg_shared_t *shared;
+	msg_shared_ref_t ref;
+
+	if (port == NULL || shared_buf == NULL || priority < 0) {
+		msgdbg("[Messaging] port send shared fail : invalid param.\n");
+		return ERROR;
+	}
+
+	shared = MSG_SHARED_HDR(shared_buf);
+	if (datalen <= 0 || datalen > shared->size) {
+		msgdbg("[Messaging] port send shared fail : invalid length %d.\n", datalen);
+		return ERROR;
+	}
+
+	ref.data = shared_buf;
+	ref.datalen = datalen;
+	port->shared = true;
+
+	/* Take the references for all receivers in advance, because a receiver
+	 * can release its reference before mq_send returns to the next receiver.
+	 */
+	while (sem_wait(&g_shared_sem) != OK);
+	shared->refs += CONFIG_MESSAGING_RECV_LIST_SIZE;
+	sem_post(&g_shared_sem);
+
+	ret = messaging_port_send_packet(port, (const char *)&ref, sizeof(msg_shared_ref_t), priority);
+
+	/* Give back the references of receivers which did not get the buffer. */
+	while (sem_wait(&g_shared_sem) != OK);
+	shared->refs -= CONFIG_MESSAGING_RECV_LIST_SIZE - (ret > 0 ? ret : 0);
+	sem_post(&g_shared_sem);
+
+	return ret;
+}
+
+/****************************************************************************
+ * messaging_port_close
+ ****************************************************************************/
+int messaging_port_close(msg_port_t *port)
+{
+	if (port == NULL) {
+		msgdbg("[Messaging] port close fail : invalid port.\n");
+		return ERROR;
+	}
+
+	while (port->nrecv > 0) {
+		messaging_port_close_recv(port, port->nrecv - 1);
+	}
+
+	if (port->packet != NULL) {
+		MSG_FREE(port->packet);
+	}
+	MSG_FREE(port);
+
+	return OK;
+}
+
+/****************************************************************************
+ * messaging_shared_alloc
+ ****************************************************************************/
+void *messaging_shared_alloc(int size)
+{
+	msg_shared_t *shared;
+
+	if (size <= 0) {
+		return NULL;
+	}
+
+	shared = (msg_shared_t *)MSG_ALLOC(sizeof(msg_shared_t) + size);
+	if (shared == NULL) {
+		msgdbg("[Messaging] shared alloc fail : out of memory.\n");
+		return NULL;
+	}
+
+	shared->refs = 1;
+	shared->size = size;
+
+	return (char *)shared + sizeof(msg_shared_t);
+}
+
+/****************************************************************************
+ * messaging_shared_release
+ ****************************************************************************/
+void messaging_shared_release(void *shared_buf)
+{
+	msg_shared_t *shared;
+	int refs;
+
+	if (shared_buf == NULL) {
+		return;
+	}
+
+	shared = MSG_SHARED_HDR(shared_buf);
+
+	while (sem_wait(&g_shared_sem) != OK);
+	refs = --shared->refs;
+	sem_post(&g_shared_sem);
+
+	if (refs == 0) {
+		MSG_FREE(shared);
+	}
+}
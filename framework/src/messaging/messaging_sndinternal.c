@@ -89,6 +89,44 @@ static int messaging_set_async_callback(const char *port_name, msg_recv_buf_t *r
 	}
 	return OK;
 }
+/****************************************************************************
+ * Name : messaging_set_header
+ *
+ * Description:
+ *  This function fills the header of the packet to be sent.
+ *
+ * Input Parameters:
+ *  packet   : The packet which has MSG_HEADER_SIZE bytes of header
+ *  msg_type : The type of sending message
+ ****************************************************************************/
+void messaging_set_header(char *packet, msg_send_type_t msg_type)
+{
+	uint32_t send_type;
+
+	/* Send packet(version 1) is like below.
+	 * +--------------------------------------------------------------------------------------------------------+
+	 * | version(4bytes) | msg_offset(4bytes) | sender_pid(4bytes) | msg type(4bytes) | message(Max 65515bytes) |
+	 * +--------------------------------------------------------------------------------------------------------+
+	 */
+
+	/* Add data header for message version and msg offset. */
+	((messaging_packet_t *)packet)->version = messaging_get_version();
+	((messaging_packet_t *)packet)->offset = MSG_HEADER_SIZE;
+
+	/* Add data header for sender pid. */
+	((messaging_packet_t *)packet)->sender_pid = getpid();
+
+	/* Add data header for send type. */
+	if (msg_type == MSG_SEND_NOREPLY || msg_type == MSG_SEND_MULTI) {
+		send_type = MSG_REPLY_NO_REQUIRED;
+	} else if (msg_type == MSG_SEND_REPLY) {
+		send_type = MSG_SEND_REPLY;
+	} else {
+		send_type = MSG_REPLY_REQUIRED;
+	}
+	((messaging_packet_t *)packet)->msg_type = send_type;
+}
+
 /****************************************************************************
  * Name : messaging_send_packet
  * 
@@ -111,9 +149,6 @@ int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_s
 	struct mq_attr internal_attr;
 	char *send_packet;
 	int send_size;
-	uint32_t send_type;
-	uint32_t msg_offset;
-	uint32_t msg_version;
 
 	send_size = MSG_HEADER_SIZE + send_data->msglen;
 
@@ -139,33 +174,10 @@ int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_s
 		return ERROR;
 	}
 
-	/* Send packet(version 1) is like below.
-	 * +--------------------------------------------------------------------------------------------------------+
-	 * | version(4bytes) | msg_offset(4bytes) | sender_pid(4bytes) | msg type(4bytes) | message(Max 65515bytes) |
-	 * +--------------------------------------------------------------------------------------------------------+
-	 */
-
-	/* Add data header for message version and msg offset. */
-	msg_version = messaging_get_version();
-	((messaging_packet_t *)send_packet)->version = msg_version;
-	msg_offset = MSG_HEADER_SIZE;
-	((messaging_packet_t *)send_packet)->offset = msg_offset;
-
-	/* Add data header for sender pid. */
-	((messaging_packet_t *)send_packet)->sender_pid = getpid();
-
-	/* Add data header for send type. */
-	if (msg_type == MSG_SEND_NOREPLY || msg_type == MSG_SEND_MULTI) {
-		send_type = MSG_REPLY_NO_REQUIRED;
-	} else if (msg_type == MSG_SEND_REPLY) {
-		send_type = MSG_SEND_REPLY;
-	} else {
-		send_type = MSG_REPLY_REQUIRED;
-	}
-	((messaging_packet_t *)send_packet)->msg_type = send_type;
+	messaging_set_header(send_packet, msg_type);
 
 	/* Copy the real send message. */
-	memcpy(send_packet + msg_offset, send_data->msg, send_data->msglen);
+	memcpy(send_packet + MSG_HEADER_SIZE, send_data->msg, send_data->msglen);
 
 	ret = mq_send(mqdes, (char *)send_packet, send_size, send_data->priority);
 	if (ret != OK) {
@@ -92,6 +92,13 @@
 
 #define putc(c, stream)	(total_len++, (stream)->put(stream, c))
 
+/* Put a run of characters or of padding at once */
+
+#define putstr(s, n, stream)	(total_len += (n), vsprintf_putstr(stream, s, n))
+#define putpad(p, n, stream)	(total_len += (n), vsprintf_putpad(stream, p, n))
+
+#define PAD_SIZE           16
+
 /* Order is relevant here and matches order in format string */
 
 #define FL_ZFILL           0x0001
@@ -157,6 +164,36 @@ struct arg {
  ****************************************************************************/
 
 static const char g_nullstring[] = "(null)";
+static const char g_spaces[PAD_SIZE + 1] = "                ";
+static const char g_zeros[PAD_SIZE + 1] = "0000000000000000";
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void vsprintf_putstr(FAR struct lib_outstream_s *stream, FAR const char *str, int len)
+{
+	if (stream->puts != NULL) {
+		stream->puts(stream, str, len);
+		return;
+	}
+
+	while (len-- > 0) {
+		stream->put(stream, *str++);
+	}
+}
+
+static void vsprintf_putpad(FAR struct lib_outstream_s *stream, FAR const char *pad, int len)
+{
+	while (len > PAD_SIZE) {
+		vsprintf_putstr(stream, pad, PAD_SIZE);
+		len -= PAD_SIZE;
+	}
+
+	if (len > 0) {
+		vsprintf_putstr(stream, pad, len);
+	}
+}
 
 /****************************************************************************
  * Public Functions
@@ -195,6 +232,22 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream, FAR struct arg
 
 	for (;;) {
 		for (;;) {
+#ifndef CONFIG_ARCH_ROMGETC
+			/* Put the literal text up to the next conversion as one run */
+
+			pnt = fmt;
+			while (*fmt != '\0' && *fmt != '%') {
+				fmt++;
+			}
+
+#ifdef CONFIG_LIBC_NUMBERED_ARGS
+			if (stream != NULL && fmt != pnt) {
+#else
+			if (fmt != pnt) {
+#endif
+				putstr(pnt, fmt - pnt, stream);
+			}
+#endif
 			c = fmt_char(fmt);
 			if (c == '\0') {
 				goto ret;
@@ -603,10 +656,8 @@ flt_oper:
 			/* Output before first digit */
 
 			if ((flags & (FL_LPAD | FL_ZFILL)) == 0) {
-				while (width) {
-					putc(' ', stream);
-					width--;
-				}
+				putpad(g_spaces, width, stream);
+				width = 0;
 			}
 
 			if (sign != 0) {
@@ -614,10 +665,8 @@ flt_oper:
 			}
 
 			if ((flags & FL_LPAD) == 0) {
-				while (width) {
-					putc('0', stream);
-					width--;
-				}
+				putpad(g_zeros, width, stream);
+				width = 0;
 			}
 
 			if ((flags & FL_FLTFIX) != 0) {
@@ -749,21 +798,13 @@ flt_oper:
 			size = strnlen(pnt, (flags & FL_PREC) ? prec : ~0);
 
 str_lpad:
-			if ((flags & FL_LPAD) == 0) {
-				while (size < width) {
-					putc(' ', stream);
-					width--;
-				}
+			if ((flags & FL_LPAD) == 0 && size < width) {
+				putpad(g_spaces, width - (int)size, stream);
+				width = size;
 			}
 
-			while (size) {
-				putc(*pnt++, stream);
-				if (width != 0) {
-					width -= 1;
-				}
-
-				size -= 1;
-			}
+			putstr(pnt, size, stream);
+			width = (size < width) ? width - (int)size : 0;
 
 			goto tail;
 		}
@@ -956,9 +997,9 @@ str_lpad:
 				}
 			}
 
-			while (len < width) {
-				putc(' ', stream);
-				len++;
+			if (len < width) {
+				putpad(g_spaces, width - len, stream);
+				len = width;
 			}
 		}
 
@@ -982,22 +1023,26 @@ str_lpad:
 			putc(z, stream);
 		}
 
-		while (prec > c) {
-			putc('0', stream);
-			prec--;
+		if (prec > c) {
+			putpad(g_zeros, prec - c, stream);
 		}
 
-		while (c) {
-			putc(buf[--c], stream);
+		/* The digits are stored backwards, turn them around to put them as a run */
+
+		for (len = 0; len < c / 2; len++) {
+			unsigned char t = buf[len];
+			buf[len] = buf[c - 1 - len];
+			buf[c - 1 - len] = t;
 		}
 
+		putstr((FAR const char *)buf, c, stream);
+
 tail:
 
 		/* Tail is possible.  */
 
-		while (width) {
-			putc(' ', stream);
-			width--;
+		if (width > 0) {
+			putpad(g_spaces, width, stream);
 		}
 	}
 
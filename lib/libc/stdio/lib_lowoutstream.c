@@ -83,6 +83,24 @@ static void lowoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 #endif
 }
 
+/****************************************************************************
+ * Name: lowoutstream_puts
+ ****************************************************************************/
+
+static void lowoutstream_puts(FAR struct lib_outstream_s *this, FAR const void *buf, int len)
+{
+	DEBUGASSERT(this);
+#if defined(CONFIG_BUILD_FLAT) || (defined(CONFIG_BUILD_PROTECTED) && defined(__KERNEL__))
+	FAR const char *ptr = (FAR const char *)buf;
+
+	while (len-- > 0) {
+		if (up_putc(*ptr++) != EOF) {
+			this->nput++;
+		}
+	}
+#endif
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -105,6 +123,7 @@ static void lowoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 void lib_lowoutstream(FAR struct lib_outstream_s *stream)
 {
 	stream->put = lowoutstream_putc;
+	stream->puts = lowoutstream_puts;
 #ifdef CONFIG_STDIO_LINEBUFFER
 	stream->flush = lib_noflush;
 #endif
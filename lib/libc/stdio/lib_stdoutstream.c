@@ -55,6 +55,8 @@
  ****************************************************************************/
 
 #include <fcntl.h>
+#include <stdbool.h>
+#include <string.h>
 #include <assert.h>
 #include <errno.h>
 
@@ -92,6 +94,43 @@ static void stdoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 	} while (get_errno() == EINTR);
 }
 
+/****************************************************************************
+ * Name: stdoutstream_puts
+ ****************************************************************************/
+
+static void stdoutstream_puts(FAR struct lib_outstream_s *this, FAR const void *buf, int len)
+{
+	FAR struct lib_stdoutstream_s *sthis = (FAR struct lib_stdoutstream_s *)this;
+	FAR const char *ptr = (FAR const char *)buf;
+	ssize_t result;
+#ifdef CONFIG_STDIO_LINEBUFFER
+	bool newline = (memchr(buf, '\n', len) != NULL);
+#endif
+
+	DEBUGASSERT(this && sthis->stream);
+
+	/* Hand the whole run to the stream buffer, continuing after EINTR */
+
+	while (len > 0) {
+		result = lib_fwrite(ptr, len, sthis->stream);
+		if (result > 0) {
+			this->nput += result;
+			ptr += result;
+			len -= result;
+		} else if (result == 0 || get_errno() != EINTR) {
+			return;
+		}
+	}
+
+	/* Flush the buffer if a newline was written, as fputc() does */
+
+#ifdef CONFIG_STDIO_LINEBUFFER
+	if (newline) {
+		lib_fflush(sthis->stream, true);
+	}
+#endif
+}
+
 /****************************************************************************
  * Name: stdoutstream_flush
  ****************************************************************************/
@@ -130,6 +169,7 @@ void lib_stdoutstream(FAR struct lib_stdoutstream_s *outstream, FAR FILE *stream
 	/* Select the put operation */
 
 	outstream->public.put = stdoutstream_putc;
+	outstream->public.puts = stdoutstream_puts;
 
 	/* Select the correct flush operation.  This flush is only called when
 	 * a newline is encountered in the output stream.  However, we do not
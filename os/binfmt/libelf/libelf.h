@@ -373,10 +373,11 @@ void elf_addrenv_free(FAR struct elf_loadinfo_s *loadinfo);
 struct block_cache_s {
 	unsigned char *out_buffer;              /* Buffer that is going to hold uncompressed data */
 	int block_number;                       /* Block number in compressed file for the cached block */
-	unsigned int no_requests_for_block;     /* Number of requests for current block that is cached */
+	bool prefetched;                        /* Block was read ahead and is not requested yet */
 	unsigned int index_block_cache;         /* Index of block cache in the array */
 	struct block_cache_s *next;             /* Pointer to next element in doubly linked list */
 	struct block_cache_s *prev;             /* Pointer to previous element in doubly linked list */
+	struct block_cache_s *hash_next;        /* Pointer to next element in the same hash bucket */
 };
 typedef struct block_cache_s block_cache_t;
 
@@ -403,6 +404,19 @@ void elf_cache_uninit(void);
  ****************************************************************************/
 int elf_cache_init(int filfd, uint16_t offset, off_t filelen);
 
+/****************************************************************************
+ * Name: elf_cache_set_sections
+ *
+ * Description:
+ *   Tell the cache which parts of the file the loader will read and in
+ *   which order, using the section headers in 'loadinfo'. Read ahead
+ *   follows this order and never reads blocks outside of it.
+ *
+ * Returned Value:
+ *   None
+ ****************************************************************************/
+void elf_cache_set_sections(FAR struct elf_loadinfo_s *loadinfo);
+
 /****************************************************************************
  * Name: elf_cache_read
  *
@@ -29,11 +29,32 @@
 #include <errno.h>
 
 #include <tinyara/fs/fs.h>
+#include <tinyara/kmalloc.h>
 #include "libelf.h"
 
 #ifdef CONFIG_COMPRESSED_BINARY
 #include <tinyara/binfmt/compression/compress_read.h>
 #endif
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Range of blocks holding one section that the loader is going to read */
+struct elf_cache_extent_s {
+	int first_block;
+	int last_block;
+};
+
+/* Counters reported when the cache is released */
+struct elf_cache_stats_s {
+	unsigned int reads;			/* Number of elf_cache_read calls */
+	unsigned int hits;			/* Blocks copied from cache */
+	unsigned int misses;			/* Blocks read into cache on request */
+	unsigned int prefetched;		/* Blocks read into cache ahead of request */
+	unsigned int prefetch_hits;		/* Prefetched blocks which were requested later */
+	unsigned int direct;			/* Blocks read directly into caller's buffer */
+};
+
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
@@ -56,10 +77,20 @@ static block_cache_t *blockcache;
 /* Pointers for maintaining doubly linked list of blockcache */
 static block_cache_t *head;		/* Pointer to least priority block for caching */
 static block_cache_t *tail;		/* Pointer to highest priority block for caching */
-static block_cache_t *most_accessed;	/* Pointer to most accessed block for quick access */
 
-/* Number of requests for the most accessed block in blockcache list */
-static unsigned int max_accessed_count;
+/* Hash table of cached blocks, indexed by block_number & hash_mask */
+static block_cache_t **hashtable;
+static unsigned int hash_mask;
+
+/* Sections to be read by the loader, in the order they are read */
+static struct elf_cache_extent_s *extents;
+static int number_of_extents;
+
+/* Read ahead state */
+static unsigned int ra_window;		/* Number of blocks to read ahead */
+static int ra_last;			/* Last block read from file on request */
+
+static struct elf_cache_stats_s stats;
 
 /****************************************************************************
  * Private Functions
@@ -82,7 +113,7 @@ static void elf_cache_blocks_to_read(int *first_block, int *last_block, int *no_
 	blocksize = cache_blocks_size;
 
 	*first_block = offset / blocksize;
-	*last_block = (offset + readsize) / blocksize;
+	*last_block = (offset + readsize - 1) / blocksize;
 	*no_blocks = *last_block - *first_block + 1;
 }
 
@@ -118,23 +149,24 @@ static off_t elf_cache_lseek_block(int filfd, uint16_t binary_header_size, int b
 }
 
 /****************************************************************************
- * Name: elf_cache_read_block
+ * Name: elf_cache_read_blocks
  *
  * Description:
- *   Read 'block_number' block from elf blocks section into
- *   provided respective block numbers 'out_buffer' variable.
+ *   Read 'count' consecutive blocks starting at 'block_number' from elf
+ *   blocks section into 'buf'. The last block of the file is read with its
+ *   actual size.
  *
  * Returned Value:
- *   Number of bytes read into out_buffer on Success
+ *   Number of bytes read into buf on Success
  *   Negative value on Failure
  ****************************************************************************/
-static off_t elf_cache_read_block(int filfd, uint16_t binary_header_size, FAR uint8_t *buf, int block_number)
+static off_t elf_cache_read_blocks(int filfd, uint16_t binary_header_size, FAR uint8_t *buf, int block_number, int count)
 {
 	off_t rpos;
 	size_t readsize;
 	ssize_t nbytes;
 
-	binfo("filfd: %d block_number: %d binary_header_size: %d\n", filfd, block_number, binary_header_size);
+	binfo("filfd: %d block_number: %d count: %d binary_header_size: %d\n", filfd, block_number, count, binary_header_size);
 
 	/* Seek to location of 'block_number' block in elf file for uncompressed elf */
 #ifdef CONFIG_COMPRESSED_BINARY
@@ -143,17 +175,16 @@ static off_t elf_cache_read_block(int filfd, uint16_t binary_header_size, FAR ui
 	rpos = elf_cache_lseek_block(filfd, binary_header_size, block_number);
 #endif
 
-
 	if (rpos < 0) {
 		berr("Failed to seek to offset of block number %d\n", block_number);
 		return rpos;
 	}
 
-	/* Last unaligned blocks to be read with its actual size and not with blocksize;*/
-	if (block_number == number_of_blocks - 1) {
-		readsize = file_len % cache_blocks_size;
+	/* Last unaligned blocks to be read with its actual size and not with blocksize */
+	if (block_number + count >= number_of_blocks) {
+		readsize = file_len - block_number * cache_blocks_size;
 	} else {
-		readsize = cache_blocks_size;
+		readsize = count * cache_blocks_size;
 	}
 
 #ifdef CONFIG_COMPRESSED_BINARY
@@ -169,177 +200,281 @@ static off_t elf_cache_read_block(int filfd, uint16_t binary_header_size, FAR ui
 	if (nbytes != readsize) {
 		int errval = get_errno();
 		berr("Read failed for size (%d) errno(%d)\n", readsize, errval);
-		return -errval;
+		return errval > 0 ? -errval : -EIO;
 	}
 
 	return nbytes;
 }
 
 /****************************************************************************
- * Name: elf_cache_update_blockcache_list
+ * Name: elf_cache_lookup
+ *
+ * Description:
+ *   Find the blockcache element holding 'block_number' block.
+ *
+ * Returned Value:
+ *   Pointer to blockcache element, NULL if the block is not cached
+ ****************************************************************************/
+static block_cache_t *elf_cache_lookup(int block_number)
+{
+	block_cache_t *ptr;
+
+	for (ptr = hashtable[block_number & hash_mask]; ptr != NULL; ptr = ptr->hash_next) {
+		if (ptr->block_number == block_number) {
+			return ptr;
+		}
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: elf_cache_hash_remove
+ *
+ * Description:
+ *   Remove a blockcache element from its hash bucket.
+ *
+ * Returned Value:
+ *   None
+ ****************************************************************************/
+static void elf_cache_hash_remove(block_cache_t *ptr)
+{
+	block_cache_t **prev;
+
+	for (prev = &hashtable[ptr->block_number & hash_mask]; *prev != NULL; prev = &(*prev)->hash_next) {
+		if (*prev == ptr) {
+			*prev = ptr->hash_next;
+			break;
+		}
+	}
+
+	ptr->hash_next = NULL;
+}
+
+/****************************************************************************
+ * Name: elf_cache_move_to_tail
  *
  * Description:
- *   Update blockcache list based on whether 'block_number' block in
- *   blockwise-elf binary is already cached or not. Also, maintain
- *   head, tail and most_accessed pointers.
- *   tail = most recently cached block (highest priority block for keeping
+ *   Move a blockcache element to the tail of blockcache list.
+ *   tail = most recently used block (highest priority block for keeping
  *          cached)
  *   head = oldest cached block (lowest priority for keeping it cached).
  *          If a new block needs to be cached, cache to this blockcache element.
- *   most_accessed = pointer to most accessed block in blockcache list.
- *          Needed for easy access to most accessed block from comp. binary.
  *
  * Returned Value:
- *   Index in blockcache list where 'block_number' from elf
- *   binary is cached state. Return Negative value on failure.
+ *   None
  ****************************************************************************/
-static unsigned int elf_cache_update_blockcache_list(int block_number, int filfd, uint16_t binary_header_size)
+static void elf_cache_move_to_tail(block_cache_t *ptr)
 {
-	unsigned int blockcache_index;		/* Which blockcache element has needed ELF data for read */
-	block_cache_t *ptr;					/* Pointer to element in blockcache list which will be updated */
-	block_cache_t *temp;				/* Used when updating blockcache list */
-	bool flag_for_caching;				/* 1 = Block needs to be cached, 0 = Block already cached */
-	bool update_most_accessed;			/* 1 = Most accessed block is being removed from blockcache.
-										 *     Need to update most accessed pointer from scratch */
-	int size;
-
-	binfo("filfd: %d block_number: %d\n", filfd, block_number);
-
-	/* Initialize flags */
-	flag_for_caching = true;
-	update_most_accessed = false;
-
-	/* First check is with block_number at most_accessed pointer */
-	if (most_accessed->block_number == block_number) {
-		flag_for_caching = false;
-		blockcache_index = most_accessed->index_block_cache;
-	}
-
-	/* Start checking for if block is cached from the tail */
-	if (flag_for_caching == true) {
-		ptr = tail;
-		while (ptr != NULL) {
-			if (ptr->block_number == block_number) {
-				flag_for_caching = false;
-				blockcache_index = ptr->index_block_cache;
-				break;
-			} else {
-				ptr = ptr->prev;
-			}
-		}
+	if (ptr == tail) {
+		return;
 	}
 
-	/* If block_number block from elf binary needs to be cached */
-	if (flag_for_caching == true) {
+	/* Detach ptr */
+	if (ptr == head) {
+		head = ptr->next;
+	} else {
+		ptr->prev->next = ptr->next;
+	}
+	ptr->next->prev = ptr->prev;
 
-		/* If most_accessed == head, need to update most_accessed */
-		if (head == most_accessed)
-			update_most_accessed = true;
+	/* Always attach ptr at tail */
+	tail->next = ptr;
+	ptr->prev = tail;
+	ptr->next = NULL;
+	tail = ptr;
+}
 
-		/* Detach head, Reassign head to head->next */
-		ptr = head;
-		head = ptr->next;
-		head->prev = ptr->prev;
+/****************************************************************************
+ * Name: elf_cache_fill
+ *
+ * Description:
+ *   Read 'block_number' block into the least recently used blockcache
+ *   element and make it the most recently used one.
+ *
+ * Returned Value:
+ *   Pointer to blockcache element on Success
+ *   NULL on Failure
+ ****************************************************************************/
+static block_cache_t *elf_cache_fill(int filfd, uint16_t binary_header_size, int block_number, bool prefetched)
+{
+	block_cache_t *ptr;
+
+	ptr = head;
+	if (ptr->block_number >= 0) {
+		elf_cache_hash_remove(ptr);
+		ptr->block_number = -1;
+	}
 
-		/* Read elf 'block_number' block into respective 'out_buffer' */
-		size = elf_cache_read_block(filfd, binary_header_size, ptr->out_buffer, block_number);
-		if (size < 0) {
-			berr("Read for block %d failed\n", block_number);
-			return ERROR;
+	if (elf_cache_read_blocks(filfd, binary_header_size, ptr->out_buffer, block_number, 1) < 0) {
+		berr("Read for block %d failed\n", block_number);
+		return NULL;
+	}
+
+	ptr->block_number = block_number;
+	ptr->prefetched = prefetched;
+	ptr->hash_next = hashtable[block_number & hash_mask];
+	hashtable[block_number & hash_mask] = ptr;
+
+	elf_cache_move_to_tail(ptr);
+
+	return ptr;
+}
+
+/****************************************************************************
+ * Name: elf_cache_next_block
+ *
+ * Description:
+ *   Find the block the loader is expected to read after 'block_number'.
+ *   '*extent' is the index of the section holding 'block_number' and is
+ *   updated when the next block belongs to the next section. Without
+ *   section information, blocks are expected to be read in file order.
+ *
+ * Returned Value:
+ *   Next block number, Negative value if there is none
+ ****************************************************************************/
+static int elf_cache_next_block(int block_number, int *extent)
+{
+	if (number_of_extents == 0) {
+		return (block_number + 1 < number_of_blocks) ? block_number + 1 : ERROR;
+	}
+
+	if (*extent < 0 || *extent >= number_of_extents) {
+		return ERROR;
+	}
+
+	if (block_number < extents[*extent].last_block) {
+		return block_number + 1;
+	}
+
+	if (++(*extent) < number_of_extents) {
+		return extents[*extent].first_block;
+	}
+
+	return ERROR;
+}
+
+/****************************************************************************
+ * Name: elf_cache_readahead
+ *
+ * Description:
+ *   Read up to ra_window blocks following 'block_number' into the cache.
+ *
+ * Returned Value:
+ *   None
+ ****************************************************************************/
+static void elf_cache_readahead(int filfd, uint16_t binary_header_size, int block_number)
+{
+	unsigned int count;
+	int extent;
+
+	/* Find the section being read */
+	for (extent = 0; extent < number_of_extents; extent++) {
+		if (extents[extent].first_block <= block_number && block_number <= extents[extent].last_block) {
+			break;
 		}
+	}
 
-		/* Update block_number, Number of requests */
-		ptr->block_number = block_number;
-		ptr->no_requests_for_block = 1;
+	for (count = 0; count < ra_window; count++) {
+		block_number = elf_cache_next_block(block_number, &extent);
+		if (block_number < 0) {
+			break;
+		}
 
-		/* Updating most_accessed pointer */
-		if (ptr->no_requests_for_block >= max_accessed_count) {
-			max_accessed_count = ptr->no_requests_for_block;
-			most_accessed = ptr;
+		if (elf_cache_lookup(block_number) != NULL) {
+			continue;
 		}
 
-		/* Always attach ptr at tail */
-		temp = tail;
-		temp->next = ptr;
-		ptr->prev = temp;
-		ptr->next = NULL;
-		tail = ptr;
-
-		/* Update most_accessed from scratch, if needed */
-		if (update_most_accessed == true) {
-			max_accessed_count = 0;
-			temp = tail;
-			while (temp != NULL) {
-				if (temp->no_requests_for_block > max_accessed_count) {
-					max_accessed_count = temp->no_requests_for_block;
-					most_accessed = temp;
-				}
-				temp = temp->prev;
-			}
+		if (elf_cache_fill(filfd, binary_header_size, block_number, true) == NULL) {
+			break;
 		}
 
-		/* Update blockcache_index into which block is cached */
-		blockcache_index = ptr->index_block_cache;
+		stats.prefetched++;
+	}
+}
 
-	} else { /* If block is already cached */
+/****************************************************************************
+ * Name: elf_cache_block_covered
+ *
+ * Description:
+ *   Check whether 'block_number' block is entirely inside of the request.
+ *
+ * Returned Value:
+ *   true if the whole block is requested, false otherwise
+ ****************************************************************************/
+static bool elf_cache_block_covered(int block_number, off_t offset, size_t readsize)
+{
+	off_t start = block_number * cache_blocks_size;
+	off_t end = start + cache_blocks_size;
 
-		/* If block is cached at head location */
-		if (head == &blockcache[blockcache_index]) {
-			/* Detach head, Reassign head to head->next */
-			ptr = head;
-			head = ptr->next;
-			head->prev = ptr->prev;
+	if (end > file_len) {
+		end = file_len;
+	}
 
-			ptr->no_requests_for_block += 1;
+	return start >= offset && end <= offset + readsize;
+}
 
-			/* Update most_accessed pointer */
-			if (ptr->no_requests_for_block >= max_accessed_count) {
-				max_accessed_count = ptr->no_requests_for_block;
-				most_accessed = ptr;
-			}
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
 
-			/* Always attach ptr at tail */
-			temp = tail;
-			temp->next = ptr;
-			ptr->prev = temp;
-			ptr->next = NULL;
-			tail = ptr;
-
-		} else if (tail == &blockcache[blockcache_index]) { /* Block is cached at tail location */
-			blockcache[blockcache_index].no_requests_for_block += 1;
-
-			/* Update most_accessed pointer */
-			ptr = tail;
-			if (ptr->no_requests_for_block >= max_accessed_count) {
-				max_accessed_count = ptr->no_requests_for_block;
-				most_accessed = ptr;
-			}
-		} else { /* Block is cached at some other index in blockcache list */
+/****************************************************************************
+ * Name: elf_cache_set_sections
+ *
+ * Description:
+ *   Tell the cache which parts of the file the loader will read and in
+ *   which order, using the section headers in 'loadinfo'. The loader reads
+ *   the allocated sections in index order, then the symbol, string and
+ *   relocation tables while binding.
+ *
+ * Returned Value:
+ *   None
+ ****************************************************************************/
+void elf_cache_set_sections(FAR struct elf_loadinfo_s *loadinfo)
+{
+	FAR Elf32_Shdr *shdr;
+	int pass;
+	int i;
+
+	if (extents) {
+		kmm_free(extents);
+		extents = NULL;
+	}
+	number_of_extents = 0;
+
+	if (!loadinfo->shdr || loadinfo->ehdr.e_shnum == 0) {
+		return;
+	}
 
-			/* Detach blockcache element at blockcache_index */
-			ptr = &blockcache[blockcache_index];
-			ptr->prev->next = ptr->next;
-			ptr->next->prev = ptr->prev;
+	extents = (struct elf_cache_extent_s *)kmm_malloc(loadinfo->ehdr.e_shnum * sizeof(struct elf_cache_extent_s));
+	if (!extents) {
+		/* Read ahead falls back to file order */
+		return;
+	}
+
+	for (pass = 0; pass < 2; pass++) {
+		for (i = 0; i < loadinfo->ehdr.e_shnum; i++) {
+			shdr = &loadinfo->shdr[i];
 
-			/* Update Number of requests for block */
-			ptr->no_requests_for_block += 1;
+			if (shdr->sh_size == 0 || shdr->sh_type == SHT_NOBITS || shdr->sh_offset + shdr->sh_size > file_len) {
+				continue;
+			}
+
+			if (pass == 0 && (shdr->sh_flags & SHF_ALLOC) == 0) {
+				continue;
+			}
 
-			/* Update most accessed pointer */
-			if (ptr->no_requests_for_block >= max_accessed_count) {
-				max_accessed_count = ptr->no_requests_for_block;
-				most_accessed = ptr;
+			if (pass == 1 && ((shdr->sh_flags & SHF_ALLOC) != 0 || (shdr->sh_type != SHT_SYMTAB && shdr->sh_type != SHT_STRTAB && shdr->sh_type != SHT_REL))) {
+				continue;
 			}
 
-			/* Always attach ptr at tail */
-			temp = tail;
-			temp->next = ptr;
-			ptr->prev = temp;
-			ptr->next = NULL;
-			tail = ptr;
+			extents[number_of_extents].first_block = shdr->sh_offset / cache_blocks_size;
+			extents[number_of_extents].last_block = (shdr->sh_offset + shdr->sh_size - 1) / cache_blocks_size;
+			number_of_extents++;
 		}
 	}
 
-	return blockcache_index;
+	binfo("Read ahead follows %d sections\n", number_of_extents);
 }
 
 /****************************************************************************
@@ -351,6 +486,11 @@ static unsigned int elf_cache_update_blockcache_list(int block_number, int filfd
  *   value here is offset from start of elf binary (excluding binary
  *   header).
  *
+ *   Cached blocks are copied from the cache. Blocks which are requested
+ *   entirely and not cached are read directly into 'buffer'. Other blocks
+ *   are read into the cache first. When small reads go through the file
+ *   sequentially, the following blocks are read ahead into the cache.
+ *
  * Returned Value:
  *   Number of bytes read into buffer on Success
  *   Negative value on failure
@@ -361,68 +501,118 @@ int elf_cache_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer,
 	int last_block;
 	int no_blocks;
 	int block_number;		/* Block number in an ELF file */
-	int actual_offset;		/* Offset from start of ELF file */
+	int count;			/* Number of blocks to read directly */
+	int block_start;		/* Offset of first byte to write from this block */
 	int block_size_to_write;	/* Size to write into buffer from cached block */
 	int buffer_pos;			/* Position in buffer to start writing from */
 	int blocksize;			/* Blocksize used by the binary */
-	unsigned int blockcache_index;	/* Which blockcache element has needed ELF data for read */
+	bool sequential;		/* Request continues the previous one */
+	bool from_file;			/* Some block was read from file for this request */
+	block_cache_t *ptr;
+	off_t ret;
 
 	binfo("filfd: %d readsize: %d offset: %d\n", filfd, readsize, offset);
 
+	if (offset < 0 || offset >= file_len) {
+		return offset == file_len ? 0 : ERROR;
+	}
+
+	if (offset + readsize > file_len) {
+		readsize = file_len - offset;
+	}
+
 	/* Setting first block, end block and number of blocks to read */
 	blocksize = cache_blocks_size;
 	elf_cache_blocks_to_read(&first_block, &last_block, &no_blocks, offset, readsize);
-	if (first_block < 0 || no_blocks < 0) {
+	if (first_block < 0 || no_blocks <= 0) {
 		berr("Incorrect first_block, no_blocks info\n");
-		buffer_pos = ERROR;
-		goto error_cache_read;
+		return ERROR;
 	}
 
-	block_number = first_block;
+	stats.reads++;
+	sequential = false;
+	from_file = false;
 	buffer_pos = 0;
-	/* Actual Offset in ELF file is same as Offset passed to this function */
-	actual_offset = offset;
 
 	/* Reading from first_block to last_block. Then writing to buffer. */
-	for (; block_number < first_block + no_blocks; block_number++) {
+	for (block_number = first_block; block_number <= last_block;) {
 
-		/* Update blockcache list and get data into one of the blockcache elements */
-		blockcache_index = elf_cache_update_blockcache_list(block_number, filfd, binary_header_size);
-		if (blockcache_index >= number_blocks_caching) {
-			buffer_pos = ERROR;
-			goto error_cache_read;
+		/* Position of requested data in this block */
+		block_start = offset + buffer_pos - block_number * blocksize;
+		block_size_to_write = blocksize - block_start;
+		if (block_size_to_write > readsize - buffer_pos) {
+			block_size_to_write = readsize - buffer_pos;
 		}
 
-		if (block_number == first_block) {
-			/*
-			 * Read appropriate number of bytes to buffer from this block using readsize and offset info.
-			 * If start_offset + readsize < end_offset, write from start_offset to start_offset + readsize.
-			 * Otherwise, write from start_offset to end_offset into buffer.
-			 */
-			block_size_to_write = (((block_number + 1) * blocksize - 1) > (actual_offset + readsize - 1)) ? readsize : ((block_number + 1) * blocksize - actual_offset);
-			memcpy(&buffer[buffer_pos], &blockcache[blockcache_index].out_buffer[actual_offset - (block_number * blocksize)], block_size_to_write);
-			buffer_pos += block_size_to_write;
-		} else if (block_number == last_block) {
-			/*
-			 * Read appropriate number of bytes to buffer from this block using readsize and offset info.
-			 * Calculate end_offset (Offset of last byte to write from this block).
-			 * Write from start_offset to end_offset from this block into buffer.
-			 */
-			block_size_to_write = actual_offset + readsize - (block_number * blocksize);
-			memcpy(&buffer[buffer_pos], &blockcache[blockcache_index].out_buffer[0], block_size_to_write);
-			buffer_pos += block_size_to_write;
+		ptr = elf_cache_lookup(block_number);
+		if (ptr != NULL) {
+			stats.hits++;
+			if (ptr->prefetched) {
+				stats.prefetch_hits++;
+				ptr->prefetched = false;
+				sequential = true;
+			}
+			elf_cache_move_to_tail(ptr);
+		} else if (elf_cache_block_covered(block_number, offset, readsize)) {
+			/* Read all following requested blocks which are not cached at once */
+			for (count = 1; block_number + count <= last_block; count++) {
+				if (!elf_cache_block_covered(block_number + count, offset, readsize) || elf_cache_lookup(block_number + count) != NULL) {
+					break;
+				}
+			}
+
+			ret = elf_cache_read_blocks(filfd, binary_header_size, &buffer[buffer_pos], block_number, count);
+			if (ret < 0) {
+				return ret;
+			}
+
+			stats.direct += count;
+			sequential |= (block_number == ra_last + 1);
+			from_file = true;
+			ra_last = block_number + count - 1;
+			buffer_pos += ret;
+			block_number += count;
+			continue;
 		} else {
-			/*
-			 * This is not the first or last block. This is intermediary block.
-			 * So, write entire block into buffer.
-			 */
-			block_size_to_write = blocksize;
-			memcpy(&buffer[buffer_pos], &blockcache[blockcache_index].out_buffer[0], block_size_to_write);
-			buffer_pos += block_size_to_write;
+			ptr = elf_cache_fill(filfd, binary_header_size, block_number, false);
+			if (ptr == NULL) {
+				return ERROR;
+			}
+
+			stats.misses++;
+			sequential |= (block_number == ra_last + 1);
+			from_file = true;
+			ra_last = block_number;
 		}
+
+		memcpy(&buffer[buffer_pos], &ptr->out_buffer[block_start], block_size_to_write);
+		buffer_pos += block_size_to_write;
+		block_number++;
 	}
 
-error_cache_read:
+#if CONFIG_ELF_CACHE_READAHEAD > 0
+	/*
+	 * Large reads are served directly, read ahead is for small reads which
+	 * walk through the file block after block, like symbols and relocations.
+	 */
+	if (readsize < blocksize && (from_file || sequential)) {
+		if (sequential) {
+			ra_window = ra_window ? ra_window << 1 : 1;
+			if (ra_window > CONFIG_ELF_CACHE_READAHEAD) {
+				ra_window = CONFIG_ELF_CACHE_READAHEAD;
+			}
+			if (ra_window > number_blocks_caching / 2) {
+				ra_window = number_blocks_caching / 2;
+			}
+
+			elf_cache_readahead(filfd, binary_header_size, last_block);
+		} else {
+			/* Random access, stop reading ahead until the reads become sequential */
+			ra_window = 0;
+		}
+	}
+#endif
+
 	return buffer_pos;
 }
 
@@ -430,7 +620,7 @@ error_cache_read:
  * Name: elf_cache_init
  *
  * Description:
- *   IInitialize the cache blocks
+ *   Initialize the cache blocks
  *
  * Returned value:
  *   OK (0) on Success
@@ -438,7 +628,8 @@ error_cache_read:
  ****************************************************************************/
 int elf_cache_init(int filfd, uint16_t offset, off_t filelen)
 {
-	int ret = OK;
+	unsigned int nbuckets;
+	int i;
 
 	binfo("filfd: %d offset: %u filelen: %d\n", filfd, offset, filelen);
 
@@ -464,18 +655,26 @@ int elf_cache_init(int filfd, uint16_t offset, off_t filelen)
 		number_blocks_caching = 2;
 	}
 
-	/* Initialize max_accesed_count to 0 */
-	max_accessed_count = 0;
+	extents = NULL;
+	number_of_extents = 0;
+	ra_window = 0;
+	ra_last = -2;
+	memset(&stats, 0, sizeof(stats));
+
+	/* Hash table with a power of two number of buckets */
+	for (nbuckets = 1; nbuckets < number_blocks_caching; nbuckets <<= 1);
+	hash_mask = nbuckets - 1;
 
-	blockcache = (block_cache_t *)kmm_malloc(number_blocks_caching * sizeof(block_cache_t));
-	if (!blockcache) {
-		berr("Failed kmm_malloc for blockcache\n");
+	hashtable = (block_cache_t **)kmm_zalloc(nbuckets * sizeof(block_cache_t *));
+	blockcache = (block_cache_t *)kmm_zalloc(number_blocks_caching * sizeof(block_cache_t));
+	if (!hashtable || !blockcache) {
+		berr("Failed kmm_zalloc for blockcache\n");
 		elf_cache_uninit();
 		return -ENOMEM;
 	}
 
 	/* Initialize blockcache list */
-	for (int i = 0; i < number_blocks_caching; i++) {
+	for (i = 0; i < number_blocks_caching; i++) {
 		blockcache[i].out_buffer = (unsigned char *)kmm_malloc(cache_blocks_size);
 
 		if (!blockcache[i].out_buffer) {
@@ -485,21 +684,16 @@ int elf_cache_init(int filfd, uint16_t offset, off_t filelen)
 		}
 
 		blockcache[i].block_number = -1;
-		blockcache[i].no_requests_for_block = 0;
 		blockcache[i].index_block_cache = i;
-		blockcache[i].next = &blockcache[(i + 1) % number_blocks_caching];
-		blockcache[i].prev = &blockcache[(i - 1) % number_blocks_caching];
+		blockcache[i].next = (i + 1 < number_blocks_caching) ? &blockcache[i + 1] : NULL;
+		blockcache[i].prev = (i > 0) ? &blockcache[i - 1] : NULL;
 	}
 
-	/* Assign head, tail and most_accessed pointers */
+	/* Assign head and tail pointers */
 	head = &blockcache[0];
 	tail = &blockcache[number_blocks_caching - 1];
-	most_accessed = tail;
 
-	head->prev = NULL;
-	tail->next = NULL;
-
-	return ret;
+	return OK;
 }
 
 /****************************************************************************
@@ -513,15 +707,31 @@ int elf_cache_init(int filfd, uint16_t offset, off_t filelen)
  ****************************************************************************/
 void elf_cache_uninit(void)
 {
-	for (int i = 0; i < number_blocks_caching; i++) {
-		if (blockcache[i].out_buffer) {
-			kmm_free(blockcache[i].out_buffer);
-			blockcache[i].out_buffer = NULL;
-		}
-	}
+	int i;
+
+	binfo("reads: %u hits: %u misses: %u prefetched: %u prefetch hits: %u direct: %u\n",
+		  stats.reads, stats.hits, stats.misses, stats.prefetched, stats.prefetch_hits, stats.direct);
 
 	if (blockcache) {
+		for (i = 0; i < number_blocks_caching; i++) {
+			if (blockcache[i].out_buffer) {
+				kmm_free(blockcache[i].out_buffer);
+				blockcache[i].out_buffer = NULL;
+			}
+		}
+
 		kmm_free(blockcache);
 		blockcache = NULL;
 	}
+
+	if (hashtable) {
+		kmm_free(hashtable);
+		hashtable = NULL;
+	}
+
+	if (extents) {
+		kmm_free(extents);
+		extents = NULL;
+	}
+	number_of_extents = 0;
 }
@@ -288,6 +288,12 @@ int elf_load(FAR struct elf_loadinfo_s *loadinfo)
 		goto errout_with_buffers;
 	}
 
+#ifdef CONFIG_ELF_CACHE_READ
+	/* Let the cache know which sections are going to be read */
+
+	elf_cache_set_sections(loadinfo);
+#endif
+
 	/* Determine total size to allocate */
 
 	elf_elfsize(loadinfo);
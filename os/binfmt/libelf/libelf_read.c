@@ -66,6 +66,8 @@
 #include <tinyara/fs/fs.h>
 #include <tinyara/binfmt/elf.h>
 
+#include "libelf.h"
+
 #ifdef CONFIG_COMPRESSED_BINARY
 #include <tinyara/binfmt/compression/compress_read.h>
 #endif
@@ -128,7 +130,7 @@ static inline void elf_dumpreaddata(FAR char *buffer, int buflen)
 int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer, size_t readsize, off_t offset)
 {
 	ssize_t nbytes;				/* Number of bytes read */
-#if !defined(CONFIG_COMPRESSED_BINARY)
+#if !defined(CONFIG_COMPRESSED_BINARY) && !defined(CONFIG_ELF_CACHE_READ)
 	off_t rpos;					/* Position returned by lseek */
 #endif
 
@@ -139,11 +141,9 @@ int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer, size_t re
 
 	while (readsize > 0) {
 #if defined(CONFIG_ELF_CACHE_READ)
-		/* Cache only if readsize request <= cache block size */
-		if (readsize <= CONFIG_ELF_CACHE_BLOCK_SIZE) {
-			nbytes = elf_cache_read(loadinfo->filfd, loadinfo->offset, buffer, readsize, offset - loadinfo->offset);
-		} else
-#endif
+		/* The cache copies cached blocks and reads the others directly */
+		nbytes = elf_cache_read(loadinfo->filfd, loadinfo->offset, buffer, readsize, offset - loadinfo->offset);
+#else
 		{
 #ifdef CONFIG_COMPRESSED_BINARY
 			nbytes = compress_read(loadinfo->filfd, loadinfo->offset, buffer, readsize, offset - loadinfo->offset);
@@ -161,6 +161,7 @@ int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer, size_t re
 			nbytes = read(loadinfo->filfd, buffer, readsize);
 #endif
 		}
+#endif
 
 		if (nbytes < 0) {
 			/* EINTR just means that we received a signal */
@@ -74,6 +74,7 @@
 #include <crc32.h>
 #ifndef NXFUSE_HOST_BUILD
 #include <tinyara/irq.h>
+#include <tinyara/clock.h>
 #endif
 #include <tinyara/math.h>
 #include <tinyara/kmalloc.h>
@@ -82,6 +83,10 @@
 #include <tinyara/fs/mtd.h>
 #include <tinyara/fs/smart_procfs.h>
 #include <tinyara/fs/smart.h>
+#ifdef CONFIG_MTD_SMART_BGGC
+#include <semaphore.h>
+#include <tinyara/wqueue.h>
+#endif
 
 /****************************************************************************
  * Private Definitions
@@ -102,6 +107,8 @@
 #define SMART_FORMAT_DISABLE      0xff
 #define SMART_FORMAT_ENABLE       0x01
 
+#define SMART_CHECKPOINT_ENABLE   0x43	/* 'C', neither erased state */
+
 #ifdef CONFIG_MTD_SMART_JOURNALING
 #define SMART_FMT_JOURNAL         SMART_JOURNAL_ENABLE
 #else
@@ -143,6 +150,7 @@
 #define SMART_FMT_NAMESIZE_POS    (SMART_FMT_POS1 + 6)
 #define SMART_FMT_ROOTDIRS_POS    (SMART_FMT_POS1 + 7)
 #define SMART_FMT_FORMAT_POS      (SMART_FMT_POS1 + 8)
+#define SMART_FMT_CHECKPOINT_POS  (SMART_FMT_POS1 + 9)
 
 #define SMARTFS_FMT_WEAR_POS      36
 #define SMART_WEAR_LEVEL_FORMAT_SIG 32
@@ -199,6 +207,37 @@
 
 #define SET_TO_TRUE(v, n) v[n/8] |= (1<<(7-(n%8)))
 #define GET_VAL(v, n) (v[n/8] & 1<<(7-(n%8)))
+
+/* Set the free and released sector counts of an erase block once the counts
+ * are valid, i.e. after the scan or the low-level format.
+ */
+
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+#if defined(CONFIG_MTD_SMART_MINIMIZE_RAM) || defined(CONFIG_MTD_SMART_PACK_COUNTS)
+#error "CONFIG_MTD_SMART_BLOCK_INDEX requires unpacked sector counts"
+#endif
+#define SMART_INDEX_NBUCKETS      256
+#define SMART_INDEX_NONE          0xFFFF
+#define SMART_INDEX_SIZE(n)       ((4 * SMART_INDEX_NBUCKETS + 4 * (uint32_t)(n)) * sizeof(uint16_t))
+#define SMART_SET_FREECOUNT(d, b, c)    smart_index_set(&(d)->freeindex, (d)->freecount, b, c)
+#define SMART_SET_RELEASECOUNT(d, b, c) smart_index_set(&(d)->releaseindex, (d)->releasecount, b, c)
+#else
+#define SMART_SET_FREECOUNT(d, b, c)    ((d)->freecount[(b)] = (c))
+#define SMART_SET_RELEASECOUNT(d, b, c) ((d)->releasecount[(b)] = (c))
+#endif
+
+/* The background garbage collection worker runs after the device has been
+ * idle for a while, and keeps the free sectors of a few erase blocks above
+ * the reserve of the foreground garbage collection.
+ */
+
+#ifdef CONFIG_MTD_SMART_BGGC
+#if defined(CONFIG_MTD_SMART_MINIMIZE_RAM) || defined(CONFIG_MTD_SMART_PACK_COUNTS)
+#error "CONFIG_MTD_SMART_BGGC requires unpacked sector counts"
+#endif
+#define SMART_BGGC_IDLE_TICKS     MSEC2TICK(CONFIG_MTD_SMART_BGGC_IDLE_MS)
+#define SMART_BGGC_TARGET(d)      (CONFIG_MTD_SMART_BGGC_ERASED_BLOCKS * (d)->availSectPerBlk + (d)->sectorsPerBlk + 4)
+#endif
 /* Bit mapping for wear level bits */
 /* These are defined to allow updating the wear leveling with the minimum
  * number of sector relocations / maximum use of 1 --> 0 transitions when
@@ -262,6 +301,23 @@ struct smart_allocsector_s {
 };
 #endif
 
+/* With CONFIG_MTD_SMART_BLOCK_INDEX, the erase blocks are kept in buckets
+ * indexed by their free (or released) sector count, so that the block with
+ * the most free (or released) sectors is found without a scan of all the
+ * counts.  Each bucket is a list in the order the blocks entered it, which
+ * spreads the allocations over the blocks with the same count.
+ */
+
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+struct smart_index_s {
+	FAR uint16_t *head;			/* First block of each bucket */
+	FAR uint16_t *tail;			/* Last block of each bucket */
+	FAR uint16_t *next;			/* Next block in the bucket, per block */
+	FAR uint16_t *prev;			/* Previous block in the bucket, per block */
+	uint32_t map[SMART_INDEX_NBUCKETS / 32];	/* Bitmap of non-empty buckets */
+};
+#endif
+
 struct smart_struct_s {
 	FAR struct mtd_dev_s *mtd;	/* Contained MTD interface */
 	struct mtd_geometry_s geo;	/* Device geometry */
@@ -320,6 +376,30 @@ struct smart_struct_s {
 	size_t bytesalloc;
 	struct smart_alloc_s alloc[SMART_MAX_ALLOCS];	/* Array of memory allocations */
 #endif
+#ifdef CONFIG_MTD_SMART_BGGC
+	sem_t exclsem;				/* Serializes requests and the worker */
+	struct work_s gcwork;			/* Background garbage collection */
+	clock_t lastio;				/* Time of the last request */
+	uint8_t fgwaiters;			/* Requests waiting for exclsem */
+	bool gcerase;				/* Released blocks wait for the erase */
+	bool gcstop;				/* Device is closed, do not queue the worker */
+#endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	struct smart_index_s freeindex;		/* Blocks by free sector count */
+	struct smart_index_s releaseindex;	/* Blocks by released sector count */
+#endif
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	uint16_t cpblocks;			/* Number of erase blocks of a checkpoint slot */
+	uint16_t cplogcount;			/* Number of entries in the dirty block log */
+	uint32_t cplogoffset;			/* Offset of the dirty block log in a slot */
+	uint32_t cpdataoffset;			/* Offset of the sector map in a slot */
+	uint32_t cpseq;				/* Sequence number of the latest checkpoint */
+	uint8_t cpslot;				/* Slot of the latest checkpoint */
+	bool cpvalid;				/* The latest checkpoint can be loaded */
+	bool cpformat;				/* The format sector reserves the slots */
+	bool cpdisabled;			/* Volume was formatted without the slots */
+	FAR uint8_t *cpdirty;			/* Bitmap of blocks written since the checkpoint */
+#endif
 #ifdef CONFIG_MTD_SMART_JOURNALING
 	size_t journal_seq;			/* Current Sequence of Journal */
 	uint16_t njournalPerBlk;		/* Total Number of Journal entries per Erase block */
@@ -447,6 +527,61 @@ struct smart_journal_entry_s {
 typedef struct smart_journal_entry_s journal_log_t;
 #endif
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#error "CONFIG_MTD_SMART_CHECKPOINT requires the full logical sector map"
+#endif
+#ifndef CONFIG_MTD_SMART_BGGC
+#error "CONFIG_MTD_SMART_CHECKPOINT requires CONFIG_MTD_SMART_BGGC"
+#endif
+
+/* A checkpoint of the logical sector map and the free and released sector
+ * counts lets the mount skip the scan of all sector headers.  Two slots are
+ * reserved at the end of the device and used alternately.  A slot holds the
+ * header, the log of erase blocks written after the checkpoint was taken and
+ * a copy of the sector map and the counts.  When the log is getting full,
+ * the background worker takes a new checkpoint once the device is idle.
+ */
+
+#define SMART_CP_MAGIC              0x50434d53	/* "SMCP" */
+#define SMART_CP_VERSION            1
+#define SMART_CP_NSLOTS             2
+#define SMART_CP_LOG_ENTRIES        CONFIG_MTD_SMART_CHECKPOINT_LOG_ENTRIES
+#define SMART_CP_LOG_THRESHOLD      (SMART_CP_LOG_ENTRIES * 3 / 4)
+#define SMART_CP_OBSOLETE           ((uint8_t)~CONFIG_SMARTFS_ERASEDSTATE)
+
+#if CONFIG_SMARTFS_ERASEDSTATE == 0xFF
+#define SMART_CP_LOG_ERASED         0xFFFF
+#else
+#define SMART_CP_LOG_ERASED         0x0000
+#endif
+
+/* The sector map, releasecount and freecount arrays are contiguous. */
+
+#define SMART_CP_DATASIZE(d)        ((uint32_t)(d)->totalsectors * sizeof(uint16_t) + ((uint32_t)(d)->neraseblocks << 1))
+
+struct smart_checkpoint_s {
+	uint32_t magic;				/* SMART_CP_MAGIC */
+	uint32_t seq;				/* Incremented for each checkpoint */
+	uint32_t size;				/* Size of the sector map and counts */
+	uint32_t crc;				/* CRC-32 of the sector map and counts */
+	uint16_t totalsectors;			/* Geometry the checkpoint was taken with */
+	uint16_t neraseblocks;
+	uint16_t sectorsize;
+	uint16_t freesectors;			/* Total number of free sectors */
+	uint16_t releasesectors;		/* Total number of released sectors */
+	uint8_t version;			/* SMART_CP_VERSION */
+	uint8_t obsolete;			/* Programmed when a newer checkpoint is taken */
+	uint32_t hdrcrc;			/* CRC-32 of the fields above 'obsolete' */
+};
+
+/* Must be called before an erase block is written or erased. */
+
+#define SMART_CHECKPOINT_DIRTY(d, b) smart_checkpoint_dirty(d, b)
+#else
+#define SMART_CHECKPOINT_DIRTY(d, b)
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -460,6 +595,10 @@ static ssize_t smart_write(FAR struct inode *inode, const unsigned char *buffer,
 #endif
 static int smart_geometry(FAR struct inode *inode, struct geometry *geometry);
 static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg);
+#if defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE)
+static void smart_bggc_lock(FAR struct smart_struct_s *dev);
+static void smart_bggc_unlock(FAR struct smart_struct_s *dev);
+#endif
 
 static uint16_t smart_findfreephyssector(FAR struct smart_struct_s *dev, uint8_t canrelocate);
 
@@ -474,7 +613,11 @@ static int smart_allocsector(FAR struct smart_struct_s *dev, unsigned long reque
 static int smart_read_wearstatus(FAR struct smart_struct_s *dev);
 static int smart_relocate_static_data(FAR struct smart_struct_s *dev, uint16_t block);
 #endif
-static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t block, uint8_t forceerase);
+static int smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t block, uint8_t forceerase);
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+static void smart_checkpoint_dirty(FAR struct smart_struct_s *dev, uint16_t block);
+static void smart_checkpoint_update(FAR struct smart_struct_s *dev, bool force);
+#endif
 static int smart_relocate_sector(FAR struct smart_struct_s *dev, uint16_t oldsector, uint16_t newsector);
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 static int smart_validate_crc(FAR struct smart_struct_s *dev);
@@ -646,7 +789,23 @@ static void smart_free(FAR struct smart_struct_s *dev, FAR void *ptr)
 
 static int smart_open(FAR struct inode *inode)
 {
+#if defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE)
+	FAR struct smart_struct_s *dev;
+#endif
+
 	fvdbg("Entry\n");
+
+#if defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE)
+	/* Let requests schedule the background worker again. */
+
+	DEBUGASSERT(inode && inode->i_private);
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+	dev = ((FAR struct smart_multiroot_device_s *)inode->i_private)->dev;
+#else
+	dev = (FAR struct smart_struct_s *)inode->i_private;
+#endif
+	dev->gcstop = false;
+#endif
 	return OK;
 }
 
@@ -659,7 +818,46 @@ static int smart_open(FAR struct inode *inode)
 
 static int smart_close(FAR struct inode *inode)
 {
+#if defined(CONFIG_MTD_SMART_CHECKPOINT) || (defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE))
+	FAR struct smart_struct_s *dev;
+#endif
+#if defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE)
+	irqstate_t flags;
+#endif
+
 	fvdbg("Entry\n");
+
+#if defined(CONFIG_MTD_SMART_CHECKPOINT) || (defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE))
+	DEBUGASSERT(inode && inode->i_private);
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+	dev = ((FAR struct smart_multiroot_device_s *)inode->i_private)->dev;
+#else
+	dev = (FAR struct smart_struct_s *)inode->i_private;
+#endif
+#endif
+
+#if defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE)
+	/* Wait for the block the background worker works on, then stop it.  A
+	 * worker that found the device busy does not queue itself again once
+	 * gcstop is set.
+	 */
+
+	smart_bggc_lock(dev);
+	flags = enter_critical_section();
+	dev->gcstop = true;
+	leave_critical_section(flags);
+	work_cancel(LPWORK, &dev->gcwork);
+#endif
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	/* Take a checkpoint so that the next mount does not rescan any block. */
+
+	smart_checkpoint_update(dev, true);
+#endif
+
+#if defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE)
+	sem_post(&dev->exclsem);
+#endif
 	return OK;
 }
 
@@ -756,6 +954,94 @@ static void smart_add_count(struct smart_struct_s *dev, uint8_t *pCount, uint16_
 }
 #endif
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+/****************************************************************************
+ * Name: smart_index_link
+ *
+ * Description: Append an erase block to the bucket of the given count.
+ *
+ ****************************************************************************/
+
+static void smart_index_link(FAR struct smart_index_s *index, uint16_t block, uint8_t count)
+{
+	index->next[block] = SMART_INDEX_NONE;
+	index->prev[block] = index->tail[count];
+	if (index->tail[count] == SMART_INDEX_NONE) {
+		index->head[count] = block;
+		index->map[count >> 5] |= (uint32_t)1 << (count & 31);
+	} else {
+		index->next[index->tail[count]] = block;
+	}
+	index->tail[count] = block;
+}
+
+/****************************************************************************
+ * Name: smart_index_unlink
+ *
+ * Description: Remove an erase block from the bucket of the given count.
+ *
+ ****************************************************************************/
+
+static void smart_index_unlink(FAR struct smart_index_s *index, uint16_t block, uint8_t count)
+{
+	if (index->prev[block] == SMART_INDEX_NONE) {
+		index->head[count] = index->next[block];
+	} else {
+		index->next[index->prev[block]] = index->next[block];
+	}
+
+	if (index->next[block] == SMART_INDEX_NONE) {
+		index->tail[count] = index->prev[block];
+	} else {
+		index->prev[index->next[block]] = index->prev[block];
+	}
+
+	if (index->head[count] == SMART_INDEX_NONE) {
+		index->map[count >> 5] &= ~((uint32_t)1 << (count & 31));
+	}
+}
+
+/****************************************************************************
+ * Name: smart_index_set
+ *
+ * Description: Set the count of an erase block and move the block to the
+ *              bucket of the new count.
+ *
+ ****************************************************************************/
+
+static void smart_index_set(FAR struct smart_index_s *index, FAR uint8_t *counts, uint16_t block, uint8_t count)
+{
+	if (counts[block] != count) {
+		smart_index_unlink(index, block, counts[block]);
+		counts[block] = count;
+		smart_index_link(index, block, count);
+	}
+}
+
+/****************************************************************************
+ * Name: smart_index_build
+ *
+ * Description: Rebuild both indexes from the free and released sector
+ *              counts, after they were set by the scan or the format.
+ *
+ ****************************************************************************/
+
+static void smart_index_build(FAR struct smart_struct_s *dev)
+{
+	uint16_t block;
+
+	memset(dev->freeindex.head, 0xFF, SMART_INDEX_NBUCKETS * 2 * sizeof(uint16_t));
+	memset(dev->freeindex.map, 0, sizeof(dev->freeindex.map));
+	memset(dev->releaseindex.head, 0xFF, SMART_INDEX_NBUCKETS * 2 * sizeof(uint16_t));
+	memset(dev->releaseindex.map, 0, sizeof(dev->releaseindex.map));
+
+	for (block = 0; block < dev->neraseblocks; block++) {
+		smart_index_link(&dev->freeindex, block, dev->freecount[block]);
+		smart_index_link(&dev->releaseindex, block, dev->releasecount[block]);
+	}
+}
+#endif							/* CONFIG_MTD_SMART_BLOCK_INDEX */
+
 /****************************************************************************
  * Name: smart_checkfree
  *
@@ -894,6 +1180,9 @@ static ssize_t smart_reload(struct smart_struct_s *dev, FAR uint8_t *buffer, off
 static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer, size_t start_sector, unsigned int nsectors)
 {
 	struct smart_struct_s *dev;
+#if defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE)
+	ssize_t ret;
+#endif
 
 	fvdbg("SMART: sector: %d nsectors: %d\n", start_sector, nsectors);
 
@@ -903,7 +1192,17 @@ static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer, size_t
 #else
 	dev = (struct smart_struct_s *)inode->i_private;
 #endif
+#if defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE)
+	/* The background worker may be relocating the sectors. */
+
+	smart_bggc_lock(dev);
+	ret = smart_reload(dev, buffer, start_sector, nsectors);
+	smart_bggc_unlock(dev);
+
+	return ret;
+#else
 	return smart_reload(dev, buffer, start_sector, nsectors);
+#endif
 }
 
 /****************************************************************************
@@ -938,7 +1237,11 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 	dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
-	/* I think maybe we need to lock on a mutex here. */
+#if defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE)
+	/* Keep the background worker off the device during the write. */
+
+	smart_bggc_lock(dev);
+#endif
 
 	/* Get the aligned block. Here it is assumed that:
 	 *  (1) The number of R/W blocks per erase block is a power of 2, and
@@ -965,6 +1268,8 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 	/* Loop for all blocks to be written. */
 
 	while (remaining > 0) {
+		SMART_CHECKPOINT_DIRTY(dev, nextblock / mtdBlksPerErase);
+
 		/* If this is an aligned block, then erase the block. */
 
 		if (alignedblock == nextblock) {
@@ -975,10 +1280,7 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 			ret = MTD_ERASE(dev->mtd, eraseblock, 1);
 			if (ret < 0) {
 				fdbg("Erase block=%d failed: %d\n", eraseblock, ret);
-
-				/* Unlock the mutex if we add one. */
-
-				return ret;
+				goto errout;
 			}
 		}
 
@@ -1001,10 +1303,8 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 			/* The block is not empty!!  What to do? */
 
 			fdbg("Write block %d failed: %d.\n", nextblock, nxfrd);
-
-			/* Unlock the mutex if we add one. */
-
-			return -EIO;
+			ret = -EIO;
+			goto errout;
 		}
 
 		/* Then update for amount written. */
@@ -1015,7 +1315,13 @@ static ssize_t smart_write(FAR struct inode *inode, FAR const unsigned char *buf
 		alignedblock += mtdBlksPerErase;
 	}
 
-	return nsectors;
+	ret = nsectors;
+
+errout:
+#if defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE)
+	smart_bggc_unlock(dev);
+#endif
+	return ret;
 }
 #endif							/* CONFIG_FS_WRITABLE */
 
@@ -1154,6 +1460,32 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 
 #endif
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	/* Reserve two checkpoint slots at the end of the device.  A slot holds
+	 * the header, the dirty block log and the sector map with the counts,
+	 * each starting on an MTD block.  The header and the log are handled in
+	 * rwbuffer, so they must fit in a sector.
+	 */
+
+	dev->cpblocks = 0;
+	if (dev->erasesize != 0 && !dev->cpdisabled) {
+		uint32_t blocksize = dev->geo.blocksize;
+		uint32_t cpsize;
+
+		dev->cplogoffset = (sizeof(struct smart_checkpoint_s) + blocksize - 1) / blocksize * blocksize;
+		dev->cpdataoffset = dev->cplogoffset + (SMART_CP_LOG_ENTRIES * 2 + blocksize - 1) / blocksize * blocksize;
+		cpsize = dev->cpdataoffset + (uint32_t)dev->neraseblocks * dev->sectorsPerBlk * sizeof(uint16_t) + ((uint32_t)dev->neraseblocks << 1);
+		dev->cpblocks = (cpsize + dev->erasesize - 1) / dev->erasesize;
+
+		if (dev->cplogoffset > dev->sectorsize || SMART_CP_LOG_ENTRIES * 2 > dev->sectorsize ||
+				dev->cpblocks * SMART_CP_NSLOTS >= dev->neraseblocks / 2) {
+			dev->cpblocks = 0;
+		} else {
+			dev->neraseblocks -= dev->cpblocks * SMART_CP_NSLOTS;
+		}
+	}
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
 	dev->unusedsectors = 0;
 	dev->blockerases = 0;
@@ -1166,6 +1498,12 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 		smart_free(dev, dev->sMap);
 		dev->sMap = NULL;
 	}
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	if (dev->freeindex.head != NULL) {
+		smart_free(dev, dev->freeindex.head);
+		dev->freeindex.head = NULL;
+	}
+#endif
 #else
 	if (dev->sBitMap != NULL) {
 		smart_free(dev, dev->sBitMap);
@@ -1222,6 +1560,11 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 	allocsize = dev->neraseblocks << 1;
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	/* The dirty block bitmap of the checkpoint follows the counts. */
+
+	allocsize += (dev->neraseblocks + 7) >> 3;
+#endif
 	dev->sMap = (FAR uint16_t *)smart_malloc(dev, totalsectors * sizeof(uint16_t) + allocsize, "Sector map");
 	if (!dev->sMap) {
 		fdbg("Error allocating SMART virtual map buffer\n");
@@ -1230,6 +1573,31 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 
 	dev->releasecount = (FAR uint8_t *)dev->sMap + (totalsectors * sizeof(uint16_t));
 	dev->freecount = dev->releasecount + dev->neraseblocks;
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	dev->cpdirty = dev->freecount + dev->neraseblocks;
+	memset(dev->cpdirty, 0, (dev->neraseblocks + 7) >> 3);
+	dev->cpvalid = false;
+#endif
+
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	/* Allocate the buckets and the block links of both indexes in one buffer.
+	 * The head and tail arrays of an index are contiguous.
+	 */
+
+	dev->freeindex.head = (FAR uint16_t *)smart_malloc(dev, SMART_INDEX_SIZE(dev->neraseblocks), "Block index");
+	if (!dev->freeindex.head) {
+		fdbg("Error allocating SMART block index\n");
+		goto errexit;
+	}
+
+	dev->freeindex.tail = dev->freeindex.head + SMART_INDEX_NBUCKETS;
+	dev->releaseindex.head = dev->freeindex.tail + SMART_INDEX_NBUCKETS;
+	dev->releaseindex.tail = dev->releaseindex.head + SMART_INDEX_NBUCKETS;
+	dev->freeindex.next = dev->releaseindex.tail + SMART_INDEX_NBUCKETS;
+	dev->freeindex.prev = dev->freeindex.next + dev->neraseblocks;
+	dev->releaseindex.next = dev->freeindex.prev + dev->neraseblocks;
+	dev->releaseindex.prev = dev->releaseindex.next + dev->neraseblocks;
+#endif
 #else
 	dev->sBitMap = (FAR uint8_t *)smart_malloc(dev, (totalsectors + 7) >> 3, "Sector Bitmap");
 	if (dev->sBitMap == NULL) {
@@ -1335,6 +1703,11 @@ errexit:
 	if (dev->sMap) {
 		smart_free(dev, dev->sMap);
 	}
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	if (dev->freeindex.head) {
+		smart_free(dev, dev->freeindex.head);
+	}
+#endif
 #else
 	if (dev->sBitMap) {
 		smart_free(dev, dev->sBitMap);
@@ -1410,6 +1783,8 @@ static int smart_byte_to_block_write(FAR struct smart_struct_s *dev, size_t offs
 static ssize_t smart_bytewrite(FAR struct smart_struct_s *dev, size_t offset, int nbytes, FAR const uint8_t *buffer)
 {
 	ssize_t ret;
+
+	SMART_CHECKPOINT_DIRTY(dev, offset / dev->erasesize);
 #ifdef CONFIG_MTD_BYTE_WRITE
 	/* Check if the underlying MTD device supports write. */
 
@@ -1833,430 +2208,942 @@ static int smart_set_wear_level(FAR struct smart_struct_s *dev, uint16_t block,
 #endif
 
 /****************************************************************************
- * Name: smart_scan
+ * Name: smart_scan_format
  *
- * Description: Perform a scan of the MTD device to search for format
- *              information and fill in logical sector mapping, freesector
- *              count, etc.
+ * Description: Validate the format signature of a physical sector claiming
+ *              to be logical sector zero and read the format information.
+ *              Returns 1 if it is a valid format sector, 0 if not, or a
+ *              negated errno value on failure.
  *
  ****************************************************************************/
 
-static int smart_scan(FAR struct smart_struct_s *dev)
+static int smart_scan_format(FAR struct smart_struct_s *dev, uint32_t readaddress)
 {
-	int sector;
-	int ret = OK;
-	uint16_t totalsectors;
-	uint16_t prerelease;
-	uint16_t logicalsector;
-	uint16_t loser;
-	uint16_t winner;
-	uint32_t readaddress;
-	uint32_t offset;
-	uint16_t seq1;
-	uint16_t seq2;
-	uint16_t seqwrap;
-	struct smart_sect_header_s header;
-	bool status_released, status_committed;
-#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
-	int dupsector;
-	uint16_t duplogsector;
-#endif
+	int ret;
 #ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
 	int x;
 	char devname[22];
 	FAR struct smart_multiroot_device_s *rootdirdev;
 #endif
 
-	// ToDo: Revert to the flexible logic that searches sectors and
-	//       reads sector sizes stored in the sectors instead of
-	//		 using CONFIG_MTD_SMART_SECTOR_SIZE.
-	ret = smart_setsectorsize(dev, CONFIG_MTD_SMART_SECTOR_SIZE);
-	if (ret != OK) {
-		goto err_out;
-	}
-
-	/* Initialize the device variables. */
-
-	totalsectors = dev->totalsectors;
-
-	dev->formatstatus = SMART_FMT_STAT_NOFMT;
-	dev->freesectors = dev->availSectPerBlk * dev->neraseblocks;
-	dev->releasesectors = 0;
+	/* Read the sector data. */
 
-	/* Initialize the freecount and releasecount arrays. */
+	ret = MTD_READ(dev->mtd, readaddress, 32, (FAR uint8_t *)dev->rwbuffer);
+	if (ret != 32) {
+		fdbg("Error reading format sector at 0x%08x.\n", readaddress);
+		return ret < 0 ? ret : -EIO;
+	}
 
-	for (sector = 0; sector < dev->neraseblocks; sector++) {
-		if (sector == dev->neraseblocks - 1 && dev->totalsectors == 65534) {
-			prerelease = 2;
-		} else {
-			prerelease = 0;
-		}
+	/* Validate the format signature */
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-		smart_set_count(dev, dev->freecount, sector, dev->availSectPerBlk - prerelease);
-		smart_set_count(dev, dev->releasecount, sector, prerelease);
-#else
-		dev->freecount[sector] = dev->availSectPerBlk - prerelease;
-		dev->releasecount[sector] = prerelease;
-#endif
+	if (dev->rwbuffer[SMART_FMT_POS1] != SMART_FMT_SIG1 ||
+			dev->rwbuffer[SMART_FMT_POS2] != SMART_FMT_SIG2 ||
+			dev->rwbuffer[SMART_FMT_POS3] != SMART_FMT_SIG3 ||
+			dev->rwbuffer[SMART_FMT_POS4] != SMART_FMT_SIG4) {
+		/* Invalid signature on a sector claiming to be sector 0!
+		 * What should we do?  Release it?
+		 */
+		fdbg("INVALID SIGNATURE!! %c %c %c %c\n", dev->rwbuffer[SMART_FMT_POS1], dev->rwbuffer[SMART_FMT_POS2],
+				dev->rwbuffer[SMART_FMT_POS3], dev->rwbuffer[SMART_FMT_POS4]);
+		return 0;
 	}
 
-	/* Initialize the sector map. */
-
-#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-	for (sector = 0; sector < totalsectors; sector++) {
-		dev->sMap[sector] = -1;
+	/* Validate journal format */
+	if (dev->rwbuffer[SMART_FMT_JOURNAL_POS] != SMART_FMT_JOURNAL) {
+		return 0;
+	}
+	if (dev->rwbuffer[SMART_FMT_FORMAT_POS] == SMART_FORMAT_ENABLE) {
+		dev->formatstatus = SMART_FMT_STAT_NOFMT;
+		fdbg("format requested, Flash will be erased!!\n");
+		return 0;
 	}
-#else
-	/* Clear all logical sector used bits. */
 
-	memset(dev->sBitMap, 0, (dev->totalsectors + 7) >> 3);
+	/* Mark the volume as formatted and set the sector size */
+	fdbg("Formatted, continue scanning!!\n");
+	dev->formatstatus = SMART_FMT_STAT_FORMATTED;
+	dev->namesize = dev->rwbuffer[SMART_FMT_NAMESIZE_POS];
+	dev->formatversion = dev->rwbuffer[SMART_FMT_VERSION_POS];
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	dev->cpformat = (dev->rwbuffer[SMART_FMT_CHECKPOINT_POS] == SMART_CHECKPOINT_ENABLE);
 #endif
 
-	/* Now scan the MTD device. */
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+	dev->rootdirentries = dev->rwbuffer[SMART_FMT_ROOTDIRS_POS];
 
-	for (sector = 0; sector < totalsectors; sector++) {
-		winner = sector;
-		fvdbg("Scan sector %d\n", sector);
+	/* If rootdirentries is greater than 1, then we need to register
+	 * additional block devices.
+	 */
 
-		/* Calculate the read address for this sector. */
+	for (x = 1; x < dev->rootdirentries; x++) {
+		if (dev->partname[0] != '\0') {
+			snprintf(dev->rwbuffer, sizeof(devname), "/dev/smart%d%sd%d", dev->minor, dev->partname, x + 1);
+		} else {
+			snprintf(devname, sizeof(devname), "/dev/smart%dd%d", dev->minor, x + 1);
+		}
 
-		readaddress = sector * dev->mtdBlksPerSector * dev->geo.blocksize;
+		/* Inode private data is a reference to a struct containing
+		 * the SMART device structure and the root directory number.
+		 */
 
-		/* Read the header for this sector. */
-		ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (uint8_t *)dev->rwbuffer);
-		if (ret != sizeof(struct smart_sect_header_s)) {
-			fdbg("Error reading physical sector %d.\n", sector);
-			goto err_out;
+		rootdirdev = (struct smart_multiroot_device_s *)smart_malloc(dev, sizeof(*rootdirdev), "Root Dir");
+		if (rootdirdev == NULL) {
+			fdbg("Memory alloc failed\n");
+			return -ENOMEM;
 		}
-		/* copy header data only, will be used below */
-		memcpy(&header, dev->rwbuffer, sizeof(struct smart_sect_header_s));
 
-		/* Get the logical sector number for this physical sector. */
-		logicalsector = UINT8TOUINT16(header.logicalsector);
-#if CONFIG_SMARTFS_ERASEDSTATE == 0x00
-		if (logicalsector == 0) {
-			logicalsector = -1;
-		}
-#endif
+		/* Populate the rootdirdev. */
 
-		status_released = SECTOR_IS_RELEASED(header);
-		status_committed = SECTOR_IS_COMMITTED(header);
-#ifdef CONFIG_MTD_SMART_JOURNALING
-		fvdbg("released : %d committed : %d logical : %d physical : %d crc : %d sta :%d seq :%d\n", status_released, status_committed, logicalsector, sector, UINT8TOUINT16(header.crc16), header.status, header.seq);
-#endif
+		rootdirdev->dev = dev;
+		rootdirdev->rootdirnum = x;
+		ret = register_blockdriver(dev->rwbuffer, &g_bops, 0, rootdirdev);
 
-		/* Test if this sector has been committed. */
-		if (status_committed) {
-			/* This block is now committed, therefore not free. Update the erase block's freecount.*/
+		/* Inode private data is a reference to the SMART device structure. */
 
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-			smart_add_count(dev, dev->freecount, sector / dev->sectorsPerBlk, -1);
-#else
-			dev->freecount[sector / dev->sectorsPerBlk]--;
+		ret = register_blockdriver(devname, &g_bops, 0, rootdirdev);
+	}
 #endif
-			dev->freesectors--;
-		}
 
-		/* Test if this sector has been release and if it has,
-		 * update the erase block's releasecount.
-		 */
+	return 1;
+}
 
-		if (status_released) {
-			/* Keep track of the total number of released sectors and
-			 * released sectors per erase block.
-			 */
+/****************************************************************************
+ * Name: smart_scan_sector
+ *
+ * Description: Read the header of a physical sector and update the logical
+ *              sector map, the free and released sector counts and the
+ *              format information.  Duplicate logical sectors are resolved
+ *              and the loser is released.
+ *
+ ****************************************************************************/
 
-			dev->releasesectors++;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-			smart_add_count(dev, dev->releasecount, sector / dev->sectorsPerBlk, 1);
-#else
-			dev->releasecount[sector / dev->sectorsPerBlk]++;
+static int smart_scan_sector(FAR struct smart_struct_s *dev, uint16_t sector)
+{
+	int ret;
+	uint16_t logicalsector;
+	uint16_t loser;
+	uint16_t winner;
+	uint32_t readaddress;
+	uint32_t offset;
+	uint16_t seq1;
+	uint16_t seq2;
+	uint16_t seqwrap;
+	struct smart_sect_header_s header;
+	bool status_released, status_committed;
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+	int dupsector;
+	uint16_t duplogsector;
 #endif
-			continue;
-		}
 
-		if ((header.status & SMART_STATUS_VERBITS) != SMART_STATUS_VERSION) {
-			continue;
-		}
+	winner = sector;
+	fvdbg("Scan sector %d\n", sector);
 
-		/* Validate the logical sector number is in bounds. */
+	/* Calculate the read address for this sector. */
 
-		if (logicalsector >= totalsectors) {
-			/* Error in logical sector read from the MTD device. */
+	readaddress = sector * dev->mtdBlksPerSector * dev->geo.blocksize;
 
-			fdbg("Invalid logical sector %d at physical %d.\n", logicalsector, sector);
-			continue;
-		}
-
-		/* If this is logical sector zero, then read in the signature
-		 * information to validate the format signature.
-		 */
-
-		if (logicalsector == 0) {
-			/* Read the sector data. */
-
-			ret = MTD_READ(dev->mtd, readaddress, 32, (FAR uint8_t *)dev->rwbuffer);
-			if (ret != 32) {
-				fdbg("Error reading physical sector %d at line %d.\n", sector, __LINE__);
-				goto err_out;
-			}
+	/* Read the header for this sector. */
+	ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (uint8_t *)dev->rwbuffer);
+	if (ret != sizeof(struct smart_sect_header_s)) {
+		fdbg("Error reading physical sector %d.\n", sector);
+		goto err_out;
+	}
+	/* copy header data only, will be used below */
+	memcpy(&header, dev->rwbuffer, sizeof(struct smart_sect_header_s));
 
-			/* Validate the format signature */
+	/* Get the logical sector number for this physical sector. */
+	logicalsector = UINT8TOUINT16(header.logicalsector);
+#if CONFIG_SMARTFS_ERASEDSTATE == 0x00
+	if (logicalsector == 0) {
+		logicalsector = -1;
+	}
+#endif
 
-			if (dev->rwbuffer[SMART_FMT_POS1] != SMART_FMT_SIG1 ||
-					dev->rwbuffer[SMART_FMT_POS2] != SMART_FMT_SIG2 ||
-					dev->rwbuffer[SMART_FMT_POS3] != SMART_FMT_SIG3 ||
-					dev->rwbuffer[SMART_FMT_POS4] != SMART_FMT_SIG4) {
-				/* Invalid signature on a sector claiming to be sector 0!
-				 * What should we do?  Release it?
-				 */
-				fdbg("INVALID SIGNATURE!! %c %c %c %c\n", dev->rwbuffer[SMART_FMT_POS1], dev->rwbuffer[SMART_FMT_POS2],
-						dev->rwbuffer[SMART_FMT_POS3], dev->rwbuffer[SMART_FMT_POS4]);
-				continue;
-			}
+	status_released = SECTOR_IS_RELEASED(header);
+	status_committed = SECTOR_IS_COMMITTED(header);
+#ifdef CONFIG_MTD_SMART_JOURNALING
+	fvdbg("released : %d committed : %d logical : %d physical : %d crc : %d sta :%d seq :%d\n", status_released, status_committed, logicalsector, sector, UINT8TOUINT16(header.crc16), header.status, header.seq);
+#endif
 
-			/* Validate journal format */
-			if (dev->rwbuffer[SMART_FMT_JOURNAL_POS] != SMART_FMT_JOURNAL) {
-				continue;
-			}
-			if (dev->rwbuffer[SMART_FMT_FORMAT_POS] == SMART_FORMAT_ENABLE) {
-				dev->formatstatus = SMART_FMT_STAT_NOFMT;
-				fdbg("format requested, Flash will be erased!!\n");
-				continue;
-			}
+	/* Test if this sector has been committed. */
+	if (status_committed) {
+		/* This block is now committed, therefore not free. Update the erase block's freecount.*/
 
-			/* Mark the volume as formatted and set the sector size */
-			fdbg("Formatted, continue scanning!!\n");
-			dev->formatstatus = SMART_FMT_STAT_FORMATTED;
-			dev->namesize = dev->rwbuffer[SMART_FMT_NAMESIZE_POS];
-			dev->formatversion = dev->rwbuffer[SMART_FMT_VERSION_POS];
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		smart_add_count(dev, dev->freecount, sector / dev->sectorsPerBlk, -1);
+#else
+		dev->freecount[sector / dev->sectorsPerBlk]--;
+#endif
+		dev->freesectors--;
+	}
 
-#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
-			dev->rootdirentries = dev->rwbuffer[SMART_FMT_ROOTDIRS_POS];
+	/* Test if this sector has been release and if it has,
+	 * update the erase block's releasecount.
+	 */
 
-			/* If rootdirentries is greater than 1, then we need to register
-			 * additional block devices.
-			 */
+	if (status_released) {
+		/* Keep track of the total number of released sectors and
+		 * released sectors per erase block.
+		 */
 
-			for (x = 1; x < dev->rootdirentries; x++) {
-				if (dev->partname[0] != '\0') {
-					snprintf(dev->rwbuffer, sizeof(devname), "/dev/smart%d%sd%d", dev->minor, dev->partname, x + 1);
-				} else {
-					snprintf(devname, sizeof(devname), "/dev/smart%dd%d", dev->minor, x + 1);
-				}
+		dev->releasesectors++;
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		smart_add_count(dev, dev->releasecount, sector / dev->sectorsPerBlk, 1);
+#else
+		dev->releasecount[sector / dev->sectorsPerBlk]++;
+#endif
+		return OK;
+	}
 
-				/* Inode private data is a reference to a struct containing
-				 * the SMART device structure and the root directory number.
-				 */
+	if ((header.status & SMART_STATUS_VERBITS) != SMART_STATUS_VERSION) {
+		return OK;
+	}
 
-				rootdirdev = (struct smart_multiroot_device_s *)smart_malloc(dev, sizeof(*rootdirdev), "Root Dir");
-				if (rootdirdev == NULL) {
-					fdbg("Memory alloc failed\n");
-					ret = -ENOMEM;
-					goto err_out;
-				}
+	/* Validate the logical sector number is in bounds. */
 
-				/* Populate the rootdirdev. */
+	if (logicalsector >= dev->totalsectors) {
+		/* Error in logical sector read from the MTD device. */
 
-				rootdirdev->dev = dev;
-				rootdirdev->rootdirnum = x;
-				ret = register_blockdriver(dev->rwbuffer, &g_bops, 0, rootdirdev);
+		fdbg("Invalid logical sector %d at physical %d.\n", logicalsector, sector);
+		return OK;
+	}
 
-				/* Inode private data is a reference to the SMART device structure. */
+	/* If this is logical sector zero, then read in the signature
+	 * information to validate the format signature.
+	 */
 
-				ret = register_blockdriver(devname, &g_bops, 0, rootdirdev);
-			}
-#endif
+	if (logicalsector == 0) {
+		ret = smart_scan_format(dev, readaddress);
+		if (ret < 0) {
+			goto err_out;
+		} else if (ret == 0) {
+			return OK;
 		}
+	}
 
-		/* Test for duplicate logical sectors on the device. */
+	/* Test for duplicate logical sectors on the device. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-		if (dev->sMap[logicalsector] != 0xFFFF)
+	if (dev->sMap[logicalsector] != 0xFFFF)
 #else
-		if (dev->sBitMap[logicalsector >> 3] & (1 << (logicalsector & 0x07)))
+	if (dev->sBitMap[logicalsector >> 3] & (1 << (logicalsector & 0x07)))
 #endif
-		{
-			/* Uh-oh, we found more than 1 physical sector claiming to be
-			 * the same logical sector.  Use the sequence number information
-			 * to resolve who wins.
-			 */
-			fvdbg("Duplication occurs!!\n, Popular Physical Sector = %d\n", dev->sMap[logicalsector]);
+	{
+		/* Uh-oh, we found more than 1 physical sector claiming to be
+		 * the same logical sector.  Use the sequence number information
+		 * to resolve who wins.
+		 */
+		fvdbg("Duplication occurs!!\n, Popular Physical Sector = %d\n", dev->sMap[logicalsector]);
 #if SMART_STATUS_VERSION == 1
-			if (header.status & SMART_STATUS_CRC) {
-				seq2 = header.seq;
-			} else {
-				//seq2 = *((FAR uint16_t *)&header.seq);
-				seq2 = (uint16_t)(((header.crc8 << 8) & 0xFF00) | header.seq);
-			}
-#else
+		if (header.status & SMART_STATUS_CRC) {
 			seq2 = header.seq;
+		} else {
+			//seq2 = *((FAR uint16_t *)&header.seq);
+			seq2 = (uint16_t)(((header.crc8 << 8) & 0xFF00) | header.seq);
+		}
+#else
+		seq2 = header.seq;
 #endif
 
-			/* We must re-read the 1st physical sector to get it's seq number. */
+		/* We must re-read the 1st physical sector to get it's seq number. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-			readaddress = dev->sMap[logicalsector] * dev->mtdBlksPerSector * dev->geo.blocksize;
+		readaddress = dev->sMap[logicalsector] * dev->mtdBlksPerSector * dev->geo.blocksize;
 #else
-			/* For minimize RAM, we have to rescan to find the 1st sector claiming to
-			 * be this logical sector.
-			 */
+		/* For minimize RAM, we have to rescan to find the 1st sector claiming to
+		 * be this logical sector.
+		 */
 
-			for (dupsector = 0; dupsector < sector; dupsector++) {
-				/* Calculate the read address for this sector. */
+		for (dupsector = 0; dupsector < sector; dupsector++) {
+			/* Calculate the read address for this sector. */
 
-				readaddress = dupsector * dev->mtdBlksPerSector * dev->geo.blocksize;
+			readaddress = dupsector * dev->mtdBlksPerSector * dev->geo.blocksize;
 
-				/* Read the header for this sector. */
+			/* Read the header for this sector. */
 
-				ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
-				if (ret != sizeof(struct smart_sect_header_s)) {
-					goto err_out;
-				}
+			ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
+			if (ret != sizeof(struct smart_sect_header_s)) {
+				goto err_out;
+			}
 
-				/* Get the logical sector number for this physical sector. */
+			/* Get the logical sector number for this physical sector. */
 
-				duplogsector = *((FAR uint16_t *)header.logicalsector);
+			duplogsector = *((FAR uint16_t *)header.logicalsector);
 #if CONFIG_SMARTFS_ERASEDSTATE == 0x00
-				if (duplogsector == 0) {
-					duplogsector = -1;
-				}
+			if (duplogsector == 0) {
+				duplogsector = -1;
+			}
 #endif
 
-				/* Test if this sector has been committed. */
+			/* Test if this sector has been committed. */
 
-				if (!SECTOR_IS_COMMITTED(header)) {
-					continue;
-				}
+			if (!SECTOR_IS_COMMITTED(header)) {
+				continue;
+			}
 
-				/* Test if this sector has been release and skip it if it has. */
+			/* Test if this sector has been release and skip it if it has. */
 
-				if (SECTOR_IS_RELEASED(header)) {
-					continue;
-				}
+			if (SECTOR_IS_RELEASED(header)) {
+				continue;
+			}
 
-				if ((header.status & SMART_STATUS_VERBITS) != SMART_STATUS_VERSION) {
-					continue;
-				}
+			if ((header.status & SMART_STATUS_VERBITS) != SMART_STATUS_VERSION) {
+				continue;
+			}
 
-				/* Now compare if this logical sector matches the current sector. */
+			/* Now compare if this logical sector matches the current sector. */
 
-				if (duplogsector == logicalsector) {
-					break;
-				}
+			if (duplogsector == logicalsector) {
+				break;
 			}
+		}
 #endif
 
-			ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
-			if (ret != sizeof(struct smart_sect_header_s)) {
-				goto err_out;
-			}
+		ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
+		if (ret != sizeof(struct smart_sect_header_s)) {
+			goto err_out;
+		}
 #if SMART_STATUS_VERSION == 1
-			if (header.status & SMART_STATUS_CRC) {
-				seq1 = header.seq;
-				seqwrap = 0xf0;
-			} else {
-				seq1 = (uint16_t)(((header.crc8 << 8) & 0xFF00) | header.seq);
-				seqwrap = 0xfff0;
-			}
-#else
+		if (header.status & SMART_STATUS_CRC) {
 			seq1 = header.seq;
 			seqwrap = 0xf0;
+		} else {
+			seq1 = (uint16_t)(((header.crc8 << 8) & 0xFF00) | header.seq);
+			seqwrap = 0xfff0;
+		}
+#else
+		seq1 = header.seq;
+		seqwrap = 0xf0;
 #endif
 
-			/* Now determine who wins. */
+		/* Now determine who wins. */
 
-			if ((seq1 > seqwrap && seq2 < 10) || seq2 > seq1) {
-				/* Seq 2 is the winner ... bigger or it wrapped. */
+		if ((seq1 > seqwrap && seq2 < 10) || seq2 > seq1) {
+			/* Seq 2 is the winner ... bigger or it wrapped. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-				loser = dev->sMap[logicalsector];
-				dev->sMap[logicalsector] = sector;
+			loser = dev->sMap[logicalsector];
+			dev->sMap[logicalsector] = sector;
 #else
-				loser = dupsector;
+			loser = dupsector;
 #endif
-				winner = sector;
-			} else {
-				/* We keep the original mapping and seq2 is the loser. */
+			winner = sector;
+		} else {
+			/* We keep the original mapping and seq2 is the loser. */
 
-				loser = sector;
+			loser = sector;
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-				winner = dev->sMap[logicalsector];
+			winner = dev->sMap[logicalsector];
 #else
-				winner = smart_cache_lookup(dev, logicalsector);
+			winner = smart_cache_lookup(dev, logicalsector);
 #endif
-			}
+		}
 
 #if defined(CONFIG_MTD_SMART_ENABLE_CRC) && !defined(CONFIG_MTD_SMART_JOURNALING)
-			/* Check CRC of the winner sector just in case */
+		/* Check CRC of the winner sector just in case */
 
-			ret = MTD_BREAD(dev->mtd, winner * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
-			if (ret != dev->mtdBlksPerSector) {
-				goto err_out;
-			}
+		ret = MTD_BREAD(dev->mtd, winner * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
+		if (ret != dev->mtdBlksPerSector) {
+			goto err_out;
+		}
 
-			/* Validate the CRC of the read-back data */
-			ret = smart_validate_crc(dev);
-			if (ret != OK) {
-				/* The winner sector has CRC error, so we select the loser
-				 * sector.  After swapping the winner and the loser sector, we
-				 * will release the loser sector with CRC error.
-				 */
+		/* Validate the CRC of the read-back data */
+		ret = smart_validate_crc(dev);
+		if (ret != OK) {
+			/* The winner sector has CRC error, so we select the loser
+			 * sector.  After swapping the winner and the loser sector, we
+			 * will release the loser sector with CRC error.
+			 */
 
-				if (sector == winner) {
-					/* winner: sector(CRC error) -> origin
-					 * loser : origin            -> sector(CRC error)
-					 */
+			if (sector == winner) {
+				/* winner: sector(CRC error) -> origin
+				 * loser : origin            -> sector(CRC error)
+				 */
 
-					winner = loser;
-					loser = sector;
-				} else {
-					/* winner: origin(CRC error) -> sector
-					 * loser : sector            -> origin(CRC error)
-					 */
+				winner = loser;
+				loser = sector;
+			} else {
+				/* winner: origin(CRC error) -> sector
+				 * loser : sector            -> origin(CRC error)
+				 */
 
-					loser = winner;
-					winner = sector;
-				}
+				loser = winner;
+				winner = sector;
 			}
+		}
 #endif /* CONFIG_MTD_SMART_ENABLE_CRC */
 
-			fvdbg("Duplicate Sector active_sector=%d, inactive_sector=%d\n", winner, loser);
+		fvdbg("Duplicate Sector active_sector=%d, inactive_sector=%d\n", winner, loser);
 
-			/* Now release the loser sector. */
+		/* Now release the loser sector. */
 
-			readaddress = loser * dev->mtdBlksPerSector * dev->geo.blocksize;
-			ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
-			if (ret != sizeof(struct smart_sect_header_s)) {
-				goto err_out;
-			}
+		readaddress = loser * dev->mtdBlksPerSector * dev->geo.blocksize;
+		ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
+		if (ret != sizeof(struct smart_sect_header_s)) {
+			goto err_out;
+		}
 #if CONFIG_SMARTFS_ERASEDSTATE == 0xFF
-			header.status &= ~SMART_STATUS_RELEASED;
+		header.status &= ~SMART_STATUS_RELEASED;
 #else
-			header.status |= SMART_STATUS_RELEASED;
+		header.status |= SMART_STATUS_RELEASED;
 #endif
-			offset = readaddress + offsetof(struct smart_sect_header_s, status);
-			ret = smart_bytewrite(dev, offset, 1, &header.status);
-			if (ret < 0) {
-				fdbg("Error %d releasing duplicate sector\n", -ret);
-				goto err_out;
-			}
+		offset = readaddress + offsetof(struct smart_sect_header_s, status);
+		ret = smart_bytewrite(dev, offset, 1, &header.status);
+		if (ret < 0) {
+			fdbg("Error %d releasing duplicate sector\n", -ret);
+			goto err_out;
 		}
+	}
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-		/* Update the logical to physical sector map. */
+	/* Update the logical to physical sector map. */
 
-		dev->sMap[logicalsector] = winner;
+	dev->sMap[logicalsector] = winner;
 #else
-		/* Mark the logical sector as used in the bitmap */
-		dev->sBitMap[logicalsector >> 3] |= 1 << (logicalsector & 0x07);
+	/* Mark the logical sector as used in the bitmap */
+	dev->sBitMap[logicalsector >> 3] |= 1 << (logicalsector & 0x07);
+
+	if (logicalsector < SMART_FIRST_ALLOC_SECTOR) {
+		smart_add_sector_to_cache(dev, logicalsector, winner, __LINE__);
+	}
+#endif
+
+	return OK;
 
-		if (logicalsector < SMART_FIRST_ALLOC_SECTOR) {
-			smart_add_sector_to_cache(dev, logicalsector, winner, __LINE__);
+err_out:
+	return ret;
+}
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+/****************************************************************************
+ * Name: smart_checkpoint_addr
+ *
+ * Description: Return the byte address of a checkpoint slot.
+ *
+ ****************************************************************************/
+
+static uint32_t smart_checkpoint_addr(FAR struct smart_struct_s *dev, uint8_t slot)
+{
+	return (uint32_t)(dev->neraseblocks + slot * dev->cpblocks) * dev->erasesize;
+}
+
+/****************************************************************************
+ * Name: smart_checkpoint_bytewrite
+ *
+ * Description: Write bytes in the checkpoint area.  Unlike smart_bytewrite,
+ *              it does not mark the erase block as dirty.
+ *
+ ****************************************************************************/
+
+static ssize_t smart_checkpoint_bytewrite(FAR struct smart_struct_s *dev, size_t offset, int nbytes, FAR const uint8_t *buffer)
+{
+#ifdef CONFIG_MTD_BYTE_WRITE
+	if (dev->mtd->write != NULL) {
+		return MTD_WRITE(dev->mtd, offset, nbytes, buffer);
+	}
+#endif
+	return smart_byte_to_block_write(dev, offset, nbytes, buffer);
+}
+
+/****************************************************************************
+ * Name: smart_checkpoint_obsolete
+ *
+ * Description: Mark the checkpoint in a slot as obsolete, so that it is not
+ *              loaded at mount.  If the marker cannot be written, the first
+ *              block of the slot is erased instead.  Returns an error if
+ *              the checkpoint could not be invalidated either way.
+ *
+ ****************************************************************************/
+
+static int smart_checkpoint_obsolete(FAR struct smart_struct_s *dev, uint8_t slot)
+{
+	uint8_t obsolete = SMART_CP_OBSOLETE;
+	ssize_t ret;
+
+	ret = smart_checkpoint_bytewrite(dev, smart_checkpoint_addr(dev, slot) + offsetof(struct smart_checkpoint_s, obsolete), 1, &obsolete);
+	if (ret != 1) {
+		fdbg("Error %d marking checkpoint slot %d obsolete\n", ret, slot);
+		ret = MTD_ERASE(dev->mtd, dev->neraseblocks + slot * dev->cpblocks, 1);
+		if (ret < 0) {
+			fdbg("Error %d erasing checkpoint slot %d\n", ret, slot);
+			return ret;
 		}
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: smart_checkpoint_dirty
+ *
+ * Description: Record an erase block in the dirty block log of the current
+ *              checkpoint before it is written or erased.  The block will be
+ *              scanned again when the checkpoint is loaded.  When the log is
+ *              full, the checkpoint is no longer used and the next mount
+ *              performs a full scan.
+ *
+ ****************************************************************************/
+
+static void smart_checkpoint_dirty(FAR struct smart_struct_s *dev, uint16_t block)
+{
+	uint16_t entry;
+	uint8_t buffer[2];
+	ssize_t ret;
+
+	if (!dev->cpvalid || block >= dev->neraseblocks || GET_VAL(dev->cpdirty, block)) {
+		return;
+	}
+
+	SET_TO_TRUE(dev->cpdirty, block);
+	if (dev->cplogcount >= SMART_CP_LOG_ENTRIES) {
+		return;
+	}
+
+	/* Store block + 1 so that no entry looks erased. */
+
+	entry = block + 1;
+	buffer[0] = (uint8_t)(entry & 0xFF);
+	buffer[1] = (uint8_t)(entry >> 8);
+	ret = smart_checkpoint_bytewrite(dev, smart_checkpoint_addr(dev, dev->cpslot) + dev->cplogoffset + dev->cplogcount * 2, 2, buffer);
+	if (ret != 2) {
+		fdbg("Error %d logging dirty block %d, checkpoint dropped\n", ret, block);
+		(void)smart_checkpoint_obsolete(dev, dev->cpslot);
+		dev->cpvalid = false;
+		return;
+	}
+
+	dev->cplogcount++;
+}
+
+/****************************************************************************
+ * Name: smart_checkpoint_write
+ *
+ * Description: Write the logical sector map, the free and released sector
+ *              counts into the other checkpoint slot.  The previous
+ *              checkpoint is invalidated before the header of the new one
+ *              is written, so at most one checkpoint looks valid at any
+ *              time, and a failed or interrupted write leaves none and the
+ *              next mount performs a full scan.  Must be called between
+ *              sector operations, when the map and the counts match the
+ *              device.
+ *
+ ****************************************************************************/
+
+static int smart_checkpoint_write(FAR struct smart_struct_s *dev)
+{
+	FAR struct smart_checkpoint_s *cp;
+	FAR uint8_t *data;
+	uint32_t addr;
+	uint32_t size;
+	uint32_t startblock;
+	uint32_t nblocks;
+	uint32_t tail;
+	uint8_t slot;
+	int ret;
+
+	if (dev->cpblocks == 0 || dev->formatstatus != SMART_FMT_STAT_FORMATTED) {
+		return -EINVAL;
+	}
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+	/* Allocated sectors are not on the device yet. */
+
+	if (dev->allocsector != NULL) {
+		return -EBUSY;
+	}
 #endif
+
+	slot = dev->cpslot ^ 1;
+	addr = smart_checkpoint_addr(dev, slot);
+
+	ret = MTD_ERASE(dev->mtd, dev->neraseblocks + slot * dev->cpblocks, dev->cpblocks);
+	if (ret < 0) {
+		fdbg("Error %d erasing checkpoint slot %d\n", ret, slot);
+		return ret;
+	}
+
+	/* Write the sector map and the counts, which are contiguous in RAM. */
+
+	data = (FAR uint8_t *)dev->sMap;
+	size = SMART_CP_DATASIZE(dev);
+	startblock = (addr + dev->cpdataoffset) / dev->geo.blocksize;
+	nblocks = size / dev->geo.blocksize;
+	tail = size - nblocks * dev->geo.blocksize;
+
+	if (nblocks > 0) {
+		ret = MTD_BWRITE(dev->mtd, startblock, nblocks, data);
+		if (ret != nblocks) {
+			goto errout;
+		}
+	}
+
+	if (tail > 0) {
+		memset(dev->rwbuffer, CONFIG_SMARTFS_ERASEDSTATE, dev->geo.blocksize);
+		memcpy(dev->rwbuffer, &data[nblocks * dev->geo.blocksize], tail);
+		ret = MTD_BWRITE(dev->mtd, startblock + nblocks, 1, (FAR uint8_t *)dev->rwbuffer);
+		if (ret != 1) {
+			goto errout;
+		}
+	}
+
+	/* The previous checkpoint must not be used anymore, and no block is
+	 * logged until the new one is committed.
+	 */
+
+	ret = smart_checkpoint_obsolete(dev, dev->cpslot);
+	if (ret < 0) {
+		goto errout;
+	}
+	dev->cpvalid = false;
+
+	/* Now commit the checkpoint by writing its header. */
+
+	memset(dev->rwbuffer, CONFIG_SMARTFS_ERASEDSTATE, dev->cplogoffset);
+	cp = (FAR struct smart_checkpoint_s *)dev->rwbuffer;
+	cp->magic = SMART_CP_MAGIC;
+	cp->seq = dev->cpseq + 1;
+	cp->size = size;
+	cp->crc = crc32(data, size);
+	cp->totalsectors = dev->totalsectors;
+	cp->neraseblocks = dev->neraseblocks;
+	cp->sectorsize = dev->sectorsize;
+	cp->freesectors = dev->freesectors;
+	cp->releasesectors = dev->releasesectors;
+	cp->version = SMART_CP_VERSION;
+	cp->hdrcrc = crc32((FAR const uint8_t *)cp, offsetof(struct smart_checkpoint_s, obsolete));
+
+	ret = MTD_BWRITE(dev->mtd, addr / dev->geo.blocksize, dev->cplogoffset / dev->geo.blocksize, (FAR uint8_t *)dev->rwbuffer);
+	if (ret != dev->cplogoffset / dev->geo.blocksize) {
+		goto errout;
+	}
+
+	dev->cpslot = slot;
+	dev->cpseq++;
+	dev->cplogcount = 0;
+	dev->cpvalid = true;
+	memset(dev->cpdirty, 0, (dev->neraseblocks + 7) >> 3);
+
+	fvdbg("Checkpoint %d written to slot %d\n", dev->cpseq, slot);
+	return OK;
+
+errout:
+	fdbg("Error %d writing checkpoint slot %d\n", ret, slot);
+	return ret < 0 ? ret : -EIO;
+}
+
+/****************************************************************************
+ * Name: smart_checkpoint_due
+ *
+ * Description: Test if a new checkpoint should be taken, because there is
+ *              no valid one or the dirty block log of the current one is
+ *              getting full.
+ *
+ ****************************************************************************/
+
+static bool smart_checkpoint_due(FAR struct smart_struct_s *dev)
+{
+	if (dev->cpblocks == 0 || dev->formatstatus != SMART_FMT_STAT_FORMATTED) {
+		return false;
+	}
+
+	return !dev->cpvalid || dev->cplogcount >= SMART_CP_LOG_THRESHOLD;
+}
+
+/****************************************************************************
+ * Name: smart_checkpoint_update
+ *
+ * Description: Take a new checkpoint if it is due, or at unmount ('force')
+ *              if any block was written since the checkpoint.
+ *
+ ****************************************************************************/
+
+static void smart_checkpoint_update(FAR struct smart_struct_s *dev, bool force)
+{
+	if (!smart_checkpoint_due(dev) && !(force && dev->cpblocks != 0 && dev->cplogcount > 0)) {
+		return;
+	}
+
+	(void)smart_checkpoint_write(dev);
+}
+
+/****************************************************************************
+ * Name: smart_checkpoint_load
+ *
+ * Description: Load the logical sector map, the free and released sector
+ *              counts from the latest checkpoint, and scan again only the
+ *              erase blocks written after it was taken.  If it returns an
+ *              error, the map and the counts must be rebuilt by a full scan.
+ *
+ ****************************************************************************/
+
+static int smart_checkpoint_load(FAR struct smart_struct_s *dev)
+{
+	struct smart_checkpoint_s cp;
+	struct smart_checkpoint_s latest;
+	FAR uint8_t *log;
+	uint32_t size;
+	uint16_t count;
+	uint16_t entry;
+	uint16_t block;
+	uint16_t sector;
+	uint16_t prerelease;
+	uint8_t slot;
+	int ret;
+
+	dev->cpvalid = false;
+	dev->cpslot = SMART_CP_NSLOTS - 1;
+	dev->cpseq = 0;
+	dev->cplogcount = 0;
+
+	if (dev->cpblocks == 0) {
+		return -ENOSYS;
 	}
 
+	memset(dev->cpdirty, 0, (dev->neraseblocks + 7) >> 3);
+
+	/* Find the checkpoint with the highest sequence number.  An older one is
+	 * never used, because its log misses the blocks written after the newer
+	 * one was taken.
+	 */
+
+	for (slot = 0; slot < SMART_CP_NSLOTS; slot++) {
+		ret = MTD_READ(dev->mtd, smart_checkpoint_addr(dev, slot), sizeof(cp), (FAR uint8_t *)&cp);
+		if (ret != sizeof(cp) || cp.magic != SMART_CP_MAGIC ||
+				cp.hdrcrc != crc32((FAR const uint8_t *)&cp, offsetof(struct smart_checkpoint_s, obsolete))) {
+			continue;
+		}
+
+		if (cp.seq > dev->cpseq) {
+			dev->cpseq = cp.seq;
+			dev->cpslot = slot;
+			memcpy(&latest, &cp, sizeof(cp));
+		}
+	}
+
+	if (dev->cpseq == 0) {
+		return -ENOENT;
+	}
+
+	size = SMART_CP_DATASIZE(dev);
+	if (latest.obsolete != CONFIG_SMARTFS_ERASEDSTATE || latest.version != SMART_CP_VERSION ||
+			latest.totalsectors != dev->totalsectors || latest.neraseblocks != dev->neraseblocks ||
+			latest.sectorsize != dev->sectorsize || latest.size != size) {
+		fvdbg("Checkpoint %d is not usable\n", latest.seq);
+		return -EINVAL;
+	}
+
+	/* Read the dirty block log. */
+
+	log = (FAR uint8_t *)dev->rwbuffer;
+	ret = MTD_READ(dev->mtd, smart_checkpoint_addr(dev, dev->cpslot) + dev->cplogoffset, SMART_CP_LOG_ENTRIES * 2, log);
+	if (ret != SMART_CP_LOG_ENTRIES * 2) {
+		return -EIO;
+	}
+
+	for (count = 0; count < SMART_CP_LOG_ENTRIES; count++) {
+		entry = (uint16_t)(log[count * 2] | (log[count * 2 + 1] << 8));
+		if (entry == SMART_CP_LOG_ERASED) {
+			break;
+		}
+
+		block = entry - 1;
+		if (block >= dev->neraseblocks) {
+			return -EINVAL;
+		}
+		SET_TO_TRUE(dev->cpdirty, block);
+	}
+
+	if (count == SMART_CP_LOG_ENTRIES) {
+		/* Blocks written after the log got full are unknown. */
+
+		fvdbg("Checkpoint %d log is full\n", latest.seq);
+		return -ENOSPC;
+	}
+
+	/* Read the sector map and the counts. */
+
+	ret = MTD_READ(dev->mtd, smart_checkpoint_addr(dev, dev->cpslot) + dev->cpdataoffset, size, (FAR uint8_t *)dev->sMap);
+	if (ret != size) {
+		return -EIO;
+	}
+
+	if (crc32((FAR const uint8_t *)dev->sMap, size) != latest.crc) {
+		fdbg("Checkpoint %d CRC error\n", latest.seq);
+		return -EIO;
+	}
+
+	dev->freesectors = latest.freesectors;
+	dev->releasesectors = latest.releasesectors;
+	dev->formatstatus = SMART_FMT_STAT_NOFMT;
+
+	/* Forget the sectors in dirty blocks, they are scanned again below. */
+
+	for (sector = 0; sector < dev->totalsectors; sector++) {
+		if (dev->sMap[sector] != 0xFFFF && GET_VAL(dev->cpdirty, dev->sMap[sector] / dev->sectorsPerBlk)) {
+			dev->sMap[sector] = 0xFFFF;
+		}
+	}
+
+	for (block = 0; block < dev->neraseblocks; block++) {
+		if (!GET_VAL(dev->cpdirty, block)) {
+			continue;
+		}
+
+		/* Reset the counts of the block as smart_scan does. */
+
+		if (block == dev->neraseblocks - 1 && dev->totalsectors == 65534) {
+			prerelease = 2;
+		} else {
+			prerelease = 0;
+		}
+
+		dev->freesectors += dev->availSectPerBlk - prerelease - dev->freecount[block];
+		dev->releasesectors -= dev->releasecount[block] - prerelease;
+		dev->freecount[block] = dev->availSectPerBlk - prerelease;
+		dev->releasecount[block] = prerelease;
+
+		for (sector = block * dev->sectorsPerBlk; sector < (block + 1) * dev->sectorsPerBlk && sector < dev->totalsectors; sector++) {
+			ret = smart_scan_sector(dev, sector);
+			if (ret != OK) {
+				return ret;
+			}
+		}
+	}
+
+	/* Read the format information, if logical sector zero was not scanned. */
+
+	if (dev->formatstatus != SMART_FMT_STAT_FORMATTED && dev->sMap[0] != 0xFFFF) {
+		ret = smart_scan_format(dev, dev->sMap[0] * dev->mtdBlksPerSector * dev->geo.blocksize);
+		if (ret < 0) {
+			return ret;
+		} else if (ret == 0) {
+			dev->sMap[0] = 0xFFFF;
+		}
+	}
+
+	dev->cplogcount = count;
+	dev->cpvalid = true;
+
+	return OK;
+}
+#endif							/* CONFIG_MTD_SMART_CHECKPOINT */
+
+/****************************************************************************
+ * Name: smart_scan
+ *
+ * Description: Perform a scan of the MTD device to search for format
+ *              information and fill in logical sector mapping, freesector
+ *              count, etc.  With CONFIG_MTD_SMART_CHECKPOINT, the mapping
+ *              and the counts are loaded from the checkpoint if possible.
+ *
+ ****************************************************************************/
+
+static int smart_scan(FAR struct smart_struct_s *dev)
+{
+	int sector;
+	int ret = OK;
+	uint16_t totalsectors;
+	uint16_t prerelease;
+#if defined(CONFIG_DEBUG_FS_ERROR) && !defined(NXFUSE_HOST_BUILD)
+	clock_t start = clock_systimer();
+#endif
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+rescan:
+#endif
+	// ToDo: Revert to the flexible logic that searches sectors and
+	//       reads sector sizes stored in the sectors instead of
+	//		 using CONFIG_MTD_SMART_SECTOR_SIZE.
+	ret = smart_setsectorsize(dev, CONFIG_MTD_SMART_SECTOR_SIZE);
+	if (ret != OK) {
+		goto err_out;
+	}
+
+	/* Initialize the device variables. */
+
+	totalsectors = dev->totalsectors;
+
+	dev->formatstatus = SMART_FMT_STAT_NOFMT;
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	/* Load the map and the counts from the checkpoint, and fall back to the
+	 * full scan below if there is no valid one.
+	 */
+
+	dev->cpformat = false;
+	ret = smart_checkpoint_load(dev);
+	if (ret == OK) {
+		goto scan_done;
+	}
+
+	fvdbg("No checkpoint loaded (%d), scan all sectors\n", ret);
+	dev->cpvalid = false;
+	dev->formatstatus = SMART_FMT_STAT_NOFMT;
+#endif
+
+	dev->freesectors = dev->availSectPerBlk * dev->neraseblocks;
+	dev->releasesectors = 0;
+
+	/* Initialize the freecount and releasecount arrays. */
+
+	for (sector = 0; sector < dev->neraseblocks; sector++) {
+		if (sector == dev->neraseblocks - 1 && dev->totalsectors == 65534) {
+			prerelease = 2;
+		} else {
+			prerelease = 0;
+		}
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		smart_set_count(dev, dev->freecount, sector, dev->availSectPerBlk - prerelease);
+		smart_set_count(dev, dev->releasecount, sector, prerelease);
+#else
+		dev->freecount[sector] = dev->availSectPerBlk - prerelease;
+		dev->releasecount[sector] = prerelease;
+#endif
+	}
+
+	/* Initialize the sector map. */
+
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+	for (sector = 0; sector < totalsectors; sector++) {
+		dev->sMap[sector] = -1;
+	}
+#else
+	/* Clear all logical sector used bits. */
+
+	memset(dev->sBitMap, 0, (dev->totalsectors + 7) >> 3);
+#endif
+
+	/* Now scan the MTD device. */
+
+	for (sector = 0; sector < totalsectors; sector++) {
+		fvdbg("Scan sector %d\n", sector);
+
+		ret = smart_scan_sector(dev, sector);
+		if (ret != OK) {
+			goto err_out;
+		}
+	}
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	if (dev->cpblocks != 0 && !dev->cpformat) {
+		/* The volume was formatted without the checkpoint slots, or it is
+		 * not formatted.  Its sectors may be in the blocks reserved for the
+		 * slots, so scan the whole device again and never write there until
+		 * a low-level format reserves them.
+		 */
+
+		fdbg("No checkpoint slots on the volume, format it to use them\n");
+		dev->cpdisabled = true;
+		dev->sectorsize = 0;
+		goto rescan;
+	}
+
+scan_done:
+#endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	/* The counts are valid now, index them. */
+
+	smart_index_build(dev);
+#endif
+
 #if defined(CONFIG_MTD_SMART_WEAR_LEVEL) && (SMART_STATUS_VERSION == 1)
 #ifdef CONFIG_MTD_SMART_CONVERT_WEAR_FORMAT
 
@@ -2275,6 +3162,8 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	/* Validate the sector is valid ... may be an unformatted device. */
 
 	if (sector != 0xFFFF) {
+		uint32_t readaddress;
+
 		/* Read the sector data from start to offset of SMART_WEAR_LEVEL_FORMAT_SIG. */
 		readaddress = sector * dev->mtdBlksPerSector * dev->geo.blocksize;
 		ret = MTD_READ(dev->mtd, readaddress, SMART_WEAR_LEVEL_FORMAT_SIG + 1, (uint8_t *)dev->rwbuffer);
@@ -2308,8 +3197,8 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 			dev->sMap[0] = newsector;
-			dev->freecount[newsector / dev->sectorsPerBlk]--;
-			dev->releasecount[sector / dev->sectorsPerBlk]++;
+			SMART_SET_FREECOUNT(dev, newsector / dev->sectorsPerBlk, dev->freecount[newsector / dev->sectorsPerBlk] - 1);
+			SMART_SET_RELEASECOUNT(dev, sector / dev->sectorsPerBlk, dev->releasecount[sector / dev->sectorsPerBlk] + 1);
 #else
 			smart_update_cache(dev, 0, newsector);
 			smart_add_count(dev, dev->freecount, newsector / dev->sectorsPerBlk, -1);
@@ -2340,6 +3229,16 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	fdbg("   Journal total:        %10d\n", dev->njournalentries);
 	fdbg("   Journal usage:        %10d\n", dev->journal_seq);
 #endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	fdbg("   Block index (bytes):  %10d\n", SMART_INDEX_SIZE(dev->neraseblocks));
+#endif
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	fdbg("   Checkpoint blocks:    %10d\n", dev->cpblocks * SMART_CP_NSLOTS);
+	fdbg("   Blocks scanned:       %10d\n", dev->cpvalid ? dev->cplogcount : dev->neraseblocks);
+#endif
+#if defined(CONFIG_DEBUG_FS_ERROR) && !defined(NXFUSE_HOST_BUILD)
+	fdbg("   Scan time (ms):       %10d\n", TICK2MSEC(clock_systimer() - start));
+#endif
 #ifdef CONFIG_MTD_SMART_ALLOC_DEBUG
 	fdbg("   Allocations:\n");
 	for (sector = 0; sector < SMART_MAX_ALLOCS; sector++) {
@@ -2348,6 +3247,17 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 		}
 	}
 #endif
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	/* Take a new checkpoint after a full scan or a rescan of dirty blocks.
+	 * Released duplicates are not logged while scanning, so the next mount
+	 * must not rely on the old log.
+	 */
+
+	if (!dev->cpvalid || dev->cplogcount > 0) {
+		(void)smart_checkpoint_write(dev);
+	}
+#endif
 	ret = OK;
 
 err_out:
@@ -2422,11 +3332,12 @@ static inline int smart_getformat(FAR struct smart_struct_s *dev, FAR struct sma
  * Name: smart_erase_block_if_empty
  *
  * Description:  Tests the specified erase block if it contains all free or
- *               released sectors and erases it.
+ *               released sectors and erases it.  Returns a negated errno
+ *               value if the erase failed.
  *
  ****************************************************************************/
 
-static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t block, uint8_t forceerase)
+static int smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t block, uint8_t forceerase)
 {
 	uint16_t freecount, releasecount, prerelease;
 	int ret;
@@ -2446,6 +3357,7 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t
 		dev->blockerases++;
 #endif
 
+		SMART_CHECKPOINT_DIRTY(dev, block);
 #ifdef CONFIG_MTD_SMART_JOURNALING
 		ret = smart_journal_erase(dev, block);
 #else
@@ -2453,8 +3365,8 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t
 #endif
 		if (ret < 0) {
 			fdbg("MTD_ERASE failed!!\n");
-			dev->freecount[block] = 0;
-			return;
+			SMART_SET_FREECOUNT(dev, block, 0);
+			return ret;
 		}
 
 
@@ -2487,8 +3399,8 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t
 		smart_set_count(dev, dev->releasecount, block, prerelease);
 		smart_set_count(dev, dev->freecount, block, dev->availSectPerBlk - prerelease);
 #else
-		dev->releasecount[block] = prerelease;
-		dev->freecount[block] = dev->availSectPerBlk - prerelease;
+		SMART_SET_RELEASECOUNT(dev, block, prerelease);
+		SMART_SET_FREECOUNT(dev, block, dev->availSectPerBlk - prerelease);
 #endif							/* CONFIG_MTD_SMART_PACK_COUNTS */
 
 		/* Now that we have erased this block and updated the release / free counts,
@@ -2510,6 +3422,8 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t
 		}
 #endif
 	}
+
+	return OK;
 }
 
 /****************************************************************************
@@ -2692,7 +3606,7 @@ static int smart_relocate_static_data(FAR struct smart_struct_s *dev, uint16_t b
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
 			smart_add_count(dev, dev->freecount, block, -1);
 #else
-			dev->freecount[block]--;
+			SMART_SET_FREECOUNT(dev, block, dev->freecount[block] - 1);
 #endif							/* CONFIG_MTD_SMART_PACK_COUNTS */
 			dev->freesectors--;
 		}
@@ -2831,6 +3745,15 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 
 	fvdbg("Entry\n");
 
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	/* Reserve the checkpoint slots, the old volume may have had none. */
+
+	if (dev->cpdisabled) {
+		dev->cpdisabled = false;
+		dev->sectorsize = 0;
+	}
+#endif
+
 	ret = smart_setsectorsize(dev, CONFIG_MTD_SMART_SECTOR_SIZE);
 	if (ret != OK) {
 		return ret;
@@ -2853,6 +3776,11 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 	if (ret < 0) {
 		return ret;
 	}
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	/* The checkpoint slots are erased too. */
+
+	dev->cpvalid = false;
+#endif
 
 	/* Now construct a logical sector zero header to write to the device. */
 
@@ -2910,6 +3838,11 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 
 	dev->rwbuffer[SMART_FMT_ROOTDIRS_POS] = (uint8_t) (arg & 0xff);
 	dev->rwbuffer[SMART_FMT_FORMAT_POS] = SMART_FORMAT_DISABLE;
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	if (dev->cpblocks != 0) {
+		dev->rwbuffer[SMART_FMT_CHECKPOINT_POS] = SMART_CHECKPOINT_ENABLE;
+	}
+#endif
 
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 #ifdef CONFIG_SMART_CRC_8
@@ -2975,6 +3908,9 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 #else
 	dev->freecount[0]--;
 #endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	smart_index_build(dev);
+#endif
 
 	/* Now initialize the logical to physical sector map. */
 
@@ -3021,6 +3957,7 @@ static int smart_relocate_sector(FAR struct smart_struct_s *dev, uint16_t oldsec
 	fvdbg("Entry\n");
 
 	header = (FAR struct smart_sect_header_s *)dev->rwbuffer;
+	SMART_CHECKPOINT_DIRTY(dev, newsector / dev->sectorsPerBlk);
 
 	/* Increment the sequence number and clear the "commit" flag. */
 
@@ -3200,7 +4137,7 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 #endif
 #endif
 
-	dev->freecount[block] = 0;
+	SMART_SET_FREECOUNT(dev, block, 0);
 #endif
 
 	/* Next move all live data in the block to a new home. */
@@ -3288,12 +4225,13 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
 		smart_add_count(dev, dev->freecount, newsector / dev->sectorsPerBlk, -1);
 #else
-		dev->freecount[newsector / dev->sectorsPerBlk]--;
+		SMART_SET_FREECOUNT(dev, newsector / dev->sectorsPerBlk, dev->freecount[newsector / dev->sectorsPerBlk] - 1);
 #endif
 
 	}
 
 	/* Now erase the erase block. */
+	SMART_CHECKPOINT_DIRTY(dev, block);
 #ifdef CONFIG_MTD_SMART_JOURNALING
 	ret = smart_journal_erase(dev, block);
 #else
@@ -3301,7 +4239,7 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 #endif
 	if (ret < 0) {
 		fdbg("MTD_ERASE failed!!\n");
-		dev->freecount[block] = 0;
+		SMART_SET_FREECOUNT(dev, block, 0);
 		return ret;
 	}
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
@@ -3344,8 +4282,8 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 	oldrelease = dev->releasecount[block];
 	dev->freesectors += oldrelease - prerelease;
 	dev->releasesectors -= oldrelease - prerelease;
-	dev->freecount[block] = dev->availSectPerBlk - prerelease;
-	dev->releasecount[block] = prerelease;
+	SMART_SET_FREECOUNT(dev, block, dev->availSectPerBlk - prerelease);
+	SMART_SET_RELEASECOUNT(dev, block, prerelease);
 #endif
 
 #ifdef CONFIG_SMART_LOCAL_CHECKFREE
@@ -3370,11 +4308,88 @@ errout:
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
 	smart_set_count(dev, dev->freecount, block, freecount);
 #else
-	dev->freecount[block] = freecount;
+	SMART_SET_FREECOUNT(dev, block, freecount);
 #endif
 	return ret;
 }
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+/****************************************************************************
+ * Name: smart_index_max_from
+ *
+ * Description: Return the erase block with the highest non-zero count,
+ *              skipping the blocks whose wear level reached 'wearlimit'.
+ *              Among the blocks of that count, return the first one at or
+ *              after 'from' in block order, wrapping around, as the scan
+ *              of all blocks does.  If 'from' is SMART_INDEX_NONE, return
+ *              the first block of the bucket.  Returns SMART_INDEX_NONE if
+ *              there is no such block.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_index_max_from(FAR struct smart_struct_s *dev, FAR struct smart_index_s *index, uint8_t wearlimit, uint16_t from)
+{
+	uint16_t bucket;
+	uint16_t block;
+	uint16_t best = SMART_INDEX_NONE;
+	uint16_t bestdist = 0;
+	uint16_t dist;
+
+	for (bucket = SMART_INDEX_NBUCKETS - 1; bucket > 0; bucket--) {
+		if (index->map[bucket >> 5] == 0) {
+			/* Skip the whole word of empty buckets. */
+
+			bucket &= ~31;
+			continue;
+		}
+
+		if ((index->map[bucket >> 5] & ((uint32_t)1 << (bucket & 31))) == 0) {
+			continue;
+		}
+
+		for (block = index->head[bucket]; block != SMART_INDEX_NONE; block = index->next[block]) {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+			if (smart_get_wear_level(dev, block) >= wearlimit) {
+				continue;
+			}
+#endif
+			if (from == SMART_INDEX_NONE) {
+				return block;
+			}
+
+			dist = (block >= from) ? block - from : block + dev->neraseblocks - from;
+			if (best == SMART_INDEX_NONE || dist < bestdist) {
+				best = block;
+				bestdist = dist;
+				if (dist == 0) {
+					break;
+				}
+			}
+		}
+
+		if (best != SMART_INDEX_NONE) {
+			return best;
+		}
+	}
+
+	return SMART_INDEX_NONE;
+}
+
+/****************************************************************************
+ * Name: smart_index_max
+ *
+ * Description: Return the erase block with the highest non-zero count,
+ *              skipping the blocks whose wear level reached 'wearlimit'.
+ *              Returns SMART_INDEX_NONE if there is no such block.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_index_max(FAR struct smart_struct_s *dev, FAR struct smart_index_s *index, uint8_t wearlimit)
+{
+	return smart_index_max_from(dev, index, wearlimit, SMART_INDEX_NONE);
+}
+#endif
+
 /****************************************************************************
  * Name: smart_findfreephyssector
  *
@@ -3393,6 +4408,8 @@ static uint16_t smart_findfreephyssector(FAR struct smart_struct_s *dev, uint8_t
 #endif
 	uint16_t physicalsector;
 	uint16_t x, block;
+	uint16_t i, start = 0;
+	uint16_t nsectors;
 	uint32_t readaddr;
 	struct smart_sect_header_s header;
 	int ret;
@@ -3416,6 +4433,18 @@ retry:
 		dev->lastallocblock = 0;
 	}
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	/* Take the unworn block with the most free sectors from the index, the
+	 * first one from lastallocblock on among equal blocks.  The scan below
+	 * is needed only to select a worn block.
+	 */
+
+	allocblock = smart_index_max_from(dev, &dev->freeindex, SMART_WEAR_FULL_RELOCATE_THRESHOLD, dev->lastallocblock);
+	if (allocblock != SMART_INDEX_NONE) {
+		goto found;
+	}
+#endif
+
 	block = dev->lastallocblock;
 	for (x = 0; x < dev->neraseblocks; x++) {
 		/* Test if this block has more free blocks than the
@@ -3519,10 +4548,34 @@ retry:
 		}
 	}
 
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+found:
+#endif
+	/* The last erase block of a 65536 sector device has sectors beyond
+	 * totalsectors, which are never allocated.
+	 */
+
+	nsectors = dev->availSectPerBlk;
+	if ((uint32_t)allocblock * dev->sectorsPerBlk + nsectors > dev->totalsectors) {
+		nsectors = dev->totalsectors - allocblock * dev->sectorsPerBlk;
+	}
+
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	/* Sectors are allocated in order within a block, so the free sectors are
+	 * usually the last 'freecount' ones.  Start there and wrap around.
+	 */
+
+	if (dev->freecount[allocblock] < nsectors) {
+		start = nsectors - dev->freecount[allocblock];
+	}
+#endif
+
 	/* Now find a free physical sector within this selected
 	 * erase block to allocate. */
 
-	for (x = allocblock * dev->sectorsPerBlk; x < allocblock * dev->sectorsPerBlk + dev->availSectPerBlk; x++) {
+	for (i = 0; i < nsectors; i++) {
+		x = allocblock * dev->sectorsPerBlk + (start + i) % nsectors;
+
 		/* Check if this physical sector is available. */
 
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
@@ -3579,6 +4632,57 @@ retry:
 	return physicalsector;
 }
 
+/****************************************************************************
+ * Name: smart_find_collectblock
+ *
+ * Description:  Find the erase block with the most released sectors which
+ *               is not worn completely.  Returns 0xFFFF if no block has
+ *               released sectors.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_WRITABLE
+static uint16_t smart_find_collectblock(FAR struct smart_struct_s *dev)
+{
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	return smart_index_max(dev, &dev->releaseindex, SMART_WEAR_REORG_THRESHOLD);
+#else
+	uint16_t collectblock;
+	uint16_t releasemax;
+	int x;
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+	uint8_t count;
+#endif
+
+	collectblock = 0xFFFF;
+	releasemax = 0;
+	for (x = 0; x < dev->neraseblocks; x++) {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+		/* Don't collect blocks that have been worn completely. */
+
+		if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD) {
+			continue;
+		}
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+		count = smart_get_count(dev, dev->releasecount, x);
+		if (count > releasemax) {
+			releasemax = count;
+			collectblock = x;
+		}
+#else
+		if (dev->releasecount[x] > releasemax) {
+			releasemax = dev->releasecount[x];
+			collectblock = x;
+		}
+#endif
+	}
+
+	return collectblock;
+#endif							/* CONFIG_MTD_SMART_BLOCK_INDEX */
+}
+
 /****************************************************************************
  * Name: smart_garbagecollect
  *
@@ -3588,17 +4692,11 @@ retry:
  *
  ****************************************************************************/
 
-#ifdef CONFIG_FS_WRITABLE
 static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 {
 	uint16_t collectblock;
-	uint16_t releasemax;
 	bool collect = TRUE;
-	int x;
 	int ret;
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-	uint8_t count;
-#endif
 
 	while (collect) {
 		collect = FALSE;
@@ -3622,30 +4720,7 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 		if (collect) {
 			/* Find the block with the most released sectors. */
 
-			collectblock = 0xFFFF;
-			releasemax = 0;
-			for (x = 0; x < dev->neraseblocks; x++) {
-#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
-				/* Don't collect blocks that have been worn completely. */
-
-				if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD) {
-					continue;
-				}
-#endif
-
-#ifdef CONFIG_MTD_SMART_PACK_COUNTS
-				count = smart_get_count(dev, dev->releasecount, x);
-				if (count > releasemax) {
-					releasemax = count;
-					collectblock = x;
-				}
-#else
-				if (dev->releasecount[x] > releasemax) {
-					releasemax = dev->releasecount[x];
-					collectblock = x;
-				}
-#endif
-			}
+			collectblock = smart_find_collectblock(dev);
 			//releasemax = smart_get_count(dev, dev->releasecount, collectblock);
 
 			if (collectblock == 0xFFFF) {
@@ -3684,6 +4759,193 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 
 	return OK;
 }
+
+#ifdef CONFIG_MTD_SMART_BGGC
+/****************************************************************************
+ * Name: smart_bggc_find_empty
+ *
+ * Description:  Find an erase block with only released sectors, whose erase
+ *               was left to the background worker.  Returns 0xFFFF if there
+ *               is none.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_bggc_find_empty(FAR struct smart_struct_s *dev)
+{
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	return dev->releaseindex.head[dev->availSectPerBlk];
+#else
+	uint16_t block;
+
+	for (block = 0; block < dev->neraseblocks; block++) {
+		if (dev->freecount[block] == 0 && dev->releasecount[block] == dev->availSectPerBlk) {
+			return block;
+		}
+	}
+
+	return 0xFFFF;
+#endif
+}
+
+/****************************************************************************
+ * Name: smart_bggc_collect_needed
+ *
+ * Description:  Test if there are blocks to erase or relocate.
+ *
+ ****************************************************************************/
+
+static bool smart_bggc_collect_needed(FAR struct smart_struct_s *dev)
+{
+	if (dev->formatstatus != SMART_FMT_STAT_FORMATTED) {
+		return false;
+	}
+
+	return dev->gcerase || (dev->freesectors < SMART_BGGC_TARGET(dev) && dev->releasesectors > 0);
+}
+
+/****************************************************************************
+ * Name: smart_bggc_needed
+ *
+ * Description:  Test if the background worker has anything to do.
+ *
+ ****************************************************************************/
+
+static bool smart_bggc_needed(FAR struct smart_struct_s *dev)
+{
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	if (smart_checkpoint_due(dev)) {
+		return true;
+	}
+#endif
+
+	return smart_bggc_collect_needed(dev);
+}
+
+/****************************************************************************
+ * Name: smart_bggc_worker
+ *
+ * Description:  Erase the blocks with only released sectors and relocate
+ *               the blocks with the most released sectors until the free
+ *               sector target is met, then take the checkpoint if it is
+ *               due.  It works one erase block at a time and stops as soon
+ *               as a request is waiting for the device, so a request waits
+ *               at most for one block relocation or one checkpoint.
+ *
+ ****************************************************************************/
+
+static void smart_bggc_worker(FAR void *arg)
+{
+	FAR struct smart_struct_s *dev = (FAR struct smart_struct_s *)arg;
+	irqstate_t flags;
+	clock_t idle;
+	uint16_t block;
+	int ret;
+
+	idle = clock_systimer() - dev->lastio;
+	if (idle < SMART_BGGC_IDLE_TICKS || dev->fgwaiters > 0 || sem_trywait(&dev->exclsem) != OK) {
+		/* The device is busy, try again later unless it is being closed.
+		 * smart_close sets gcstop and then cancels the work, so the test
+		 * and the queueing must not be split by it.
+		 */
+
+		flags = enter_critical_section();
+		if (!dev->gcstop) {
+			work_queue(LPWORK, &dev->gcwork, smart_bggc_worker, dev, idle < SMART_BGGC_IDLE_TICKS ? SMART_BGGC_IDLE_TICKS - idle : SMART_BGGC_IDLE_TICKS);
+		}
+		leave_critical_section(flags);
+		return;
+	}
+
+	while (dev->fgwaiters == 0 && smart_bggc_collect_needed(dev)) {
+		block = smart_bggc_find_empty(dev);
+		if (block != 0xFFFF) {
+			fvdbg("Erasing released block %d\n", block);
+			ret = smart_erase_block_if_empty(dev, block, FALSE);
+			if (ret != OK) {
+				/* The block would be found again, leave it to the
+				 * foreground collection.
+				 */
+
+				fdbg("Error %d erasing block %d\n", ret, block);
+				dev->gcerase = false;
+				break;
+			}
+			continue;
+		}
+
+		dev->gcerase = false;
+		if (dev->freesectors >= SMART_BGGC_TARGET(dev)) {
+			break;
+		}
+
+		block = smart_find_collectblock(dev);
+		if (block == 0xFFFF) {
+			break;
+		}
+
+		fvdbg("Collecting block %d, free=%d released=%d\n", block, dev->freecount[block], dev->releasecount[block]);
+		ret = smart_relocate_block(dev, block);
+		if (ret != OK) {
+			fdbg("Error %d collecting block %d\n", ret, block);
+			break;
+		}
+	}
+
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+	if (dev->fgwaiters == 0) {
+		smart_checkpoint_update(dev, false);
+	}
+#endif
+	sem_post(&dev->exclsem);
+}
+
+/****************************************************************************
+ * Name: smart_bggc_lock
+ *
+ * Description:  Take the device for a request.  The worker gives way after
+ *               the erase block it is working on.
+ *
+ ****************************************************************************/
+
+static void smart_bggc_lock(FAR struct smart_struct_s *dev)
+{
+	irqstate_t flags;
+
+	flags = enter_critical_section();
+	dev->fgwaiters++;
+	leave_critical_section(flags);
+
+	while (sem_wait(&dev->exclsem) != OK) {
+		/* The only case that an error should occur here is if
+		 * the wait was awakened by a signal.
+		 */
+
+		ASSERT(*get_errno_ptr() == EINTR);
+	}
+
+	flags = enter_critical_section();
+	dev->fgwaiters--;
+	leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: smart_bggc_unlock
+ *
+ * Description:  Release the device after a request, and schedule the
+ *               worker to run once the device is idle.
+ *
+ ****************************************************************************/
+
+static void smart_bggc_unlock(FAR struct smart_struct_s *dev)
+{
+	dev->lastio = clock_systimer();
+	if (!dev->gcstop && smart_bggc_needed(dev) && work_available(&dev->gcwork)) {
+		work_queue(LPWORK, &dev->gcwork, smart_bggc_worker, dev, SMART_BGGC_IDLE_TICKS);
+	}
+
+	sem_post(&dev->exclsem);
+}
+#endif							/* CONFIG_MTD_SMART_BGGC */
 #endif							/* CONFIG_FS_WRITABLE */
 
 /****************************************************************************
@@ -3972,6 +5234,7 @@ static int smart_write_alloc_sector(FAR struct smart_struct_s *dev, uint16_t log
 
 #ifndef CONFIG_MTD_SMART_ENABLE_CRC
 	fvdbg("Write MTD block ALLOCATION!!! Logical %d -> Physical %d\n", logical, physical);
+	SMART_CHECKPOINT_DIRTY(dev, physical / dev->sectorsPerBlk);
 	ret = MTD_BWRITE(dev->mtd, physical * dev->mtdBlksPerSector, 1, (FAR uint8_t *)dev->rwbuffer);
 	if (ret != 1) {
 		/* The block is not empty!!  What to do? */
@@ -4279,6 +5542,7 @@ static int smart_writesector(FAR struct smart_struct_s *dev, unsigned long arg)
 	/* Now write the sector buffer to the device. */
 	if (needsrelocate) {
 		/* Write the entire sector to the new physical location, uncommitted. */
+		SMART_CHECKPOINT_DIRTY(dev, physsector / dev->sectorsPerBlk);
 #ifdef CONFIG_MTD_SMART_JOURNALING
 		ret = smart_journal_bwrite(dev, physsector);
 #else
@@ -4329,8 +5593,8 @@ static int smart_writesector(FAR struct smart_struct_s *dev, unsigned long arg)
 		smart_add_count(dev, dev->releasecount, block, 1);
 		smart_add_count(dev, dev->freecount, physsector / dev->sectorsPerBlk, -1);
 #else
-		dev->releasecount[block]++;
-		dev->freecount[physsector / dev->sectorsPerBlk]--;
+		SMART_SET_RELEASECOUNT(dev, block, dev->releasecount[block] + 1);
+		SMART_SET_FREECOUNT(dev, physsector / dev->sectorsPerBlk, dev->freecount[physsector / dev->sectorsPerBlk] - 1);
 #endif
 		dev->freesectors--;
 		dev->releasesectors++;
@@ -4351,7 +5615,13 @@ static int smart_writesector(FAR struct smart_struct_s *dev, unsigned long arg)
 
 		/* Test if releasing the sector created an empty erase block. */
 
+#ifdef CONFIG_MTD_SMART_BGGC
+		/* Leave the erase to the background worker. */
+
+		dev->gcerase = true;
+#else
 		smart_erase_block_if_empty(dev, block, FALSE);
+#endif
 
 		/* Since we performed a relocation, do garbage collection to
 		 * ensure we don't fill up our flash with released blocks.
@@ -4361,6 +5631,7 @@ static int smart_writesector(FAR struct smart_struct_s *dev, unsigned long arg)
 
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 		/* Write the entire sector to FLASH when CRC enabled. */
+		SMART_CHECKPOINT_DIRTY(dev, physsector / dev->sectorsPerBlk);
 #ifdef CONFIG_MTD_SMART_JOURNALING
 		ret = smart_journal_bwrite(dev, physsector);
 #else
@@ -4716,7 +5987,7 @@ static int smart_allocsector(FAR struct smart_struct_s *dev, unsigned long reque
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
 	smart_add_count(dev, dev->freecount, physicalsector / dev->sectorsPerBlk, -1);
 #else
-	dev->freecount[physicalsector / dev->sectorsPerBlk]--;
+	SMART_SET_FREECOUNT(dev, physicalsector / dev->sectorsPerBlk, dev->freecount[physicalsector / dev->sectorsPerBlk] - 1);
 #endif
 	dev->freesectors--;
 
@@ -4807,7 +6078,7 @@ static inline int smart_freesector(FAR struct smart_struct_s *dev, unsigned long
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
 	smart_add_count(dev, dev->releasecount, block, 1);
 #else
-	dev->releasecount[block]++;
+	SMART_SET_RELEASECOUNT(dev, block, dev->releasecount[block] + 1);
 #endif
 
 	/* Unmap this logical sector. */
@@ -4821,20 +6092,26 @@ static inline int smart_freesector(FAR struct smart_struct_s *dev, unsigned long
 
 	/* If this block has only released blocks, then erase it. */
 
+#ifdef CONFIG_MTD_SMART_BGGC
+	/* Leave the erase to the background worker. */
+
+	dev->gcerase = true;
+#else
 	smart_erase_block_if_empty(dev, block, FALSE);
+#endif
 
 	return OK;
 }
 #endif							/* CONFIG_FS_WRITABLE */
 
 /****************************************************************************
- * Name: smart_ioctl
+ * Name: smart_ioctl_internal
  *
- * Description: Return device geometry.
+ * Description: Process the ioctl commands of the SMART device.
  *
  ****************************************************************************/
 
-static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
+static int smart_ioctl_internal(FAR struct inode *inode, int cmd, unsigned long arg)
 {
 	FAR struct smart_struct_s *dev;
 	int ret = OK;
@@ -4963,6 +6240,7 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #endif
 #endif
 		dev->rwbuffer[SMART_FMT_FORMAT_POS] = SMART_FORMAT_ENABLE;
+		SMART_CHECKPOINT_DIRTY(dev, psector / dev->sectorsPerBlk);
 		ret = MTD_BWRITE(dev->mtd, psector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
 		if (ret == dev->mtdBlksPerSector) {
 			fdbg("Update Format Info Finished. after reboot, fs will be formatted\n");
@@ -5094,6 +6372,36 @@ ok_out:
 	return ret;
 }
 
+/****************************************************************************
+ * Name: smart_ioctl
+ *
+ * Description: Return device geometry.
+ *
+ ****************************************************************************/
+
+static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
+{
+#if defined(CONFIG_MTD_SMART_BGGC) && defined(CONFIG_FS_WRITABLE)
+	FAR struct smart_struct_s *dev;
+	int ret;
+
+	DEBUGASSERT(inode && inode->i_private);
+#ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
+	dev = ((FAR struct smart_multiroot_device_s *)inode->i_private)->dev;
+#else
+	dev = (FAR struct smart_struct_s *)inode->i_private;
+#endif
+
+	smart_bggc_lock(dev);
+	ret = smart_ioctl_internal(inode, cmd, arg);
+	smart_bggc_unlock(dev);
+
+	return ret;
+#else
+	return smart_ioctl_internal(inode, cmd, arg);
+#endif
+}
+
 #ifdef CONFIG_MTD_SMART_JOURNALING
 /****************************************************************************
  * Name: smart_journal_init
@@ -6057,6 +7365,23 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
 		dev->block_map = NULL;
 		dev->journal_seq = 0;
 #endif
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+		dev->freeindex.head = NULL;
+#endif
+#ifdef CONFIG_MTD_SMART_BGGC
+		sem_init(&dev->exclsem, 0, 1);
+		memset(&dev->gcwork, 0, sizeof(struct work_s));
+		dev->lastio = 0;
+		dev->fgwaiters = 0;
+		dev->gcerase = false;
+		dev->gcstop = false;
+#endif
+#ifdef CONFIG_MTD_SMART_CHECKPOINT
+		dev->cpblocks = 0;
+		dev->cpvalid = false;
+		dev->cpformat = false;
+		dev->cpdisabled = false;
+#endif
 
 		dev->sectorsize = 0;
 		ret = smart_setsectorsize(dev, CONFIG_MTD_SMART_SECTOR_SIZE);
@@ -6160,6 +7485,11 @@ errout:
 	if (dev->sMap != NULL) {
 		smart_free(dev, dev->sMap);
 	}
+#ifdef CONFIG_MTD_SMART_BLOCK_INDEX
+	if (dev->freeindex.head != NULL) {
+		smart_free(dev, dev->freeindex.head);
+	}
+#endif
 #else
 	smart_free(dev, dev->sBitMap);
 	smart_free(dev, dev->sCache);
@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
+#include <sys/sendfile.h>
+#include <stdint.h>
+#include <errno.h>
+
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#include <tinyara/net/net.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sendfile_xip
+ *
+ * Description:
+ *   Send a file in an XIP ROMFS to a socket straight from the flash.  The
+ *   flash does not change while the segments wait for their ACKs, so the
+ *   network stack can reference the file data instead of copying it.
+ *
+ * Returned Value:
+ *   The number of bytes sent, or a negated errno value.  -ENOSYS means the
+ *   file or the socket cannot be used this way.
+ *
+ ****************************************************************************/
+
+static ssize_t sendfile_xip(int outfd, FAR struct file *filep, FAR off_t *offset, size_t count)
+{
+	FAR struct inode *inode = filep->f_inode;
+	FAR const uint8_t *base;
+	struct statfs fsbuf;
+	struct stat st;
+	off_t pos;
+	ssize_t ret;
+
+	if (inode == NULL || !INODE_IS_MOUNTPT(inode) || inode->u.i_mops->statfs == NULL || inode->u.i_mops->fstat == NULL) {
+		return -ENOSYS;
+	}
+
+	if (inode->u.i_mops->statfs(inode, &fsbuf) < 0 || fsbuf.f_type != ROMFS_MAGIC) {
+		return -ENOSYS;
+	}
+
+	/* This fails if the ROMFS is not on a memory mapped media */
+
+	if (file_ioctl(filep, FIOC_MMAP, (unsigned long)&base) < 0) {
+		return -ENOSYS;
+	}
+
+	ret = inode->u.i_mops->fstat(filep, &st);
+	if (ret < 0) {
+		return ret;
+	}
+
+	pos = offset ? *offset : filep->f_pos;
+	if (pos < 0) {
+		return -EINVAL;
+	}
+
+	if (pos >= st.st_size) {
+		return 0;
+	}
+
+	if (count > st.st_size - pos) {
+		count = st.st_size - pos;
+	}
+
+	ret = net_send_ref(outfd, base + pos, count, 0);
+	if (ret < 0) {
+		ret = get_errno();
+		return (ret == EOPNOTSUPP) ? -ENOSYS : -ret;
+	}
+
+	if (offset) {
+		*offset = pos + ret;
+	} else {
+		filep->f_pos = pos + ret;
+	}
+
+	return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sendfile
+ *
+ * Description:
+ *   See sys/sendfile.h.  Files in an XIP ROMFS are sent to TCP sockets
+ *   without copying, everything else goes through lib_sendfile().
+ *
+ ****************************************************************************/
+
+ssize_t sendfile(int outfd, int infd, FAR off_t *offset, size_t count)
+{
+	FAR struct file *filep;
+	ssize_t ret;
+
+	if ((unsigned int)outfd >= CONFIG_NFILE_DESCRIPTORS && fs_getfilep(infd, &filep) == OK) {
+		ret = sendfile_xip(outfd, filep, offset, count);
+		if (ret != -ENOSYS) {
+			if (ret < 0) {
+				set_errno(-ret);
+				return ERROR;
+			}
+			return ret;
+		}
+	}
+
+	return lib_sendfile(outfd, infd, offset, count);
+}
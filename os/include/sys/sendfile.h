@@ -132,6 +132,12 @@ extern "C" {
 
 ssize_t sendfile(int outfd, int infd, FAR off_t *offset, size_t count);
 
+#ifdef CONFIG_NET_SENDFILE
+/* The read/write loop of sendfile(), used for what cannot be sent in place */
+
+ssize_t lib_sendfile(int outfd, int infd, FAR off_t *offset, size_t count);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -46,10 +46,17 @@ enum logm_loglevel_e {
 enum logm_param_type_e {
 	LOGM_BUFSIZE,
 	LOGM_INTERVAL,
-	LOGM_PRIORITY
+	LOGM_PRIORITY,
+	LOGM_MODE
 	/* This would grow later */
 };
 
+/* Record modes of logm buffer, used with LOGM_MODE */
+enum logm_mode_e {
+	LOGM_MODE_TEXT,	  /* Messages are formatted by the caller */
+	LOGM_MODE_BINARY  /* Raw arguments are queued and formatted by logm task */
+};
+
 /* Log flags for somethings related to logging */
 enum logm_logflag_e {
 	LOGM_NORMAL,
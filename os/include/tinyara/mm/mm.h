@@ -64,6 +64,9 @@
 #include <debug.h>
 #include <stdint.h>
 #include <tinyara/mm/heap_regioninfo.h>
+#ifdef CONFIG_MM_SIZECLASS
+#include <tinyara/spinlock.h>
+#endif
 #ifdef CONFIG_HEAPINFO_USER_GROUP
 #include <tinyara/mm/heapinfo_internal.h>
 #endif
@@ -340,6 +343,34 @@ struct mm_delaynode_s
 	FAR struct mm_delaynode_s *flink;
 };
 
+#ifdef CONFIG_MM_SIZECLASS
+/* Chunks of up to CONFIG_MM_SIZECLASS_MAXSIZE bytes are cached in one list
+ * per chunk size.  A chunk size (including the allocnode) is a multiple of
+ * MM_MIN_CHUNK, so the list index is simply the number of granules - 1.
+ */
+
+#define MM_SIZECLASS_NCLASSES   (MM_ALIGN_UP(CONFIG_MM_SIZECLASS_MAXSIZE + SIZEOF_MM_ALLOCNODE) >> MM_MIN_SHIFT)
+#define MM_SIZECLASS_NDX(size)  (((size) >> MM_MIN_SHIFT) - 1)
+#define MM_SIZECLASS_FITS(size) ((size) >= SIZEOF_MM_ALLOCNODE + sizeof(struct mm_cachenode_s) && \
+				 (size) <= (MM_SIZECLASS_NCLASSES << MM_MIN_SHIFT))
+
+/* Marker in allocnode 'reserved' of a cached chunk */
+
+#define MM_SIZECLASS_CACHED     0x5343
+
+/* A cached chunk keeps MM_ALLOC_BIT, its payload is used as a list link */
+
+struct mm_cachenode_s {
+	FAR struct mm_cachenode_s *flink;
+	uint32_t magic;
+};
+
+struct mm_sizeclass_s {
+	FAR struct mm_cachenode_s *head;
+	uint16_t count;
+};
+#endif
+
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 struct heapinfo_tcb_info_s {
 	int pid;
@@ -425,6 +456,15 @@ struct mm_heap_s {
 
 	FAR struct mm_delaynode_s *mm_delaylist[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_MM_SIZECLASS
+	/* Per-CPU lists of cached small chunks, their total size and the lock
+	 * which protects both.
+	 */
+
+	struct mm_sizeclass_s mm_sizeclass[CONFIG_SMP_NCPUS][MM_SIZECLASS_NCLASSES];
+	size_t mm_sizeclass_cached[CONFIG_SMP_NCPUS];
+	spinlock_t mm_sizeclass_lock[CONFIG_SMP_NCPUS];
+#endif
 };
 
 /****************************************************************************
@@ -443,6 +443,24 @@ int net_vfcntl(int sockfd, int cmd, va_list ap);
 
 int net_ioctl(int sockfd, int cmd, unsigned long arg);
 
+#ifdef CONFIG_NET_SENDFILE
+/****************************************************************************
+ * Name: net_send_ref
+ *
+ * Description:
+ *   Send data on a TCP socket without copying it into the send buffer.  The
+ *   data must stay unchanged until the peer has acknowledged it, so this is
+ *   used by sendfile() for files in XIP flash only.
+ *
+ * Returned Value:
+ *   The number of bytes sent; -1 on failure with errno set.  ENOSYS means
+ *   the socket cannot send without copying.
+ *
+ ****************************************************************************/
+
+ssize_t net_send_ref(int sockfd, FAR const void *data, size_t size, int flags);
+#endif
+
 /****************************************************************************
  * Function: netdev_foreach
  *
@@ -21,6 +21,9 @@
 
 #define NM_MAX_HWADDR_LEN 6
 
+/* Frames taken by network stack at once in netdev_input_batch */
+#define NETDEV_INPUT_BATCH_MAX 16
+
 #ifndef IFNAMSIZ
 #define IFNAMSIZ           6	/* Older naming standard */
 #endif
@@ -83,6 +86,12 @@ struct nic_io_ops {
 	int (*igmp_mac_filter)(struct netdev *netif, const struct in_addr *group, netdev_mac_filter_action action);
 };
 
+/* A received frame passed to netdev_input_batch() */
+struct netdev_frame {
+	void *data; /* if NET_NETMGR_ZEROCOPY is enabled then it's pbuf */
+	uint16_t len; /* if NET_NETMGR_ZEROCOPY is enabled then it's 0 */
+};
+
 struct netdev_config {
 	struct nic_io_ops *ops;
 	int flag;
@@ -126,6 +135,21 @@ struct netdev *netdev_register(struct netdev_config *config);
  * On error: return -1;
  */
 int netdev_input(struct netdev *dev, void *data, uint16_t len);
+/*
+ * DESC:
+ * NIC driver can call following function to pass all the frames it received
+ * in one wake-up to network stack at once. The stack takes them with one lock
+ * or one message for up to NETDEV_INPUT_BATCH_MAX frames instead of one per frame.
+ * Unlike netdev_input, the frames are always consumed, the ones the stack can't
+ * take are dropped and freed.
+ * PARAMETER
+ * dev: network device which send data to network stack
+ * frames: frames received
+ * count: number of frames
+ * RETURN
+ * the number of frames passed to network stack
+ */
+int netdev_input_batch(struct netdev *dev, struct netdev_frame *frames, int count);
 /**
  * Configuration
  */
@@ -79,6 +79,7 @@ typedef int (*lib_getc_t)(FAR struct lib_instream_s *this);
 
 struct lib_outstream_s;
 typedef void (*lib_putc_t)(FAR struct lib_outstream_s *this, int ch);
+typedef void (*lib_puts_t)(FAR struct lib_outstream_s *this, FAR const void *buf, int len);
 typedef int (*lib_flush_t)(FAR struct lib_outstream_s *this);
 
 /**
@@ -97,6 +98,8 @@ struct lib_instream_s {
  */
 struct lib_outstream_s {
 	lib_putc_t put;				/* Put one character to the outstream */
+	lib_puts_t puts;			/* Put a run of characters to the outstream.
+								 * May be NULL, then put is used per character */
 #ifdef CONFIG_STDIO_LINEBUFFER
 	lib_flush_t flush;			/* Flush any buffered characters in the outstream */
 #endif
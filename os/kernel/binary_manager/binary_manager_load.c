@@ -37,6 +37,7 @@
 #include <sys/boardctl.h>
 
 #include <tinyara/irq.h>
+#include <tinyara/clock.h>
 #include <tinyara/mm/mm.h>
 #include <tinyara/sched.h>
 #include <tinyara/init.h>
@@ -115,16 +116,23 @@ static int binary_manager_load_binary(int bin_idx, char *path, load_attr_t *load
 {
 	int ret;
 	int retry_count;
+#ifdef CONFIG_DEBUG_BINMGR_ERROR
+	clock_t load_start;
+#endif
 
 	retry_count = 0;
 	while (retry_count < BINMGR_LOADING_TRYCNT) {
+#ifdef CONFIG_DEBUG_BINMGR_ERROR
+		load_start = clock_systimer();
+#endif
 		ret = load_binary(bin_idx, path, load_attr);
 		if (ret >= 0) {
 			/* Set the data in table from header */
 			BIN_LOAD_ATTR(bin_idx) = *load_attr;
 			strncpy(BIN_NAME(bin_idx), load_attr->bin_name, BIN_NAME_MAX);
-			bmdbg("Load success! [Name: %s] [Version: %d] [Partition: %s] [Text start : 0x%08x] %s\n", BIN_NAME(bin_idx), 
-					BIN_LOADVER(bin_idx), GET_PARTNAME(BIN_USEIDX(bin_idx)), elf_find_text_section_addr(bin_idx), BINARY_COMP_TYPE);
+			bmdbg("Load success! [Name: %s] [Version: %d] [Partition: %s] [Text start : 0x%08x] [Load time: %u ms] %s\n", BIN_NAME(bin_idx),
+					BIN_LOADVER(bin_idx), GET_PARTNAME(BIN_USEIDX(bin_idx)), elf_find_text_section_addr(bin_idx),
+					(unsigned int)TICK2MSEC(clock_systimer() - load_start), BINARY_COMP_TYPE);
 			return OK;
 		} else if (errno == ENOMEM) {
 			/* Sleep for a moment to get available memory */
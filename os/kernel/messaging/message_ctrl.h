@@ -61,6 +61,7 @@
 
 int messaging_save_receiver(char *port_name, pid_t recv_pid, int recv_prio);
 int messaging_read_list(char *port_name, int *recv_arr, int *total_cnt);
+int messaging_read_receivers(char *port_name, int *pid_arr, int *regid_arr, int max_cnt);
 int messaging_remove_list(char *port_name);
 void messaging_initialize(void);
 #endif							/* __KERNEL_MESSAGING_MESSAGE_CTRL_H */
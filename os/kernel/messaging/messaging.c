@@ -71,9 +71,6 @@
 
 #define MSG_MAX_PORT_NAME 64
 
-#define MSG_RECV_EXIST   0
-#define MSG_RECV_NOEXIST 1
-
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
@@ -91,6 +88,7 @@ struct msg_recv_node_s {
 	struct msg_recv_node_s *flink;
 	pid_t pid;
 	int prio;
+	int regid;
 };
 typedef struct msg_recv_node_s msg_recv_node_t;
 
@@ -105,6 +103,12 @@ static sem_t port_list_sem;
  ****************************************************************************/
 static sq_queue_t g_port_node_list;
 static int curr_recv_cnt;;
+
+/* Registration id of the last saved receiver. A receiver which registers
+ * again gets a new id, so that senders can find out that its message queue
+ * was recreated.
+ */
+static int g_recv_regid;
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -120,6 +124,7 @@ static int messaging_append_receiver(pid_t pid, int prio, sq_queue_t *queue)
 	}
 	recv_node->pid = pid;
 	recv_node->prio = prio;
+	recv_node->regid = ++g_recv_regid;
 
 	/* Append recv node by decreasing order. */
 	next_node = (msg_recv_node_t *)sq_peek(queue);
@@ -153,18 +158,18 @@ static int messaging_append_receiver(pid_t pid, int prio, sq_queue_t *queue)
 	return OK;
 }
 
-static int messaging_check_recv_exist(int recv_pid, sq_queue_t *queue)
+static msg_recv_node_t *messaging_find_receiver(int recv_pid, sq_queue_t *queue)
 {
 	msg_recv_node_t *recv_node;
 	recv_node = (msg_recv_node_t *)sq_peek(queue);
 	while (recv_node != NULL) {
 		if (recv_node->pid == recv_pid) {
-			return MSG_RECV_EXIST;
+			return recv_node;
 		}
 		recv_node = (msg_recv_node_t *)sq_next(recv_node);
 	}
 
-	return MSG_RECV_NOEXIST;
+	return NULL;
 }
 /****************************************************************************
  * Public Functions
@@ -191,12 +196,19 @@ int messaging_save_receiver(char *port_name, pid_t recv_pid, int recv_prio)
 {
 	int ret;
 	msg_port_node_t *port_node;
+	msg_recv_node_t *recv_node;
 
 	port_node = (msg_port_node_t *)sq_peek(&g_port_node_list);
 	while (port_node != NULL) {
 		if (strncmp(port_node->port_name, port_name, strlen(port_name) + 1) == 0) {
-			ret = messaging_check_recv_exist(recv_pid, &port_node->recv_node_list);
-			if (ret == MSG_RECV_EXIST) {
+			recv_node = messaging_find_receiver(recv_pid, &port_node->recv_node_list);
+			if (recv_node != NULL) {
+				/* The receiver waits again with a new message queue,
+				 * so the queue which senders opened before is stale.
+				 */
+				sem_wait(&port_node->port_sem);
+				recv_node->regid = ++g_recv_regid;
+				sem_post(&port_node->port_sem);
 				return OK;
 			}
 			port_node->nreceiver++;
@@ -296,6 +308,53 @@ int messaging_read_list(char *port_name, int *recv_arr, int *total_cnt)
 	return ERROR;
 }
 
+/****************************************************************************
+ * Name: messaging_read_receivers
+ *
+ * Description:
+ *   Read the pid and the registration id of the receivers of the port at once.
+ *
+ * Parameters:
+ *   port_name - A message port name
+ *   pid_arr   - An array to get pids of receivers
+ *   regid_arr - An array to get registration ids of receivers
+ *   max_cnt   - The number of entries of pid_arr and regid_arr
+ *
+ * Return Value:
+ *   Return the number of receivers who wait the port. It can be larger than
+ *   max_cnt, then only max_cnt receivers are read.
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+int messaging_read_receivers(char *port_name, int *pid_arr, int *regid_arr, int max_cnt)
+{
+	int recv_cnt = 0;
+	msg_port_node_t *port_node;
+	msg_recv_node_t *recv_node;
+
+	port_node = (msg_port_node_t *)sq_peek(&g_port_node_list);
+	while (port_node != NULL) {
+		if (strncmp(port_node->port_name, port_name, strlen(port_name) + 1) == 0) {
+			sem_wait(&port_node->port_sem);
+			recv_node = (msg_recv_node_t *)sq_peek(&port_node->recv_node_list);
+			while (recv_node != NULL) {
+				if (recv_cnt < max_cnt) {
+					pid_arr[recv_cnt] = recv_node->pid;
+					regid_arr[recv_cnt] = recv_node->regid;
+				}
+				recv_cnt++;
+				recv_node = (msg_recv_node_t *)sq_next(recv_node);
+			}
+			sem_post(&port_node->port_sem);
+			break;
+		}
+		port_node = (msg_port_node_t *)sq_next(port_node);
+	}
+
+	return recv_cnt;
+}
+
 /****************************************************************************
  * Name: messaging_remove_recv_node
  *
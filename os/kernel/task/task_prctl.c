@@ -235,10 +235,23 @@ int prctl(int option, ...)
 		return ret;
 	}
 	break;
+	case PR_MSG_READ_ID:
+	{
+		int ret;
+		char *port_name = va_arg(ap, char *);
+		int *pid_arr = va_arg(ap, int *);
+		int *regid_arr = va_arg(ap, int *);
+		int max_cnt = va_arg(ap, int);
+		ret = messaging_read_receivers(port_name, pid_arr, regid_arr, max_cnt);
+		va_end(ap);
+		return ret;
+	}
+	break;
 #else /* CONFIG_MESSAGING_IPC */
 	case PR_MSG_SAVE:
 	case PR_MSG_READ:
 	case PR_MSG_REMOVE:
+	case PR_MSG_READ_ID:
 	{
 		sdbg("Not supported.\n");
 		err = ENOSYS;
@@ -47,6 +47,7 @@ static void logm_putc(FAR struct lib_outstream_s *this, int ch)
 static void logm_outstream(FAR struct lib_outstream_s *outstream)
 {
 	outstream->put = logm_putc;
+	outstream->puts = NULL;
 #ifdef CONFIG_STDIO_LINEBUFFER
 	outstream->flush = lib_noflush;
 #endif
@@ -58,13 +59,30 @@ static void logm_flush(struct lib_outstream_s *stream)
 {
 	sched_lock();
 
-	while (g_logm_head != g_logm_tail) {
-		stream->put(stream, g_logm_rsvbuf[g_logm_head]);
-		g_logm_head = (g_logm_head + 1) % logm_bufsize;
-	}
+#ifdef CONFIG_LOGM_BINARY
+	if (LOGM_STATUS(LOGM_BINARY_RECORD)) {
+		/* The ring holds records, not text. They are left to logm_task
+		 * if it is in the middle of draining them.
+		 */
+		logm_binary_flush(stream);
+
+		/* Producers stay blocked by the overflow state until the records
+		 * which filled the ring are really printed.
+		 */
+		if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW) && logm_binary_isempty()) {
+			LOGM_STATUS_CLEAR(LOGM_BUFFER_OVERFLOW);
+		}
+	} else
+#endif
+	{
+		while (g_logm_head != g_logm_tail) {
+			stream->put(stream, g_logm_rsvbuf[g_logm_head]);
+			g_logm_head = (g_logm_head + 1) % logm_bufsize;
+		}
 
-	if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
-		LOGM_STATUS_CLEAR(LOGM_BUFFER_OVERFLOW);
+		if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
+			LOGM_STATUS_CLEAR(LOGM_BUFFER_OVERFLOW);
+		}
 	}
 
 	/* Reset nput in stream for next stream */
@@ -83,14 +101,26 @@ int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 #ifdef CONFIG_LOGM_TIMESTAMP
 	struct timespec ts;
 #endif
+#ifdef CONFIG_LOGM_BENCHMARK
+	uint32_t cycles;
+#endif
 
 	if (LOGM_STATUS(LOGM_READY) && !LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ) \
 		&& flag == LOGM_NORMAL && !up_interrupt_context()) {
 
+#ifdef CONFIG_LOGM_BINARY
+		if (LOGM_STATUS(LOGM_BINARY_RECORD)) {
+			/* Only raw arguments are queued, logm_task formats them later */
+			return logm_binary_put(priority, fmt, ap);
+		}
+#endif
+
 		flags = enter_critical_section();
+		LOGM_BENCH_CS_START(cycles);
 
 		if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
 			g_logm_dropmsg_count++;
+			LOGM_BENCH_CS_END(cycles);
 			leave_critical_section(flags);
 			return 0;
 		}
@@ -113,6 +143,7 @@ int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 			g_logm_dropmsg_count = 1;
 			g_logm_overflow_offset = g_logm_tail;
 		}
+		LOGM_BENCH_CS_END(cycles);
 		leave_critical_section(flags);
 	} else {
 		/* Low Output: Sytem is not yet completely ready or this is called from interrupt handler */
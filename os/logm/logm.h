@@ -20,6 +20,9 @@
 
 #include <tinyara/config.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <tinyara/streams.h>
 
 /****************************************************************************
  * Preprocessor Definitions
@@ -46,16 +49,87 @@
 #define LOGM_READY BIT(0)
 #define LOGM_BUFFER_RESIZE_REQ BIT(1)
 #define LOGM_BUFFER_OVERFLOW BIT(2)
+#define LOGM_BINARY_RECORD BIT(3)
+#define LOGM_MODE_CHANGE_REQ BIT(4)
 
 #define LOGM_STATUS(a) (logm_status & (a))
 #define LOGM_STATUS_SET(a) (logm_status |= (a))
 #define LOGM_STATUS_CLEAR(a) (logm_status &= ~(a))
 
+#ifdef CONFIG_LOGM_BINARY
+#ifdef CONFIG_LOGM_BINARY_MAXARGS
+#define LOGM_BINARY_MAXARGS CONFIG_LOGM_BINARY_MAXARGS
+#else
+#define LOGM_BINARY_MAXARGS (8)
+#endif
+
+#ifdef CONFIG_LOGM_BINARY_STRMAX
+#define LOGM_BINARY_STRMAX CONFIG_LOGM_BINARY_STRMAX
+#else
+#define LOGM_BINARY_STRMAX (64)
+#endif
+
+#define LOGM_BINARY_MAGIC (0x4c42)
+
+/* Record flags */
+#define LOGM_BINREC_TRUNCATED BIT(0)
+#endif
+
+#ifdef CONFIG_LOGM_PERCPU
+#define LOGM_NCPUS CONFIG_SMP_NCPUS
+#else
+#define LOGM_NCPUS 1
+#endif
+
+#ifdef CONFIG_LOGM_BENCHMARK
+#define LOGM_BENCH_CS_START(c) ((c) = logm_bench_getcycles())
+#define LOGM_BENCH_CS_END(c) logm_bench_cs_update(c)
+#else
+#define LOGM_BENCH_CS_START(c)
+#define LOGM_BENCH_CS_END(c)
+#endif
+
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
 
-/* Structure for a single debug message */
+#ifdef CONFIG_LOGM_BINARY
+/* Header of a deferred binary log record.
+ * The raw arguments follow the header in the order they appear in fmt,
+ * each one with its natural size. A string argument is stored as
+ * a 16bit length followed by its characters (without terminating null).
+ */
+
+struct logm_binhdr_s {
+	uint16_t magic;				/* LOGM_BINARY_MAGIC, used to detect corruption */
+	uint16_t size;				/* Total record size including this header */
+	uint8_t nargs;				/* Number of stored arguments */
+	uint8_t priority;			/* Log priority */
+	uint8_t flags;				/* LOGM_BINREC_xxx */
+	uint8_t reserved;
+	const char *fmt;			/* Format string, formatted later by logm_task */
+	uint32_t sec;				/* Timestamp taken when the record was queued */
+	uint32_t nsec;
+};
+#endif
+
+#ifdef CONFIG_LOGM_PERCPU
+/* Single-producer ring of one CPU. The owner CPU only moves tail and
+ * logm_task only moves head, so no global lock is needed.
+ */
+
+struct logm_cpubuf_s {
+	char *buf;					/* Slice of g_logm_rsvbuf for this CPU */
+	int size;					/* Size of the slice */
+	volatile int head;			/* Written by logm_task only */
+	volatile int tail;			/* Written by the owner CPU only */
+	volatile bool overflow;		/* Messages are dropped until logm_task consumes a record */
+	volatile uint8_t busy;		/* Owner CPU is writing into the ring */
+	int overflow_offset;		/* Tail when overflow happened, -1 if none */
+	int dropmsg_count;			/* Dropped messages since last overflow */
+	uint32_t dropmsg_total;		/* Dropped messages since boot */
+};
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -74,12 +148,32 @@ EXTERN int logm_bufsize;
 EXTERN uint8_t logm_status;
 EXTERN volatile int new_logm_bufsize;
 EXTERN volatile int logm_print_interval;
+#ifdef CONFIG_LOGM_BINARY
+EXTERN volatile int new_logm_mode;
+#endif
+#ifdef CONFIG_LOGM_PERCPU
+EXTERN struct logm_cpubuf_s g_logm_cpubuf[LOGM_NCPUS];
+#endif
 
 /************************************************************************************
  * Private Function Prototypes
  ************************************************************************************/
 int logm_task(int argc, char *argv[]);
 void logm_register_tashcmds(void);
+#ifdef CONFIG_LOGM_BINARY
+int logm_binary_put(int priority, const char *fmt, va_list ap);
+void logm_binary_flush(struct lib_outstream_s *stream);
+bool logm_binary_isempty(void);
+#endif
+#ifdef CONFIG_LOGM_PERCPU
+void logm_percpu_init(char *buf, int bufsize);
+void logm_percpu_quiesce(void);
+#endif
+#ifdef CONFIG_LOGM_BENCHMARK
+uint32_t logm_bench_getcycles(void);
+void logm_bench_cs_update(uint32_t start);
+int logm_benchmark(int count);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -0,0 +1,197 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <arch/irq.h>
+#include <tinyara/clock.h>
+#include <tinyara/logm.h>
+#include "logm.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_ARCH_ARMV7M_FAMILY) || defined(CONFIG_ARCH_ARMV8M_FAMILY)
+/* Cycle counter of the Data Watchpoint and Trace unit */
+#define LOGM_DEMCR              (*(volatile uint32_t *)0xe000edfc)
+#define LOGM_DEMCR_TRCENA       (1 << 24)
+#define LOGM_DWT_CTRL           (*(volatile uint32_t *)0xe0001000)
+#define LOGM_DWT_CTRL_CYCCNTENA (1 << 0)
+#define LOGM_DWT_CYCCNT         (*(volatile uint32_t *)0xe0001004)
+#define LOGM_CYCLE_UNIT         "cycles"
+#elif defined(CONFIG_ARCH_ARMV7A_FAMILY) || defined(CONFIG_ARCH_ARMV7R_FAMILY)
+#define LOGM_CYCLE_UNIT         "cycles"
+#else
+/* No cycle counter, fall back to system ticks */
+#define LOGM_CYCLE_UNIT         "ticks"
+#endif
+
+#define LOGM_BENCH_MODE_WAIT    (100 * 1000)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static volatile uint32_t g_logm_cs_max;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void logm_bench_enable_counter(void)
+{
+#if defined(CONFIG_ARCH_ARMV7M_FAMILY) || defined(CONFIG_ARCH_ARMV8M_FAMILY)
+	LOGM_DEMCR |= LOGM_DEMCR_TRCENA;
+	LOGM_DWT_CYCCNT = 0;
+	LOGM_DWT_CTRL |= LOGM_DWT_CTRL_CYCCNTENA;
+#elif defined(CONFIG_ARCH_ARMV7A_FAMILY) || defined(CONFIG_ARCH_ARMV7R_FAMILY)
+	uint32_t pmcr;
+
+	/* Enable PMU and cycle counter (PMCR.E, PMCNTENSET.C) */
+	__asm__ __volatile__("mrc p15, 0, %0, c9, c12, 0" : "=r"(pmcr));
+	pmcr |= 1;
+	__asm__ __volatile__("mcr p15, 0, %0, c9, c12, 0" : : "r"(pmcr));
+	__asm__ __volatile__("mcr p15, 0, %0, c9, c12, 1" : : "r"(0x80000000));
+#endif
+}
+
+static int logm_bench_setmode(int mode)
+{
+	int cur;
+	int retry = 50;
+
+	if (logm_set_values(LOGM_MODE, mode) != 0) {
+		return ERROR;
+	}
+
+	/* logm task switches the mode after flushing queued messages */
+	do {
+		logm_get_values(LOGM_MODE, &cur);
+		if (cur == mode) {
+			return OK;
+		}
+		usleep(LOGM_BENCH_MODE_WAIT);
+	} while (--retry > 0);
+
+	return ERROR;
+}
+
+/* Number of dropped messages. With per-CPU buffers each CPU counts its own. */
+
+static uint32_t logm_bench_dropped(void)
+{
+#ifdef CONFIG_LOGM_PERCPU
+	uint32_t total = 0;
+	int cpu;
+
+	for (cpu = 0; cpu < LOGM_NCPUS; cpu++) {
+		total += g_logm_cpubuf[cpu].dropmsg_total;
+	}
+	return total;
+#else
+	return g_logm_dropmsg_count;
+#endif
+}
+
+static void logm_bench_run(const char *name, int count)
+{
+	uint32_t start;
+	uint32_t total;
+	uint32_t dropped;
+	int i;
+
+	g_logm_cs_max = 0;
+	dropped = logm_bench_dropped();
+
+	start = logm_bench_getcycles();
+	for (i = 0; i < count; i++) {
+		logm(LOGM_NORMAL, LOGM_UNKNOWN, LOGM_INF, "logm bench %d/%d val=0x%08x name=%s\n", i, count, i * 31, name);
+	}
+	total = logm_bench_getcycles() - start;
+
+	/* Let logm task drain the buffer before printing the result */
+	usleep(logm_print_interval * 2);
+
+	fprintf(stdout, "[LOGM BENCH] %-6s : %u %s per call, worst critical section %u %s",
+			name, total / count, LOGM_CYCLE_UNIT, g_logm_cs_max, LOGM_CYCLE_UNIT);
+	if (logm_bench_dropped() != dropped) {
+		fprintf(stdout, " (messages dropped, use a smaller count)");
+	}
+	fprintf(stdout, "\n");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+uint32_t logm_bench_getcycles(void)
+{
+#if defined(CONFIG_ARCH_ARMV7M_FAMILY) || defined(CONFIG_ARCH_ARMV8M_FAMILY)
+	return LOGM_DWT_CYCCNT;
+#elif defined(CONFIG_ARCH_ARMV7A_FAMILY) || defined(CONFIG_ARCH_ARMV7R_FAMILY)
+	uint32_t ccnt;
+
+	__asm__ __volatile__("mrc p15, 0, %0, c9, c13, 0" : "=r"(ccnt));
+	return ccnt;
+#else
+	return (uint32_t)clock_systimer();
+#endif
+}
+
+/* Called with interrupts disabled at the end of each critical section */
+
+void logm_bench_cs_update(uint32_t start)
+{
+	uint32_t elapsed = logm_bench_getcycles() - start;
+
+	if (elapsed > g_logm_cs_max) {
+		g_logm_cs_max = elapsed;
+	}
+}
+
+/* Measure cost of logm calls in text and binary mode */
+
+int logm_benchmark(int count)
+{
+	int mode;
+
+	if (count <= 0) {
+		return ERROR;
+	}
+
+	logm_bench_enable_counter();
+	logm_get_values(LOGM_MODE, &mode);
+
+	if (logm_bench_setmode(LOGM_MODE_TEXT) == OK) {
+		logm_bench_run("text", count);
+	} else {
+		fprintf(stdout, "[LOGM BENCH] text   : not available\n");
+	}
+#ifdef CONFIG_LOGM_BINARY
+	if (logm_bench_setmode(LOGM_MODE_BINARY) == OK) {
+		logm_bench_run("binary", count);
+	}
+
+	/* Restore the original mode */
+	(void)logm_bench_setmode(mode);
+#endif
+
+	return OK;
+}
@@ -0,0 +1,767 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <arch/irq.h>
+#include <tinyara/arch.h>
+#include <tinyara/logm.h>
+#include <tinyara/streams.h>
+#include <tinyara/clock.h>
+#ifdef CONFIG_LOGM_PERCPU
+#include <tinyara/spinlock.h>
+#endif
+#include "logm.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Argument classes of a conversion specification */
+
+enum logm_argtype_e {
+	LOGM_ARG_NONE,				/* No argument, e.g. "%%" */
+	LOGM_ARG_INT,
+	LOGM_ARG_LONG,
+	LOGM_ARG_LLONG,
+	LOGM_ARG_PTR,
+	LOGM_ARG_DOUBLE,
+	LOGM_ARG_STR
+};
+
+union logm_binarg_u {
+	int i;
+	long l;
+	long long ll;
+	void *p;
+	double d;
+	const char *s;
+};
+
+/* A record collected from the caller's arguments, before it is queued */
+
+struct logm_binrec_s {
+	struct logm_binhdr_s hdr;
+	union logm_binarg_u args[LOGM_BINARY_MAXARGS];
+	uint8_t types[LOGM_BINARY_MAXARGS];
+	uint16_t slen[LOGM_BINARY_MAXARGS];
+	int size;
+};
+
+/* Maximum length of a single conversion specification, e.g. "%-08.3lld" */
+
+#define LOGM_SPEC_MAX 16
+
+/* Room for a specification with both '*' replaced by int values */
+
+#define LOGM_SPEC_BUFLEN (LOGM_SPEC_MAX + 24)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Set while a consumer drains the binary records. logm_task and the low
+ * output path of logm_internal can both flush, but only one at a time may
+ * move the head.
+ */
+
+static volatile bool g_logm_binary_flushing;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Parse one conversion specification. fmt points right after '%'.
+ * Returns the position after the conversion character.
+ */
+
+static const char *logm_parse_spec(const char *fmt, uint8_t *type, int *nstars)
+{
+	int lcount = 0;
+
+	*nstars = 0;
+
+	while (*fmt == '-' || *fmt == '+' || *fmt == ' ' || *fmt == '#' || *fmt == '0') {
+		fmt++;
+	}
+
+	if (*fmt == '*') {
+		(*nstars)++;
+		fmt++;
+	} else {
+		while (*fmt >= '0' && *fmt <= '9') {
+			fmt++;
+		}
+	}
+
+	if (*fmt == '.') {
+		fmt++;
+		if (*fmt == '*') {
+			(*nstars)++;
+			fmt++;
+		} else {
+			while (*fmt >= '0' && *fmt <= '9') {
+				fmt++;
+			}
+		}
+	}
+
+	while (*fmt == 'h' || *fmt == 'l' || *fmt == 'z' || *fmt == 'j' || *fmt == 't' || *fmt == 'L') {
+		if (*fmt == 'l') {
+			lcount++;
+		} else if (*fmt == 'j') {
+			lcount = 2;
+		} else if (*fmt == 'z' || *fmt == 't') {
+			lcount = 1;
+		}
+		fmt++;
+	}
+
+	switch (*fmt) {
+	case 'd':
+	case 'i':
+	case 'u':
+	case 'x':
+	case 'X':
+	case 'o':
+	case 'c':
+		*type = (lcount >= 2) ? LOGM_ARG_LLONG : (lcount == 1) ? LOGM_ARG_LONG : LOGM_ARG_INT;
+		break;
+	case 's':
+		*type = LOGM_ARG_STR;
+		break;
+	case 'p':
+	case 'n':
+		*type = LOGM_ARG_PTR;
+		break;
+	case 'f':
+	case 'F':
+	case 'e':
+	case 'E':
+	case 'g':
+	case 'G':
+	case 'a':
+	case 'A':
+		*type = LOGM_ARG_DOUBLE;
+		break;
+	case '\0':
+		*type = LOGM_ARG_NONE;
+		return fmt;
+	default:
+		*type = LOGM_ARG_NONE;
+		break;
+	}
+
+	return fmt + 1;
+}
+
+static int logm_argsize(uint8_t type)
+{
+	switch (type) {
+	case LOGM_ARG_INT:
+		return sizeof(int);
+	case LOGM_ARG_LONG:
+		return sizeof(long);
+	case LOGM_ARG_LLONG:
+		return sizeof(long long);
+	case LOGM_ARG_PTR:
+		return sizeof(void *);
+	case LOGM_ARG_DOUBLE:
+		return sizeof(double);
+	default:
+		return 0;
+	}
+}
+
+/* Copy data into the ring at offset and return the next offset */
+
+static int logm_ring_write(char *buf, int bufsize, int offset, const void *data, int len)
+{
+	int first = bufsize - offset;
+
+	if (len <= first) {
+		memcpy(&buf[offset], data, len);
+	} else {
+		memcpy(&buf[offset], data, first);
+		memcpy(buf, (const char *)data + first, len - first);
+	}
+
+	return (offset + len) % bufsize;
+}
+
+/* Copy data out of the ring at offset and return the next offset */
+
+static int logm_ring_read(const char *buf, int bufsize, int offset, void *data, int len)
+{
+	int first = bufsize - offset;
+
+	if (len <= first) {
+		memcpy(data, &buf[offset], len);
+	} else {
+		memcpy(data, &buf[offset], first);
+		memcpy((char *)data + first, buf, len - first);
+	}
+
+	return (offset + len) % bufsize;
+}
+
+/* Replace '*' in spec with the stored width/precision values */
+
+static void logm_expand_stars(char *spec, int speclen, const int *stars, int nstars)
+{
+	char tmp[LOGM_SPEC_BUFLEN];
+	int len = 0;
+	int idx = 0;
+	int i;
+
+	for (i = 0; i < speclen; i++) {
+		if (spec[i] == '*' && idx < nstars) {
+			len += snprintf(&tmp[len], sizeof(tmp) - len, "%d", stars[idx++]);
+		} else {
+			tmp[len++] = spec[i];
+		}
+	}
+	tmp[len] = '\0';
+
+	strcpy(spec, tmp);
+}
+
+/* Format a single record whose arguments start at offset into stream */
+
+static void logm_binary_format(struct lib_outstream_s *stream, const char *buf, int bufsize, struct logm_binhdr_s *hdr, int offset)
+{
+	const char *fmt = hdr->fmt;
+	const char *start;
+	char spec[LOGM_SPEC_BUFLEN];
+	char str[LOGM_BINARY_STRMAX + 1];
+	union logm_binarg_u arg;
+	int stars[2];
+	int nstars;
+	int nargs = 0;
+	int speclen;
+	uint16_t slen;
+	uint8_t type;
+	int i;
+
+#ifdef CONFIG_LOGM_TIMESTAMP
+	(void)lib_sprintf(stream, "[%4d.%4d] ", hdr->sec, hdr->nsec / 100000);
+#endif
+
+	while (*fmt != '\0') {
+		if (*fmt != '%') {
+			stream->put(stream, *fmt++);
+			continue;
+		}
+
+		start = fmt;
+		fmt = logm_parse_spec(fmt + 1, &type, &nstars);
+		speclen = fmt - start;
+
+		if (type == LOGM_ARG_NONE && nstars == 0) {
+			if (speclen == 2 && start[1] == '%') {
+				stream->put(stream, '%');
+			}
+			continue;
+		}
+
+		if (nargs + nstars + (type != LOGM_ARG_NONE) > hdr->nargs || speclen > LOGM_SPEC_MAX) {
+			/* Arguments were truncated when the record was queued */
+
+			for (i = 0; i < speclen; i++) {
+				stream->put(stream, start[i]);
+			}
+			continue;
+		}
+
+		memcpy(spec, start, speclen);
+		spec[speclen] = '\0';
+
+		for (i = 0; i < nstars; i++) {
+			offset = logm_ring_read(buf, bufsize, offset, &stars[i], sizeof(int));
+			nargs++;
+		}
+		if (nstars > 0) {
+			logm_expand_stars(spec, speclen, stars, nstars);
+		}
+
+		if (type == LOGM_ARG_NONE) {
+			continue;
+		}
+		nargs++;
+
+		switch (type) {
+		case LOGM_ARG_INT:
+			offset = logm_ring_read(buf, bufsize, offset, &arg.i, sizeof(int));
+			(void)lib_sprintf(stream, spec, arg.i);
+			break;
+		case LOGM_ARG_LONG:
+			offset = logm_ring_read(buf, bufsize, offset, &arg.l, sizeof(long));
+			(void)lib_sprintf(stream, spec, arg.l);
+			break;
+		case LOGM_ARG_LLONG:
+			offset = logm_ring_read(buf, bufsize, offset, &arg.ll, sizeof(long long));
+			(void)lib_sprintf(stream, spec, arg.ll);
+			break;
+		case LOGM_ARG_PTR:
+			offset = logm_ring_read(buf, bufsize, offset, &arg.p, sizeof(void *));
+			if (start[speclen - 1] == 'p') {
+				(void)lib_sprintf(stream, spec, arg.p);
+			}
+			/* %n can not be supported on deferred formatting */
+			break;
+		case LOGM_ARG_DOUBLE:
+			offset = logm_ring_read(buf, bufsize, offset, &arg.d, sizeof(double));
+			(void)lib_sprintf(stream, spec, arg.d);
+			break;
+		case LOGM_ARG_STR:
+			offset = logm_ring_read(buf, bufsize, offset, &slen, sizeof(uint16_t));
+			offset = logm_ring_read(buf, bufsize, offset, str, slen);
+			str[slen] = '\0';
+			(void)lib_sprintf(stream, spec, str);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/* Collect raw arguments of a record. This runs before any lock is taken. */
+
+static void logm_binary_collect(struct logm_binrec_s *rec, int priority, const char *fmt, va_list ap)
+{
+	const char *ptr = fmt;
+	uint8_t type;
+	int nstars;
+	int nargs = 0;
+	int size;
+	int i;
+
+	rec->hdr.magic = LOGM_BINARY_MAGIC;
+	rec->hdr.priority = (uint8_t)priority;
+	rec->hdr.flags = 0;
+	rec->hdr.reserved = 0;
+	rec->hdr.fmt = fmt;
+	rec->hdr.sec = 0;
+	rec->hdr.nsec = 0;
+
+	size = sizeof(struct logm_binhdr_s);
+	while (*ptr != '\0') {
+		if (*ptr++ != '%') {
+			continue;
+		}
+
+		ptr = logm_parse_spec(ptr, &type, &nstars);
+
+		if (nargs + nstars + (type != LOGM_ARG_NONE) > LOGM_BINARY_MAXARGS) {
+			rec->hdr.flags |= LOGM_BINREC_TRUNCATED;
+			break;
+		}
+
+		for (i = 0; i < nstars; i++) {
+			rec->types[nargs] = LOGM_ARG_INT;
+			rec->args[nargs++].i = va_arg(ap, int);
+			size += sizeof(int);
+		}
+
+		switch (type) {
+		case LOGM_ARG_INT:
+			rec->args[nargs].i = va_arg(ap, int);
+			break;
+		case LOGM_ARG_LONG:
+			rec->args[nargs].l = va_arg(ap, long);
+			break;
+		case LOGM_ARG_LLONG:
+			rec->args[nargs].ll = va_arg(ap, long long);
+			break;
+		case LOGM_ARG_PTR:
+			rec->args[nargs].p = va_arg(ap, void *);
+			break;
+		case LOGM_ARG_DOUBLE:
+			rec->args[nargs].d = va_arg(ap, double);
+			break;
+		case LOGM_ARG_STR:
+			rec->args[nargs].s = va_arg(ap, const char *);
+			if (rec->args[nargs].s == NULL) {
+				rec->args[nargs].s = "(null)";
+			}
+			rec->slen[nargs] = strnlen(rec->args[nargs].s, LOGM_BINARY_STRMAX);
+			size += sizeof(uint16_t) + rec->slen[nargs];
+			break;
+		default:
+			continue;
+		}
+
+		size += logm_argsize(type);
+		rec->types[nargs++] = type;
+	}
+
+	rec->hdr.nargs = (uint8_t)nargs;
+	rec->size = size;
+	rec->hdr.size = (uint16_t)size;
+}
+
+/* Copy a collected record into the ring at offset and return the new tail */
+
+static int logm_binary_store(char *buf, int bufsize, int offset, struct logm_binrec_s *rec)
+{
+	int i;
+
+	offset = logm_ring_write(buf, bufsize, offset, &rec->hdr, sizeof(struct logm_binhdr_s));
+	for (i = 0; i < rec->hdr.nargs; i++) {
+		if (rec->types[i] == LOGM_ARG_STR) {
+			offset = logm_ring_write(buf, bufsize, offset, &rec->slen[i], sizeof(uint16_t));
+			offset = logm_ring_write(buf, bufsize, offset, rec->args[i].s, rec->slen[i]);
+		} else {
+			offset = logm_ring_write(buf, bufsize, offset, &rec->args[i], logm_argsize(rec->types[i]));
+		}
+	}
+
+	return offset;
+}
+
+/* Read the header of the record at head. Returns the offset of its arguments
+ * or ERROR if the record is corrupted.
+ */
+
+static int logm_binary_peek(const char *buf, int bufsize, int head, struct logm_binhdr_s *hdr)
+{
+	int offset = logm_ring_read(buf, bufsize, head, hdr, sizeof(struct logm_binhdr_s));
+
+	if (hdr->magic != LOGM_BINARY_MAGIC || hdr->size < sizeof(struct logm_binhdr_s)) {
+		return ERROR;
+	}
+
+	return offset;
+}
+
+#ifdef CONFIG_LOGM_PERCPU
+/* Queue a record into the ring of current CPU. Only local interrupts are
+ * disabled, so CPUs never contend with each other. Records are taken out
+ * by logm_binary_flush, which lets one consumer at a time drain the rings.
+ */
+
+static int logm_percpu_put(struct logm_binrec_s *rec)
+{
+	struct logm_cpubuf_s *cpubuf;
+	struct timespec ts;
+	irqstate_t flags;
+	int avail;
+	int tail;
+#ifdef CONFIG_LOGM_BENCHMARK
+	uint32_t cycles;
+#endif
+
+	flags = irqsave();
+	LOGM_BENCH_CS_START(cycles);
+
+	cpubuf = &g_logm_cpubuf[up_cpu_index()];
+
+	/* Tell logm_task that this ring is in use, then check resize request */
+
+	cpubuf->busy = 1;
+	SP_DSB();
+	if (LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ) || cpubuf->buf == NULL) {
+		goto errout;
+	}
+
+	if (cpubuf->overflow) {
+		cpubuf->dropmsg_count++;
+		cpubuf->dropmsg_total++;
+		goto errout;
+	}
+
+	avail = (cpubuf->head - cpubuf->tail - 1 + cpubuf->size) % cpubuf->size;
+	if (rec->size > avail) {
+		cpubuf->overflow = true;
+		cpubuf->dropmsg_count = 1;
+		cpubuf->dropmsg_total++;
+		cpubuf->overflow_offset = cpubuf->tail;
+		goto errout;
+	}
+
+	/* Timestamp is taken here so that each ring stays in time order */
+
+	if (clock_systimespec(&ts) == OK) {
+		rec->hdr.sec = (uint32_t)ts.tv_sec;
+		rec->hdr.nsec = (uint32_t)ts.tv_nsec;
+	}
+
+	tail = logm_binary_store(cpubuf->buf, cpubuf->size, cpubuf->tail, rec);
+
+	/* Publish the record only after its contents are visible */
+
+	SP_DMB();
+	cpubuf->tail = tail;
+	SP_DMB();
+	cpubuf->busy = 0;
+
+	LOGM_BENCH_CS_END(cycles);
+	irqrestore(flags);
+	return rec->size;
+
+errout:
+	SP_DMB();
+	cpubuf->busy = 0;
+	LOGM_BENCH_CS_END(cycles);
+	irqrestore(flags);
+	return 0;
+}
+
+/* Consume the oldest record among all CPU rings. Returns false if all rings are empty. */
+
+static bool logm_percpu_flush_one(struct lib_outstream_s *stream)
+{
+	struct logm_cpubuf_s *cpubuf;
+	struct logm_binhdr_s hdr;
+	struct logm_binhdr_s oldest_hdr;
+	int oldest = -1;
+	int oldest_offset = 0;
+	int offset;
+	int cpu;
+
+	for (cpu = 0; cpu < LOGM_NCPUS; cpu++) {
+		cpubuf = &g_logm_cpubuf[cpu];
+		if (cpubuf->head == cpubuf->tail) {
+			continue;
+		}
+
+		/* Make sure record contents are read after the tail */
+
+		SP_DSB();
+		offset = logm_binary_peek(cpubuf->buf, cpubuf->size, cpubuf->head, &hdr);
+		if (offset < 0) {
+			(void)lib_sprintf(stream, "\n[LOGM] Invalid binary record on CPU%d, buffer is discarded\n", cpu);
+			cpubuf->head = cpubuf->tail;
+			continue;
+		}
+
+		/* Equal timestamps keep CPU order */
+
+		if (oldest < 0 || hdr.sec < oldest_hdr.sec || (hdr.sec == oldest_hdr.sec && hdr.nsec < oldest_hdr.nsec)) {
+			oldest = cpu;
+			oldest_hdr = hdr;
+			oldest_offset = offset;
+		}
+	}
+
+	if (oldest < 0) {
+		return false;
+	}
+
+	cpubuf = &g_logm_cpubuf[oldest];
+	logm_binary_format(stream, cpubuf->buf, cpubuf->size, &oldest_hdr, oldest_offset);
+	if (oldest_hdr.flags & LOGM_BINREC_TRUNCATED) {
+		(void)lib_sprintf(stream, " [LOGM] args truncated\n");
+	}
+
+	/* Release the space only after the record is fully read */
+
+	SP_DSB();
+	cpubuf->head = (cpubuf->head + oldest_hdr.size) % cpubuf->size;
+
+	if (cpubuf->overflow) {
+		cpubuf->overflow = false;
+	}
+	if (cpubuf->overflow_offset >= 0 && cpubuf->overflow_offset == cpubuf->head) {
+		(void)lib_sprintf(stream, "\n[LOGM BUFFER OVERFLOW] CPU%d : %d messages are dropped\n", oldest, cpubuf->dropmsg_count);
+		cpubuf->overflow_offset = -1;
+	}
+
+	return true;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/* Queue a binary record. Only the argument values are collected here,
+ * text formatting is deferred to logm_task.
+ */
+
+int logm_binary_put(int priority, const char *fmt, va_list ap)
+{
+	struct logm_binrec_s rec;
+#ifndef CONFIG_LOGM_PERCPU
+	irqstate_t flags;
+	struct timespec ts;
+	int avail;
+#ifdef CONFIG_LOGM_BENCHMARK
+	uint32_t cycles;
+#endif
+#endif
+
+	/* Collect raw arguments outside of critical section */
+
+	logm_binary_collect(&rec, priority, fmt, ap);
+
+	if (rec.size >= logm_bufsize / LOGM_NCPUS || rec.size > UINT16_MAX) {
+		/* This record can never fit into the buffer */
+		return 0;
+	}
+
+#ifdef CONFIG_LOGM_PERCPU
+	return logm_percpu_put(&rec);
+#else
+	if (clock_systimespec(&ts) == OK) {
+		rec.hdr.sec = (uint32_t)ts.tv_sec;
+		rec.hdr.nsec = (uint32_t)ts.tv_nsec;
+	}
+
+	flags = enter_critical_section();
+	LOGM_BENCH_CS_START(cycles);
+
+	if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
+		g_logm_dropmsg_count++;
+		LOGM_BENCH_CS_END(cycles);
+		leave_critical_section(flags);
+		return 0;
+	}
+
+	avail = (g_logm_head - g_logm_tail - 1 + logm_bufsize) % logm_bufsize;
+	if (rec.size > avail) {
+		LOGM_STATUS_SET(LOGM_BUFFER_OVERFLOW);
+		g_logm_dropmsg_count = 1;
+		g_logm_overflow_offset = g_logm_tail;
+		LOGM_BENCH_CS_END(cycles);
+		leave_critical_section(flags);
+		return 0;
+	}
+
+	g_logm_tail = logm_binary_store(g_logm_rsvbuf, logm_bufsize, g_logm_tail, &rec);
+
+	LOGM_BENCH_CS_END(cycles);
+	leave_critical_section(flags);
+
+	return rec.size;
+#endif
+}
+
+/* Format all queued binary records into stream. Called by logm_task and by
+ * the low output path. If the other one is draining already, e.g. logm_task
+ * is interrupted in the middle of a record, nothing is done here.
+ */
+
+void logm_binary_flush(struct lib_outstream_s *stream)
+{
+	irqstate_t flags;
+#ifndef CONFIG_LOGM_PERCPU
+	struct logm_binhdr_s hdr;
+	int offset;
+#endif
+
+	flags = enter_critical_section();
+	if (g_logm_binary_flushing) {
+		leave_critical_section(flags);
+		return;
+	}
+	g_logm_binary_flushing = true;
+	leave_critical_section(flags);
+
+#ifdef CONFIG_LOGM_PERCPU
+	while (logm_percpu_flush_one(stream)) {
+	}
+#else
+
+	while (g_logm_head != g_logm_tail) {
+		offset = logm_binary_peek(g_logm_rsvbuf, logm_bufsize, g_logm_head, &hdr);
+		if (offset < 0) {
+			/* Ring is corrupted, nothing after this point can be trusted */
+
+			(void)lib_sprintf(stream, "\n[LOGM] Invalid binary record, buffer is discarded\n");
+			g_logm_head = g_logm_tail;
+			break;
+		}
+
+		logm_binary_format(stream, g_logm_rsvbuf, logm_bufsize, &hdr, offset);
+		if (hdr.flags & LOGM_BINREC_TRUNCATED) {
+			(void)lib_sprintf(stream, " [LOGM] args truncated\n");
+		}
+
+		g_logm_head = (g_logm_head + hdr.size) % logm_bufsize;
+
+		if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
+			LOGM_STATUS_CLEAR(LOGM_BUFFER_OVERFLOW);
+		}
+		if (g_logm_overflow_offset >= 0 && g_logm_overflow_offset == g_logm_head) {
+			(void)lib_sprintf(stream, "\n[LOGM BUFFER OVERFLOW] %d messages are dropped\n", g_logm_dropmsg_count);
+			g_logm_overflow_offset = -1;
+		}
+	}
+#endif
+
+	g_logm_binary_flushing = false;
+}
+
+/* Check whether all binary records are flushed */
+
+bool logm_binary_isempty(void)
+{
+#ifdef CONFIG_LOGM_PERCPU
+	int cpu;
+
+	for (cpu = 0; cpu < LOGM_NCPUS; cpu++) {
+		if (g_logm_cpubuf[cpu].head != g_logm_cpubuf[cpu].tail) {
+			return false;
+		}
+	}
+	return true;
+#else
+	return g_logm_head == g_logm_tail;
+#endif
+}
+
+#ifdef CONFIG_LOGM_PERCPU
+/* Split the logm buffer into one ring per CPU. Called by logm_task when the
+ * buffer is allocated or resized, after all producers left their rings.
+ */
+
+void logm_percpu_init(char *buf, int bufsize)
+{
+	int size = bufsize / LOGM_NCPUS;
+	int cpu;
+
+	for (cpu = 0; cpu < LOGM_NCPUS; cpu++) {
+		g_logm_cpubuf[cpu].buf = buf + cpu * size;
+		g_logm_cpubuf[cpu].size = size;
+		g_logm_cpubuf[cpu].head = 0;
+		g_logm_cpubuf[cpu].tail = 0;
+		g_logm_cpubuf[cpu].overflow = false;
+		g_logm_cpubuf[cpu].overflow_offset = -1;
+		g_logm_cpubuf[cpu].dropmsg_count = 0;
+	}
+}
+
+/* Wait until no CPU is writing into its ring */
+
+void logm_percpu_quiesce(void)
+{
+	int cpu;
+
+	SP_DSB();
+	for (cpu = 0; cpu < LOGM_NCPUS; cpu++) {
+		while (g_logm_cpubuf[cpu].busy) {
+			SP_DSB();
+		}
+	}
+}
+#endif
@@ -29,6 +29,9 @@ int logm_get_values(enum logm_param_type_e type, int *value)
 	case LOGM_INTERVAL:
 		*value = (int)(logm_print_interval / 1000);
 		break;
+	case LOGM_MODE:
+		*value = LOGM_STATUS(LOGM_BINARY_RECORD) ? LOGM_MODE_BINARY : LOGM_MODE_TEXT;
+		break;
 	default:
 		break;
 	}
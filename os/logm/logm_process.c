@@ -42,6 +42,11 @@ static int logm_change_bufsize(int buflen)
 		return ERROR;
 	}
 
+#ifdef CONFIG_LOGM_PERCPU
+	/* Producers do not take the critical section, wait until they leave */
+	logm_percpu_quiesce();
+#endif
+
 	/* Realloc new buffer with new length */
 	char *new_g_logm_rsvbuf = (char *)kmm_realloc(g_logm_rsvbuf, buflen);
 	if (new_g_logm_rsvbuf == NULL) {
@@ -57,6 +62,9 @@ static int logm_change_bufsize(int buflen)
 	logm_bufsize = buflen;
 	g_logm_dropmsg_count = 0;
 	g_logm_overflow_offset = -1;
+#ifdef CONFIG_LOGM_PERCPU
+	logm_percpu_init(g_logm_rsvbuf, logm_bufsize);
+#endif
 
 	LOGM_STATUS_CLEAR(LOGM_BUFFER_RESIZE_REQ);
 
@@ -66,10 +74,23 @@ static int logm_change_bufsize(int buflen)
 int logm_task(int argc, char *argv[])
 {
 	irqstate_t flags;
+#ifdef CONFIG_LOGM_BINARY
+	struct lib_stdoutstream_s strm;
+
+	lib_stdoutstream(&strm, stdout);
+#endif
 
 	g_logm_rsvbuf = (char *)kmm_malloc(logm_bufsize);
 	memset(g_logm_rsvbuf, 0, logm_bufsize);
 
+#if defined(CONFIG_LOGM_PERCPU)
+	/* Each CPU queues binary records into its own slice of the buffer */
+	logm_percpu_init(g_logm_rsvbuf, logm_bufsize);
+	LOGM_STATUS_SET(LOGM_BINARY_RECORD);
+#elif defined(CONFIG_LOGM_BINARY_DEFAULT)
+	LOGM_STATUS_SET(LOGM_BINARY_RECORD);
+#endif
+
 	/* Now logm is ready */
 	LOGM_STATUS_SET(LOGM_READY);
 
@@ -78,6 +99,11 @@ int logm_task(int argc, char *argv[])
 #endif
 
 	while (1) {
+#ifdef CONFIG_LOGM_BINARY
+		if (LOGM_STATUS(LOGM_BINARY_RECORD)) {
+			logm_binary_flush((struct lib_outstream_s *)&strm);
+		} else
+#endif
 		while (g_logm_head != g_logm_tail) {
 			fputc(g_logm_rsvbuf[g_logm_head], stdout);
 			g_logm_head = (g_logm_head + 1) % logm_bufsize;
@@ -97,6 +123,24 @@ int logm_task(int argc, char *argv[])
 			}
 			leave_critical_section(flags);
 		}
+
+#ifdef CONFIG_LOGM_BINARY
+		if (LOGM_STATUS(LOGM_MODE_CHANGE_REQ)) {
+			/* Text and binary records can not be mixed in the buffer.
+			 * Switch the mode only after everything queued is flushed.
+			 */
+			flags = enter_critical_section();
+			if (g_logm_head == g_logm_tail) {
+				if (new_logm_mode == LOGM_MODE_BINARY) {
+					LOGM_STATUS_SET(LOGM_BINARY_RECORD);
+				} else {
+					LOGM_STATUS_CLEAR(LOGM_BINARY_RECORD);
+				}
+				LOGM_STATUS_CLEAR(LOGM_MODE_CHANGE_REQ);
+			}
+			leave_critical_section(flags);
+		}
+#endif
 		usleep(logm_print_interval);
 	}
 
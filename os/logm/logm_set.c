@@ -19,6 +19,9 @@
 #include "logm.h"
 
 volatile int new_logm_bufsize = 0;
+#ifdef CONFIG_LOGM_BINARY
+volatile int new_logm_mode = LOGM_MODE_TEXT;
+#endif
 
 /* This will be moved to upper layer or changed for protected build  */
 /* for setparam types, refer logm_param_type_e  */
@@ -32,6 +35,22 @@ int logm_set_values(enum logm_param_type_e type, int value)
 	case LOGM_INTERVAL:
 		logm_print_interval = value * 1000;
 		break;
+#ifdef CONFIG_LOGM_BINARY
+	case LOGM_MODE:
+		/* Mode is switched by logm task after flushing queued messages */
+		if (value != LOGM_MODE_TEXT && value != LOGM_MODE_BINARY) {
+			return -1;
+		}
+#ifdef CONFIG_LOGM_PERCPU
+		/* Per-CPU buffers hold binary records only */
+		if (value != LOGM_MODE_BINARY) {
+			return -1;
+		}
+#endif
+		new_logm_mode = value;
+		LOGM_STATUS_SET(LOGM_MODE_CHANGE_REQ);
+		break;
+#endif
 	default:
 		break;
 	}
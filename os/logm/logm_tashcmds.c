@@ -38,13 +38,21 @@ void logm_register_tashcmds(void)
 static void logm_usage(void)
 {
 	fprintf(stdout, "[LOGM USAGE]\n");
-	fprintf(stdout, "usage: logm [-b <BUFSIZE>] [-i <TIME>]\n");
+	fprintf(stdout, "usage: logm [-b <BUFSIZE>] [-i <TIME>] [-m <MODE>] [-t <COUNT>]\n");
 
 	fprintf(stdout, "options:\n");
 	fprintf(stdout, "    -b BUFSIZE\n");
 	fprintf(stdout, "        Set logm buffer size (bytes)\n");
 	fprintf(stdout, "    -i TIME\n");
 	fprintf(stdout, "        Set buffer flusing interval (ms)\n");
+#ifdef CONFIG_LOGM_BINARY
+	fprintf(stdout, "    -m MODE\n");
+	fprintf(stdout, "        Set record mode, text or binary\n");
+#endif
+#ifdef CONFIG_LOGM_BENCHMARK
+	fprintf(stdout, "    -t COUNT\n");
+	fprintf(stdout, "        Measure cost of COUNT log calls in each mode\n");
+#endif
 
 }
 
@@ -52,13 +60,29 @@ static void logm_info(void)
 {
 	int bufsize;
 	int interval;
+	int mode;
+#ifdef CONFIG_LOGM_PERCPU
+	struct logm_cpubuf_s *cpubuf;
+	int cpu;
+#endif
 
 	logm_get_values(LOGM_BUFSIZE, &bufsize);
 	logm_get_values(LOGM_INTERVAL, &interval);
+	logm_get_values(LOGM_MODE, &mode);
 
 	fprintf(stdout, "[LOGM CONFIGURATIONS]\n");
 	fprintf(stdout, "  Buffer size : %d (bytes)\n", bufsize);
 	fprintf(stdout, "  Flusing interval : %d (ms)\n", interval);
+	fprintf(stdout, "  Record mode : %s\n", mode == LOGM_MODE_BINARY ? "binary" : "text");
+#ifdef CONFIG_LOGM_PERCPU
+	fprintf(stdout, "[LOGM PER-CPU BUFFERS]\n");
+	for (cpu = 0; cpu < LOGM_NCPUS; cpu++) {
+		cpubuf = &g_logm_cpubuf[cpu];
+		fprintf(stdout, "  CPU%d : used %d / %d (bytes), dropped %u, overflow offset %d\n", cpu,
+				(cpubuf->tail - cpubuf->head + cpubuf->size) % cpubuf->size, cpubuf->size,
+				cpubuf->dropmsg_total, cpubuf->overflow_offset);
+	}
+#endif
 }
 
 static int logm_tash(int argc, char **args)
@@ -82,8 +106,10 @@ static int logm_tash(int argc, char **args)
 	/*
 	 * -b [bufsize] : set buffer size (bytes)
 	 * -i [time] : set buffer flushing interval (ms)
+	 * -m [mode] : set record mode (text or binary)
+	 * -t [count] : run benchmark with count log calls
 	 */
-	while ((opt = getopt(argc, args, "b:i:")) != -1) {
+	while ((opt = getopt(argc, args, "b:i:m:t:")) != -1) {
 		switch (opt) {
 		case 'b':
 			/* TASH>> logm -b 10240 */
@@ -100,6 +126,28 @@ static int logm_tash(int argc, char **args)
 				logm_set_values(LOGM_INTERVAL, atoi(optarg));
 			}
 			break;
+#ifdef CONFIG_LOGM_BINARY
+		case 'm':
+			/* TASH>> logm -m binary */
+			/* queue raw arguments and format them in logm task */
+			if (optarg != NULL && strcmp(optarg, "binary") == 0) {
+				logm_set_values(LOGM_MODE, LOGM_MODE_BINARY);
+			} else if (optarg != NULL && strcmp(optarg, "text") == 0) {
+				logm_set_values(LOGM_MODE, LOGM_MODE_TEXT);
+			} else {
+				logm_usage();
+			}
+			break;
+#endif
+#ifdef CONFIG_LOGM_BENCHMARK
+		case 't':
+			/* TASH>> logm -t 100 */
+			/* measure cycles per call and critical section length */
+			if (optarg != NULL && atoi(optarg) > 0) {
+				logm_benchmark(atoi(optarg));
+			}
+			break;
+#endif
 		default:
 			logm_usage();
 			return 0;
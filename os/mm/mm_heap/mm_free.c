@@ -96,6 +96,73 @@ static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: mm_free_node
+ *
+ * Description:
+ *   Mark an allocated chunk free, merge it with adjacent free chunks and
+ *   put the result into the free node lists. Heapinfo is not updated.
+ *   The caller must hold the MM semaphore.
+ *
+ ****************************************************************************/
+void mm_free_node(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *alloc)
+{
+	FAR struct mm_freenode_s *node = (FAR struct mm_freenode_s *)alloc;
+	FAR struct mm_freenode_s *prev;
+	FAR struct mm_freenode_s *next;
+
+	node->preceding &= ~MM_ALLOC_BIT;
+
+	/* Check if the following node is free and, if so, merge it */
+
+	next = (FAR struct mm_freenode_s *)((char *)node + node->size);
+	if ((next->preceding & MM_ALLOC_BIT) == 0) {
+		FAR struct mm_allocnode_s *andbeyond;
+
+		/* Get the node following the next node (which will
+		 * become the new next node). We know that we can never
+		 * index past the tail chunk because it is always allocated.
+		 */
+
+		andbeyond = (FAR struct mm_allocnode_s *)((char *)next + next->size);
+
+		/* Remove the next node.  There must be a predecessor,
+		 * but there may not be a successor node.
+		 */
+
+		REMOVE_NODE_FROM_LIST(next);
+
+		/* Then merge the two chunks */
+
+		node->size          += next->size;
+		andbeyond->preceding = node->size | (andbeyond->preceding & MM_ALLOC_BIT);
+		next                 = (FAR struct mm_freenode_s *)andbeyond;
+	}
+
+	/* Check if the preceding node is also free and, if so, merge
+	 * it with this node
+	 */
+
+	prev = (FAR struct mm_freenode_s *)((char *)node - node->preceding);
+	if ((prev->preceding & MM_ALLOC_BIT) == 0) {
+		/* Remove the node.  There must be a predecessor, but there may
+		 * not be a successor node.
+		 */
+
+		REMOVE_NODE_FROM_LIST(prev);
+
+		/* Then merge the two chunks */
+
+		prev->size     += node->size;
+		next->preceding = prev->size | (next->preceding & MM_ALLOC_BIT);
+		node            = prev;
+	}
+
+	/* Add the merged node to the nodelist */
+
+	mm_addfreechunk(heap, node);
+}
+
 /****************************************************************************
  * Name: mm_free
  *
@@ -106,9 +173,7 @@ static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
  ****************************************************************************/
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 {
-	FAR struct mm_freenode_s *node;
-	FAR struct mm_freenode_s *prev;
-	FAR struct mm_freenode_s *next;
+	FAR struct mm_allocnode_s *node;
 
 	mvdbg("Freeing %p\n", mem);
 
@@ -126,6 +191,26 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		return;
 	}
 
+	/* Map the memory chunk into an allocated node */
+
+	node = (FAR struct mm_allocnode_s *)((char *)mem - SIZEOF_MM_ALLOCNODE);
+
+#if defined(CONFIG_MM_SIZECLASS) && !defined(CONFIG_DEBUG_MM_HEAPINFO)
+	/* Without heapinfo there is nothing to account, so a small chunk can
+	 * be cached without taking the MM semaphore.
+	 */
+
+	switch (mm_sizeclass_free(heap, node)) {
+	case MM_SIZECLASS_DONE:
+		return;
+	case MM_SIZECLASS_INVALID:
+		mdbg("Attempt for double freeing a pointer by pid %d at address 0x%08x\n", getpid(), __builtin_return_address(0));
+		return;
+	default:
+		break;
+	}
+#endif
+
 	/* We need to hold the MM semaphore while we muck with the
 	 * nodelist.
 	 */
@@ -140,10 +225,6 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		return;
 	}
 
-	/* Map the memory chunk into a free node */
-
-	node = (FAR struct mm_freenode_s *)((char *)mem - SIZEOF_MM_ALLOCNODE);
-	
 	if ((node->preceding & MM_ALLOC_BIT) != MM_ALLOC_BIT) {
 		/* There are 3 cases of logical error scenarios
 		 * 1) Attempt to free an unallocated memory or
@@ -159,58 +240,25 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		return;
 	}
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
-	heapinfo_subtract_size(heap, ((struct mm_allocnode_s *)node)->pid, ((struct mm_allocnode_s *)node)->size);
-	heapinfo_update_total_size(heap, ((-1) * ((struct mm_allocnode_s *)node)->size), ((struct mm_allocnode_s *)node)->pid);
-#endif
-	node->preceding &= ~MM_ALLOC_BIT;
-
-	/* Check if the following node is free and, if so, merge it */
-
-	next = (FAR struct mm_freenode_s *)((char *)node + node->size);
-	if ((next->preceding & MM_ALLOC_BIT) == 0) {
-		FAR struct mm_allocnode_s *andbeyond;
-
-		/* Get the node following the next node (which will
-		 * become the new next node). We know that we can never
-		 * index past the tail chunk because it is always allocated.
-		 */
-
-		andbeyond = (FAR struct mm_allocnode_s *)((char *)next + next->size);
-
-		/* Remove the next node.  There must be a predecessor,
-		 * but there may not be a successor node.
-		 */
-
-		REMOVE_NODE_FROM_LIST(next);
-
-		/* Then merge the two chunks */
+#ifdef CONFIG_MM_SIZECLASS
+	if (node->reserved == MM_SIZECLASS_CACHED) {
+		/* The chunk is already in the size-class cache */
 
-		node->size          += next->size;
-		andbeyond->preceding = node->size | (andbeyond->preceding & MM_ALLOC_BIT);
-		next                 = (FAR struct mm_freenode_s *)andbeyond;
+		mdbg("Attempt for double freeing a pointer by pid %d at address 0x%08x\n", getpid(), __builtin_return_address(0));
+		mm_givesemaphore(heap);
+		return;
 	}
-
-	/* Check if the preceding node is also free and, if so, merge
-	 * it with this node
-	 */
-
-	prev = (FAR struct mm_freenode_s *)((char *)node - node->preceding);
-	if ((prev->preceding & MM_ALLOC_BIT) == 0) {
-		/* Remove the node.  There must be a predecessor, but there may
-		 * not be a successor node.
-		 */
-
-		REMOVE_NODE_FROM_LIST(prev);
-
-		/* Then merge the two chunks */
-
-		prev->size     += node->size;
-		next->preceding = prev->size | (next->preceding & MM_ALLOC_BIT);
-		node            = prev;
+#endif
+	heapinfo_subtract_size(heap, node->pid, node->size);
+	heapinfo_update_total_size(heap, ((-1) * node->size), node->pid);
+#ifdef CONFIG_MM_SIZECLASS
+	if (mm_sizeclass_free(heap, node) == MM_SIZECLASS_DONE) {
+		mm_givesemaphore(heap);
+		return;
 	}
+#endif
+#endif
 
-	/* Add the merged node to the nodelist */
-
-	mm_addfreechunk(heap, node);
+	mm_free_node(heap, node);
 	mm_givesemaphore(heap);
 }
@@ -191,6 +191,16 @@ void heapinfo_parse_heap(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 			ASSERT(node->size);
 
 			/* Check if the node corresponds to an allocated memory chunk */
+#ifdef CONFIG_MM_SIZECLASS
+			if ((node->preceding & MM_ALLOC_BIT) != 0 && node->reserved == MM_SIZECLASS_CACHED) {
+				/* Chunk is free in the size-class cache, not owned by a task */
+
+				fordblks += node->size;
+				if (mode == HEAPINFO_DETAIL_ALL || mode == HEAPINFO_DETAIL_FREE || mode == HEAPINFO_DETAIL_SPECIFIC_HEAP) {
+					heap_dbg("0x%x | %8d |   %c    |            |       |\n", node, node->size, 'C');
+				}
+			} else
+#endif
 			if ((pid == HEAPINFO_PID_ALL || node->pid == pid) && (node->preceding & MM_ALLOC_BIT) != 0) {
 				if (mode == HEAPINFO_DETAIL_ALL || mode == HEAPINFO_DETAIL_PID || mode == HEAPINFO_DETAIL_SPECIFIC_HEAP) {
 					if (node->pid >= 0) {
@@ -259,6 +259,18 @@ int mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart, size_t heapsi
 		heap->mm_delaylist[i] = NULL;
 	}
 
+#ifdef CONFIG_MM_SIZECLASS
+	/* Initialize the size-class cache to be empty */
+
+	memset(heap->mm_sizeclass, 0, sizeof(heap->mm_sizeclass));
+	for (i = 0; i < CONFIG_SMP_NCPUS; i++) {
+		heap->mm_sizeclass_cached[i] = 0;
+#ifdef CONFIG_SMP
+		spin_initialize(&heap->mm_sizeclass_lock[i], SP_UNLOCKED);
+#endif
+	}
+#endif
+
 	/* Initialize the malloc semaphore to one (to support one-at-
 	 * a-time access to private data sets).
 	 */
@@ -94,6 +94,9 @@ int mm_mallinfo_aligned(FAR struct mm_heap_s *heap, FAR struct mallinfo *info, s
 	int    ordblks  = 0;		/* Number of non-inuse chunks */
 	size_t uordblks = 0;		/* Total allocated space */
 	size_t fordblks = 0;		/* Total non-inuse space */
+#ifdef CONFIG_MM_SIZECLASS
+	int cpu;
+#endif
 #if CONFIG_KMM_REGIONS > 1
 	int region;
 #else
@@ -153,6 +156,15 @@ int mm_mallinfo_aligned(FAR struct mm_heap_s *heap, FAR struct mallinfo *info, s
 	}
 #undef region
 
+#ifdef CONFIG_MM_SIZECLASS
+	/* Chunks in the size-class cache look allocated but are free to use */
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		uordblks -= heap->mm_sizeclass_cached[cpu];
+		fordblks += heap->mm_sizeclass_cached[cpu];
+	}
+#endif
+
 	DEBUGASSERT(uordblks + fordblks == heap->mm_heapsize);
 
 #if CONFIG_KMM_NHEAPS > 1
@@ -130,48 +130,19 @@ static void mm_free_delaylist(FAR struct mm_heap_s *heap)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_malloc
+ * Name: mm_alloc_node
  *
  * Description:
- *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
- *
- *  8-byte alignment of the allocated data is assured.
+ *  Take the best fitting free chunk for 'size' (which already includes the
+ *  allocnode and is aligned) out of the free node lists, split off the
+ *  remainder and mark the chunk allocated. Heapinfo of the chunk is not
+ *  updated. The caller must hold the MM semaphore.
  *
  ****************************************************************************/
-#ifdef CONFIG_DEBUG_MM_HEAPINFO
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr)
-#else
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
-#endif
+FAR struct mm_allocnode_s *mm_alloc_node(FAR struct mm_heap_s *heap, size_t size)
 {
 	FAR struct mm_freenode_s *node;
-	void *ret = NULL;
 	int ndx;
-	bool gc_done = false;
-
-	/* Free the delay list first */
-	mm_free_delaylist(heap);
-
-	/* Handle bad sizes */
-
-	if (size > MM_ALIGN_DOWN(MMSIZE_MAX) - SIZEOF_MM_ALLOCNODE) {
-		mdbg("Because of mm_allocnode, %u cannot be allocated. The maximum \
-			 allocable size is (MM_ALIGN_DOWN(MMSIZE_MAX) - SIZEOF_MM_ALLOCNODE) \
-			 : %u\n.", size, (MM_ALIGN_DOWN(MMSIZE_MAX) - SIZEOF_MM_ALLOCNODE));
-		return NULL;
-	}
-
-	/* Adjust the size to account for (1) the size of the allocated node and
-	 * (2) to make sure that it is an even multiple of our granule size.
-	 */
-
-	size = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
-
-retry_after_gc:
-	/* We need to hold the MM semaphore while we muck with the nodelist. */
-
-	mm_takesemaphore(heap);
 
 	/* Get the location in the node list to start the search
 	 * by converting the request size into a nodelist index.
@@ -249,11 +220,78 @@ retry_after_gc:
 		/* Handle the case of an exact size match */
 
 		node->preceding |= MM_ALLOC_BIT;
+		return (FAR struct mm_allocnode_s *)node;
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ ****************************************************************************/
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr)
+#else
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+#endif
+{
+	FAR struct mm_allocnode_s *node;
+	void *ret = NULL;
+	bool gc_done = false;
 
+	/* Free the delay list first */
+	mm_free_delaylist(heap);
+
+	/* Handle bad sizes */
+
+	if (size > MM_ALIGN_DOWN(MMSIZE_MAX) - SIZEOF_MM_ALLOCNODE) {
+		mdbg("Because of mm_allocnode, %u cannot be allocated. The maximum \
+			 allocable size is (MM_ALIGN_DOWN(MMSIZE_MAX) - SIZEOF_MM_ALLOCNODE) \
+			 : %u\n.", size, (MM_ALIGN_DOWN(MMSIZE_MAX) - SIZEOF_MM_ALLOCNODE));
+		return NULL;
+	}
+
+	/* Adjust the size to account for (1) the size of the allocated node and
+	 * (2) to make sure that it is an even multiple of our granule size.
+	 */
+
+	size = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+
+#ifdef CONFIG_MM_SIZECLASS
+	/* Small chunks are served from the size-class cache first */
+
+	if (MM_SIZECLASS_FITS(size)) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		node = mm_sizeclass_alloc(heap, size, caller_retaddr);
+#else
+		node = mm_sizeclass_alloc(heap, size);
+#endif
+		if (node) {
+			ret = (void *)((char *)node + SIZEOF_MM_ALLOCNODE);
+			mvdbg("Allocated %p, size %u\n", ret, size);
+			return ret;
+		}
+	}
+#endif
+
+retry_after_gc:
+	/* We need to hold the MM semaphore while we muck with the nodelist. */
+
+	mm_takesemaphore(heap);
+
+	node = mm_alloc_node(heap, size);
+	if (node) {
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
-		heapinfo_update_node((struct mm_allocnode_s *)node, caller_retaddr);
-		heapinfo_add_size(heap, ((struct mm_allocnode_s *)node)->pid, node->size);
-		heapinfo_update_total_size(heap, node->size, ((struct mm_allocnode_s *)node)->pid);
+		heapinfo_update_node(node, caller_retaddr);
+		heapinfo_add_size(heap, node->pid, node->size);
+		heapinfo_update_total_size(heap, node->size, node->pid);
 #endif
 		ret = (void *)((char *)node + SIZEOF_MM_ALLOCNODE);
 	}
@@ -261,6 +299,11 @@ retry_after_gc:
 	mm_givesemaphore(heap);
 
 	if (!ret && gc_done == false) {
+#ifdef CONFIG_MM_SIZECLASS
+		/* Give the cached small chunks back before anything else */
+
+		mm_sizeclass_drain(heap);
+#endif
 		mdbg("Allocation failed!!! We dont have enough memory. Try to free dead task stack areas\n");
 		sched_garbagecollection();
 		gc_done = true;
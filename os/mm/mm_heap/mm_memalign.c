@@ -277,6 +277,11 @@ retry_after_gc:
 	mm_givesemaphore(heap);
 
 	if (!ret && gc_done == false) {
+#ifdef CONFIG_MM_SIZECLASS
+		/* Give the cached small chunks back before anything else */
+
+		mm_sizeclass_drain(heap);
+#endif
 		mdbg("Allocation failed!!! We dont have enough memory. Try to free dead task stack areas\n");
 		sched_garbagecollection();
 		gc_done = true;
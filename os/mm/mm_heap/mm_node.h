@@ -25,6 +25,8 @@
 
 #include <assert.h>
 
+#include <tinyara/mm/mm.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -38,8 +40,36 @@
 		}						\
 	} while (0)
 
+#ifdef CONFIG_MM_SIZECLASS
+/* Results of mm_sizeclass_free() */
+
+#define MM_SIZECLASS_DONE       0	/* Chunk is cached */
+#define MM_SIZECLASS_SKIP       1	/* Chunk should go back to the heap */
+#define MM_SIZECLASS_INVALID    2	/* Chunk is already cached */
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/* Functions contained in mm_malloc.c ***************************************/
+
+FAR struct mm_allocnode_s *mm_alloc_node(FAR struct mm_heap_s *heap, size_t size);
+
+/* Functions contained in mm_free.c *****************************************/
+
+void mm_free_node(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node);
+
+#ifdef CONFIG_MM_SIZECLASS
+/* Functions contained in mm_sizeclass.c ************************************/
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR struct mm_allocnode_s *mm_sizeclass_alloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr);
+#else
+FAR struct mm_allocnode_s *mm_sizeclass_alloc(FAR struct mm_heap_s *heap, size_t size);
+#endif
+int mm_sizeclass_free(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node);
+void mm_sizeclass_drain(FAR struct mm_heap_s *heap);
+#endif
+
 #endif /* __MM_MM_HEAP_MM_NODE_H */
@@ -0,0 +1,357 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * mm/mm_heap/mm_sizeclass.c
+ *
+ * Size-class cache in front of the heap.  Freed small chunks are kept, as
+ * allocated heap nodes, in per-CPU lists indexed by chunk size.  malloc
+ * pops a chunk of the exact size from the list of the current CPU under
+ * the spinlock of that CPU with local interrupts disabled, without taking
+ * the MM semaphore, the global critical section or searching the free
+ * node lists.  When a list is empty, one larger chunk is taken
+ * from the heap and split into several chunks of that size.
+ *
+ * With CONFIG_DEBUG_MM_HEAPINFO, the per-task accounting still needs the
+ * MM semaphore, so it is taken around the list operations.  Cached chunks
+ * are marked with MM_SIZECLASS_CACHED in the 'reserved' field of the node.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <debug.h>
+
+#include <tinyara/mm/mm.h>
+#include <tinyara/arch.h>
+#include <tinyara/irq.h>
+#include <tinyara/spinlock.h>
+
+#include "mm_node.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Stored in the payload of a cached chunk */
+
+#define MM_SIZECLASS_MAGIC      0x5a43a5c3
+
+#define MM_NODE_PAYLOAD(node) \
+	((FAR struct mm_cachenode_s *)((char *)(node) + SIZEOF_MM_ALLOCNODE))
+#define MM_PAYLOAD_NODE(cache) \
+	((FAR struct mm_allocnode_s *)((char *)(cache) - SIZEOF_MM_ALLOCNODE))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Push a chunk to a list of 'cpu'. Must be called holding the lock of 'cpu'. */
+
+static void mm_sizeclass_push(FAR struct mm_heap_s *heap, int cpu, FAR struct mm_sizeclass_s *list, FAR struct mm_allocnode_s *node)
+{
+	FAR struct mm_cachenode_s *cache = MM_NODE_PAYLOAD(node);
+
+	cache->magic = MM_SIZECLASS_MAGIC;
+	cache->flink = list->head;
+	list->head = cache;
+	list->count++;
+	heap->mm_sizeclass_cached[cpu] += node->size;
+}
+
+/* Check whether a chunk is in any list of its class. Takes the lock of each
+ * CPU in turn, so it must be called without holding any of them.
+ */
+
+static bool mm_sizeclass_is_cached(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node)
+{
+	FAR struct mm_cachenode_s *cache = MM_NODE_PAYLOAD(node);
+	FAR struct mm_cachenode_s *iter;
+	irqstate_t flags;
+	bool found = false;
+	int cpu;
+
+	if (cache->magic != MM_SIZECLASS_MAGIC) {
+		return false;
+	}
+
+	/* The payload may hold the magic by chance, so search the lists */
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS && !found; cpu++) {
+		flags = spin_lock_irqsave(&heap->mm_sizeclass_lock[cpu]);
+		for (iter = heap->mm_sizeclass[cpu][MM_SIZECLASS_NDX(node->size)].head; iter; iter = iter->flink) {
+			if (iter == cache) {
+				found = true;
+				break;
+			}
+		}
+		spin_unlock_irqrestore(&heap->mm_sizeclass_lock[cpu], flags);
+	}
+
+	return found;
+}
+
+/****************************************************************************
+ * Name: mm_sizeclass_refill
+ *
+ * Description:
+ *   Take one chunk from the heap, split it into chunks of 'size' bytes,
+ *   cache all of them but the first one and return the first one.
+ *   The first chunk also takes the unused tail of the heap chunk, if any.
+ *   The caller must hold the MM semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+static FAR struct mm_allocnode_s *mm_sizeclass_refill(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr)
+#else
+static FAR struct mm_allocnode_s *mm_sizeclass_refill(FAR struct mm_heap_s *heap, size_t size)
+#endif
+{
+	FAR struct mm_allocnode_s *first;
+	FAR struct mm_allocnode_s *node;
+	FAR struct mm_allocnode_s *next;
+	FAR struct mm_sizeclass_s *list;
+	irqstate_t flags;
+	size_t count;
+	size_t extra;
+	size_t i;
+	int cpu;
+
+	count = CONFIG_MM_SIZECLASS_REFILL_SIZE / size;
+	if (count > CONFIG_MM_SIZECLASS_DEPTH + 1) {
+		count = CONFIG_MM_SIZECLASS_DEPTH + 1;
+	}
+
+	if (count <= 1) {
+		return NULL;
+	}
+
+	first = mm_alloc_node(heap, count * size);
+	if (!first) {
+		return NULL;
+	}
+
+	/* mm_alloc_node may leave a few more bytes than requested */
+
+	extra = first->size - count * size;
+	next = (FAR struct mm_allocnode_s *)((char *)first + first->size);
+	first->size = size + extra;
+
+	for (node = first, i = 1; i < count; i++) {
+		mmsize_t prevsize = node->size;
+
+		node = (FAR struct mm_allocnode_s *)((char *)node + prevsize);
+		node->preceding = prevsize | MM_ALLOC_BIT;
+		node->size = size;
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		heapinfo_update_node(node, caller_retaddr);
+		node->reserved = MM_SIZECLASS_CACHED;
+#endif
+	}
+	next->preceding = size | (next->preceding & MM_ALLOC_BIT);
+
+	/* The list of this CPU is empty or was just emptied, so all chunks fit */
+
+	cpu = up_cpu_index();
+	flags = spin_lock_irqsave(&heap->mm_sizeclass_lock[cpu]);
+	list = &heap->mm_sizeclass[cpu][MM_SIZECLASS_NDX(size)];
+	node = first;
+	for (i = 1; i < count && list->count < CONFIG_MM_SIZECLASS_DEPTH; i++) {
+		node = (FAR struct mm_allocnode_s *)((char *)node + node->size);
+		mm_sizeclass_push(heap, cpu, list, node);
+	}
+	spin_unlock_irqrestore(&heap->mm_sizeclass_lock[cpu], flags);
+
+	/* Another task could fill the list while we split the chunk */
+
+	for (; i < count; i++) {
+		node = (FAR struct mm_allocnode_s *)((char *)node + node->size);
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		node->reserved = 0;
+#endif
+		mm_free_node(heap, node);
+	}
+
+	mvdbg("Refilled size-class %u with %u chunks\n", size, count - 1);
+	return first;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_sizeclass_alloc
+ *
+ * Description:
+ *   Get a chunk of exactly 'size' bytes (allocnode included) from the
+ *   size-class cache, refilling it from the heap if empty. Returns NULL if
+ *   the heap has no chunk large enough for a refill.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR struct mm_allocnode_s *mm_sizeclass_alloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr)
+#else
+FAR struct mm_allocnode_s *mm_sizeclass_alloc(FAR struct mm_heap_s *heap, size_t size)
+#endif
+{
+	FAR struct mm_sizeclass_s *list;
+	FAR struct mm_cachenode_s *cache;
+	FAR struct mm_allocnode_s *node = NULL;
+	irqstate_t flags;
+	int cpu;
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	mm_takesemaphore(heap);
+#endif
+
+	/* The task may move to another CPU after up_cpu_index(), but it keeps
+	 * using the list and the lock of the same CPU, so this stays consistent.
+	 */
+
+	cpu = up_cpu_index();
+	flags = spin_lock_irqsave(&heap->mm_sizeclass_lock[cpu]);
+	list = &heap->mm_sizeclass[cpu][MM_SIZECLASS_NDX(size)];
+	cache = list->head;
+	if (cache) {
+		list->head = cache->flink;
+		list->count--;
+		cache->magic = 0;
+		node = MM_PAYLOAD_NODE(cache);
+		heap->mm_sizeclass_cached[cpu] -= node->size;
+	}
+	spin_unlock_irqrestore(&heap->mm_sizeclass_lock[cpu], flags);
+
+	if (!node) {
+#ifndef CONFIG_DEBUG_MM_HEAPINFO
+		mm_takesemaphore(heap);
+		node = mm_sizeclass_refill(heap, size);
+		mm_givesemaphore(heap);
+		return node;
+#else
+		node = mm_sizeclass_refill(heap, size, caller_retaddr);
+#endif
+	}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	if (node) {
+		heapinfo_update_node(node, caller_retaddr);
+		heapinfo_add_size(heap, node->pid, node->size);
+		heapinfo_update_total_size(heap, node->size, node->pid);
+	}
+
+	mm_givesemaphore(heap);
+#endif
+
+	return node;
+}
+
+/****************************************************************************
+ * Name: mm_sizeclass_free
+ *
+ * Description:
+ *   Put an allocated chunk into the size-class cache of the current CPU.
+ *   Returns MM_SIZECLASS_SKIP if the chunk is not a small chunk or the list
+ *   is full, and MM_SIZECLASS_INVALID if the chunk is already cached.
+ *   With CONFIG_DEBUG_MM_HEAPINFO, the caller must hold the MM semaphore
+ *   and have subtracted the chunk from heapinfo.
+ *
+ ****************************************************************************/
+
+int mm_sizeclass_free(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node)
+{
+	FAR struct mm_sizeclass_s *list;
+	irqstate_t flags;
+	int ret = MM_SIZECLASS_SKIP;
+	int cpu;
+
+	if ((node->preceding & MM_ALLOC_BIT) == 0 || !MM_SIZECLASS_FITS(node->size)) {
+		return MM_SIZECLASS_SKIP;
+	}
+
+	/* Checked before taking the local lock, so a double free racing with
+	 * itself on two CPUs is not always caught.
+	 */
+
+	if (mm_sizeclass_is_cached(heap, node)) {
+		return MM_SIZECLASS_INVALID;
+	}
+
+	cpu = up_cpu_index();
+	flags = spin_lock_irqsave(&heap->mm_sizeclass_lock[cpu]);
+	list = &heap->mm_sizeclass[cpu][MM_SIZECLASS_NDX(node->size)];
+	if (list->count < CONFIG_MM_SIZECLASS_DEPTH) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		node->reserved = MM_SIZECLASS_CACHED;
+#endif
+		mm_sizeclass_push(heap, cpu, list, node);
+		ret = MM_SIZECLASS_DONE;
+	}
+	spin_unlock_irqrestore(&heap->mm_sizeclass_lock[cpu], flags);
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name: mm_sizeclass_drain
+ *
+ * Description:
+ *   Give all cached chunks of all CPUs back to the heap, so that they can
+ *   be merged into larger free chunks.
+ *
+ ****************************************************************************/
+
+void mm_sizeclass_drain(FAR struct mm_heap_s *heap)
+{
+	FAR struct mm_cachenode_s *cache;
+	FAR struct mm_allocnode_s *node;
+	irqstate_t flags;
+	int cpu;
+	int ndx;
+
+	mm_takesemaphore(heap);
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		for (ndx = 0; ndx < MM_SIZECLASS_NCLASSES; ndx++) {
+			/* All chunks of one list have the same size */
+
+			flags = spin_lock_irqsave(&heap->mm_sizeclass_lock[cpu]);
+			cache = heap->mm_sizeclass[cpu][ndx].head;
+			heap->mm_sizeclass_cached[cpu] -= heap->mm_sizeclass[cpu][ndx].count * ((ndx + 1) << MM_MIN_SHIFT);
+			heap->mm_sizeclass[cpu][ndx].head = NULL;
+			heap->mm_sizeclass[cpu][ndx].count = 0;
+			spin_unlock_irqrestore(&heap->mm_sizeclass_lock[cpu], flags);
+
+			while (cache) {
+				node = MM_PAYLOAD_NODE(cache);
+				cache = cache->flink;
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+				node->reserved = 0;
+#endif
+				mm_free_node(heap, node);
+			}
+		}
+	}
+
+	mm_givesemaphore(heap);
+}
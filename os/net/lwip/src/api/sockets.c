@@ -1038,6 +1038,40 @@ int lwip_send(int s, const void *data, size_t size, int flags)
 	return (err == ERR_OK ? (int)written : -1);
 }
 
+#ifdef CONFIG_NET_SENDFILE
+/* Same as lwip_send() on a TCP socket, except that the segments reference
+ * the data instead of copying it.  The data must stay unchanged until it is
+ * acknowledged, so it is only used for files in XIP flash.
+ */
+int lwip_send_ref(int s, const void *data, size_t size, int flags)
+{
+	struct lwip_sock *sock;
+	err_t err;
+	u8_t write_flags;
+	size_t written;
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_send_ref(%d, data=%p, size=%" SZT_F ", flags=0x%x)\n", s, data, size, flags));
+
+	sock = get_socket_by_pid(s, getpid());
+	if (!sock) {
+		return -1;
+	}
+
+	if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) != NETCONN_TCP) {
+		sock_set_errno(sock, EOPNOTSUPP);
+		return -1;
+	}
+
+	write_flags = NETCONN_NOCOPY | ((flags & MSG_MORE) ? NETCONN_MORE : 0) | ((flags & MSG_DONTWAIT) ? NETCONN_DONTBLOCK : 0);
+	written = 0;
+	err = netconn_write_partly(sock->conn, data, size, write_flags, &written);
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_send_ref(%d) err=%d written=%" SZT_F "\n", s, err, written));
+	sock_set_errno(sock, err_to_errno(err));
+	return (err == ERR_OK ? (int)written : -1);
+}
+#endif
+
 int lwip_sendmsg(int s, const struct msghdr *msg, int flags)
 {
 	struct lwip_sock *sock;
@@ -72,6 +72,8 @@
 #include "lwip/api.h"
 #include "lwip/priv/api_msg.h"
 
+#include <string.h>
+
 #define TCPIP_MSG_VAR_REF(name)     API_VAR_REF(name)
 #define TCPIP_MSG_VAR_DECLARE(name) API_VAR_DECLARE(struct tcpip_msg, name)
 #define TCPIP_MSG_VAR_ALLOC(name)   API_VAR_ALLOC(struct tcpip_msg, MEMP_TCPIP_MSG_API, name, ERR_MEM)
@@ -148,6 +150,11 @@ static void tcpip_thread(void *arg)
 			msg->msg.inp.input_fn(msg->msg.inp.p, msg->msg.inp.netif);
 			memp_free(MEMP_TCPIP_MSG_INPKT, msg);
 			break;
+		case TCPIP_MSG_INPKT_BATCH:
+			LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_thread: PACKETS %p\n", (void *)msg));
+			netif_input_batch(msg->msg.inp_batch.p, msg->msg.inp_batch.count, msg->msg.inp_batch.netif);
+			mem_free(msg);
+			break;
 #endif							/* !LWIP_TCPIP_CORE_LOCKING_INPUT */
 
 #if LWIP_TCPIP_TIMEOUT			// && LWIP_TIMERS
@@ -242,6 +249,52 @@ err_t tcpip_input(struct pbuf *p, struct netif *inp)
 		return tcpip_inpkt(p, inp, ip_input);
 }
 
+/**
+ * Pass a batch of received packets to tcpip_thread for input processing
+ * with one core lock or one message instead of one per packet.
+ *
+ * @param p array of count received packets, as for tcpip_input()
+ * @param count number of packets in the array
+ * @param inp the network interface on which the packets were received
+ * @return ERR_OK if the packets were passed on, they are freed by the stack
+ *         then. On error the caller still owns all of them.
+ */
+err_t tcpip_input_batch(struct pbuf **p, u16_t count, struct netif *inp)
+{
+#if LWIP_TCPIP_CORE_LOCKING_INPUT
+	LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_input_batch: %u PACKETS/%p\n", count, (void *)inp));
+	LOCK_TCPIP_CORE();
+	netif_input_batch(p, count, inp);
+	UNLOCK_TCPIP_CORE();
+	return ERR_OK;
+#else							/* LWIP_TCPIP_CORE_LOCKING_INPUT */
+	struct tcpip_msg *msg;
+
+	LWIP_ASSERT("Invalid mbox", sys_mbox_valid_val(mbox));
+
+	if (count == 0) {
+		return ERR_OK;
+	}
+
+	/* The packet array follows the message in the same allocation */
+	msg = (struct tcpip_msg *)mem_malloc(sizeof(struct tcpip_msg) + count * sizeof(struct pbuf *));
+	if (msg == NULL) {
+		return ERR_MEM;
+	}
+
+	msg->type = TCPIP_MSG_INPKT_BATCH;
+	msg->msg.inp_batch.p = (struct pbuf **)(msg + 1);
+	msg->msg.inp_batch.count = count;
+	msg->msg.inp_batch.netif = inp;
+	MEMCPY(msg->msg.inp_batch.p, p, count * sizeof(struct pbuf *));
+	if (sys_mbox_trypost(&mbox, msg) != ERR_OK) {
+		mem_free(msg);
+		return ERR_MEM;
+	}
+	return ERR_OK;
+#endif							/* LWIP_TCPIP_CORE_LOCKING_INPUT */
+}
+
 /**
  * Call a specific function in the thread context of
  * tcpip_thread for easy access synchronization.
@@ -215,6 +215,32 @@ err_t netif_input(struct pbuf *p, struct netif *inp)
 		return ip_input(p, inp);
 }
 
+/**
+ * @ingroup lwip_nosys
+ * Forwards a batch of received packets for input processing like
+ * netif_input(). Packets which are not accepted are freed.
+ *
+ * @param p array of count received packets
+ * @param count number of packets in the array
+ * @param inp the network interface on which the packets were received
+ * @return the number of packets accepted for input processing
+ */
+u16_t netif_input_batch(struct pbuf **p, u16_t count, struct netif *inp)
+{
+	u16_t accepted = 0;
+	u16_t i;
+
+	for (i = 0; i < count; i++) {
+		if (netif_input(p[i], inp) == ERR_OK) {
+			accepted++;
+		} else {
+			pbuf_free(p[i]);
+		}
+	}
+
+	return accepted;
+}
+
 /**
  * Add a network interface to the list of lwIP netifs.
  *
@@ -512,6 +512,7 @@ void netif_poll_all(void);
 #endif							/* ENABLE_LOOPBACK */
 
 err_t netif_input(struct pbuf *p, struct netif *inp);
+u16_t netif_input_batch(struct pbuf **p, u16_t count, struct netif *inp);
 
 #if LWIP_IPV6
 /** @ingroup netif_ip6 */
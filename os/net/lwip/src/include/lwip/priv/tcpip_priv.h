@@ -129,6 +129,7 @@ enum tcpip_msg_type {
 	TCPIP_MSG_API,
 	TCPIP_MSG_API_CALL,
 	TCPIP_MSG_INPKT,
+	TCPIP_MSG_INPKT_BATCH,
 #if LWIP_TCPIP_TIMEOUT && LWIP_TIMERS
 	TCPIP_MSG_TIMEOUT,
 	TCPIP_MSG_UNTIMEOUT,
@@ -154,6 +155,11 @@ struct tcpip_msg {
 			struct netif *netif;
 			netif_input_fn input_fn;
 		} inp;
+		struct {
+			struct pbuf **p;
+			u16_t count;
+			struct netif *netif;
+		} inp_batch;
 		struct {
 			tcpip_callback_fn function;
 			void *ctx;
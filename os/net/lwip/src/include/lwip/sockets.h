@@ -518,6 +518,9 @@ int lwip_recv(int s, void *mem, size_t len, int flags);
 int lwip_read(int s, void *mem, size_t len);
 int lwip_recvfrom(int s, void *mem, size_t len, int flags, struct sockaddr *from, socklen_t * fromlen);
 int lwip_send(int s, const void *dataptr, size_t size, int flags);
+#ifdef CONFIG_NET_SENDFILE
+int lwip_send_ref(int s, const void *dataptr, size_t size, int flags);
+#endif
 int lwip_sendmsg(int s, const struct msghdr *message, int flags);
 int lwip_sendto(int s, const void *dataptr, size_t size, int flags, const struct sockaddr *to, socklen_t tolen);
 int lwip_socket(int domain, int type, int protocol);
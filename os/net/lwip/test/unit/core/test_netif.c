@@ -0,0 +1,213 @@
+/****************************************************************************
+ *
+ * Copyright 2026 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include "test_netif.h"
+
+#include <string.h>
+
+#include "lwip/netif.h"
+#include "lwip/udp.h"
+#include "lwip/etharp.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/stats.h"
+#include "lwip/prot/ethernet.h"
+#include "lwip/prot/ip4.h"
+#include "lwip/prot/udp.h"
+
+#if !LWIP_STATS || !UDP_STATS || !MEMP_STATS
+#error "This tests needs UDP- and MEMP-statistics enabled"
+#endif
+
+#define TEST_BURST         16
+#define TEST_PORT          5000
+#define TEST_PAYLOAD_LEN   18
+#define TEST_FRAME_LEN     (SIZEOF_ETH_HDR + IP_HLEN + UDP_HLEN + TEST_PAYLOAD_LEN)
+
+static struct netif test_netif;
+static ip4_addr_t test_ipaddr, test_netmask, test_gw, test_peer;
+static struct eth_addr test_ethaddr = { { 1, 1, 1, 1, 1, 1 } };
+static struct eth_addr test_ethaddr2 = { { 1, 1, 1, 1, 1, 2 } };
+static struct udp_pcb *test_pcb;
+static int recv_ctr;
+
+/* Helper functions */
+
+static void test_udp_recv(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t port)
+{
+	LWIP_UNUSED_ARG(arg);
+	LWIP_UNUSED_ARG(pcb);
+	LWIP_UNUSED_ARG(addr);
+	LWIP_UNUSED_ARG(port);
+	fail_unless(p->tot_len == TEST_PAYLOAD_LEN);
+	recv_ctr++;
+	pbuf_free(p);
+}
+
+static err_t test_netif_linkoutput(struct netif *netif, struct pbuf *p)
+{
+	LWIP_UNUSED_ARG(netif);
+	LWIP_UNUSED_ARG(p);
+	return ERR_OK;
+}
+
+static err_t test_netif_init(struct netif *netif)
+{
+	fail_unless(netif != NULL);
+	netif->linkoutput = test_netif_linkoutput;
+	netif->output = etharp_output;
+	netif->mtu = 1500;
+	netif->flags = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+	netif->hwaddr_len = ETH_HWADDR_LEN;
+	SMEMCPY(netif->hwaddr, &test_ethaddr, ETH_HWADDR_LEN);
+	return ERR_OK;
+}
+
+/* A frame as a driver would pass it: UDP from the peer to TEST_PORT,
+ * or an ethernet type the stack drops if type is not ETHTYPE_IP */
+static struct pbuf *test_frame(u16_t type, u16_t id)
+{
+	struct pbuf *p;
+	struct eth_hdr *ethhdr;
+	struct ip_hdr *iphdr;
+	struct udp_hdr *udphdr;
+
+	p = pbuf_alloc(PBUF_RAW, TEST_FRAME_LEN, PBUF_POOL);
+	EXPECT_RETNULL(p != NULL);
+	EXPECT_RETNULL(p->next == NULL);
+	memset(p->payload, 0, TEST_FRAME_LEN);
+
+	ethhdr = (struct eth_hdr *)p->payload;
+	ethhdr->dest = test_ethaddr;
+	ethhdr->src = test_ethaddr2;
+	ethhdr->type = lwip_htons(type);
+
+	iphdr = (struct ip_hdr *)((u8_t *)ethhdr + SIZEOF_ETH_HDR);
+	IPH_VHL_SET(iphdr, 4, IP_HLEN / 4);
+	IPH_LEN_SET(iphdr, lwip_htons(IP_HLEN + UDP_HLEN + TEST_PAYLOAD_LEN));
+	IPH_ID_SET(iphdr, lwip_htons(id));
+	IPH_TTL_SET(iphdr, 64);
+	IPH_PROTO_SET(iphdr, IP_PROTO_UDP);
+	ip4_addr_copy(iphdr->src, test_peer);
+	ip4_addr_copy(iphdr->dest, test_ipaddr);
+	IPH_CHKSUM_SET(iphdr, inet_chksum(iphdr, IP_HLEN));
+
+	/* no UDP checksum */
+	udphdr = (struct udp_hdr *)((u8_t *)iphdr + IP_HLEN);
+	udphdr->src = lwip_htons(TEST_PORT + 1);
+	udphdr->dest = lwip_htons(TEST_PORT);
+	udphdr->len = lwip_htons(UDP_HLEN + TEST_PAYLOAD_LEN);
+
+	return p;
+}
+
+static int test_burst(struct pbuf **burst, int num, u16_t type)
+{
+	int i;
+
+	for (i = 0; i < num; i++) {
+		burst[i] = test_frame(type, (u16_t)i);
+		if (burst[i] == NULL) {
+			while (i-- > 0) {
+				pbuf_free(burst[i]);
+			}
+			return 0;
+		}
+	}
+	return num;
+}
+
+/* Setups/teardown functions */
+
+static void netif_setup(void)
+{
+	IP4_ADDR(&test_gw, 192, 168, 0, 1);
+	IP4_ADDR(&test_ipaddr, 192, 168, 0, 1);
+	IP4_ADDR(&test_netmask, 255, 255, 0, 0);
+	IP4_ADDR(&test_peer, 192, 168, 0, 2);
+
+	fail_unless(netif_default == NULL);
+	netif_set_default(netif_add(&test_netif, &test_ipaddr, &test_netmask, &test_gw, NULL, test_netif_init, netif_input));
+	netif_set_up(&test_netif);
+
+	test_pcb = udp_new();
+	fail_unless(test_pcb != NULL);
+	fail_unless(udp_bind(test_pcb, IP_ADDR_ANY, TEST_PORT) == ERR_OK);
+	udp_recv(test_pcb, test_udp_recv, NULL);
+	recv_ctr = 0;
+}
+
+static void netif_teardown(void)
+{
+	udp_remove(test_pcb);
+	test_pcb = NULL;
+	netif_set_default(NULL);
+	netif_remove(&test_netif);
+	fail_unless(lwip_stats.memp[MEMP_PBUF_POOL]->used == 0);
+}
+
+/* Test functions */
+
+/** A burst is delivered in one call, every frame reaches the pcb */
+START_TEST(test_netif_input_batch)
+{
+	struct pbuf *burst[TEST_BURST];
+	u16_t accepted;
+	int num;
+	LWIP_UNUSED_ARG(_i);
+
+	num = test_burst(burst, TEST_BURST, ETHTYPE_IP);
+	EXPECT_RET(num == TEST_BURST);
+	fail_unless(lwip_stats.memp[MEMP_PBUF_POOL]->used == TEST_BURST);
+
+	accepted = netif_input_batch(burst, TEST_BURST, &test_netif);
+	fail_unless(accepted == TEST_BURST);
+	fail_unless(recv_ctr == TEST_BURST);
+	fail_unless(lwip_stats.memp[MEMP_PBUF_POOL]->used == 0);
+}
+
+END_TEST
+/** Frames the stack drops within a burst are freed and do not stop the rest */
+START_TEST(test_netif_input_batch_mixed)
+{
+	struct pbuf *burst[TEST_BURST];
+	int i;
+	LWIP_UNUSED_ARG(_i);
+
+	for (i = 0; i < TEST_BURST; i++) {
+		burst[i] = test_frame((i & 1) ? ETHTYPE_IP : 0x88b5, (u16_t)i);
+		EXPECT_RET(burst[i] != NULL);
+	}
+
+	netif_input_batch(burst, TEST_BURST, &test_netif);
+	fail_unless(recv_ctr == TEST_BURST / 2);
+	fail_unless(lwip_stats.memp[MEMP_PBUF_POOL]->used == 0);
+
+	/* an empty batch is fine */
+	fail_unless(netif_input_batch(burst, 0, &test_netif) == 0);
+}
+
+END_TEST
+/** Create the suite including all tests for this module */
+Suite *netif_suite(void)
+{
+	TFun tests[] = {
+		test_netif_input_batch,
+		test_netif_input_batch_mixed
+	};
+	return create_suite("NETIF", tests, sizeof(tests) / sizeof(TFun), netif_setup, netif_teardown);
+}
@@ -426,3 +426,35 @@ void net_releaselist(FAR struct socketlist *list)
 	/* Destroy the semaphore */
 	sem_destroy(&list->sl_sem);
 }
+
+#ifdef CONFIG_NET_SENDFILE
+/****************************************************************************
+ * Name: net_send_ref
+ *
+ * Description:
+ *   Send data on a TCP socket without copying it into the send buffer.
+ *
+ * Input Parameters:
+ *   sd    - Socket descriptor of the socket
+ *   data  - Data to send, unchanged until the peer has acknowledged it
+ *   size  - Length of data to send
+ *   flags - Send flags
+ *
+ * Returned Value:
+ *   The number of bytes sent; -1 on failure with errno set.  ENOSYS means
+ *   the socket cannot send without copying.
+ *
+ ****************************************************************************/
+
+ssize_t net_send_ref(int sd, FAR const void *data, size_t size, int flags)
+{
+	struct netstack *stk = get_netstack_byfd(sd);
+
+	if (stk == NULL || stk->ops->send_ref == NULL) {
+		set_errno(ENOSYS);
+		return ERROR;
+	}
+
+	return stk->ops->send_ref(sd, data, size, flags);
+}
+#endif
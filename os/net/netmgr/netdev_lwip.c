@@ -36,7 +36,9 @@
 #include "lwip/netifapi.h"
 #include "lwip/snmp.h"
 #include "lwip/igmp.h"
+#include "lwip/tcpip.h"
 #include "netdev_mgr_internal.h"
+#include "netdev_stats.h"
 #include <tinyara/net/netlog.h>
 
 /* This is really kind of bogus.. When asked for an IP address, this is
@@ -273,6 +275,31 @@ static inline void _free_ifaddrs(struct ifaddrs *addrs)
 	}
 }
 
+/* Frame types which are passed to tcpip_thread */
+static int lwip_input_type(struct pbuf *p)
+{
+	struct eth_hdr *ethhdr = p->payload;
+
+	if (p->len < SIZEOF_ETH_HDR) {
+		return 0;
+	}
+
+	switch (htons(ethhdr->type)) {
+	case ETHTYPE_IP:
+#if LWIP_IPV6
+	case ETHTYPE_IPV6:
+#endif
+	case ETHTYPE_ARP:
+#if PPPOE_SUPPORT
+	case ETHTYPE_PPPOEDISC:
+	case ETHTYPE_PPPOE:
+#endif
+		return 1;
+	default:
+		return 0;
+	}
+}
+
 #ifdef CONFIG_NET_NETMGR_ZEROCOPY
 static err_t lwip_linkoutput(struct netif *nic, struct pbuf *buf)
 {
@@ -326,6 +353,12 @@ static int lwip_input(struct netdev *dev, void *frame_ptr, uint16_t len)
 	}
 	return 0;
 }
+
+static struct pbuf *lwip_input_pbuf(void *frame_ptr, uint16_t len)
+{
+	(void)len;
+	return (struct pbuf *)frame_ptr;
+}
 #else /*  CONFIG_NET_NETMGR_ZEROCOPY */
 static err_t lwip_linkoutput(struct netif *nic, struct pbuf *buf)
 {
@@ -347,17 +380,10 @@ static err_t lwip_linkoutput(struct netif *nic, struct pbuf *buf)
 	return ERR_OK;
 }
 
-static int lwip_input(struct netdev *dev, void *frame_ptr, uint16_t len)
+static struct pbuf *lwip_input_pbuf(void *frame_ptr, uint16_t len)
 {
-	LWIP_DEBUGF(NETIF_DEBUG, ("passing to LWIP layer, packet len %d \n", len));
 	struct pbuf *p, *q;
-	/* Receive the complete packet */
-	/* Obtain the size of the packet and put it into the "len" variable. */
-	if (0 == len) {
-		NET_LOGKV(TAG, "input size is 0\n");
-		return 0;
-	}
-	struct netif *netif = GET_NETIF_FROM_NETDEV(dev);
+
 	/* We allocate a pbuf chain of pbufs from the pool. */
 	p = pbuf_alloc(PBUF_RAW, len, PBUF_POOL);
 
@@ -366,7 +392,7 @@ static int lwip_input(struct netdev *dev, void *frame_ptr, uint16_t len)
 		LWIP_DEBUGF(NETIF_DEBUG, ("mem error\n"));
 		LINK_STATS_INC(link.memerr);
 		LINK_STATS_INC(link.drop);
-		return -1;
+		return NULL;
 	}
 	LWIP_DEBUGF(NETIF_DEBUG, ("processing pbufs\n"));
 
@@ -376,6 +402,25 @@ static int lwip_input(struct netdev *dev, void *frame_ptr, uint16_t len)
 		frame_ptr += q->len;
 	}
 
+	return p;
+}
+
+static int lwip_input(struct netdev *dev, void *frame_ptr, uint16_t len)
+{
+	LWIP_DEBUGF(NETIF_DEBUG, ("passing to LWIP layer, packet len %d \n", len));
+	struct pbuf *p;
+	/* Receive the complete packet */
+	/* Obtain the size of the packet and put it into the "len" variable. */
+	if (0 == len) {
+		NET_LOGKV(TAG, "input size is 0\n");
+		return 0;
+	}
+	struct netif *netif = GET_NETIF_FROM_NETDEV(dev);
+	p = lwip_input_pbuf(frame_ptr, len);
+	if (!p) {
+		return -1;
+	}
+
 	struct eth_hdr *ethhdr = p->payload;
 	switch (htons(ethhdr->type)) {
 	case ETHTYPE_IP:
@@ -408,6 +453,63 @@ static int lwip_input(struct netdev *dev, void *frame_ptr, uint16_t len)
 }
 #endif /*  CONFIG_NET_NETMGR_ZEROCOPY */
 
+static int lwip_input_flush(struct netif *netif, struct pbuf **batch, int num)
+{
+	int i;
+
+	/* the whole batch goes to tcpip_thread in one message */
+	if (tcpip_input_batch(batch, num, netif) != ERR_OK) {
+		NET_LOGKE(TAG, "input processing\n");
+		LWIP_DEBUGF(NETIF_DEBUG, ("input processing error\n"));
+		NETMGR_STATS_INC(g_link_recv_err);
+		for (i = 0; i < num; i++) {
+			LINK_STATS_INC(link.err);
+			pbuf_free(batch[i]);
+		}
+		return 0;
+	}
+
+	for (i = 0; i < num; i++) {
+		LINK_STATS_INC(link.recv);
+	}
+	return num;
+}
+
+static int lwip_input_batch(struct netdev *dev, struct netdev_frame *frames, int count)
+{
+	struct netif *netif = GET_NETIF_FROM_NETDEV(dev);
+	struct pbuf *batch[NETDEV_INPUT_BATCH_MAX];
+	struct pbuf *p;
+	int passed = 0;
+	int num = 0;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		if (!frames[i].data) {
+			continue;
+		}
+		p = lwip_input_pbuf(frames[i].data, frames[i].len);
+		if (!p) {
+			continue;
+		}
+		if (!lwip_input_type(p)) {
+			LWIP_DEBUGF(NETIF_DEBUG, ("not supported ethernet type error\n"));
+			pbuf_free(p);
+			continue;
+		}
+		batch[num++] = p;
+		if (num == NETDEV_INPUT_BATCH_MAX) {
+			passed += lwip_input_flush(netif, batch, num);
+			num = 0;
+		}
+	}
+	if (num > 0) {
+		passed += lwip_input_flush(netif, batch, num);
+	}
+
+	return passed;
+}
+
 static err_t lwip_set_multicast_list(struct netif *nic, const ip4_addr_t *group, enum netif_mac_filter_action action)
 {
 	struct netdev *dev = LW_GETND(nic);
@@ -918,6 +1020,7 @@ struct netdev_ops *get_netdev_ops_lwip(void)
 	netdev_ops->leavegroup = lwip_leavegroup;
 
 	netdev_ops->input = lwip_input;
+	netdev_ops->input_batch = lwip_input_batch;
 	netdev_ops->get_stats = lwip_get_stats;
 	netdev_ops->nic = NULL;
 
@@ -29,6 +29,9 @@
 #include "netdev_mgr_internal.h"
 #include <tinyara/net/netlog.h>
 #include "netdev_stats.h"
+#ifdef CONFIG_NET_NETMGR_ZEROCOPY
+#include "lwip/pbuf.h"
+#endif
 
 #define TAG "[NETMGR]"
 
@@ -76,6 +79,30 @@ int netdev_input(struct netdev *dev, void *data, uint16_t len)
 	return ND_NETOPS(dev, input)(dev, data, len);
 }
 
+int netdev_input_batch(struct netdev *dev, struct netdev_frame *frames, int count)
+{
+	int i;
+
+	if (count <= 0) {
+		return 0;
+	}
+	NETMGR_STATS_INC(g_link_recv_batch);
+	NETMGR_STATS_MAX(g_link_recv_batch_max, (uint32_t)count);
+	for (i = 0; i < count; i++) {
+#ifdef CONFIG_NET_NETMGR_ZEROCOPY
+		/* A zero-copy frame is a pbuf and its len is 0 */
+		if (frames[i].data) {
+			NETMGR_STATS_ADD(g_link_recv_byte, ((struct pbuf *)frames[i].data)->tot_len);
+		}
+#else
+		NETMGR_STATS_ADD(g_link_recv_byte, frames[i].len);
+#endif
+		NETMGR_STATS_INC(g_link_recv_cnt);
+	}
+
+	return ND_NETOPS(dev, input_batch)(dev, frames, count);
+}
+
 int netdev_get_mtu(struct netdev *dev, int *mtu)
 {
 	return ND_NETOPS(dev, get_mtu)(dev, mtu);
@@ -76,6 +76,7 @@ struct netdev_ops {
 	int (*leavegroup)(struct netdev *dev, struct in_addr *addr);
 
 	int (*input)(struct netdev *dev, void *data, uint16_t len);
+	int (*input_batch)(struct netdev *dev, struct netdev_frame *frames, int count);
 	int (*linkoutput)(struct netdev *dev, void *data, uint16_t len);
 	int (*igmp_mac_filter)(struct netdev *dev, const struct in_addr *group, netdev_mac_filter_action action);
 
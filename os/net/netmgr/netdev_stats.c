@@ -24,6 +24,8 @@
 uint32_t g_link_recv_byte = 0;
 uint32_t g_link_recv_cnt = 0;
 uint32_t g_link_recv_err = 0;
+uint32_t g_link_recv_batch = 0;
+uint32_t g_link_recv_batch_max = 0;
 
 uint32_t g_app_recv_byte = 0;
 uint32_t g_app_recv_cnt = 0;
@@ -32,5 +34,6 @@ void netstats_display(void)
 {
 	NET_LOGK(TAG, "[driver] total recv %u\t%u\n", g_link_recv_byte, g_link_recv_cnt);
 	NET_LOGK(TAG, "[driver] mbox err %u\n", g_link_recv_err);
+	NET_LOGK(TAG, "[driver] batch recv %u\tmax %u\n", g_link_recv_batch, g_link_recv_batch_max);
 	NET_LOGK(TAG, "[app] total recv %u\t%u\n", g_app_recv_byte, g_app_recv_cnt);
 }
@@ -23,6 +23,8 @@
 extern uint32_t g_link_recv_byte;
 extern uint32_t g_link_recv_cnt;
 extern uint32_t g_link_recv_err;
+extern uint32_t g_link_recv_batch;
+extern uint32_t g_link_recv_batch_max;
 
 extern uint32_t g_app_recv_byte;
 extern uint32_t g_app_recv_cnt;
@@ -33,12 +35,21 @@ extern uint32_t g_app_recv_cnt;
 	} while (0)
 
 #define NETMGR_STATS_INC(x) x++;
+
+#define NETMGR_STATS_MAX(x, y) \
+	do {                       \
+		if ((y) > x) {         \
+			x = (y);           \
+		}                      \
+	} while (0)
+
 void netstats_display(void);
 
 #else
 
 #define NETMGR_STATS_ADD(x, y)
 #define NETMGR_STATS_INC(x)
+#define NETMGR_STATS_MAX(x, y)
 
 #define netstats_display(...)
 
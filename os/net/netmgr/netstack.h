@@ -89,6 +89,10 @@ struct netstack_ops {
 	int (*getstats)(void *arg);
 	void (*initlist)(struct socketlist *list);
 	void (*releaselist)(struct socketlist *list);
+#ifdef CONFIG_NET_SENDFILE
+	// send without copying, data must be unchanged until acknowledged
+	ssize_t (*send_ref)(int s, const void *data, size_t size, int flags);
+#endif
 };
 
 struct netstack {
@@ -601,6 +601,13 @@ static ssize_t lwip_ns_send(int s, const void *data, size_t size, int flags)
 	return lwip_send(s, data, size, flags);
 }
 
+#ifdef CONFIG_NET_SENDFILE
+static ssize_t lwip_ns_send_ref(int s, const void *data, size_t size, int flags)
+{
+	return lwip_send_ref(s, data, size, flags);
+}
+#endif
+
 static ssize_t lwip_ns_sendto(int s, const void *data, size_t size, int flags, const struct sockaddr *to, socklen_t tolen)
 {
 	return lwip_sendto(s, data, size, flags, to, tolen);
@@ -809,7 +816,11 @@ struct netstack_ops g_lwip_stack_ops = {
 #endif
 	lwip_ns_getstats,
 	lwip_ns_initlist,
-	lwip_ns_releaselist};
+	lwip_ns_releaselist,
+#ifdef CONFIG_NET_SENDFILE
+	lwip_ns_send_ref,
+#endif
+};
 
 struct netstack g_lwip_stack = {&g_lwip_stack_ops, NULL};
 